@@ -554,6 +554,13 @@ Unable to run hostname to check the network')
     ''' + ('if (MPI_Reduce_local_c(0,0,0,MPI_INT,MPI_SUM)) return 1;\n' if self.haveReduceLocal == 1 else '')):
       self.addDefine('HAVE_MPI_LARGE_COUNT', 1)
 
+    if self.checkLink('#include <mpi.h>\n',
+    '''
+      MPI_Request req;
+      if (MPI_Neighbor_alltoallv_init(0,0,0,MPI_INT,0,0,0,MPI_INT,MPI_COMM_WORLD,MPI_INFO_NULL,&req)) return 1;
+    '''):
+      self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES', 1)
+
     self.compilers.CPPFLAGS = oldFlags
     self.compilers.LIBS = oldLibs
     self.logWrite(self.framework.restoreLog())
@@ -603,6 +610,23 @@ Unable to run hostname to check the network')
       self.compilers.CPPFLAGS = oldFlags
       self.compilers.LIBS = oldLibs
       self.logWrite(self.framework.restoreLog())
+    # OpenMPI 4 provides the persistent collectives of MPI-4 in its pcollreq extension
+    if hasattr(self, 'ompi_major_version') and not self.defines.get('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES'):
+      oldFlags = self.compilers.CPPFLAGS
+      oldLibs  = self.compilers.LIBS
+      self.compilers.CPPFLAGS += ' '+self.headers.toString(self.include)
+      self.compilers.LIBS = self.libraries.toString(self.lib)+' '+self.compilers.LIBS
+      self.framework.saveLog()
+      if self.checkLink('#include <mpi.h>\n#include <mpi-ext.h>\n',
+      '''
+        MPI_Request req;
+        if (MPIX_Neighbor_alltoallv_init(0,0,0,MPI_INT,0,0,0,MPI_INT,MPI_COMM_WORLD,MPI_INFO_NULL,&req)) return 1;
+      '''):
+        self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES', 1)
+        self.addDefine('HAVE_MPIX_PERSISTENT_NEIGHBORHOOD_COLLECTIVES', 1)
+      self.compilers.CPPFLAGS = oldFlags
+      self.compilers.LIBS = oldLibs
+      self.logWrite(self.framework.restoreLog())
     return
 
   def configureMPITypes(self):
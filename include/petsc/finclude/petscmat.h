@@ -111,6 +111,9 @@
 #define MATAIJSELL         'aijsell'
 #define MATSEQAIJSELL      'seqaijsell'
 #define MATMPIAIJSELL      'mpiaijsell'
+#define MATAIJSINGLESHADOW 'aijsingleshadow'
+#define MATSEQAIJSINGLESHADOW 'seqaijsingleshadow'
+#define MATMPIAIJSINGLESHADOW 'mpiaijsingleshadow'
 #define MATAIJMKL          'aijmkl'
 #define MATSEQAIJMKL       'seqaijmkl'
 #define MATMPIAIJMKL       'mpiaijmkl'
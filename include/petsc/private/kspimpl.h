@@ -277,6 +277,19 @@ PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP, PetscBool, KSPNormType *,
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP, PetscInt, const PetscReal *, const PetscReal *);
 
+/* small dense kernels shared by the s-step methods KSPSSTEPGMRES and KSPSSTEPCG */
+PETSC_INTERN PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType, PetscInt, const PetscReal[], PetscInt, PetscReal[], PetscReal[], PetscReal[]);
+PETSC_INTERN PetscErrorCode KSPSStepCholesky_Private(PetscInt, PetscScalar[], PetscInt, const PetscReal[], PetscReal, PetscInt *);
+PETSC_INTERN PetscErrorCode KSPSStepCholeskySolve_Private(PetscInt, const PetscScalar[], PetscInt, PetscScalar[]);
+
+/* kernels shared by the block methods of KSPMatSolve() for KSPCG and KSPGMRES */
+PETSC_INTERN PetscErrorCode KSPBlockMatMult_Private(KSP, Mat, Mat, Mat *);
+PETSC_INTERN PetscErrorCode KSPBlockDotLocal_Private(Mat, Mat, PetscScalar[], PetscInt);
+PETSC_INTERN PetscErrorCode KSPBlockColumnDotsLocal_Private(Mat, Mat, PetscScalar[]);
+PETSC_INTERN PetscErrorCode KSPBlockUpdate_Private(Mat, PetscScalar, PetscScalar, Mat, const PetscScalar[], PetscInt);
+PETSC_INTERN PetscErrorCode KSPBlockResidualNorm_Private(PetscInt, const PetscReal[], PetscBool, PetscReal[], PetscReal *);
+PETSC_INTERN PetscErrorCode KSPBlockGramFactor_Private(PetscInt, PetscScalar[], PetscReal, PetscScalar[], PetscScalar[], PetscInt *, PetscBool *);
+
 typedef struct _p_DMKSP  *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
 struct _DMKSPOps {
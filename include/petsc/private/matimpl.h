@@ -383,6 +383,10 @@ struct _MatStash {
   MPI_Datatype    blocktype;
   size_t          blocktype_size;
   InsertMode     *insertmode; /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used for thread safe MatSetValues(), see MAT_THREAD_SAFE_SET_VALUES */
+  PetscInt  nthreadstash; /* number of per-thread stashes, 0 if the stash is not thread safe */
+  MatStash *threadstash;  /* values stashed by OpenMP thread t go to threadstash[t], they are merged into the stash by ScatterBegin */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -392,6 +396,7 @@ PETSC_INTERN PetscErrorCode MatStashCreate_Private(MPI_Comm, PetscInt, MatStash
 PETSC_INTERN PetscErrorCode MatStashDestroy_Private(MatStash *);
 PETSC_INTERN PetscErrorCode MatStashScatterEnd_Private(MatStash *);
 PETSC_INTERN PetscErrorCode MatStashSetInitialSize_Private(MatStash *, PetscInt);
+PETSC_INTERN PetscErrorCode MatStashSetThreadSafe_Private(MatStash *, PetscBool);
 PETSC_INTERN PetscErrorCode MatStashGetInfo_Private(MatStash *, PetscInt *, PetscInt *);
 PETSC_INTERN PetscErrorCode MatStashValuesRow_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscBool);
 PETSC_INTERN PetscErrorCode MatStashValuesCol_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscBool);
@@ -446,6 +451,22 @@ typedef struct { /* used by MatProduct() */
   PetscErrorCode (*destroy)(void *); /* destroy routine */
 } Mat_Product;
 
+typedef enum {
+  MAT_THREADSAFE_ERROR_NONE,
+  MAT_THREADSAFE_ERROR_INSERTMODE,
+  MAT_THREADSAFE_ERROR_ROW,
+  MAT_THREADSAFE_ERROR_COLUMN,
+  MAT_THREADSAFE_ERROR_NEW_NONZERO,
+  MAT_THREADSAFE_ERROR_OFF_PROC,
+  MAT_THREADSAFE_ERROR_STASH
+} MatThreadSafeErrorType;
+
+typedef struct { /* first error of an OpenMP thread in MatSetValues() with MAT_THREAD_SAFE_SET_VALUES, raised by MatAssemblyBegin() */
+  MatThreadSafeErrorType type;
+  PetscInt               row, col; /* the entry, or the row or column and the largest valid one */
+  PetscErrorCode         ierr;     /* error code of the stash */
+} MatThreadSafeError;
+
 struct _p_Mat {
   PETSCHEADER(struct _MatOps);
   PetscLayout      rmap, cmap;
@@ -502,6 +523,10 @@ struct _p_Mat {
   PetscBool            transupdated;            /* whether or not the explicitly generated transpose is up-to-date */
   char                *factorprefix;            /* the prefix to use with factored matrix that is created */
   PetscBool            hash_active;             /* indicates MatSetValues() is being handled by hashing */
+  PetscBool            threadsafe_setvalues;    /* set by MAT_THREAD_SAFE_SET_VALUES, MatSetValues() may be called from OpenMP threads */
+  PetscErrorCode (*setvalues_threadunsafe)(Mat, PetscInt, const PetscInt[], PetscInt, const PetscInt[], const PetscScalar[], InsertMode); /* ops->setvalues replaced by MAT_THREAD_SAFE_SET_VALUES */
+  PetscInt             nthreadsafe_errors;      /* number of OpenMP threads whose errors in MatSetValues() can be recorded */
+  MatThreadSafeError  *threadsafe_errors;       /* error of OpenMP thread t in threadsafe_errors[t], see MatThreadSafeSetError_Private() */
 };
 
 PETSC_INTERN PetscErrorCode MatAXPY_Basic(Mat, PetscScalar, Mat, MatStructure);
@@ -510,6 +535,8 @@ PETSC_INTERN PetscErrorCode MatAXPY_Basic_Preallocate(Mat, Mat, Mat *);
 PETSC_INTERN PetscErrorCode MatAXPY_Dense_Nest(Mat, PetscScalar, Mat);
 
 PETSC_INTERN PetscErrorCode MatSetUp_Default(Mat);
+PETSC_INTERN PetscErrorCode MatThreadSafeSetUpErrors_Private(Mat, PetscBool);
+PETSC_INTERN void MatThreadSafeSetError_Private(Mat, MatThreadSafeErrorType, PetscInt, PetscInt, PetscErrorCode);
 
 /*
     Utility for MatZeroRows
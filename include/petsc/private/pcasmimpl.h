@@ -21,6 +21,7 @@ typedef struct {
   PetscBool       dm_subdomains; /* whether DM is allowed to define subdomains */
   PCCompositeType loctype;       /* the type of composition for local solves */
   MatType         sub_mat_type;  /* the type of Mat used for subdomain solves (can be MATSAME or NULL) */
+  PetscInt        nthreads;      /* number of OpenMP threads that set up and solve the subdomains of this process concurrently */
   /* For multiplicative solve */
   Mat *lmats; /* submatrices for overlapping multiplicative (process) subdomain */
 } PC_ASM;
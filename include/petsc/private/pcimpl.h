@@ -71,3 +71,7 @@ PETSC_EXTERN PetscLogEvent PC_ModifySubMatrices;
 PETSC_EXTERN PetscLogEvent PC_ApplyOnBlocks;
 PETSC_EXTERN PetscLogEvent PC_ApplyTransposeOnBlocks;
 PETSC_EXTERN PetscLogStage PCMPIStage;
+
+/* setup and solves of the sequential sub-KSP of PCBJACOBI and PCASM, possibly concurrent on OpenMP threads */
+PETSC_INTERN PetscErrorCode PCSetUpSubKSPs_Private(PC, PetscInt, PetscInt, KSP[]);
+PETSC_INTERN PetscErrorCode PCSolveSubKSPs_Private(PC, PetscInt, PetscInt, KSP[], Vec[], Vec[], PetscBool);
@@ -1365,6 +1365,13 @@ struct PetscCommStash {
   MPI_Comm               comm;
 };
 
+/* Communicators used by PetscCommBuildTwoSided() with PETSC_BUILDTWOSIDED_HIERARCHICAL */
+struct PetscCommNodes {
+  MPI_Comm     nodecomm;   /* ranks of my node, the first one is the node leader */
+  MPI_Comm     leadercomm; /* node leaders, MPI_COMM_NULL on the other ranks */
+  PetscMPIInt *nodeinfo;   /* on node leaders, [2*size] node (rank of its leader in leadercomm) and rank in its nodecomm of each rank */
+};
+
 /*
   PETSc communicators have this attribute, see
   PetscCommDuplicate(), PetscCommDestroy(), PetscCommGetNewTag(), PetscObjectGetName()
@@ -1375,6 +1382,7 @@ typedef struct {
   PetscInt               namecount; /* used to generate the next name, as in Vec_0, Mat_1, ... */
   PetscMPIInt           *iflags;    /* length of comm size, shared by all calls to PetscCommBuildTwoSided_Allreduce/RedScatter on this comm */
   struct PetscCommStash *comms;     /* communicators available for PETSc to pass off to other packages */
+  struct PetscCommNodes *nodes;     /* created by the first call to PetscCommBuildTwoSided_Hierarchical() on this comm */
 } PetscCommCounter;
 
 typedef enum {
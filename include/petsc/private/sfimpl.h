@@ -30,7 +30,9 @@ typedef enum {
 typedef enum {
   PETSCSF_BCAST = 0,
   PETSCSF_REDUCE,
-  PETSCSF_FETCH
+  PETSCSF_FETCH,
+  PETSCSF_BCAST_MULTIPLE, /* Bcast and Reduce of several arrays at once, packed in the same buffers */
+  PETSCSF_REDUCE_MULTIPLE
 } PetscSFOperation;
 /* When doing device-aware MPI, a backend refers to the SF/device interface */
 typedef enum {
@@ -53,6 +55,10 @@ struct _PetscSFOps {
   PetscErrorCode (*ReduceEnd)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
   PetscErrorCode (*FetchAndOpBegin)(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
   PetscErrorCode (*FetchAndOpEnd)(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op);
+  PetscErrorCode (*BcastMultipleBegin)(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op); /* Host data only */
+  PetscErrorCode (*BcastMultipleEnd)(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op);
+  PetscErrorCode (*ReduceMultipleBegin)(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op);
+  PetscErrorCode (*ReduceMultipleEnd)(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op);
   PetscErrorCode (*BcastToZero)(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *); /* For internal use only */
   PetscErrorCode (*GetRootRanks)(PetscSF, PetscInt *, const PetscMPIInt **, const PetscInt **, const PetscInt **, const PetscInt **);
   PetscErrorCode (*GetLeafRanks)(PetscSF, PetscInt *, const PetscMPIInt **, const PetscInt **, const PetscInt **);
@@ -69,15 +75,18 @@ typedef struct _n_PetscSFPackOpt *PetscSFPackOpt;
 
 struct _p_PetscSF {
   PETSCHEADER(struct _PetscSFOps);
-  struct {                                  /* Fields needed to implement VecScatter behavior */
-    PetscInt           from_n, to_n;        /* Recorded local sizes of the input from/to vectors in VecScatterCreate(). Used subsequently for error checking. */
-    PetscBool          beginandendtogether; /* Indicates that the scatter begin and end  function are called together, VecScatterEnd() is then treated as a nop */
-    const PetscScalar *xdata;               /* Vector data to read from */
-    PetscScalar       *ydata;               /* Vector data to write to. The two pointers are recorded in VecScatterBegin. Memory is not managed by SF. */
-    PetscSF            lsf;                 /* The local part of the scatter, used in SCATTER_LOCAL. Built on demand. */
-    PetscInt           bs;                  /* Block size, determined by IS passed to VecScatterCreate */
-    MPI_Datatype       unit;                /* one unit = bs PetscScalars */
-    PetscBool          logging;             /* Indicate if vscat log events are happening. If yes, avoid duplicated SF logging to have clear -log_view */
+  struct {                                   /* Fields needed to implement VecScatter behavior */
+    PetscInt            from_n, to_n;        /* Recorded local sizes of the input from/to vectors in VecScatterCreate(). Used subsequently for error checking. */
+    PetscBool           beginandendtogether; /* Indicates that the scatter begin and end  function are called together, VecScatterEnd() is then treated as a nop */
+    const PetscScalar  *xdata;               /* Vector data to read from */
+    PetscScalar        *ydata;               /* Vector data to write to. The two pointers are recorded in VecScatterBegin. Memory is not managed by SF. */
+    PetscSF             lsf;                 /* The local part of the scatter, used in SCATTER_LOCAL. Built on demand. */
+    PetscInt            bs;                  /* Block size, determined by IS passed to VecScatterCreate */
+    MPI_Datatype        unit;                /* one unit = bs PetscScalars */
+    PetscBool           logging;             /* Indicate if vscat log events are happening. If yes, avoid duplicated SF logging to have clear -log_view */
+    PetscInt            nv;                  /* Number of vectors of the scatter started by VecScatterBeginMultiple() ... */
+    const PetscScalar **xdatas;              /* ... and their data, recorded until VecScatterEndMultiple() */
+    PetscScalar       **ydatas;
   } vscat;
 
   /* Fields for generic PetscSF functionality */
@@ -106,6 +106,7 @@ struct _VecOps {
   PetscErrorCode (*setvaluescoo)(Vec, const PetscScalar[], InsertMode);
   PetscErrorCode (*errorwnorm)(Vec, Vec, Vec, NormType, PetscReal, Vec, PetscReal, Vec, PetscReal, PetscReal *, PetscInt *, PetscReal *, PetscInt *, PetscReal *, PetscInt *);
   PetscErrorCode (*maxpby)(Vec, PetscInt, const PetscScalar *, PetscScalar, Vec *); /* y = beta y + alpha[j] x[j] */
+  PetscErrorCode (*mdotmaxpynorm)(Vec, PetscInt, const Vec[], PetscScalar *, PetscReal *); /* z[j] = x dot y[j], x = x - z[j] y[j], nrm = ||x|| */
 };
 
 #if defined(offsetof) && (defined(__cplusplus) || (PETSC_C_VERSION >= 23))
@@ -190,6 +191,7 @@ PETSC_EXTERN PetscLogEvent VEC_AXPY;
 PETSC_EXTERN PetscLogEvent VEC_AYPX;
 PETSC_EXTERN PetscLogEvent VEC_WAXPY;
 PETSC_EXTERN PetscLogEvent VEC_MAXPY;
+PETSC_EXTERN PetscLogEvent VEC_MDotMAXPYNorm;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent VEC_PointwiseMult;
 PETSC_EXTERN PetscLogEvent VEC_SetValues;
@@ -232,6 +234,9 @@ PETSC_EXTERN PetscErrorCode VecViennaCLCopyFromGPU(Vec v);
 /* Get Root type of vector. e.g. VECSEQ -> VECSTANDARD, VECMPICUDA -> VECCUDA */
 PETSC_EXTERN PetscErrorCode VecGetRootType_Private(Vec, VecType *);
 
+/* Use BLAS gemv in VecMDot(), VecMTDot() and VecMAXPY() of VECSEQ and VECMPI vectors, e.g. for the Krylov bases */
+PETSC_EXTERN PetscErrorCode VecSetUseGEMV_Private(Vec, PetscBool, PetscBool);
+
 /* Default obtain and release vectors; can be used by any implementation */
 PETSC_INTERN PetscErrorCode VecDuplicateVecs_Default(Vec, PetscInt, Vec *[]);
 PETSC_INTERN PetscErrorCode VecDestroyVecs_Default(PetscInt, Vec[]);
@@ -241,6 +246,9 @@ PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecLoad_Default(Vec, PetscViewer);
 
 PETSC_INTERN PetscInt NormIds[7]; /* map from NormType to IDs used to cache/retrieve values of norms */
 
+PETSC_INTERN PetscBool      VecOMPFirstTouch; /* zero newly allocated vector arrays from OpenMP threads, see -vec_omp_first_touch */
+PETSC_INTERN PetscErrorCode VecCallocArray_Private(PetscInt, PetscScalar **);
+
 PETSC_INTERN PetscErrorCode VecStashCreate_Private(MPI_Comm, PetscInt, VecStash *);
 PETSC_INTERN PetscErrorCode VecStashDestroy_Private(VecStash *);
 PETSC_INTERN PetscErrorCode VecStashScatterEnd_Private(VecStash *);
@@ -298,6 +306,7 @@ PETSC_INTERN PetscErrorCode VecStrideGather_Default(Vec, PetscInt, Vec, InsertMo
 PETSC_INTERN PetscErrorCode VecStrideScatter_Default(Vec, PetscInt, Vec, InsertMode);
 PETSC_INTERN PetscErrorCode VecStrideSubSetGather_Default(Vec, PetscInt, const PetscInt[], const PetscInt[], Vec, InsertMode);
 PETSC_INTERN PetscErrorCode VecStrideSubSetScatter_Default(Vec, PetscInt, const PetscInt[], const PetscInt[], Vec, InsertMode);
+PETSC_INTERN PetscErrorCode VecMDotMAXPYNorm_Default(Vec, PetscInt, const Vec[], PetscScalar *, PetscReal *);
 
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecReciprocal_Default(Vec);
 #if defined(PETSC_HAVE_MATLAB)
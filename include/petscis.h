@@ -173,7 +173,8 @@ typedef enum {
 
    Values:
 +  `ISLOCALTOGLOBALMAPPINGBASIC` - a non-memory scalable way of storing `ISLocalToGlobalMapping` that allows applying `ISGlobalToLocalMappingApply()` efficiently
--  `ISLOCALTOGLOBALMAPPINGHASH` - a memory scalable way of storing `ISLocalToGlobalMapping` that allows applying `ISGlobalToLocalMappingApply()` reasonably efficiently
+.  `ISLOCALTOGLOBALMAPPINGHASH` - a memory scalable way of storing `ISLocalToGlobalMapping` that allows applying `ISGlobalToLocalMappingApply()` reasonably efficiently
+-  `ISLOCALTOGLOBALMAPPINGRUNS` - a memory scalable way of storing `ISLocalToGlobalMapping` as runs of consecutive global indices, that allows applying `ISGlobalToLocalMappingApply()` efficiently when the runs are long
 
   Level: beginner
 
@@ -182,6 +183,7 @@ J*/
 typedef const char *ISLocalToGlobalMappingType;
 #define ISLOCALTOGLOBALMAPPINGBASIC "basic"
 #define ISLOCALTOGLOBALMAPPINGHASH  "hash"
+#define ISLOCALTOGLOBALMAPPINGRUNS  "runs"
 
 PETSC_EXTERN PetscErrorCode ISLocalToGlobalMappingSetType(ISLocalToGlobalMapping, ISLocalToGlobalMappingType);
 PETSC_EXTERN PetscErrorCode ISLocalToGlobalMappingGetType(ISLocalToGlobalMapping, ISLocalToGlobalMappingType *);
@@ -41,6 +41,7 @@ typedef const char *KSPType;
 #define KSPPIPELCG    "pipelcg"
 #define KSPPIPEPRCG   "pipeprcg"
 #define KSPPIPECG2    "pipecg2"
+#define KSPSSTEPCG    "sstepcg"
 #define KSPCGNE       "cgne"
 #define KSPNASH       "nash"
 #define KSPSTCG       "stcg"
@@ -56,6 +57,8 @@ typedef const char *KSPType;
 #define KSPLGMRES     "lgmres"
 #define KSPDGMRES     "dgmres"
 #define KSPPGMRES     "pgmres"
+#define KSPSSTEPGMRES "sstepgmres"
+#define KSPGCRODR     "gcrodr"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define KSPIBCGS      "ibcgs"
@@ -286,6 +289,36 @@ PETSC_EXTERN PetscErrorCode KSPLGMRESSetConstant(KSP);
 
 PETSC_EXTERN PetscErrorCode KSPPIPEFGMRESSetShift(KSP, PetscScalar);
 
+PETSC_EXTERN PetscErrorCode KSPGCRODRSetRecycle(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGCRODRGetRecycle(KSP, PetscInt *);
+
+/*E
+  KSPSStepBasisType - The polynomial basis in which the s-step Krylov methods `KSPSSTEPGMRES` and `KSPSSTEPCG` generate their blocks of s Krylov vectors
+
+  Values:
++ `KSP_SSTEP_BASIS_MONOMIAL`  - v, Av, A^2 v, ..., which quickly becomes ill-conditioned as s grows
+. `KSP_SSTEP_BASIS_NEWTON`    - v, (A - t_1) v, (A - t_2)(A - t_1) v, ... with shifts t_i the Leja ordered Ritz values of the operator
+- `KSP_SSTEP_BASIS_CHEBYSHEV` - scaled and shifted Chebyshev polynomials of A applied to v, on the interval spanned by the Ritz values
+
+  Level: intermediate
+
+  Note:
+  The Ritz values are computed from the first block of each `KSPSolve()`, which always uses the monomial basis
+
+.seealso: [](ch_ksp), `KSP`, `KSPSSTEPGMRES`, `KSPSSTEPCG`, `KSPSStepSetBasisType()`, `KSPSStepGetBasisType()`, `KSPSStepSetStepSize()`
+E*/
+typedef enum {
+  KSP_SSTEP_BASIS_MONOMIAL,
+  KSP_SSTEP_BASIS_NEWTON,
+  KSP_SSTEP_BASIS_CHEBYSHEV
+} KSPSStepBasisType;
+PETSC_EXTERN const char *const KSPSStepBasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPSStepSetStepSize(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPSStepGetStepSize(KSP, PetscInt *);
+PETSC_EXTERN PetscErrorCode KSPSStepSetBasisType(KSP, KSPSStepBasisType);
+PETSC_EXTERN PetscErrorCode KSPSStepGetBasisType(KSP, KSPSStepBasisType *);
+
 PETSC_EXTERN PetscErrorCode KSPGCRSetRestart(KSP, PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGCRGetRestart(KSP, PetscInt *);
 PETSC_EXTERN PetscErrorCode KSPGCRSetModifyPC(KSP, PetscErrorCode (*)(KSP, PetscInt, PetscReal, void *), void *, PetscErrorCode (*)(void *));
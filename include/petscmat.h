@@ -63,6 +63,9 @@ typedef const char *MatType;
 #define MATAIJSELL                   "aijsell"
 #define MATSEQAIJSELL                "seqaijsell"
 #define MATMPIAIJSELL                "mpiaijsell"
+#define MATAIJSINGLESHADOW           "aijsingleshadow"
+#define MATSEQAIJSINGLESHADOW        "seqaijsingleshadow"
+#define MATMPIAIJSINGLESHADOW        "mpiaijsingleshadow"
 #define MATAIJMKL                    "aijmkl"
 #define MATSEQAIJMKL                 "seqaijmkl"
 #define MATMPIAIJMKL                 "mpiaijmkl"
@@ -252,6 +255,13 @@ PETSC_EXTERN const char *const MatProductTypes[];
 
    Level: beginner
 
+   Note:
+   For `MATSEQAIJ`, `MATPRODUCTALGORITHMSCATTERMAP` records during the symbolic phase where each product of two entries lands in the result,
+   so the numeric phase of `MATPRODUCT_AB` and `MATPRODUCT_PtAP` streams through the factors without searching. It uses one `PetscInt` per such
+   product and pays off when the numeric phase is repeated with new values, e.g., Galerkin coarse operators. The `MATMPIAIJ` `MATPRODUCT_PtAP`
+   algorithm `MATPRODUCTALGORITHMNONSCALABLE` uses it for its local products with `-inner_C_loc_mat_product_algorithm scattermap`
+   and `-inner_C_oth_mat_product_algorithm scattermap`
+
 .seealso: [](sec_matmatproduct), [](ch_matrices), `MatSetType()`, `Mat`, `MatProductSetAlgorithm()`, `MatProductType`
 J*/
 typedef const char *MatProductAlgorithm;
@@ -263,6 +273,7 @@ typedef const char *MatProductAlgorithm;
 #define MATPRODUCTALGORITHMBHEAP           "btheap"
 #define MATPRODUCTALGORITHMLLCONDENSED     "llcondensed"
 #define MATPRODUCTALGORITHMROWMERGE        "rowmerge"
+#define MATPRODUCTALGORITHMSCATTERMAP      "scattermap"
 #define MATPRODUCTALGORITHMOUTERPRODUCT    "outerproduct"
 #define MATPRODUCTALGORITHMATB             "at*b"
 #define MATPRODUCTALGORITHMRAP             "rap"
@@ -413,6 +424,8 @@ PETSC_EXTERN PetscErrorCode MatSeqSELLGetVarSliceSize(Mat, PetscReal *);
 
 PETSC_EXTERN PetscErrorCode MatCreateSeqAIJSELL(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
 PETSC_EXTERN PetscErrorCode MatCreateMPIAIJSELL(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqAIJSingleShadow(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateMPIAIJSingleShadow(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
 PETSC_EXTERN PetscErrorCode MatMPISELLGetLocalMatCondensed(Mat, MatReuse, IS *, IS *, Mat *);
 PETSC_EXTERN PetscErrorCode MatMPISELLGetSeqSELL(Mat, Mat *, Mat *, const PetscInt *[]);
 
@@ -618,7 +631,8 @@ typedef enum {
   MAT_FORM_EXPLICIT_TRANSPOSE     = 24,
   MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25,
   MAT_SPD_ETERNAL                 = 26,
-  MAT_OPTION_MAX                  = 27
+  MAT_THREAD_SAFE_SET_VALUES      = 27,
+  MAT_OPTION_MAX                  = 28
 } MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
@@ -1565,7 +1579,8 @@ PETSC_EXTERN PetscErrorCode MatSeqDenseInvert(Mat);
 .  `SOR_ZERO_INITIAL_GUESS` - indicates the initial solution is zero so the sweep can avoid unneeded computation
 .  `SOR_EISENSTAT` - apply the Eisentat application of SOR, see `PCEISENSTAT`
 .  `SOR_APPLY_UPPER` - multiply by the upper triangular portion of the matrix
--  `SOR_APPLY_LOWER` - multiply by the lower triangular portion of the matrix
+.  `SOR_APPLY_LOWER` - multiply by the lower triangular portion of the matrix
+-  `SOR_MULTICOLOR` - sweep the rows color by color using a coloring of the (local) matrix, for `MATSEQAIJ` the rows of one color are relaxed concurrently by OpenMP threads, see `PCSORSetMulticolor()`
 
     Level: beginner
 
@@ -1587,7 +1602,8 @@ typedef enum {
   SOR_ZERO_INITIAL_GUESS    = 16,
   SOR_EISENSTAT             = 32,
   SOR_APPLY_UPPER           = 64,
-  SOR_APPLY_LOWER           = 128
+  SOR_APPLY_LOWER           = 128,
+  SOR_MULTICOLOR            = 256
 } MatSORType;
 PETSC_EXTERN PetscErrorCode MatSOR(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 
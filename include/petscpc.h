@@ -38,6 +38,7 @@ PETSC_EXTERN const char *const        PCMGCoarseSpaceTypes[];
 PETSC_EXTERN const char *const        PCExoticTypes[];
 PETSC_EXTERN const char *const        PCPatchConstructTypes[];
 PETSC_EXTERN const char *const        PCDeflationTypes[];
+PETSC_EXTERN const char *const        PCPolyTypes[];
 PETSC_EXTERN const char *const *const PCFailedReasons;
 
 PETSC_EXTERN PetscErrorCode PCCreate(MPI_Comm, PC *);
@@ -483,6 +484,12 @@ PETSC_EXTERN PetscErrorCode PCDeflationSetProjectionNullSpaceMat(PC, Mat);
 PETSC_EXTERN PetscErrorCode PCDeflationSetCoarseMat(PC, Mat);
 PETSC_EXTERN PetscErrorCode PCDeflationGetPC(PC, PC *);
 
+PETSC_EXTERN PetscErrorCode PCPolySetType(PC, PCPolyType);
+PETSC_EXTERN PetscErrorCode PCPolyGetType(PC, PCPolyType *);
+PETSC_EXTERN PetscErrorCode PCPolySetDegree(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCPolyGetDegree(PC, PetscInt *);
+PETSC_EXTERN PetscErrorCode PCPolySetEigenvalues(PC, PetscReal, PetscReal);
+
 PETSC_EXTERN PetscErrorCode PCHPDDMSetAuxiliaryMat(PC, IS, Mat, PetscErrorCode (*)(Mat, PetscReal, Vec, Vec, PetscReal, IS, void *), void *);
 PETSC_EXTERN PetscErrorCode PCHPDDMSetRHSMat(PC, Mat);
 PETSC_EXTERN PetscErrorCode PCHPDDMHasNeumannMat(PC, PetscBool);
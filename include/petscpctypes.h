@@ -76,6 +76,8 @@ typedef const char *PCType;
 #define PCHPDDM              "hpddm"
 #define PCH2OPUS             "h2opus"
 #define PCMPI                "mpi"
+#define PCFSAI               "fsai"
+#define PCPOLY               "poly"
 
 /*E
     PCSide - If the preconditioner is to be applied to the left, right
@@ -522,6 +524,22 @@ typedef enum {
   PC_HPDDM_SCHUR_PRE_GENEO,
 } PCHPDDMSchurPreType;
 
+/*E
+    PCPolyType - Type of polynomial of the `PCPOLY` preconditioner
+
+    Values:
++   `PC_POLY_GMRES` (default) - the GMRES polynomial, built from the harmonic Ritz values of a few Arnoldi steps
+-   `PC_POLY_CHEBYSHEV`       - the polynomial of a few steps of the Chebyshev iteration, for matrices with a positive real spectrum
+
+    Level: intermediate
+
+.seealso: [](sec_pc), `PCPOLY`, `PC`, `PCPolySetType()`, `PCPolyGetType()`
+E*/
+typedef enum {
+  PC_POLY_GMRES,
+  PC_POLY_CHEBYSHEV
+} PCPolyType;
+
 /*E
     PCFailedReason - indicates type of `PC` failure
 
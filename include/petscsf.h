@@ -169,6 +169,10 @@ PETSC_EXTERN PetscErrorCode PetscSFBcastWithMemTypeBegin(PetscSF, MPI_Datatype,
 /* Reduce leafdata into rootdata using provided operation */
 PETSC_EXTERN PetscErrorCode PetscSFReduceBegin(PetscSF, MPI_Datatype, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceEnd(PetscSF, MPI_Datatype, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2);
+PETSC_EXTERN PetscErrorCode PetscSFBcastMultipleBegin(PetscSF, MPI_Datatype, PetscInt, const void *[], void *[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFBcastMultipleEnd(PetscSF, MPI_Datatype, PetscInt, const void *[], void *[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFReduceMultipleBegin(PetscSF, MPI_Datatype, PetscInt, const void *[], void *[], MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFReduceMultipleEnd(PetscSF, MPI_Datatype, PetscInt, const void *[], void *[], MPI_Op);
 PETSC_EXTERN PetscErrorCode PetscSFReduceWithMemTypeBegin(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(6, 2);
 
 /* Atomically modifies (using provided operation) rootdata using leafdata from each leaf, value at root at time of modification is returned in leafupdate. */
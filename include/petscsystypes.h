@@ -881,18 +881,22 @@ typedef enum {
       the large reduction size. Requires only an MPI-1 implementation.
 .  `PETSC_BUILDTWOSIDED_IBARRIER` - nonblocking algorithm based on `MPI_Issend()` and `MPI_Ibarrier()`.
       Proved communication-optimal in Hoefler, Siebert, and Lumsdaine (2010). Requires an MPI-3 implementation.
--  `PETSC_BUILDTWOSIDED_REDSCATTER` - similar to above, but use more optimized function
+.  `PETSC_BUILDTWOSIDED_REDSCATTER` - similar to above, but use more optimized function
       that only communicates the part of the reduction that is necessary.  Requires an MPI-2 implementation.
+-  `PETSC_BUILDTWOSIDED_HIERARCHICAL` - two-level algorithm that gathers the messages of the ranks of a shared-memory node on
+      the first rank of the node, exchanges them between these node leaders with a reduction of the length of the number of nodes,
+      and scatters them to their destination ranks on the node. Best suited to large numbers of ranks per node.
 
    Level: developer
 
 .seealso: `PetscCommBuildTwoSided()`, `PetscCommBuildTwoSidedSetType()`, `PetscCommBuildTwoSidedGetType()`
 E*/
 typedef enum {
-  PETSC_BUILDTWOSIDED_NOTSET     = -1,
-  PETSC_BUILDTWOSIDED_ALLREDUCE  = 0,
-  PETSC_BUILDTWOSIDED_IBARRIER   = 1,
-  PETSC_BUILDTWOSIDED_REDSCATTER = 2
+  PETSC_BUILDTWOSIDED_NOTSET       = -1,
+  PETSC_BUILDTWOSIDED_ALLREDUCE    = 0,
+  PETSC_BUILDTWOSIDED_IBARRIER     = 1,
+  PETSC_BUILDTWOSIDED_REDSCATTER   = 2,
+  PETSC_BUILDTWOSIDED_HIERARCHICAL = 3
   /* Updates here must be accompanied by updates in finclude/petscsys.h and the string array in mpits.c */
 } PetscBuildTwoSidedType;
 PETSC_EXTERN const char *const PetscBuildTwoSidedTypes[];
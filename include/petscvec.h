@@ -313,6 +313,7 @@ PETSC_EXTERN PetscErrorCode VecAXPY(Vec, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBY(Vec, PetscScalar, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecMAXPY(Vec, PetscInt, const PetscScalar[], Vec[]);
 PETSC_EXTERN PetscErrorCode VecMAXPBY(Vec, PetscInt, const PetscScalar[], PetscScalar, Vec[]);
+PETSC_EXTERN PetscErrorCode VecMDotMAXPYNorm(Vec, PetscInt, const Vec[], PetscScalar[], PetscReal *);
 PETSC_EXTERN PetscErrorCode VecAYPX(Vec, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecWAXPY(Vec, PetscScalar, Vec, Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBYPCZ(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
@@ -413,6 +414,8 @@ PETSC_EXTERN PetscErrorCode    VecRegisterAll(void);
 
 PETSC_EXTERN PetscErrorCode VecScatterBegin(VecScatter, Vec, Vec, InsertMode, ScatterMode);
 PETSC_EXTERN PetscErrorCode VecScatterEnd(VecScatter, Vec, Vec, InsertMode, ScatterMode);
+PETSC_EXTERN PetscErrorCode VecScatterBeginMultiple(VecScatter, PetscInt, Vec[], Vec[], InsertMode, ScatterMode);
+PETSC_EXTERN PetscErrorCode VecScatterEndMultiple(VecScatter, PetscInt, Vec[], Vec[], InsertMode, ScatterMode);
 PETSC_EXTERN PetscErrorCode VecScatterDestroy(VecScatter *);
 PETSC_EXTERN PetscErrorCode VecScatterSetUp(VecScatter);
 PETSC_EXTERN PetscErrorCode VecScatterCopy(VecScatter, VecScatter *);
@@ -1390,7 +1390,7 @@ static PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
     for (c = 0, cum = 0; c < numVertices; c++) cum = PetscMax(cum, start[c + 1] - start[c]);
     PetscCall(PetscMalloc1(cum, &work));
     PetscCall(ISLocalToGlobalMappingCreateIS(gid, &g2l));
-    PetscCall(ISLocalToGlobalMappingSetType(g2l, ISLOCALTOGLOBALMAPPINGHASH));
+    PetscCall(ISLocalToGlobalMappingSetType(g2l, ISLOCALTOGLOBALMAPPINGRUNS));
     PetscCall(ISDestroy(&gid));
     PetscCall(VecGetArray(acown, &array));
     for (c = 0, ect = 0, ectn = 0; c < numVertices; c++) {
@@ -9423,7 +9423,7 @@ PetscErrorCode DMPlexComputeOrthogonalQuality(DM dm, PetscFV fv, PetscReal atol,
   PetscCall(DMPlexGetHeightStratum(dm, cellHeight, &cStart, &cEnd));
   PetscCall(DMPlexCreateCellNumbering_Internal(dm, PETSC_TRUE, &glob));
   PetscCall(ISLocalToGlobalMappingCreateIS(glob, &ltog));
-  PetscCall(ISLocalToGlobalMappingSetType(ltog, ISLOCALTOGLOBALMAPPINGHASH));
+  PetscCall(ISLocalToGlobalMappingSetType(ltog, ISLOCALTOGLOBALMAPPINGRUNS));
   PetscCall(VecCreate(comm, OrthQual));
   PetscCall(VecSetType(*OrthQual, VECSTANDARD));
   PetscCall(VecSetSizes(*OrthQual, cEnd - cStart, PETSC_DETERMINE));
@@ -42,6 +42,7 @@
     data used during the optional Lanczo process used to compute eigenvalues
 */
 #include <../src/ksp/ksp/impls/cg/cgimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
 extern PetscErrorCode KSPComputeExtremeSingularValues_CG(KSP, PetscReal *, PetscReal *);
 extern PetscErrorCode KSPComputeEigenvalues_CG(KSP, PetscInt, PetscReal *, PetscReal *, PetscInt *);
 
@@ -525,6 +526,136 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+       KSPMatSolve_CG - Block CG (O'Leary 1980) for all the columns of B at once
+
+       The operator is applied to a block with MatMatMult() and the preconditioner with PCMatApply(). The block of search directions
+       is A-orthonormalized with the eigendecomposition of its Gram matrix, which drops the directions that become linearly dependent,
+       so the method does not break down when the columns of the residual do, e.g., for duplicated right-hand sides. Each iteration has two reductions of small
+       dense matrices, the first one for the coefficients of the new directions and the norms of the columns, the second one for the
+       Gram matrix of the directions and their coefficients in the update of the solution.
+*/
+static PetscErrorCode KSPMatSolve_CG(KSP ksp, Mat B, Mat X)
+{
+  KSP_CG      *cg = (KSP_CG *)ksp->data;
+  Mat          Amat, R, Z, AZ = NULL, P, Q, Pr, Qr;
+  PetscScalar *buf, *T, *S, one = 1.0, zero = 0.0;
+  PetscReal   *nrm, *nrm0, dp;
+  PetscInt     s, r = 0, i;
+  PetscBLASInt bs, br;
+  PetscMPIInt  count;
+  PetscBool    diagonalscale, indefinite;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+  PetscCheck(cg->radius == 0.0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "KSPMatSolve() with KSPCG does not support a trust region radius");
+#if defined(PETSC_USE_COMPLEX)
+  PetscCheck(cg->type == KSP_CG_HERMITIAN, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "KSPMatSolve() with KSPCG requires KSP_CG_HERMITIAN");
+#endif
+  PetscCall(PCGetOperators(ksp->pc, &Amat, NULL));
+  PetscCall(MatGetSize(B, NULL, &s));
+  PetscCall(PetscBLASIntCast(s, &bs));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &R));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &Z));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &P));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &Q));
+  PetscCall(PetscMalloc5(2 * s * s + s, &buf, s * s, &T, s * s, &S, s, &nrm, s, &nrm0));
+
+  if (!ksp->guess_zero) {
+    PetscCall(MatCopy(X, Z, SAME_NONZERO_PATTERN));
+    PetscCall(KSPBlockMatMult_Private(ksp, Amat, Z, &AZ)); /*    r <- b - Ax                       */
+    PetscCall(MatCopy(B, R, SAME_NONZERO_PATTERN));
+    PetscCall(MatAXPY(R, -1.0, AZ, SAME_NONZERO_PATTERN));
+  } else PetscCall(MatCopy(B, R, SAME_NONZERO_PATTERN)); /*    r <- b (x is 0)                   */
+  PetscCall(KSP_PCMatApply(ksp, R, Z));                  /*    z <- Br                           */
+
+  ksp->its = 0;
+  for (i = 0;; i++) {
+    /* beta <- q'z, where q = Ap and p'q = I, and the norms of the columns */
+    if (r) {
+      PetscCall(MatDenseGetSubMatrix(Q, PETSC_DECIDE, PETSC_DECIDE, 0, r, &Qr));
+      PetscCall(KSPBlockDotLocal_Private(Qr, Z, buf, r));
+      PetscCall(MatDenseRestoreSubMatrix(Q, &Qr));
+    }
+    switch (ksp->normtype) {
+    case KSP_NORM_PRECONDITIONED:
+      PetscCall(KSPBlockColumnDotsLocal_Private(Z, Z, buf + r * s));
+      break;
+    case KSP_NORM_UNPRECONDITIONED:
+      PetscCall(KSPBlockColumnDotsLocal_Private(R, R, buf + r * s));
+      break;
+    case KSP_NORM_NATURAL:
+      PetscCall(KSPBlockColumnDotsLocal_Private(R, Z, buf + r * s));
+      break;
+    case KSP_NORM_NONE:
+      for (PetscInt j = 0; j < s; j++) buf[r * s + j] = 0.0;
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "%s", KSPNormTypes[ksp->normtype]);
+    }
+    PetscCall(PetscMPIIntCast(r * s + s, &count));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+    for (PetscInt j = 0; j < s; j++) nrm[j] = PetscSqrtReal(PetscAbsScalar(buf[r * s + j]));
+    PetscCall(KSPBlockResidualNorm_Private(s, nrm, (PetscBool)!i, nrm0, &dp));
+    ksp->rnorm = dp;
+    PetscCall(KSPLogResidualHistory(ksp, dp));
+    PetscCall(KSPMonitor(ksp, i, dp));
+    PetscCall((*ksp->converged)(ksp, i, dp, &ksp->reason, ksp->cnvP));
+    if (ksp->reason) break;
+    if (i >= ksp->max_it) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+
+    /* z <- z - p beta, then p <- z T and q <- Az T with T such that p'q = I */
+    if (r) {
+      PetscCall(MatDenseGetSubMatrix(P, PETSC_DECIDE, PETSC_DECIDE, 0, r, &Pr));
+      PetscCall(KSPBlockUpdate_Private(Z, 1.0, -1.0, Pr, buf, r));
+      PetscCall(MatDenseRestoreSubMatrix(P, &Pr));
+    }
+    PetscCall(KSPBlockMatMult_Private(ksp, Amat, Z, &AZ));
+    PetscCall(KSPBlockDotLocal_Private(Z, AZ, buf, s));
+    PetscCall(KSPBlockDotLocal_Private(Z, R, buf + s * s, s));
+    PetscCall(PetscMPIIntCast(2 * s * s, &count));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+    PetscCall(KSPBlockGramFactor_Private(s, buf, PETSC_SQRT_MACHINE_EPSILON, T, S, &r, &indefinite));
+    if (indefinite) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Diverged due to indefinite matrix");
+      ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+      PetscCall(PetscInfo(ksp, "diverging due to indefinite matrix\n"));
+      break;
+    }
+    if (!r) {
+      ksp->reason = KSP_CONVERGED_ATOL;
+      PetscCall(PetscInfo(ksp, "converged due to an empty block of search directions\n"));
+      break;
+    }
+    PetscCall(MatDenseGetSubMatrix(P, PETSC_DECIDE, PETSC_DECIDE, 0, r, &Pr));
+    PetscCall(MatDenseGetSubMatrix(Q, PETSC_DECIDE, PETSC_DECIDE, 0, r, &Qr));
+    PetscCall(KSPBlockUpdate_Private(Pr, 0.0, 1.0, Z, T, s));
+    PetscCall(KSPBlockUpdate_Private(Qr, 0.0, 1.0, AZ, T, s));
+
+    /* alpha <- p'r = T' z'r, x <- x + p alpha, r <- r - q alpha */
+    PetscCall(PetscBLASIntCast(r, &br));
+    PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &br, &bs, &bs, &one, T, &bs, buf + s * s, &bs, &zero, buf, &br));
+    PetscCall(KSPBlockUpdate_Private(X, 1.0, 1.0, Pr, buf, r));
+    PetscCall(KSPBlockUpdate_Private(R, 1.0, -1.0, Qr, buf, r));
+    PetscCall(MatDenseRestoreSubMatrix(Q, &Qr));
+    PetscCall(MatDenseRestoreSubMatrix(P, &Pr));
+    ksp->its = i + 1;
+    PetscCall(KSP_PCMatApply(ksp, R, Z)); /*    z <- Br                           */
+  }
+
+  PetscCall(PetscFree5(buf, T, S, nrm, nrm0));
+  PetscCall(MatDestroy(&AZ));
+  PetscCall(MatDestroy(&Q));
+  PetscCall(MatDestroy(&P));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(MatDestroy(&R));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
      KSPDestroy_CG - Frees resources allocated in KSPSetup_CG and clears function
                      compositions from KSPCreate_CG. If adding your own KSP implementation,
@@ -655,6 +786,10 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
 
    One can use `KSPSetComputeEigenvalues()` and `KSPComputeEigenvalues()` to compute the eigenvalues of the (preconditioned) operator
 
+   `KSPMatSolve()` uses block CG [3] on all the columns at once, applying the operator with `MatMatMult()` and the preconditioner with `PCMatApply()`.
+   The residual norm given to the monitors and the convergence test is then the largest one of the columns, each scaled so the relative
+   tolerance applies to it; the search directions that become linearly dependent are dropped.
+
    Developer Notes:
     KSPSolve_CG() should actually query the matrix to determine if it is Hermitian symmetric or not and NOT require the user to
    indicate it to the `KSP` object.
@@ -662,10 +797,11 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
    References:
 +  * - Magnus R. Hestenes and Eduard Stiefel, Methods of Conjugate Gradients for Solving Linear Systems,
    Journal of Research of the National Bureau of Standards Vol. 49, No. 6, December 1952 Research Paper 2379
--  * - Josef Malek and Zdenek Strakos, Preconditioning and the Conjugate Gradient Method in the Context of Solving PDEs,
+.  * - Josef Malek and Zdenek Strakos, Preconditioning and the Conjugate Gradient Method in the Context of Solving PDEs,
     SIAM, 2014.
+-  * - Dianne P. O'Leary, The block conjugate gradient algorithm and related methods, Linear Algebra and its Applications, 29, 1980.
 
-.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPSetComputeEigenvalues()`, `KSPComputeEigenvalues()`
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPSetComputeEigenvalues()`, `KSPComputeEigenvalues()`, `KSPMatSolve()`
           `KSPCGSetType()`, `KSPCGUseSingleReduction()`, `KSPPIPECG`, `KSPGROPPCG`
 M*/
 
@@ -700,6 +836,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_CG(KSP ksp)
   */
   ksp->ops->setup          = KSPSetUp_CG;
   ksp->ops->solve          = KSPSolve_CG;
+  ksp->ops->matsolve       = KSPMatSolve_CG;
   ksp->ops->destroy        = KSPDestroy_CG;
   ksp->ops->view           = KSPView_CG;
   ksp->ops->setfromoptions = KSPSetFromOptions_CG;
@@ -0,0 +1,402 @@
+/*
+    This file implements s-step CG (a communication avoiding conjugate gradient method).
+
+    Each outer step builds a block of s preconditioned Krylov vectors R_i with s applications of the operator, without any inner product, makes
+    them A-orthogonal to the previous block of directions, and minimizes the energy norm of the error over the new block of directions. All the
+    inner products of an outer step, which replaces s iterations of KSPCG, are computed in a single global reduction.
+
+    Reference: A. T. Chronopoulos and C. W. Gear, s-step iterative methods for symmetric linear systems, J. Comput. Appl. Math., 25:153-168, 1989.
+*/
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt          s;                    /* number of Krylov vectors generated in an outer step */
+  KSPSStepBasisType basistype;            /* polynomial basis of the blocks */
+  PetscReal        *alpha, *beta, *gamma; /* recurrence of the basis, see KSPSStepBasisCoefficients_Private() */
+  Vec              *R, *AR;               /* the new block of vectors and their products with A */
+  Vec              *P, *AP;               /* the previous block of directions and their products with A */
+  PetscScalar      *RAR, *Rr, *APR, *Bk;  /* R^H A R, R^H r, (A P)^H R and the coefficients making R A-orthogonal to P */
+  PetscScalar      *Pr;                   /* P^H r, zero in exact arithmetic */
+  PetscScalar      *W, *Wp;               /* Cholesky factors of P^H A P for the new and the previous block */
+  PetscReal        *rar;                  /* diagonal of R^H A R, the scale of the pivots of the Cholesky factorization of W */
+} KSP_SSTEPCG;
+
+#define SSTEPCG_TOL PETSC_SQRT_MACHINE_EPSILON
+
+PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP, Vec, Vec, Vec *);
+
+static PetscErrorCode KSPSetUp_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+  PetscInt     s   = scg->s;
+
+  PetscFunctionBegin;
+  /* the residual is the first work vector, as for KSPBuildResidual_CG() */
+  PetscCall(KSPSetWorkVecs(ksp, 1));
+  PetscCall(VecDuplicateVecs(ksp->work[0], s, &scg->R));
+  PetscCall(VecDuplicateVecs(ksp->work[0], s, &scg->AR));
+  PetscCall(VecDuplicateVecs(ksp->work[0], s, &scg->P));
+  PetscCall(VecDuplicateVecs(ksp->work[0], s, &scg->AP));
+  PetscCall(PetscMalloc7(s * s, &scg->RAR, s, &scg->Rr, s * s, &scg->APR, s * s, &scg->Bk, s * s, &scg->W, s * s, &scg->Wp, s, &scg->Pr));
+  PetscCall(PetscMalloc4(s, &scg->alpha, s, &scg->beta, s, &scg->gamma, s, &scg->rar));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Replaces the recurrence of the basis by one built from the Ritz values of the preconditioned operator on the first block, which is in the
+   monomial basis R_i = (B A)^i B r. They are the eigenvalues of the pencil (R^H A R, R^H B^{-1} R), where R^H B^{-1} R_0 = R^H r
+   and R^H B^{-1} R_i = R^H A R_{i-1}. When R^H B^{-1} R is numerically not positive definite, only its leading positive definite block is used
+*/
+static PetscErrorCode KSPSSTEPCGComputeBasis(KSP ksp, PetscInt n)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+  PetscScalar *Ar, *Br, *work;
+  PetscReal   *eigs;
+  PetscBLASInt bn, lwork, one = 1, lierr = 0;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal *rwork;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(3 * n, &lwork));
+  PetscCall(PetscMalloc4(n * n, &Ar, n * n, &Br, 3 * n, &work, n, &eigs));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc1(3 * n, &rwork));
+#endif
+  while (n > 0) {
+    PetscCall(PetscBLASIntCast(n, &bn));
+    for (PetscInt i = 0; i < n; i++) {
+      for (PetscInt p = 0; p <= i; p++) {
+        Ar[p + i * n] = scg->RAR[p + i * scg->s];
+        if (!i) Br[p + i * n] = scg->Rr[p];
+        else Br[p + i * n] = p < i ? scg->RAR[p + (i - 1) * scg->s] : PetscConj(scg->RAR[(i - 1) + i * scg->s]);
+      }
+    }
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+    PetscCallBLAS("LAPACKsygv", LAPACKsygv_(&one, "N", "U", &bn, Ar, &bn, Br, &bn, eigs, work, &lwork, rwork, &lierr));
+#else
+    PetscCallBLAS("LAPACKsygv", LAPACKsygv_(&one, "N", "U", &bn, Ar, &bn, Br, &bn, eigs, work, &lwork, &lierr));
+#endif
+    PetscCall(PetscFPTrapPop());
+    if (lierr > bn) n = lierr - bn - 1; /* the leading block of order lierr - n of R^H B^{-1} R is not positive definite */
+    else break;
+  }
+  if (lierr || !n) PetscCall(PetscInfo(ksp, "Error %d in LAPACK routine computing the Ritz values, keeping the monomial basis\n", (int)lierr));
+  else {
+    PetscCall(KSPSStepBasisCoefficients_Private(scg->basistype, n, eigs, scg->s, scg->alpha, scg->beta, scg->gamma));
+    PetscCall(PetscInfo(ksp, "%s basis of the blocks computed from %" PetscInt_FMT " Ritz values in [%g, %g]\n", KSPSStepBasisTypes[scg->basistype], n, (double)eigs[0], (double)eigs[n - 1]));
+  }
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscFree(rwork));
+#endif
+  PetscCall(PetscFree4(Ar, Br, work, eigs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+  PetscInt     s = scg->s, sprev = 0, ns, rank;
+  PetscScalar *RAR = scg->RAR, *Rr = scg->Rr, *Pr = scg->Pr, *APR = scg->APR, *Bk = scg->Bk, *W, *Wp;
+  PetscReal   *alpha = scg->alpha, *beta = scg->beta, *gamma = scg->gamma, dp = 0.0;
+  Vec          X, B, r, *R, *AR, *P, *AP, *tmp;
+  Mat          Amat, Pmat;
+  PetscBool    diagonalscale, ritz;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+
+  X  = ksp->vec_sol;
+  B  = ksp->vec_rhs;
+  r  = ksp->work[0];
+  R  = scg->R;
+  AR = scg->AR;
+  P  = scg->P;
+  AP = scg->AP;
+  W  = scg->W;
+  Wp = scg->Wp;
+
+  /* the first block of each solve uses the monomial basis, its Ritz values give the basis of the next ones */
+  PetscCall(KSPSStepBasisCoefficients_Private(KSP_SSTEP_BASIS_MONOMIAL, 0, NULL, s, alpha, beta, gamma));
+  ritz = (PetscBool)(scg->basistype == KSP_SSTEP_BASIS_MONOMIAL);
+
+  PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    PetscCall(KSP_MatMult(ksp, Amat, X, r)); /*     r <- b - Ax     */
+    PetscCall(VecAYPX(r, -1.0, B));
+  } else {
+    PetscCall(VecCopy(B, r)); /*     r <- b (x is 0) */
+  }
+
+  while (!ksp->reason) {
+    /* the last outer step may be shorter, with no vector only the residual norm is computed */
+    ns = PetscMin(s, ksp->max_it - ksp->its);
+
+    /* R_0 = B r, R_{i+1} = (B A R_i - alpha_i R_i - beta_i R_{i-1}) / gamma_i */
+    PetscCall(KSP_PCApply(ksp, r, R[0]));
+    for (PetscInt i = 0; i < ns; i++) {
+      PetscCall(KSP_MatMult(ksp, Amat, R[i], AR[i]));
+      if (i == ns - 1) break;
+      PetscCall(KSP_PCApply(ksp, AR[i], R[i + 1]));
+      if (alpha[i] != 0.0 || beta[i] != 0.0 || gamma[i] != 1.0) {
+        if (i) PetscCall(VecAXPBYPCZ(R[i + 1], -alpha[i] / gamma[i], -beta[i] / gamma[i], 1.0 / gamma[i], R[i], R[i - 1]));
+        else PetscCall(VecAXPBY(R[1], -alpha[0] / gamma[0], 1.0 / gamma[0], R[0]));
+      }
+    }
+
+    /* all the inner products of the outer step in a single reduction */
+    for (PetscInt i = 0; i < ns; i++) PetscCall(VecMDotBegin(AR[i], i + 1, R, RAR + i * s));
+    PetscCall(VecMDotBegin(r, PetscMax(ns, 1), R, Rr));
+    if (sprev) {
+      for (PetscInt i = 0; i < ns; i++) PetscCall(VecMDotBegin(R[i], sprev, AP, APR + i * s));
+      PetscCall(VecMDotBegin(r, sprev, P, Pr));
+    }
+    if (ksp->normtype == KSP_NORM_PRECONDITIONED) PetscCall(VecNormBegin(R[0], NORM_2, &dp));
+    else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecNormBegin(r, NORM_2, &dp));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)r)));
+    for (PetscInt i = 0; i < ns; i++) PetscCall(VecMDotEnd(AR[i], i + 1, R, RAR + i * s));
+    PetscCall(VecMDotEnd(r, PetscMax(ns, 1), R, Rr));
+    if (sprev) {
+      for (PetscInt i = 0; i < ns; i++) PetscCall(VecMDotEnd(R[i], sprev, AP, APR + i * s));
+      PetscCall(VecMDotEnd(r, sprev, P, Pr));
+    }
+    if (ksp->normtype == KSP_NORM_PRECONDITIONED) PetscCall(VecNormEnd(R[0], NORM_2, &dp));
+    else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecNormEnd(r, NORM_2, &dp));
+    KSPCheckDot(ksp, Rr[0]);
+    if (PetscRealPart(Rr[0]) < 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Diverged due to indefinite preconditioner, beta %g", (double)PetscRealPart(Rr[0]));
+      ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+      PetscCall(PetscInfo(ksp, "diverging due to indefinite preconditioner\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscRealPart(Rr[0])); /*    dp <- r'*B*r = e'*A'*B*A*e */
+    else if (ksp->normtype == KSP_NORM_NONE) dp = 0.0;
+    KSPCheckNorm(ksp, dp);
+
+    PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+    ksp->rnorm = dp;
+    PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+    PetscCall(KSPLogResidualHistory(ksp, dp));
+    PetscCall(KSPMonitor(ksp, ksp->its, dp));
+    PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+    if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+    if (!ns) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    for (PetscInt i = 0; i < ns; i++) {
+      for (PetscInt p = 0; p <= i; p++) KSPCheckDot(ksp, RAR[p + i * s]);
+    }
+
+    /* make the block A-orthogonal to the previous directions, P_i = R_i + P Bk_i with Bk = -(P^H A P)^{-1} (A P)^H R, then W = P^H A P = R^H A R + ((A P)^H R)^H Bk */
+    for (PetscInt i = 0; i < ns; i++) {
+      for (PetscInt p = 0; p <= i; p++) W[p + i * s] = RAR[p + i * s];
+      scg->rar[i] = PetscRealPart(RAR[i + i * s]);
+    }
+    if (sprev) {
+      for (PetscInt i = 0; i < ns; i++) {
+        for (PetscInt q = 0; q < sprev; q++) Bk[q + i * s] = -APR[q + i * s];
+        PetscCall(KSPSStepCholeskySolve_Private(sprev, Wp, s, Bk + i * s));
+        PetscCall(VecMAXPY(R[i], sprev, Bk + i * s, P));
+        PetscCall(VecMAXPY(AR[i], sprev, Bk + i * s, AP));
+        for (PetscInt p = 0; p <= i; p++) {
+          for (PetscInt q = 0; q < sprev; q++) W[p + i * s] += PetscConj(APR[q + p * s]) * Bk[q + i * s];
+        }
+        for (PetscInt q = 0; q < sprev; q++) Rr[i] += PetscConj(Bk[q + i * s]) * Pr[q];
+      }
+    }
+
+    /* minimize the energy norm of the error over the new directions, x <- x + P a, r <- r - A P a with W a = P^H r,
+       a direction whose energy norm cancels out in the A-orthogonalization is numerically in the span of the previous ones */
+    PetscCall(KSPSStepCholesky_Private(ns, W, s, scg->rar, SSTEPCG_TOL, &rank));
+    if (!rank && !(scg->rar[0] > 0.0)) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Diverged due to indefinite matrix");
+      ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+      PetscCall(PetscInfo(ksp, "diverging due to indefinite or negative definite matrix\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    } else if (!rank) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Breakdown, the new block of vectors is numerically in the span of the previous directions");
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      PetscCall(PetscInfo(ksp, "Breakdown, the new block of vectors is numerically in the span of the previous directions\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    if (rank < ns) PetscCall(PetscInfo(ksp, "Block at iteration %" PetscInt_FMT " is numerically rank deficient, using %" PetscInt_FMT " of its %" PetscInt_FMT " vectors\n", ksp->its, rank, ns));
+    if (!ritz) {
+      /* the first block, the Ritz values are only meaningful on its numerically independent vectors */
+      if (rank > 1) PetscCall(KSPSSTEPCGComputeBasis(ksp, rank));
+      ritz = PETSC_TRUE;
+    }
+    PetscCall(KSPSStepCholeskySolve_Private(rank, W, s, Rr));
+    PetscCall(VecMAXPY(X, rank, Rr, R));
+    for (PetscInt i = 0; i < rank; i++) Rr[i] = -Rr[i];
+    PetscCall(VecMAXPY(r, rank, Rr, AR));
+
+    /* the new directions become the previous ones */
+    tmp   = P;
+    P     = R;
+    R     = tmp;
+    tmp   = AP;
+    AP    = AR;
+    AR    = tmp;
+    Wp    = W;
+    W     = Wp == scg->W ? scg->Wp : scg->W;
+    sprev = rank;
+    PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+    ksp->its += rank;
+    PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCall(VecDestroyVecs(scg->s, &scg->R));
+  PetscCall(VecDestroyVecs(scg->s, &scg->AR));
+  PetscCall(VecDestroyVecs(scg->s, &scg->P));
+  PetscCall(VecDestroyVecs(scg->s, &scg->AP));
+  PetscCall(PetscFree7(scg->RAR, scg->Rr, scg->APR, scg->Bk, scg->W, scg->Wp, scg->Pr));
+  PetscCall(PetscFree4(scg->alpha, scg->beta, scg->gamma, scg->rar));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPCG(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_SSTEPCG(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetBasisType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetBasisType_C", NULL));
+  PetscCall(KSPDestroyDefault(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_SSTEPCG(KSP ksp, PetscViewer viewer)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+  PetscBool    iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) PetscCall(PetscViewerASCIIPrintf(viewer, "  blocks of s=%" PetscInt_FMT " vectors in the %s basis\n", scg->s, KSPSStepBasisTypes[scg->basistype]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPCG(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_SSTEPCG      *scg = (KSP_SSTEPCG *)ksp->data;
+  PetscInt          s;
+  KSPSStepBasisType type;
+  PetscBool         flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP s-step CG Options");
+  PetscCall(PetscOptionsInt("-ksp_sstep_size", "Number of Krylov vectors generated in an outer step", "KSPSStepSetStepSize", scg->s, &s, &flg));
+  if (flg) PetscCall(KSPSStepSetStepSize(ksp, s));
+  PetscCall(PetscOptionsEnum("-ksp_sstep_basis_type", "Polynomial basis of the blocks of Krylov vectors", "KSPSStepSetBasisType", KSPSStepBasisTypes, (PetscEnum)scg->basistype, (PetscEnum *)&type, &flg));
+  if (flg) PetscCall(KSPSStepSetBasisType(ksp, type));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepSetStepSize_SSTEPCG(KSP ksp, PetscInt s)
+{
+  KSP_SSTEPCG *scg = (KSP_SSTEPCG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(s >= 1, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Step size must be positive");
+  if (!ksp->setupstage) {
+    scg->s = s;
+  } else if (scg->s != s) {
+    /* free the data structures, then create them again */
+    PetscCall(KSPReset_SSTEPCG(ksp));
+    scg->s          = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepGetStepSize_SSTEPCG(KSP ksp, PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_SSTEPCG *)ksp->data)->s;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepSetBasisType_SSTEPCG(KSP ksp, KSPSStepBasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_SSTEPCG *)ksp->data)->basistype = type;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepGetBasisType_SSTEPCG(KSP ksp, KSPSStepBasisType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_SSTEPCG *)ksp->data)->basistype;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   KSPSSTEPCG - The s-step (communication avoiding) preconditioned conjugate gradient method
+
+   Options Database Keys:
++   -ksp_sstep_size <s> - the number of Krylov vectors generated in an outer step
+-   -ksp_sstep_basis_type <monomial,newton,chebyshev> - the polynomial basis in which the blocks are generated
+
+   Level: intermediate
+
+   Notes:
+   Each outer step generates a block of s preconditioned Krylov vectors with s matrix-vector products and preconditioner applications,
+   makes it A-orthogonal to the previous block of directions, and minimizes the energy norm of the error over the new block. This
+   needs a single global reduction per outer step, instead of the 2 s of s iterations of `KSPCG`, at the price of more vector
+   operations and of a basis that becomes ill-conditioned for large s, which the Newton or Chebyshev basis delay,
+   see `KSPSStepSetBasisType()`. In exact arithmetic every s iterations the iterates are those of `KSPCG`.
+
+   The convergence test, and the monitors, are only called every outer step, with the iteration number increased by the number of
+   vectors of the block, which is s unless the block is numerically rank deficient.
+
+   The operator and the preconditioner must be symmetric (Hermitian) positive definite, only left preconditioning is supported.
+
+   Reference:
+.  * - A. T. Chronopoulos and C. W. Gear, s-step iterative methods for symmetric linear systems, J. Comput. Appl. Math., 25:153-168, 1989.
+
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPCG`, `KSPPIPECG`, `KSPSSTEPGMRES`, `KSPSStepSetStepSize()`, `KSPSStepSetBasisType()`
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG *scg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&scg));
+  scg->s         = 5;
+  scg->basistype = KSP_SSTEP_BASIS_NEWTON;
+  ksp->data      = (void *)scg;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NATURAL, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+
+  ksp->ops->setup          = KSPSetUp_SSTEPCG;
+  ksp->ops->solve          = KSPSolve_SSTEPCG;
+  ksp->ops->reset          = KSPReset_SSTEPCG;
+  ksp->ops->destroy        = KSPDestroy_SSTEPCG;
+  ksp->ops->view           = KSPView_SSTEPCG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_SSTEPCG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidual_CG;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetStepSize_C", KSPSStepSetStepSize_SSTEPCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetStepSize_C", KSPSStepGetStepSize_SSTEPCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetBasisType_C", KSPSStepSetBasisType_SSTEPCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetBasisType_C", KSPSStepGetBasisType_SSTEPCG));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
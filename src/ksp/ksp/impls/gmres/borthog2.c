@@ -58,24 +58,19 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
 
   /*
      This is really a matrix-vector product, with the matrix stored
-     as pointer to rows
+     as pointer to rows, followed by the matrix vector product
+     [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
+     The norm of the new direction is computed with the subtraction, the
+     caller then finds it stashed in the vector; it is only skipped when
+     the refinement below recomputes it anyway. The vector is not updated
+     if one of the dot products is Inf or NaN, they are checked below
   */
-  PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
+  PetscCall(VecMDotMAXPYNorm(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh, refine ? NULL : &wnrm)); /* <v,vnew> */
   for (j = 0; j <= it; j++) {
     KSPCheckDot(ksp, lhh[j]);
     if (ksp->reason) goto done;
-    lhh[j] = -lhh[j];
-  }
-
-  /*
-         This is really a matrix vector product:
-         [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
-  */
-  PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
-  /* note lhh[j] is -<v,vnew> , hence the subtraction */
-  for (j = 0; j <= it; j++) {
-    hh[j] -= lhh[j];  /* hh += <v,vnew> */
-    hes[j] -= lhh[j]; /* hes += <v,vnew> */
+    hh[j] += lhh[j];  /* hh += <v,vnew> */
+    hes[j] += lhh[j]; /* hes += <v,vnew> */
   }
 
   /*
@@ -87,7 +82,6 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
     for (j = 0; j <= it; j++) hnrm += PetscRealPart(lhh[j] * PetscConj(lhh[j]));
 
     hnrm = PetscSqrtReal(hnrm);
-    PetscCall(VecNorm(VEC_VV(it + 1), NORM_2, &wnrm));
     KSPCheckNorm(ksp, wnrm);
     if (ksp->reason) goto done;
     if (wnrm < hnrm) {
@@ -97,17 +91,12 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
   }
 
   if (refine) {
-    PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
+    PetscCall(VecMDotMAXPYNorm(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh, &wnrm)); /* <v,vnew> */
     for (j = 0; j <= it; j++) {
       KSPCheckDot(ksp, lhh[j]);
       if (ksp->reason) goto done;
-      lhh[j] = -lhh[j];
-    }
-    PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
-    /* note lhh[j] is -<v,vnew> , hence the subtraction */
-    for (j = 0; j <= it; j++) {
-      hh[j] -= lhh[j];  /* hh += <v,vnew> */
-      hes[j] -= lhh[j]; /* hes += <v,vnew> */
+      hh[j] += lhh[j];  /* hh += <v,vnew> */
+      hes[j] += lhh[j]; /* hes += <v,vnew> */
     }
   }
 done:
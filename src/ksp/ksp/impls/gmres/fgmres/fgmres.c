@@ -34,7 +34,7 @@ static PetscErrorCode KSPSetUp_FGMRES(KSP ksp)
   /* fgmres->vv_allocated includes extra work vectors, which are not used in the additional
      block of vectors used to store the preconditioned directions, hence  the -VEC_OFFSET
      term for this first allocation of vectors holding preconditioned directions */
-  PetscCall(KSPCreateVecs(ksp, fgmres->vv_allocated - VEC_OFFSET, &fgmres->prevecs_user_work[0], 0, NULL));
+  PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, fgmres->vv_allocated - VEC_OFFSET, &fgmres->prevecs_user_work[0]));
   for (k = 0; k < fgmres->vv_allocated - VEC_OFFSET; k++) fgmres->prevecs[k] = fgmres->prevecs_user_work[0][k];
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -384,13 +384,13 @@ static PetscErrorCode KSPFGMRESGetNewVectors(KSP ksp, PetscInt it)
   fgmres->vv_allocated += nalloc; /* vv_allocated is the number of vectors allocated */
 
   /* work vectors */
-  PetscCall(KSPCreateVecs(ksp, nalloc, &fgmres->user_work[nwork], 0, NULL));
+  PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, nalloc, &fgmres->user_work[nwork]));
   for (k = 0; k < nalloc; k++) fgmres->vecs[it + VEC_OFFSET + k] = fgmres->user_work[nwork][k];
   /* specify size of chunk allocated */
   fgmres->mwork_alloc[nwork] = nalloc;
 
   /* preconditioned vectors */
-  PetscCall(KSPCreateVecs(ksp, nalloc, &fgmres->prevecs_user_work[nwork], 0, NULL));
+  PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, nalloc, &fgmres->prevecs_user_work[nwork]));
   for (k = 0; k < nalloc; k++) fgmres->prevecs[it + k] = fgmres->prevecs_user_work[nwork][k];
 
   /* increment the number of work vector chunks */
@@ -512,6 +512,8 @@ static PetscErrorCode KSPGMRESGetRestart_FGMRES(KSP ksp, PetscInt *max_k)
 
     Only right preconditioning is supported.
 
+    The Krylov vectors and the preconditioned directions use BLAS gemv in `VecMDot()` and `VecMAXPY()`, see `KSPGMRES`.
+
     The following options `-ksp_type fgmres -pc_type ksp -ksp_ksp_type bcgs -ksp_view -ksp_pc_type jacobi` make the preconditioner (or inner solver)
     be bi-CG-stab with a preconditioner of `PCJACOBI`
 
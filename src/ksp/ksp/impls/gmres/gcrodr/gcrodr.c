@@ -0,0 +1,707 @@
+/*
+    Implements GCRO-DR, GMRES with a deflation subspace recycled from one restart cycle and one solve to the next.
+*/
+
+#include <../src/ksp/ksp/impls/gmres/gcrodr/gcrodrimpl.h> /*I  "petscksp.h"  I*/
+
+static PetscErrorCode KSPGCRODRUpdateHessenberg(KSP, PetscInt, PetscBool, PetscReal *);
+static PetscErrorCode KSPGCRODRBuildSoln(PetscScalar *, Vec, Vec, KSP, PetscInt);
+
+/*@
+  KSPGCRODRSetRecycle - Sets the dimension of the subspace that `KSPGCRODR` recycles from one restart cycle and one `KSPSolve()` to the next
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the `KSP` context
+- k   - the dimension of the recycled subspace, it must be smaller than the restart (default is 10)
+
+  Options Database Key:
+. -ksp_gcrodr_recycle <k> - the dimension of the recycled subspace
+
+  Level: intermediate
+
+  Notes:
+  Each restart cycle of `KSPGCRODR` uses k vectors of the recycled subspace and restart - k Krylov vectors.
+
+  Changing the dimension discards the current recycled subspace. With k = 0 the method is `KSPGMRES`.
+
+.seealso: [](ch_ksp), `KSPGCRODR`, `KSPGCRODRGetRecycle()`, `KSPGMRESSetRestart()`
+@*/
+PetscErrorCode KSPGCRODRSetRecycle(KSP ksp, PetscInt k)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, k, 2);
+  PetscTryMethod(ksp, "KSPGCRODRSetRecycle_C", (KSP, PetscInt), (ksp, k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPGCRODRGetRecycle - Gets the dimension of the subspace that `KSPGCRODR` recycles from one restart cycle and one `KSPSolve()` to the next
+
+  Not Collective
+
+  Input Parameter:
+. ksp - the `KSP` context
+
+  Output Parameter:
+. k - the dimension of the recycled subspace
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `KSPGCRODR`, `KSPGCRODRSetRecycle()`
+@*/
+PetscErrorCode KSPGCRODRGetRecycle(KSP ksp, PetscInt *k)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscAssertPointer(k, 2);
+  PetscUseMethod(ksp, "KSPGCRODRGetRecycle_C", (KSP, PetscInt *), (ksp, k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRResetRecycle(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  if (gcrodr->U) {
+    PetscCall(VecDestroyVecs(gcrodr->k, &gcrodr->U));
+    PetscCall(VecDestroyVecs(gcrodr->k, &gcrodr->C));
+    PetscCall(VecDestroyVecs(gcrodr->k, &gcrodr->Uwork));
+    PetscCall(VecDestroyVecs(gcrodr->k, &gcrodr->Cwork));
+  }
+  PetscCall(PetscFree3(gcrodr->Bk, gcrodr->ct, gcrodr->d));
+  gcrodr->kcur = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Makes C = B U hold again, with orthonormal columns, when the operators have changed since the recycled subspace was computed.
+  C is orthonormalized by classical Gram-Schmidt with reorthogonalization and the same operations are applied to U.
+  Directions that become linearly dependent are discarded.
+*/
+static PetscErrorCode KSPGCRODRUpdateOperator(KSP ksp)
+{
+  KSP_GCRODR      *gcrodr = (KSP_GCRODR *)ksp->data;
+  Mat              amat, pmat;
+  PetscObjectId    amatid, pmatid;
+  PetscObjectState amatstate, pmatstate;
+  PetscInt         j, l = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetOperators(ksp->pc, &amat, &pmat));
+  PetscCall(PetscObjectGetId((PetscObject)amat, &amatid));
+  PetscCall(PetscObjectGetId((PetscObject)pmat, &pmatid));
+  PetscCall(PetscObjectStateGet((PetscObject)amat, &amatstate));
+  PetscCall(PetscObjectStateGet((PetscObject)pmat, &pmatstate));
+  if (gcrodr->kcur && (amatid != gcrodr->amatid || pmatid != gcrodr->pmatid || amatstate != gcrodr->amatstate || pmatstate != gcrodr->pmatstate)) {
+    for (j = 0; j < gcrodr->kcur; j++) PetscCall(KSP_PCApplyBAorAB(ksp, gcrodr->U[j], gcrodr->C[j], VEC_TEMP_MATOP));
+    gcrodr->matvecs += gcrodr->kcur;
+    for (j = 0; j < gcrodr->kcur; j++) {
+      PetscReal nrm0, nrm;
+
+      PetscCall(VecNorm(gcrodr->C[j], NORM_2, &nrm0));
+      for (PetscInt pass = 0; pass < 2 && l; pass++) {
+        PetscCall(VecMDot(gcrodr->C[j], l, gcrodr->C, gcrodr->ct));
+        for (PetscInt i = 0; i < l; i++) gcrodr->ct[i] = -gcrodr->ct[i];
+        PetscCall(VecMAXPY(gcrodr->C[j], l, gcrodr->ct, gcrodr->C));
+        PetscCall(VecMAXPY(gcrodr->U[j], l, gcrodr->ct, gcrodr->U));
+      }
+      PetscCall(VecNorm(gcrodr->C[j], NORM_2, &nrm));
+      if (nrm <= PETSC_SMALL * nrm0) continue;
+      PetscCall(VecScale(gcrodr->C[j], 1.0 / nrm));
+      PetscCall(VecScale(gcrodr->U[j], 1.0 / nrm));
+      if (l != j) {
+        PetscCall(VecSwap(gcrodr->C[l], gcrodr->C[j]));
+        PetscCall(VecSwap(gcrodr->U[l], gcrodr->U[j]));
+      }
+      l++;
+    }
+    if (l < gcrodr->kcur) PetscCall(PetscInfo(ksp, "Discarded %" PetscInt_FMT " linearly dependent recycled directions after a change of the operators\n", gcrodr->kcur - l));
+    gcrodr->kcur = l;
+    for (j = 0; j < gcrodr->kcur; j++) PetscCall(VecNormBegin(gcrodr->U[j], NORM_2, gcrodr->d + j));
+    for (j = 0; j < gcrodr->kcur; j++) {
+      PetscCall(VecNormEnd(gcrodr->U[j], NORM_2, gcrodr->d + j));
+      gcrodr->d[j] = 1.0 / gcrodr->d[j];
+    }
+  }
+  gcrodr->amatid    = amatid;
+  gcrodr->pmatid    = pmatid;
+  gcrodr->amatstate = amatstate;
+  gcrodr->pmatstate = pmatstate;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Computes the next recycled subspace from the harmonic Ritz vectors of the cycle that just ended.
+
+  With Uhat = U D, D = diag(1 / ||U_i||), Vhat = [Uhat V_it] and W = [C V_{it+1}], the cycle satisfies B Vhat = W G with
+  G = [D Bk; 0 Hbar]. The harmonic Ritz vectors are Vhat P where P is a basis of the deflating subspace of the pencil
+  (G^H G, G^H W^H Vhat) for its kcur eigenvalues of smallest magnitude; it is computed with the reordered generalized
+  Schur form, as in KSPDGMRESImproveEig(). With G P = Q R, the new recycled subspace is U = Vhat P R^{-1} and C = W Q = B U.
+*/
+static PetscErrorCode KSPGCRODRUpdateRecycle(KSP ksp, PetscInt it)
+{
+  KSP_GCRODR   *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt      kc = gcrodr->kcur, ne = kc + it, nr = ne + 1, ks = 0, i, j, l;
+  PetscScalar  *G, *WV, *A, *B, *Q, *Z, *GP, *Y, *work, one = 1.0, zero = 0.0;
+  PetscReal    *wr, *wi, *beta, *modul;
+  PetscInt     *perm;
+  PetscBLASInt  bne, bnr, bks, lwork, info, sdim = 0, *select;
+  Vec          *tmp;
+
+  PetscFunctionBegin;
+  if (!gcrodr->k || it < 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(ne, &bne));
+  PetscCall(PetscBLASIntCast(nr, &bnr));
+  PetscCall(PetscBLASIntCast(8 * ne + 16, &lwork));
+
+  /* G and W^H Vhat = [C^H Uhat 0; V_{it+1}^H Uhat I] */
+  PetscCall(PetscCalloc2(nr * ne, &G, nr * ne, &WV));
+  for (i = 0; i < kc; i++) G[i + i * nr] = gcrodr->d[i];
+  for (j = 0; j < it; j++) {
+    for (i = 0; i < kc; i++) G[i + (kc + j) * nr] = *BK(i, j);
+    for (i = 0; i <= j + 1; i++) G[kc + i + (kc + j) * nr] = *HES(i, j);
+    WV[kc + j + (kc + j) * nr] = 1.0;
+  }
+  for (j = 0; j < kc; j++) {
+    PetscCall(VecMDotBegin(gcrodr->U[j], kc, gcrodr->C, WV + j * nr));
+    PetscCall(VecMDotBegin(gcrodr->U[j], it + 1, &VEC_VV(0), WV + kc + j * nr));
+  }
+  for (j = 0; j < kc; j++) {
+    PetscCall(VecMDotEnd(gcrodr->U[j], kc, gcrodr->C, WV + j * nr));
+    PetscCall(VecMDotEnd(gcrodr->U[j], it + 1, &VEC_VV(0), WV + kc + j * nr));
+    for (i = 0; i < nr; i++) WV[i + j * nr] *= gcrodr->d[j];
+  }
+
+  /* generalized Schur form of the harmonic Ritz pencil, reordered so that the selected eigenvalues come first */
+  PetscCall(PetscMalloc5(ne * ne, &A, ne * ne, &B, ne * ne, &Q, ne * ne, &Z, lwork, &work));
+  PetscCall(PetscMalloc5(ne, &wr, ne, &wi, ne, &beta, ne, &modul, ne, &perm));
+  PetscCall(PetscCalloc1(ne, &select));
+  PetscCallBLAS("BLASgemm", BLASgemm_("T", "N", &bne, &bne, &bnr, &one, G, &bnr, G, &bnr, &zero, A, &bne));
+  PetscCallBLAS("BLASgemm", BLASgemm_("T", "N", &bne, &bne, &bnr, &one, G, &bnr, WV, &bnr, &zero, B, &bne));
+  PetscCallBLAS("LAPACKgges", LAPACKgges_("V", "V", "N", NULL, &bne, A, &bne, B, &bne, &sdim, wr, wi, beta, Q, &bne, Z, &bne, work, &lwork, NULL, &info));
+  if (info) PetscCall(PetscInfo(ksp, "Error in LAPACK routine XGGES %d, the recycled subspace is not updated\n", (int)info));
+  else {
+    for (i = 0; i < ne; i++) {
+      modul[i] = beta[i] != 0.0 ? PetscSqrtReal(wr[i] * wr[i] + wi[i] * wi[i]) / PetscAbsReal(beta[i]) : PETSC_MAX_REAL;
+      perm[i]  = i;
+    }
+    PetscCall(PetscSortRealWithPermutation(ne, modul, perm));
+    /* complex conjugate pairs are stored consecutively, the one with a positive imaginary part first, and selected together */
+    for (l = 0; l < ne && ks < gcrodr->k && modul[perm[l]] < PETSC_MAX_REAL; l++) {
+      i = perm[l];
+      if (select[i]) continue;
+      if (wi[i] == 0.0) {
+        select[i] = 1;
+        ks++;
+      } else if (ks + 2 <= gcrodr->k) {
+        j         = wi[i] > 0.0 ? i + 1 : i - 1;
+        select[i] = 1;
+        select[j] = 1;
+        ks += 2;
+      }
+    }
+    if (ks) {
+      PetscBLASInt ijob = 0, wantq = 1, wantz = 1, liwork = 1, iwork, m;
+      PetscReal    dif[2];
+
+      PetscCallBLAS("LAPACKtgsen", LAPACKtgsen_(&ijob, &wantq, &wantz, select, &bne, A, &bne, B, &bne, wr, wi, beta, Q, &bne, Z, &bne, &m, NULL, NULL, dif, work, &lwork, &iwork, &liwork, &info));
+      if (info) {
+        PetscCall(PetscInfo(ksp, "Unable to reorder the harmonic Ritz values with the LAPACK routine XTGSEN %d, the recycled subspace is not updated\n", (int)info));
+        ks = 0;
+      } else ks = m;
+    }
+  }
+  PetscCall(PetscFree(select));
+  PetscCall(PetscFree5(wr, wi, beta, modul, perm));
+
+  if (ks) {
+    /* G P = Q R with modified Gram-Schmidt applied twice, the same operations on P = Z(:, 0:ks-1) give P R^{-1} */
+    PetscCall(PetscBLASIntCast(ks, &bks));
+    PetscCall(PetscMalloc2(nr * ks, &GP, ne * ks, &Y));
+    PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bnr, &bks, &bne, &one, G, &bnr, Z, &bne, &zero, GP, &bnr));
+    PetscCall(PetscArraycpy(Y, Z, ne * ks));
+    for (j = 0, l = 0; j < ks; j++) {
+      PetscReal nrm0 = 0.0, nrm = 0.0;
+
+      for (i = 0; i < nr; i++) nrm0 += PetscRealPart(GP[i + j * nr] * PetscConj(GP[i + j * nr]));
+      for (PetscInt pass = 0; pass < 2; pass++) {
+        for (PetscInt c = 0; c < l; c++) {
+          PetscScalar h = 0.0;
+
+          for (i = 0; i < nr; i++) h += PetscConj(GP[i + c * nr]) * GP[i + j * nr];
+          for (i = 0; i < nr; i++) GP[i + j * nr] -= h * GP[i + c * nr];
+          for (i = 0; i < ne; i++) Y[i + j * ne] -= h * Y[i + c * ne];
+        }
+      }
+      for (i = 0; i < nr; i++) nrm += PetscRealPart(GP[i + j * nr] * PetscConj(GP[i + j * nr]));
+      nrm = PetscSqrtReal(nrm);
+      if (nrm <= PETSC_SMALL * PetscSqrtReal(nrm0)) continue;
+      for (i = 0; i < nr; i++) GP[i + l * nr] = GP[i + j * nr] / nrm;
+      for (i = 0; i < ne; i++) Y[i + l * ne] = Y[i + j * ne] / nrm;
+      l++;
+    }
+    ks = l;
+    /* coefficients of Vhat P R^{-1} on the columns of U instead of Uhat */
+    for (j = 0; j < ks; j++)
+      for (i = 0; i < kc; i++) Y[i + j * ne] *= gcrodr->d[i];
+    for (j = 0; j < ks; j++) {
+      PetscCall(VecMAXPBY(gcrodr->Cwork[j], it + 1, GP + kc + j * nr, 0.0, &VEC_VV(0)));
+      if (kc) PetscCall(VecMAXPY(gcrodr->Cwork[j], kc, GP + j * nr, gcrodr->C));
+      PetscCall(VecMAXPBY(gcrodr->Uwork[j], it, Y + kc + j * ne, 0.0, &VEC_VV(0)));
+      if (kc) PetscCall(VecMAXPY(gcrodr->Uwork[j], kc, Y + j * ne, gcrodr->U));
+    }
+    PetscCall(PetscFree2(GP, Y));
+  }
+  PetscCall(PetscFree5(A, B, Q, Z, work));
+  PetscCall(PetscFree2(G, WV));
+  if (!ks) PetscFunctionReturn(PETSC_SUCCESS);
+
+  tmp           = gcrodr->U;
+  gcrodr->U     = gcrodr->Uwork;
+  gcrodr->Uwork = tmp;
+  tmp           = gcrodr->C;
+  gcrodr->C     = gcrodr->Cwork;
+  gcrodr->Cwork = tmp;
+  gcrodr->kcur  = ks;
+  for (j = 0; j < ks; j++) PetscCall(VecNormBegin(gcrodr->U[j], NORM_2, gcrodr->d + j));
+  for (j = 0; j < ks; j++) {
+    PetscCall(VecNormEnd(gcrodr->U[j], NORM_2, gcrodr->d + j));
+    gcrodr->d[j] = 1.0 / gcrodr->d[j];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Adds U C^H r to the solution and removes C C^H r from the residual r, stored in VEC_VV(0)
+*/
+static PetscErrorCode KSPGCRODRProject(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt    kc     = gcrodr->kcur;
+
+  PetscFunctionBegin;
+  PetscCall(VecMDot(VEC_VV(0), kc, gcrodr->C, gcrodr->ct));
+  PetscCall(VecMAXPBY(VEC_TEMP, kc, gcrodr->ct, 0.0, gcrodr->U));
+  PetscCall(KSPUnwindPreconditioner(ksp, VEC_TEMP, VEC_TEMP_MATOP));
+  PetscCall(VecAXPY(ksp->vec_sol, 1.0, VEC_TEMP));
+  for (PetscInt i = 0; i < kc; i++) gcrodr->ct[i] = -gcrodr->ct[i];
+  PetscCall(VecMAXPY(VEC_VV(0), kc, gcrodr->ct, gcrodr->C));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  One restart cycle: GMRES with the operator (I - C C^H) B for restart - kcur steps, then the update of the solution
+  and of the recycled subspace.
+
+  On entry, the value in vector VEC_VV(0) should be the initial residual, orthogonal to C.
+*/
+static PetscErrorCode KSPGCRODRCycle(PetscInt *itcount, KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscReal   res, hapbnd, tt;
+  PetscInt    it = 0, kc = gcrodr->kcur, max_k = gcrodr->max_k - kc;
+  PetscBool   hapend = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  PetscCall(VecNormalize(VEC_VV(0), &res));
+  KSPCheckNorm(ksp, res);
+  *GRS(0) = gcrodr->rnorm0 = res;
+
+  /* check for the convergence */
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->rnorm = res;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  gcrodr->it = (it - 1);
+  PetscCall(KSPLogResidualHistory(ksp, res));
+  PetscCall(KSPLogErrorHistory(ksp));
+  PetscCall(KSPMonitor(ksp, ksp->its, res));
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    PetscCall(PetscInfo(ksp, "Converged due to zero residual norm on entry\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    if (it) {
+      PetscCall(KSPLogResidualHistory(ksp, res));
+      PetscCall(KSPLogErrorHistory(ksp));
+      PetscCall(KSPMonitor(ksp, ksp->its, res));
+    }
+    gcrodr->it = (it - 1);
+    if (gcrodr->vv_allocated <= it + VEC_OFFSET + 1) PetscCall(KSPGMRESGetNewVectors(ksp, it + 1));
+    PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(it), VEC_VV(1 + it), VEC_TEMP_MATOP));
+
+    /* project out the recycled directions, the coefficients form the column it of Bk */
+    if (kc) {
+      PetscCall(VecMDot(VEC_VV(1 + it), kc, gcrodr->C, BK(0, it)));
+      for (PetscInt i = 0; i < kc; i++) gcrodr->ct[i] = -*BK(i, it);
+      PetscCall(VecMAXPY(VEC_VV(1 + it), kc, gcrodr->ct, gcrodr->C));
+    }
+
+    /* update hessenberg matrix and do Gram-Schmidt */
+    PetscCall((*gcrodr->orthog)(ksp, it));
+    if (ksp->reason) break;
+
+    /* vv(i+1) . vv(i+1) */
+    PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    KSPCheckNorm(ksp, tt);
+
+    /* save the magnitude */
+    *HH(it + 1, it)  = tt;
+    *HES(it + 1, it) = tt;
+
+    /* check for the happy breakdown */
+    hapbnd = PetscAbsScalar(tt / *GRS(it));
+    if (hapbnd > gcrodr->haptol) hapbnd = gcrodr->haptol;
+    if (tt < hapbnd) {
+      PetscCall(PetscInfo(ksp, "Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n", (double)hapbnd, (double)tt));
+      hapend = PETSC_TRUE;
+    }
+    PetscCall(KSPGCRODRUpdateHessenberg(ksp, it, hapend, &res));
+
+    it++;
+    gcrodr->it = (it - 1); /* For converged */
+    ksp->its++;
+    ksp->rnorm = res;
+    if (ksp->reason) break;
+
+    PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+
+    /* Catch error in happy breakdown and signal convergence and break from loop */
+    if (hapend) {
+      if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+        ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+      } else if (!ksp->reason) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Reached happy break down, but convergence was not indicated. Residual norm = %g", (double)res);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        break;
+      }
+    }
+  }
+
+  /* Monitor if we know that we will not return for a restart */
+  if (it && (ksp->reason || ksp->its >= ksp->max_it)) {
+    PetscCall(KSPLogResidualHistory(ksp, res));
+    PetscCall(KSPLogErrorHistory(ksp));
+    PetscCall(KSPMonitor(ksp, ksp->its, res));
+  }
+
+  if (itcount) *itcount = it;
+
+  /* Form the solution (or the solution so far) and compute the recycled subspace for the next cycle or the next solve */
+  PetscCall(KSPGCRODRBuildSoln(GRS(0), ksp->vec_sol, ksp->vec_sol, ksp, it - 1));
+  if (ksp->reason >= 0 || ksp->reason == KSP_DIVERGED_ITS) PetscCall(KSPGCRODRUpdateRecycle(ksp, it));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt    its, itcount = 0;
+  PetscBool   guess_zero = ksp->guess_zero;
+
+  PetscFunctionBegin;
+  PetscCheck(gcrodr->k < gcrodr->max_k, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "The dimension of the recycled subspace %" PetscInt_FMT " must be smaller than the restart %" PetscInt_FMT, gcrodr->k, gcrodr->max_k);
+  if (gcrodr->k && !gcrodr->U) {
+    PetscCall(KSPCreateVecs(ksp, gcrodr->k, &gcrodr->U, gcrodr->k, &gcrodr->C));
+    PetscCall(KSPCreateVecs(ksp, gcrodr->k, &gcrodr->Uwork, gcrodr->k, &gcrodr->Cwork));
+    PetscCall(PetscMalloc3(gcrodr->k * gcrodr->max_k, &gcrodr->Bk, gcrodr->k, &gcrodr->ct, gcrodr->k, &gcrodr->d));
+    gcrodr->kcur = 0;
+  }
+
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its = 0;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+
+  PetscCall(KSPGCRODRUpdateOperator(ksp));
+  while (!ksp->reason) {
+    PetscCall(KSPInitialResidual(ksp, ksp->vec_sol, VEC_TEMP, VEC_TEMP_MATOP, VEC_VV(0), ksp->vec_rhs));
+    if (gcrodr->kcur) PetscCall(KSPGCRODRProject(ksp));
+    PetscCall(KSPGCRODRCycle(&its, ksp));
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_GCRODR(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPGCRODRResetRecycle(ksp));
+  PetscCall(KSPReset_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_GCRODR(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPGCRODRResetRecycle(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRSetRecycle_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRGetRecycle_C", NULL));
+  PetscCall(KSPDestroy_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPGCRODRBuildSoln - create the solution from the starting vector and the current iterates.
+
+  Input parameters:
+  nrs - work area of size it + 1.
+  vs  - index of initial guess
+  vdest - index of result.  Note that vs may == vdest (replace guess with the solution).
+
+  The correction of the preconditioned problem is V y - U Bk y, with y the least squares solution of the Hessenberg system.
+*/
+static PetscErrorCode KSPGCRODRBuildSoln(PetscScalar *nrs, Vec vs, Vec vdest, KSP ksp, PetscInt it)
+{
+  PetscScalar tt;
+  PetscInt    ii, k, j;
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  /* If it is < 0, no gmres steps have been performed */
+  if (it < 0) {
+    PetscCall(VecCopy(vs, vdest)); /* VecCopy() is smart, exists immediately if vguess == vdest */
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(*HH(it, it) != 0.0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Likely your matrix is the zero operator. HH(it,it) is identically zero; it = %" PetscInt_FMT " GRS(it) = %g", it, (double)PetscAbsScalar(*GRS(it)));
+  nrs[it] = *GRS(it) / *HH(it, it);
+  for (ii = 1; ii <= it; ii++) {
+    k  = it - ii;
+    tt = *GRS(k);
+    for (j = k + 1; j <= it; j++) tt = tt - *HH(k, j) * nrs[j];
+    PetscCheck(*HH(k, k) != 0.0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Likely your matrix is singular. HH(k,k) is identically zero; it = %" PetscInt_FMT " k = %" PetscInt_FMT, it, k);
+    nrs[k] = tt / *HH(k, k);
+  }
+
+  /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
+  PetscCall(VecMAXPBY(VEC_TEMP, it + 1, nrs, 0, &VEC_VV(0)));
+  if (gcrodr->kcur) {
+    for (k = 0; k < gcrodr->kcur; k++) {
+      gcrodr->ct[k] = 0.0;
+      for (j = 0; j <= it; j++) gcrodr->ct[k] -= *BK(k, j) * nrs[j];
+    }
+    PetscCall(VecMAXPY(VEC_TEMP, gcrodr->kcur, gcrodr->ct, gcrodr->U));
+  }
+  PetscCall(KSPUnwindPreconditioner(ksp, VEC_TEMP, VEC_TEMP_MATOP));
+
+  /* add solution to previous solution */
+  if (vdest != vs) PetscCall(VecCopy(vs, vdest));
+  PetscCall(VecAXPY(vdest, 1.0, VEC_TEMP));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Do the scalar work for the orthogonalization.  Return new residual norm.
+*/
+static PetscErrorCode KSPGCRODRUpdateHessenberg(KSP ksp, PetscInt it, PetscBool hapend, PetscReal *res)
+{
+  PetscScalar *hh, *cc, *ss, tt;
+  PetscInt     j;
+  KSP_GCRODR  *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  hh = HH(0, it);
+  cc = CC(0);
+  ss = SS(0);
+
+  /* Apply all the previously computed plane rotations to the new column of the Hessenberg matrix */
+  for (j = 1; j <= it; j++) {
+    tt  = *hh;
+    *hh = PetscConj(*cc) * tt + *ss * *(hh + 1);
+    hh++;
+    *hh = *cc++ * *hh - (*ss++ * tt);
+  }
+
+  /*
+    compute the new plane rotation, and apply it to:
+     1) the right-hand-side of the Hessenberg system
+     2) the new column of the Hessenberg matrix
+    thus obtaining the updated value of the residual
+  */
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(*hh) * *hh + PetscConj(*(hh + 1)) * *(hh + 1));
+    if (tt == 0.0) {
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    *cc          = *hh / tt;
+    *ss          = *(hh + 1) / tt;
+    *GRS(it + 1) = -(*ss * *GRS(it));
+    *GRS(it)     = PetscConj(*cc) * *GRS(it);
+    *hh          = PetscConj(*cc) * *hh + *ss * *(hh + 1);
+    *res         = PetscAbsScalar(*GRS(it + 1));
+  } else {
+    /* happy breakdown: HH(it+1, it) = 0, therefore we don't need to apply another rotation matrix (so RH doesn't change) */
+    *res = 0.0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPBuildSolution_GCRODR(KSP ksp, Vec ptr, Vec *result)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!gcrodr->sol_temp) PetscCall(VecDuplicate(ksp->vec_sol, &gcrodr->sol_temp));
+    ptr = gcrodr->sol_temp;
+  }
+  if (!gcrodr->nrs) {
+    /* allocate the work area */
+    PetscCall(PetscMalloc1(gcrodr->max_k, &gcrodr->nrs));
+  }
+  PetscCall(KSPGCRODRBuildSoln(gcrodr->nrs, ksp->vec_sol, ptr, ksp, gcrodr->it));
+  if (result) *result = ptr;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_GCRODR(KSP ksp, PetscViewer viewer)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscBool   iascii;
+
+  PetscFunctionBegin;
+  PetscCall(KSPView_GMRES(ksp, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  recycled subspace: dimension %" PetscInt_FMT ", maximum dimension %" PetscInt_FMT "\n", gcrodr->kcur, gcrodr->k));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  operator applications to update the recycled subspace after a change of the operators: %" PetscInt_FMT "\n", gcrodr->matvecs));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_GCRODR(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt    k;
+  PetscBool   flg;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSetFromOptions_GMRES(ksp, PetscOptionsObject));
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP GCRODR Options");
+  PetscCall(PetscOptionsInt("-ksp_gcrodr_recycle", "Dimension of the subspace recycled between restart cycles and solves", "KSPGCRODRSetRecycle", gcrodr->k, &k, &flg));
+  if (flg) PetscCall(KSPGCRODRSetRecycle(ksp, k));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRSetRecycle_GCRODR(KSP ksp, PetscInt k)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(k >= 0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "The dimension of the recycled subspace must be nonnegative");
+  if (k == gcrodr->k) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(KSPGCRODRResetRecycle(ksp));
+  gcrodr->k = k;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRGetRecycle_GCRODR(KSP ksp, PetscInt *k)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  *k = gcrodr->k;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   KSPGCRODR - Implements GCRO-DR [1], the restarted GMRES variant that recycles a deflation subspace from one restart cycle
+               and from one `KSPSolve()` to the next, for sequences of linear systems whose operators change slowly
+
+   Options Database Keys:
++   -ksp_gmres_restart <restart> - the total dimension of the approximation space, recycled vectors and Krylov vectors
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_gmres_preallocate - preallocate all the Krylov search directions initially (otherwise groups of vectors are allocated as needed)
+.   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
+.   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
+                                   stability of the classical Gram-Schmidt  orthogonalization.
+-   -ksp_gcrodr_recycle <k> - the dimension of the recycled subspace, see `KSPGCRODRSetRecycle()`
+
+   Level: intermediate
+
+   Notes:
+   Each restart cycle minimizes the residual over the recycled subspace U and the Krylov subspace of the operator
+   (I - C C^H) B, where B is the preconditioned operator and C = B U has orthonormal columns. At the end of each cycle U is
+   replaced by the harmonic Ritz vectors of smallest magnitude of the space of that cycle, so U approximates the invariant
+   subspace of B that slows down GMRES. The subspace is kept by the `KSP` at the end of `KSPSolve()` and used from the
+   start of the next solve. If the operators have changed, C is recomputed first, which costs k applications of the
+   preconditioned operator. `KSPReset()` or `KSPGCRODRSetRecycle()` discard the subspace.
+
+   The first cycle of the first solve is a GMRES cycle. Later cycles use restart - k Krylov vectors.
+
+   Left and right preconditioning are supported, but not symmetric preconditioning. Complex arithmetic is not supported.
+
+   The harmonic Ritz vectors are computed from the reordered generalized Schur form of a small pencil, like the improved
+   eigenvectors of `KSPDGMRES`. Complex conjugate harmonic Ritz values are kept or discarded together, so fewer than
+   k vectors may be recycled.
+
+   References:
+.  [1] - M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson and S. Maiti, Recycling Krylov subspaces for sequences of linear systems,
+   SIAM Journal on Scientific Computing, 28 (2006).
+
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPGMRES`, `KSPDGMRES`, `KSPLGMRES`, `KSPGuess`,
+          `KSPGCRODRSetRecycle()`, `KSPGCRODRGetRecycle()`, `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`,
+          `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`, `KSPSetPCSide()`
+M*/
+
+PETSC_EXTERN PetscErrorCode KSPCreate_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&gcrodr));
+  ksp->data = (void *)gcrodr;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_RIGHT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_RIGHT, 1));
+
+  ksp->ops->buildsolution  = KSPBuildSolution_GCRODR;
+  ksp->ops->setup          = KSPSetUp_GMRES;
+  ksp->ops->solve          = KSPSolve_GCRODR;
+  ksp->ops->reset          = KSPReset_GCRODR;
+  ksp->ops->destroy        = KSPDestroy_GCRODR;
+  ksp->ops->view           = KSPView_GCRODR;
+  ksp->ops->setfromoptions = KSPSetFromOptions_GCRODR;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetPreAllocateVectors_C", KSPGMRESSetPreAllocateVectors_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetOrthogonalization_C", KSPGMRESSetOrthogonalization_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetOrthogonalization_C", KSPGMRESGetOrthogonalization_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetRestart_C", KSPGMRESSetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetRestart_C", KSPGMRESGetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetHapTol_C", KSPGMRESSetHapTol_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetCGSRefinementType_C", KSPGMRESSetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetCGSRefinementType_C", KSPGMRESGetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRSetRecycle_C", KSPGCRODRSetRecycle_GCRODR));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRGetRecycle_C", KSPGCRODRGetRecycle_GCRODR));
+
+  gcrodr->haptol         = 1.0e-30;
+  gcrodr->q_preallocate  = 0;
+  gcrodr->delta_allocate = GCRODR_DELTA_DIRECTIONS;
+  gcrodr->orthog         = KSPGMRESClassicalGramSchmidtOrthogonalization;
+  gcrodr->nrs            = NULL;
+  gcrodr->sol_temp       = NULL;
+  gcrodr->max_k          = GCRODR_DEFAULT_MAXK;
+  gcrodr->Rsvd           = NULL;
+  gcrodr->cgstype        = KSP_GMRES_CGS_REFINE_NEVER;
+  gcrodr->orthogwork     = NULL;
+
+  gcrodr->k    = GCRODR_DEFAULT_RECYCLE;
+  gcrodr->kcur = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,43 @@
+/*
+   Private data structure used by the GCRODR method.
+*/
+
+#pragma once
+
+#define KSPGMRES_NO_MACROS
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  KSPGMRESHEADER
+
+  /* Data specific to GCRODR */
+  PetscInt         k;               /* requested dimension of the recycled subspace */
+  PetscInt         kcur;            /* current dimension of the recycled subspace, 0 until the end of the first cycle */
+  Vec             *U;               /* basis of the recycled subspace */
+  Vec             *C;               /* C = B U with orthonormal columns, B the preconditioned operator */
+  Vec             *Uwork, *Cwork;   /* the next recycled subspace while it is computed from U, C and the Arnoldi vectors */
+  PetscScalar     *Bk;              /* Bk = C^H B V for the Arnoldi vectors V of the current cycle, size k x max_k */
+  PetscScalar     *ct;              /* work array of size k */
+  PetscReal       *d;               /* 1 / ||U_i||, scales the recycled vectors in the harmonic Ritz problem */
+  PetscObjectId    amatid, pmatid;  /* operators for which C = B U holds */
+  PetscObjectState amatstate, pmatstate;
+  PetscInt         matvecs; /* number of operator applications spent on recomputing C = B U */
+} KSP_GCRODR;
+
+#define HH(a, b)  (gcrodr->hh_origin + (b) * (gcrodr->max_k + 2) + (a))
+#define HES(a, b) (gcrodr->hes_origin + (b) * (gcrodr->max_k + 1) + (a))
+#define CC(a)     (gcrodr->cc_origin + (a))
+#define SS(a)     (gcrodr->ss_origin + (a))
+#define GRS(a)    (gcrodr->rs_origin + (a))
+#define BK(a, b)  (gcrodr->Bk + (b) * gcrodr->k + (a))
+
+/* vector names */
+#define VEC_OFFSET     2
+#define VEC_TEMP       gcrodr->vecs[0]
+#define VEC_TEMP_MATOP gcrodr->vecs[1]
+#define VEC_VV(i)      gcrodr->vecs[VEC_OFFSET + i]
+
+#define GCRODR_DELTA_DIRECTIONS 10
+#define GCRODR_DEFAULT_MAXK     30
+#define GCRODR_DEFAULT_RECYCLE  10
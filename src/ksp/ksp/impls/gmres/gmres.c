@@ -27,11 +27,33 @@
  */
 
 #include <../src/ksp/ksp/impls/gmres/gmresimpl.h> /*I  "petscksp.h"  I*/
+#include <petsc/private/vecimpl.h>
+#include <petscblaslapack.h>
 #define GMRES_DELTA_DIRECTIONS 10
 #define GMRES_DEFAULT_MAXK     30
 static PetscErrorCode KSPGMRESUpdateHessenberg(KSP, PetscInt, PetscBool, PetscReal *);
 static PetscErrorCode KSPGMRESBuildSoln(PetscScalar *, Vec, Vec, KSP, PetscInt);
 
+/*
+   Creates n vectors of the Krylov basis like KSPCreateVecs(). Unless -vec_mdot_use_gemv or -vec_maxpy_use_gemv is false, they are
+   stored contiguously and VecMDot(), respectively VecMAXPY(), use BLAS gemv on them (see VECSEQ), so the inner products of the
+   orthogonalization and the update of the solution take one matrix-vector product per chunk of vectors
+*/
+PetscErrorCode KSPGMRESCreateBasisVecs_Private(KSP ksp, PetscInt n, Vec **vecs)
+{
+  Vec      *t;
+  PetscBool mdot = PETSC_TRUE, maxpy = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(KSPCreateVecs(ksp, 1, &t, 0, NULL));
+  PetscCall(PetscOptionsGetBool(((PetscObject)t[0])->options, ((PetscObject)t[0])->prefix, "-vec_mdot_use_gemv", &mdot, NULL));
+  PetscCall(PetscOptionsGetBool(((PetscObject)t[0])->options, ((PetscObject)t[0])->prefix, "-vec_maxpy_use_gemv", &maxpy, NULL));
+  PetscCall(VecSetUseGEMV_Private(t[0], mdot, maxpy));
+  PetscCall(VecDuplicateVecs(t[0], n, vecs));
+  PetscCall(VecDestroyVecs(1, &t));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode KSPSetUp_GMRES(KSP ksp)
 {
   PetscInt   hh, hes, rs, cc;
@@ -64,7 +86,7 @@ PetscErrorCode KSPSetUp_GMRES(KSP ksp)
   if (gmres->q_preallocate) {
     gmres->vv_allocated = VEC_OFFSET + 2 + max_k;
 
-    PetscCall(KSPCreateVecs(ksp, gmres->vv_allocated, &gmres->user_work[0], 0, NULL));
+    PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, gmres->vv_allocated, &gmres->user_work[0]));
 
     gmres->mwork_alloc[0] = gmres->vv_allocated;
     gmres->nwork_alloc    = 1;
@@ -72,7 +94,7 @@ PetscErrorCode KSPSetUp_GMRES(KSP ksp)
   } else {
     gmres->vv_allocated = 5;
 
-    PetscCall(KSPCreateVecs(ksp, 5, &gmres->user_work[0], 0, NULL));
+    PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, 5, &gmres->user_work[0]));
 
     gmres->mwork_alloc[0] = 5;
     gmres->nwork_alloc    = 1;
@@ -249,6 +271,263 @@ static PetscErrorCode KSPSolve_GMRES(KSP ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Orthonormalizes the block W of s vectors, whose Gram matrix is G, into the columns off, off + 1, ..., off + rank - 1 of V so that
+   W = V(:, off:off + rank - 1) S. The second pass restores the orthogonality lost by the first one when W is ill-conditioned; Y is
+   a work block of s vectors, T and S2 are s x s work arrays
+*/
+static PetscErrorCode KSPGMRESBlockOrthonormalize_Private(KSP ksp, Mat W, PetscScalar G[], Mat V, PetscInt off, Mat Y, PetscScalar T[], PetscScalar S[], PetscScalar S2[], PetscInt *rank)
+{
+  Mat          Vr, Yr;
+  PetscInt     s, r, r2;
+  PetscReal    tol;
+  PetscScalar  one = 1.0, zero = 0.0;
+  PetscBLASInt bs, br, br2;
+  PetscMPIInt  count;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(W, NULL, &s));
+  tol = 10 * s * PETSC_MACHINE_EPSILON;
+  PetscCall(KSPBlockGramFactor_Private(s, G, tol, T, S, &r, NULL));
+  *rank = r;
+  if (!r) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, off, off + r, &Vr));
+  PetscCall(KSPBlockUpdate_Private(Vr, 0.0, 1.0, W, T, s));
+  PetscCall(KSPBlockDotLocal_Private(Vr, Vr, G, r));
+  PetscCall(PetscMPIIntCast(r * r, &count));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, G, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+  PetscCall(KSPBlockGramFactor_Private(r, G, tol, T, S2, &r2, NULL));
+  PetscCall(MatDenseGetSubMatrix(Y, PETSC_DECIDE, PETSC_DECIDE, 0, r2, &Yr));
+  PetscCall(KSPBlockUpdate_Private(Yr, 0.0, 1.0, Vr, T, r));
+  PetscCall(MatDenseRestoreSubMatrix(V, &Vr));
+  PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, off, off + r2, &Vr));
+  PetscCall(MatCopy(Yr, Vr, SAME_NONZERO_PATTERN));
+  PetscCall(MatDenseRestoreSubMatrix(V, &Vr));
+  PetscCall(MatDenseRestoreSubMatrix(Y, &Yr));
+  /* S <- S2 S */
+  PetscCall(PetscBLASIntCast(s, &bs));
+  PetscCall(PetscBLASIntCast(r, &br));
+  PetscCall(PetscBLASIntCast(r2, &br2));
+  PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &br2, &bs, &br, &one, S2, &br, S, &bs, &zero, T, &bs));
+  PetscCall(PetscArraycpy(S, T, s * s));
+  *rank = r2;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   KSPMatSolve_GMRES - Block GMRES with restart for all the columns of B at once
+
+   The Krylov basis is a MATDENSE of (restart + 1) blocks of at most s vectors. The operator is applied to a block with MatMatMult()
+   and the preconditioner with PCMatApply(). Each new block is orthogonalized against the basis with two passes of block classical
+   Gram-Schmidt, then orthonormalized from its Gram matrix, which drops the vectors that are numerically linearly dependent, so each
+   iteration has three reductions of small dense matrices. The block Hessenberg matrix is triangularized with Householder reflectors as
+   it grows, which gives the residual norms of all the columns at each iteration.
+*/
+static PetscErrorCode KSPMatSolve_GMRES(KSP ksp, Mat B, Mat X)
+{
+  KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  Mat          Amat, V, W, AW = NULL, Z, Vk, Vj, Wr, Op, Work;
+  PetscScalar *H, *Gr, *buf, *T, *S, *S2, *tau, *y, *work, one = 1.0, mone = -1.0;
+  PetscReal   *nrm, *nrm0, dp;
+  PetscInt     s, m, ld, M, mloc, j, k, *off, *rk;
+  PetscBLASInt bs, bk, bld, bm, bn, bkk, blwork, info;
+  PetscMPIInt  count;
+  PetscBool    diagonalscale, first = PETSC_TRUE;
+#if defined(PETSC_USE_COMPLEX)
+  const char *trans = "C";
+#else
+  const char *trans = "T";
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+  PetscCheck(ksp->pc_side != PC_SYMMETRIC, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "KSPMatSolve() with KSPGMRES does not support symmetric preconditioning");
+  PetscCall(PCGetOperators(ksp->pc, &Amat, NULL));
+  PetscCall(MatGetSize(B, &M, &s));
+  PetscCall(MatGetLocalSize(B, &mloc, NULL));
+  m  = gmres->max_k;
+  ld = (m + 1) * s;
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)B), &V));
+  PetscCall(MatSetSizes(V, mloc, PETSC_DECIDE, M, ld));
+  PetscCall(MatSetType(V, ((PetscObject)B)->type_name));
+  PetscCall(MatSetUp(V));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &W));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &Z));
+  PetscCall(PetscMalloc6(ld * m * s, &H, ld * s, &Gr, (ld + s) * s, &buf, ld * s, &y, m * s, &tau, 64 * s, &work));
+  PetscCall(PetscMalloc7(s * s, &T, s * s, &S, s * s, &S2, s, &nrm, s, &nrm0, m + 2, &off, m + 2, &rk));
+  PetscCall(PetscBLASIntCast(s, &bs));
+  PetscCall(PetscBLASIntCast(ld, &bld));
+  PetscCall(PetscBLASIntCast(64 * s, &blwork));
+
+  ksp->its = 0;
+  for (;;) {
+    /* r <- b - Ax, left preconditioned r <- B(b - Ax) */
+    if (!first || !ksp->guess_zero) {
+      PetscCall(MatCopy(X, W, SAME_NONZERO_PATTERN));
+      PetscCall(KSPBlockMatMult_Private(ksp, Amat, W, &AW));
+      PetscCall(MatCopy(B, Z, SAME_NONZERO_PATTERN));
+      PetscCall(MatAXPY(Z, -1.0, AW, SAME_NONZERO_PATTERN));
+    } else PetscCall(MatCopy(B, Z, SAME_NONZERO_PATTERN));
+    if (ksp->pc_side == PC_LEFT) {
+      PetscCall(KSP_PCMatApply(ksp, Z, W));
+      Op   = W;
+      Work = Z;
+    } else {
+      Op   = Z;
+      Work = W;
+    }
+    PetscCall(KSPBlockDotLocal_Private(Op, Op, buf, s));
+    PetscCall(PetscMPIIntCast(s * s, &count));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+    for (PetscInt c = 0; c < s; c++) nrm[c] = ksp->normtype == KSP_NORM_NONE ? 0.0 : PetscSqrtReal(PetscAbsScalar(buf[c + c * s]));
+    PetscCall(KSPBlockResidualNorm_Private(s, nrm, first, nrm0, &dp));
+    first      = PETSC_FALSE;
+    ksp->rnorm = dp;
+    PetscCall(KSPLogResidualHistory(ksp, dp));
+    PetscCall(KSPMonitor(ksp, ksp->its, dp));
+    PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+    if (!ksp->reason && ksp->its >= ksp->max_it) ksp->reason = KSP_DIVERGED_ITS;
+    if (ksp->reason) break;
+
+    /* first block of the basis, the right-hand side of the least-squares problem is its coefficient matrix */
+    PetscCall(KSPGMRESBlockOrthonormalize_Private(ksp, Op, buf, V, 0, Work, T, S, S2, &rk[0]));
+    if (!rk[0]) {
+      ksp->reason = KSP_CONVERGED_ATOL;
+      PetscCall(PetscInfo(ksp, "Converged due to a zero block of residuals\n"));
+      break;
+    }
+    off[0] = 0;
+    off[1] = rk[0];
+    PetscCall(PetscArrayzero(Gr, ld * s));
+    for (PetscInt c = 0; c < s; c++)
+      for (PetscInt i = 0; i < rk[0]; i++) Gr[i + c * ld] = S[i + c * s];
+    PetscCall(PetscArrayzero(H, ld * m * s));
+
+    for (j = 0; j < m; j++) {
+      PetscInt rj = rk[j];
+
+      /* the new block Op = AB V_j or BA V_j, zero past the rank of V_j */
+      PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, off[j], off[j] + rj, &Vj));
+      if (rj < s) {
+        PetscCall(MatDenseGetSubMatrix(W, PETSC_DECIDE, PETSC_DECIDE, rj, s, &Wr));
+        PetscCall(MatZeroEntries(Wr));
+        PetscCall(MatDenseRestoreSubMatrix(W, &Wr));
+      }
+      PetscCall(MatDenseGetSubMatrix(W, PETSC_DECIDE, PETSC_DECIDE, 0, rj, &Wr));
+      if (ksp->pc_side == PC_LEFT) PetscCall(MatCopy(Vj, Wr, SAME_NONZERO_PATTERN));
+      else PetscCall(KSP_PCMatApply(ksp, Vj, Wr));
+      PetscCall(MatDenseRestoreSubMatrix(W, &Wr));
+      PetscCall(MatDenseRestoreSubMatrix(V, &Vj));
+      PetscCall(KSPBlockMatMult_Private(ksp, Amat, W, &AW));
+      if (ksp->pc_side == PC_LEFT) {
+        PetscCall(KSP_PCMatApply(ksp, AW, Z));
+        Op   = Z;
+        Work = W;
+      } else {
+        Op   = AW;
+        Work = Z;
+      }
+
+      /* two passes of block classical Gram-Schmidt, the second one also computes the Gram matrix of the new block */
+      k = off[j] + rj;
+      PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, 0, k, &Vk));
+      PetscCall(PetscBLASIntCast(k, &bk));
+      PetscCall(KSPBlockDotLocal_Private(Vk, Op, buf, k));
+      PetscCall(PetscMPIIntCast(k * s, &count));
+      PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+      PetscCall(KSPBlockUpdate_Private(Op, 1.0, -1.0, Vk, buf, k));
+      for (PetscInt c = 0; c < rj; c++)
+        for (PetscInt i = 0; i < k; i++) H[i + (off[j] + c) * ld] = buf[i + c * k];
+      PetscCall(KSPBlockDotLocal_Private(Vk, Op, buf, k));
+      PetscCall(KSPBlockDotLocal_Private(Op, Op, buf + k * s, s));
+      PetscCall(PetscMPIIntCast((k + s) * s, &count));
+      PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, count, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)ksp)));
+      PetscCall(KSPBlockUpdate_Private(Op, 1.0, -1.0, Vk, buf, k));
+      PetscCall(MatDenseRestoreSubMatrix(V, &Vk));
+      for (PetscInt c = 0; c < rj; c++)
+        for (PetscInt i = 0; i < k; i++) H[i + (off[j] + c) * ld] += buf[i + c * k];
+      /* Gram matrix of the projected block */
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bs, &bs, &bk, &mone, buf, &bk, buf, &bk, &one, buf + k * s, &bs));
+      PetscCall(KSPGMRESBlockOrthonormalize_Private(ksp, Op, buf + k * s, V, k, Work, T, S, S2, &rk[j + 1]));
+      PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      off[j + 1] = k;
+      off[j + 2] = k + rk[j + 1];
+      for (PetscInt c = 0; c < rj; c++)
+        for (PetscInt i = 0; i < rk[j + 1]; i++) H[k + i + (off[j] + c) * ld] = S[i + c * s];
+
+      /* apply the reflectors of the previous blocks to the new block column, then triangularize it and update the right-hand side */
+      PetscCall(PetscBLASIntCast(rj, &bn));
+      for (PetscInt i = 0; i < j; i++) {
+        PetscCall(PetscBLASIntCast(off[i + 2] - off[i], &bm));
+        PetscCall(PetscBLASIntCast(rk[i], &bkk));
+        PetscCallBLAS("LAPACKormqr", LAPACKormqr_("L", trans, &bm, &bn, &bkk, H + off[i] + off[i] * ld, &bld, tau + off[i], H + off[i] + off[j] * ld, &bld, work, &blwork, &info));
+        PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in ORMQR Lapack routine %d", (int)info);
+      }
+      PetscCall(PetscBLASIntCast(off[j + 2] - off[j], &bm));
+      PetscCallBLAS("LAPACKgeqrf", LAPACKgeqrf_(&bm, &bn, H + off[j] + off[j] * ld, &bld, tau + off[j], work, &blwork, &info));
+      PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in GEQRF Lapack routine %d", (int)info);
+      PetscCallBLAS("LAPACKormqr", LAPACKormqr_("L", trans, &bm, &bs, &bn, H + off[j] + off[j] * ld, &bld, tau + off[j], Gr + off[j], &bld, work, &blwork, &info));
+      PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in ORMQR Lapack routine %d", (int)info);
+
+      /* the residual of each column is the part of its right-hand side below the triangular factor */
+      for (PetscInt c = 0; c < s; c++) {
+        PetscReal t = 0.0;
+
+        for (PetscInt i = off[j + 1]; i < off[j + 2]; i++) t += PetscRealPart(PetscConj(Gr[i + c * ld]) * Gr[i + c * ld]);
+        nrm[c] = ksp->normtype == KSP_NORM_NONE ? 0.0 : PetscSqrtReal(t);
+      }
+      PetscCall(KSPBlockResidualNorm_Private(s, nrm, PETSC_FALSE, nrm0, &dp));
+      ksp->its++;
+      ksp->rnorm = dp;
+      PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+      if (!ksp->reason && ksp->its >= ksp->max_it) ksp->reason = KSP_DIVERGED_ITS;
+      /* the residual at a restart is monitored at the beginning of the next cycle */
+      if (ksp->reason || (j + 1 < m && rk[j + 1])) {
+        PetscCall(KSPLogResidualHistory(ksp, dp));
+        PetscCall(KSPMonitor(ksp, ksp->its, dp));
+      }
+      if (ksp->reason || !rk[j + 1]) {
+        if (!rk[j + 1]) PetscCall(PetscInfo(ksp, "Detected happy breakdown\n"));
+        j++;
+        break;
+      }
+    }
+
+    /* y <- R^-1 g, left preconditioned x <- x + V y, right preconditioned x <- x + B V y */
+    k = off[j];
+    PetscCall(PetscBLASIntCast(k, &bk));
+    for (PetscInt c = 0; c < s; c++)
+      for (PetscInt i = 0; i < k; i++) y[i + c * k] = Gr[i + c * ld];
+    PetscCallBLAS("LAPACKtrtrs", LAPACKtrtrs_("U", "N", "N", &bk, &bs, H, &bld, y, &bk, &info));
+    PetscCheck(info >= 0, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in TRTRS Lapack routine %d", (int)info);
+    if (info) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Singular block Hessenberg matrix");
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      PetscCall(PetscInfo(ksp, "Diverged due to a singular block Hessenberg matrix\n"));
+      break;
+    }
+    PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, 0, k, &Vk));
+    if (ksp->pc_side == PC_LEFT) PetscCall(KSPBlockUpdate_Private(X, 1.0, 1.0, Vk, y, k));
+    else {
+      PetscCall(KSPBlockUpdate_Private(Z, 0.0, 1.0, Vk, y, k));
+      PetscCall(KSP_PCMatApply(ksp, Z, W));
+      PetscCall(MatAXPY(X, 1.0, W, SAME_NONZERO_PATTERN));
+    }
+    PetscCall(MatDenseRestoreSubMatrix(V, &Vk));
+    if (ksp->reason) break;
+  }
+
+  PetscCall(PetscFree7(T, S, S2, nrm, nrm0, off, rk));
+  PetscCall(PetscFree6(H, Gr, buf, y, tau, work));
+  PetscCall(MatDestroy(&AW));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(MatDestroy(&W));
+  PetscCall(MatDestroy(&V));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode KSPReset_GMRES(KSP ksp)
 {
   KSP_GMRES *gmres = (KSP_GMRES *)ksp->data;
@@ -424,7 +703,7 @@ PetscErrorCode KSPGMRESGetNewVectors(KSP ksp, PetscInt it)
 
   gmres->vv_allocated += nalloc;
 
-  PetscCall(KSPCreateVecs(ksp, nalloc, &gmres->user_work[nwork], 0, NULL));
+  PetscCall(KSPGMRESCreateBasisVecs_Private(ksp, nalloc, &gmres->user_work[nwork]));
 
   gmres->mwork_alloc[nwork] = nalloc;
   for (k = 0; k < nalloc; k++) gmres->vecs[it + VEC_OFFSET + k] = gmres->user_work[nwork][k];
@@ -837,9 +1116,17 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 
    Level: beginner
 
-   Note:
+   Notes:
     Left and right preconditioning are supported, but not symmetric preconditioning.
 
+    For `VECSEQ` and `VECMPI` vectors the Krylov vectors are stored contiguously and `VecMDot()` and `VecMAXPY()` use BLAS gemv on
+    them, use `-vec_mdot_use_gemv false` or `-vec_maxpy_use_gemv false` to get the default kernels of the vector type.
+
+    `KSPMatSolve()` uses block GMRES on all the columns at once, applying the operator with `MatMatMult()` and the preconditioner with
+    `PCMatApply()`. The restart is then a number of blocks of vectors, always orthogonalized with two passes of classical Gram-Schmidt, and
+    the residual norm given to the monitors and the convergence test is the largest one of the columns, each scaled so the relative tolerance
+    applies to it; the Krylov vectors that become linearly dependent are dropped.
+
    Reference:
 .  [1] - YOUCEF SAAD AND MARTIN H. SCHULTZ, GMRES: A GENERALIZED MINIMAL RESIDUAL ALGORITHM FOR SOLVING NONSYMMETRIC LINEAR SYSTEMS.
           SIAM J. ScI. STAT. COMPUT. Vo|. 7, No. 3, July 1986.
@@ -847,7 +1134,8 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 .seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPFGMRES`, `KSPLGMRES`,
           `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`,
           `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
-          `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPSetPCSide()`
+          `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPSetPCSide()`,
+          `KSPMatSolve()`
 M*/
 
 PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
@@ -867,6 +1155,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
   ksp->ops->buildsolution                = KSPBuildSolution_GMRES;
   ksp->ops->setup                        = KSPSetUp_GMRES;
   ksp->ops->solve                        = KSPSolve_GMRES;
+  ksp->ops->matsolve                     = KSPMatSolve_GMRES;
   ksp->ops->reset                        = KSPReset_GMRES;
   ksp->ops->destroy                      = KSPDestroy_GMRES;
   ksp->ops->view                         = KSPView_GMRES;
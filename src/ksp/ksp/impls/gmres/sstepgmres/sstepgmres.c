@@ -0,0 +1,701 @@
+/*
+    This file implements s-step GMRES (a communication avoiding Generalized Minimal Residual method).
+
+    Each block of s Krylov vectors is generated with s applications of the operator, v_{i+1} = (Op v_i - alpha_i v_i - beta_i v_{i-1}) / gamma_i,
+    starting from the last basis vector, without any inner product. The block is then orthogonalized against the basis with
+    block classical Gram-Schmidt and orthonormalized with Cholesky QR, the inner products of both in a single global reduction
+    (optionally a second pass, CholQR2), and the s new columns of the Hessenberg matrix are recovered from the change of basis.
+    The rest, plane rotations, restarts and the construction of the solution, is the same as KSPGMRES.
+
+    Reference: M. Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, UC Berkeley, 2010.
+ */
+
+#include <../src/ksp/ksp/impls/gmres/sstepgmres/sstepgmresimpl.h> /*I  "petscksp.h"  I*/
+#include <petscblaslapack.h>
+
+static PetscErrorCode KSPSSTEPGMRESUpdateHessenberg(KSP, PetscInt, PetscBool, PetscReal *);
+static PetscErrorCode KSPSSTEPGMRESBuildSoln(PetscScalar *, Vec, Vec, KSP, PetscInt);
+
+static PetscErrorCode KSPSetUp_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscInt        s      = sgmres->s, ldc = sgmres->max_k + 1;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSetUp_GMRES(ksp));
+  PetscCall(PetscMalloc5(ldc * s, &sgmres->C, s * s, &sgmres->R, ldc * s, &sgmres->C2, s * s, &sgmres->R2, (ldc + 1) * s, &sgmres->M));
+  PetscCall(PetscMalloc4(s, &sgmres->alpha, s, &sgmres->beta, s, &sgmres->gamma, s, &sgmres->nrm2));
+  if (!sgmres->orthogwork) PetscCall(PetscMalloc1(sgmres->max_k + 2, &sgmres->orthogwork));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   One pass of block classical Gram-Schmidt and Cholesky QR of the s vectors W_i = VEC_VV(it+1+i) against the orthonormal VEC_VV(0..it),
+   W = V C + Q R, with a single global reduction: the Gram matrix of the W - V C is obtained from the one of the W with the Pythagorean
+   theorem. The first rank vectors are replaced by the Q_i, the factorization stops at a vector that is numerically in the span of the
+   previous ones. refine tells if some vector lost more than half of its norm, then a second pass is useful
+*/
+static PetscErrorCode KSPSSTEPGMRESBlockOrthogonalize(KSP ksp, PetscInt it, PetscInt s, PetscScalar *C, PetscScalar *R, PetscInt *rank, PetscBool *refine)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscInt        ldc = sgmres->max_k + 1, lds = sgmres->s;
+  PetscScalar    *work = sgmres->orthogwork;
+  PetscReal      *nrm2 = sgmres->nrm2;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  for (PetscInt i = 0; i < s; i++) {
+    PetscCall(VecMDotBegin(VEC_VV(it + 1 + i), it + 1, &VEC_VV(0), C + i * ldc));
+    PetscCall(VecMDotBegin(VEC_VV(it + 1 + i), i + 1, &VEC_VV(it + 1), R + i * lds));
+  }
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(0))));
+  for (PetscInt i = 0; i < s; i++) {
+    PetscCall(VecMDotEnd(VEC_VV(it + 1 + i), it + 1, &VEC_VV(0), C + i * ldc));
+    PetscCall(VecMDotEnd(VEC_VV(it + 1 + i), i + 1, &VEC_VV(it + 1), R + i * lds));
+  }
+  for (PetscInt i = 0; i < s; i++) {
+    for (PetscInt k = 0; k <= it; k++) KSPCheckDot(ksp, C[k + i * ldc]);
+    for (PetscInt p = 0; p <= i; p++) KSPCheckDot(ksp, R[p + i * lds]);
+  }
+  if (ksp->reason) goto done;
+
+  /* Gram matrix of the components of the W orthogonal to V */
+  for (PetscInt i = 0; i < s; i++) {
+    nrm2[i] = PetscRealPart(R[i + i * lds]);
+    for (PetscInt p = 0; p <= i; p++) {
+      for (PetscInt k = 0; k <= it; k++) R[p + i * lds] -= PetscConj(C[k + p * ldc]) * C[k + i * ldc];
+    }
+  }
+  PetscCall(KSPSStepCholesky_Private(s, R, lds, nrm2, 1.e3 * PETSC_MACHINE_EPSILON, rank));
+  *refine = PETSC_FALSE;
+  for (PetscInt i = 0; i < *rank; i++) {
+    if (PetscRealPart(R[i + i * lds] * R[i + i * lds]) < 0.5 * nrm2[i]) *refine = PETSC_TRUE;
+  }
+
+  /* Q_i = (W_i - V C_i - sum_{p<i} Q_p R(p,i)) / R(i,i), with the Q_p stored in place of the W_p right after V */
+  for (PetscInt i = 0; i < *rank; i++) {
+    for (PetscInt k = 0; k <= it; k++) work[k] = -C[k + i * ldc];
+    for (PetscInt p = 0; p < i; p++) work[it + 1 + p] = -R[p + i * lds];
+    PetscCall(VecMAXPY(VEC_VV(it + 1 + i), it + 1 + i, work, &VEC_VV(0)));
+    PetscCall(VecScale(VEC_VV(it + 1 + i), 1.0 / R[i + i * lds]));
+  }
+done:
+  PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   A single Arnoldi step, for a block whose first vector is numerically in the span of the basis. On entry Op VEC_VV(it) is
+   gamma_0 (V cw + sw VEC_VV(it+1)) + alpha_0 VEC_VV(it), cw being NULL when it is zero
+*/
+static PetscErrorCode KSPSSTEPGMRESArnoldiStep(KSP ksp, PetscInt it, const PetscScalar cw[], PetscReal sw)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscReal       tt;
+
+  PetscFunctionBegin;
+  PetscCall((*sgmres->orthog)(ksp, it));
+  if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+  KSPCheckNorm(ksp, tt);
+  for (PetscInt k = 0; k <= it; k++) {
+    *HH(k, it) = sgmres->gamma[0] * (sw * *HH(k, it) + (cw ? cw[k] : 0.0));
+    if (k == it) *HH(k, it) += sgmres->alpha[0];
+    *HES(k, it) = *HH(k, it);
+  }
+  *HH(it + 1, it)  = sgmres->gamma[0] * sw * tt;
+  *HES(it + 1, it) = *HH(it + 1, it);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Generates the block of s vectors following VEC_VV(it), orthonormalizes it, and computes the corresponding columns it, ..., it+ncols-1
+   of the Hessenberg matrix; ncols is smaller than s when the block is numerically rank deficient.
+
+   With the vectors K = [VEC_VV(it), W_1, ..., W_s] of the block and the change of basis matrix B, Op K(:,0:s-1) = K B. The
+   orthogonalization gives K = V Z with Z(:,0) = e_it and Z(:,i) = [C(:,i-1); R(:,i-1)], and Op V(:,0:it-1) = V(:,0:it) H_old, hence
+   Op V(:,it:it+s-1) T = V (Z B - H_old X) where X = Z(0:it-1,0:s-1) and T = Z(it:it+s-1,0:s-1) is upper triangular
+*/
+static PetscErrorCode KSPSSTEPGMRESBlock(KSP ksp, PetscInt it, PetscInt s, PetscInt *ncols)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscInt        ldc = sgmres->max_k + 1, lds = sgmres->s, ldm = sgmres->max_k + 2, rank, rank2;
+  PetscScalar    *C = sgmres->C, *R = sgmres->R, *M = sgmres->M;
+  PetscReal      *alpha = sgmres->alpha, *beta = sgmres->beta, *gamma = sgmres->gamma;
+  PetscBool       refine;
+
+  PetscFunctionBegin;
+  *ncols = 0;
+  for (PetscInt i = 0; i < s; i++) {
+    PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(it + i), VEC_VV(it + i + 1), VEC_TEMP_MATOP));
+    if (alpha[i] != 0.0 || beta[i] != 0.0 || gamma[i] != 1.0) {
+      if (i) PetscCall(VecAXPBYPCZ(VEC_VV(it + i + 1), -alpha[i] / gamma[i], -beta[i] / gamma[i], 1.0 / gamma[i], VEC_VV(it + i), VEC_VV(it + i - 1)));
+      else PetscCall(VecAXPBY(VEC_VV(it + 1), -alpha[0] / gamma[0], 1.0 / gamma[0], VEC_VV(it)));
+    }
+  }
+
+  PetscCall(KSPSSTEPGMRESBlockOrthogonalize(ksp, it, s, C, R, &rank, &refine));
+  if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!rank) {
+    PetscCall(PetscInfo(ksp, "First vector of the block at iteration %" PetscInt_FMT " is in the span of the basis, doing an Arnoldi step\n", it));
+    PetscCall(KSPSSTEPGMRESArnoldiStep(ksp, it, NULL, 1.0));
+    *ncols = 1;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (sgmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS || (sgmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED && refine)) {
+    PetscScalar *C2 = sgmres->C2, *R2 = sgmres->R2;
+
+    PetscCall(KSPSSTEPGMRESBlockOrthogonalize(ksp, it, rank, C2, R2, &rank2, &refine));
+    if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+    if (!rank2) {
+      PetscCall(PetscInfo(ksp, "First vector of the block at iteration %" PetscInt_FMT " is in the span of the basis after reorthogonalization, doing an Arnoldi step\n", it));
+      PetscCall(KSPSSTEPGMRESArnoldiStep(ksp, it, C, PetscRealPart(R[0])));
+      *ncols = 1;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    /* W = V (C + C2 R) + Q (R2 R) */
+    for (PetscInt i = 0; i < rank2; i++) {
+      for (PetscInt p = 0; p <= i; p++) {
+        for (PetscInt k = 0; k <= it; k++) C[k + i * ldc] += C2[k + p * ldc] * R[p + i * lds];
+      }
+      for (PetscInt q = 0; q <= i; q++) {
+        PetscScalar t = 0.0;
+
+        for (PetscInt p = q; p <= i; p++) t += R2[q + p * lds] * R[p + i * lds];
+        R[q + i * lds] = t;
+      }
+    }
+    rank = rank2;
+  }
+  if (rank < s) PetscCall(PetscInfo(ksp, "Block at iteration %" PetscInt_FMT " is numerically rank deficient, using %" PetscInt_FMT " of its %" PetscInt_FMT " vectors\n", it, rank, s));
+
+  /* M = Z B - H_old X, column c only has entries in the rows 0, ..., it+c+1 */
+  for (PetscInt c = 0; c < rank; c++) {
+    PetscScalar *m = M + c * ldm;
+
+    for (PetscInt r = 0; r <= it + c + 1; r++) m[r] = 0.0;
+    for (PetscInt j = PetscMax(c - 1, 0); j <= c + 1; j++) {
+      PetscReal f = j == c ? alpha[c] : (j == c + 1 ? gamma[c] : beta[c]);
+
+      if (!j) m[it] += f;
+      else {
+        for (PetscInt k = 0; k <= it; k++) m[k] += f * C[k + (j - 1) * ldc];
+        for (PetscInt p = 0; p < j; p++) m[it + 1 + p] += f * R[p + (j - 1) * lds];
+      }
+    }
+    if (c) {
+      for (PetscInt k = 0; k < it; k++) {
+        for (PetscInt r = 0; r <= k + 1; r++) m[r] -= *HES(r, k) * C[k + (c - 1) * ldc];
+      }
+    }
+  }
+  /* the new columns of the Hessenberg matrix are M T^{-1} */
+  for (PetscInt c = 0; c < rank; c++) {
+    PetscScalar *m = M + c * ldm;
+
+    for (PetscInt p = 0; p < c; p++) {
+      PetscScalar t = p ? R[(p - 1) + (c - 1) * lds] : C[it + (c - 1) * ldc];
+
+      for (PetscInt r = 0; r <= it + p + 1; r++) m[r] -= M[r + p * ldm] * t;
+    }
+    if (c) {
+      for (PetscInt r = 0; r <= it + c + 1; r++) m[r] /= R[(c - 1) + (c - 1) * lds];
+    }
+    for (PetscInt r = 0; r <= it + c + 1; r++) *HH(r, it + c) = *HES(r, it + c) = m[r];
+  }
+  *ncols = rank;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Replaces the recurrence of the basis by one built from the Ritz values, the eigenvalues of the leading n x n block of the Hessenberg matrix
+*/
+static PetscErrorCode KSPSSTEPGMRESComputeBasis(KSP ksp, PetscInt n)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscScalar    *H, *work, sdummy = 0;
+  PetscReal      *re;
+  PetscBLASInt    bn, lwork, idummy = 1, lierr;
+#if defined(PETSC_USE_COMPLEX)
+  PetscScalar *eigs;
+  PetscReal   *rwork;
+#else
+  PetscReal *im;
+#endif
+
+  PetscFunctionBegin;
+  sgmres->ritz = PETSC_TRUE;
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscBLASIntCast(5 * n, &lwork));
+  PetscCall(PetscMalloc3(n * n, &H, 5 * n, &work, n, &re));
+  for (PetscInt c = 0; c < n; c++) {
+    for (PetscInt r = 0; r < n; r++) H[r + c * n] = *HES(r, c);
+  }
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc2(n, &eigs, 2 * n, &rwork));
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bn, H, &bn, eigs, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, rwork, &lierr));
+  for (PetscInt i = 0; i < n; i++) re[i] = PetscRealPart(eigs[i]);
+  PetscCall(PetscFree2(eigs, rwork));
+#else
+  PetscCall(PetscMalloc1(n, &im));
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bn, H, &bn, re, im, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, &lierr));
+  PetscCall(PetscFree(im));
+#endif
+  PetscCall(PetscFPTrapPop());
+  if (lierr) PetscCall(PetscInfo(ksp, "Error %d in LAPACK routine computing the Ritz values, keeping the monomial basis\n", (int)lierr));
+  else {
+    PetscCall(KSPSStepBasisCoefficients_Private(sgmres->basistype, n, re, sgmres->s, sgmres->alpha, sgmres->beta, sgmres->gamma));
+    PetscCall(PetscInfo(ksp, "%s basis of the blocks computed from %" PetscInt_FMT " Ritz values\n", KSPSStepBasisTypes[sgmres->basistype], n));
+  }
+  PetscCall(PetscFree3(H, work, re));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Run s-step gmres, possibly with restart, see KSPGMRESCycle() for the details that are the same.
+
+   On entry, the value in vector VEC_VV(0) should be the initial residual.
+ */
+static PetscErrorCode KSPSSTEPGMRESCycle(PetscInt *itcount, KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)(ksp->data);
+  PetscReal       res, hapbnd, tt;
+  PetscInt        it = 0, max_k = sgmres->max_k;
+  PetscBool       hapend = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  PetscCall(VecNormalize(VEC_VV(0), &res));
+  KSPCheckNorm(ksp, res);
+
+  /* the constant .1 is arbitrary, just some measure at how incorrect the residuals are */
+  if ((ksp->rnorm > 0.0) && (PetscAbsReal(res - ksp->rnorm) > sgmres->breakdowntol * sgmres->rnorm0)) {
+    PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Residual norm computed by GMRES recursion formula %g is far from the computed residual norm %g at restart, residual norm at start of cycle %g",
+               (double)ksp->rnorm, (double)res, (double)sgmres->rnorm0);
+    PetscCall(PetscInfo(ksp, "Residual norm computed by GMRES recursion formula %g is far from the computed residual norm %g at restart, residual norm at start of cycle %g\n", (double)ksp->rnorm, (double)res, (double)sgmres->rnorm0));
+    ksp->reason = KSP_DIVERGED_BREAKDOWN;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *GRS(0) = sgmres->rnorm0 = res;
+
+  /* check for the convergence */
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->rnorm = res;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  sgmres->it = (it - 1);
+  PetscCall(KSPLogResidualHistory(ksp, res));
+  PetscCall(KSPLogErrorHistory(ksp));
+  PetscCall(KSPMonitor(ksp, ksp->its, res));
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    PetscCall(PetscInfo(ksp, "Converged due to zero residual norm on entry\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    PetscInt s = PetscMin(sgmres->s, PetscMin(max_k - it, ksp->max_it - ksp->its)), ncols;
+
+    while (sgmres->vv_allocated <= it + s + VEC_OFFSET) PetscCall(KSPGMRESGetNewVectors(ksp, sgmres->vv_allocated - VEC_OFFSET));
+    PetscCall(KSPSSTEPGMRESBlock(ksp, it, s, &ncols));
+    if (ksp->reason) break;
+    if (!sgmres->ritz && sgmres->basistype != KSP_SSTEP_BASIS_MONOMIAL) PetscCall(KSPSSTEPGMRESComputeBasis(ksp, it + ncols));
+
+    /* the plane rotations and the convergence test are done one column at a time as in KSPGMRES */
+    for (PetscInt c = 0; c < ncols; c++) {
+      if (it) {
+        PetscCall(KSPLogResidualHistory(ksp, res));
+        PetscCall(KSPLogErrorHistory(ksp));
+        PetscCall(KSPMonitor(ksp, ksp->its, res));
+      }
+      sgmres->it = (it - 1);
+
+      /* check for the happy breakdown */
+      tt     = PetscAbsScalar(*HH(it + 1, it));
+      hapbnd = PetscAbsScalar(tt / *GRS(it));
+      if (hapbnd > sgmres->haptol) hapbnd = sgmres->haptol;
+      if (tt < hapbnd) {
+        PetscCall(PetscInfo(ksp, "Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n", (double)hapbnd, (double)tt));
+        hapend = PETSC_TRUE;
+      }
+      PetscCall(KSPSSTEPGMRESUpdateHessenberg(ksp, it, hapend, &res));
+
+      it++;
+      sgmres->it = (it - 1); /* For converged */
+      ksp->its++;
+      ksp->rnorm = res;
+      if (ksp->reason) break;
+
+      PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+
+      /* Catch error in happy breakdown and signal convergence and break from loop */
+      if (hapend) {
+        if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+          ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+        } else if (!ksp->reason) {
+          PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Reached happy break down, but convergence was not indicated. Residual norm = %g", (double)res);
+          ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        }
+      }
+      if (ksp->reason) break;
+    }
+  }
+
+  /* Monitor if we know that we will not return for a restart */
+  if (it && (ksp->reason || ksp->its >= ksp->max_it)) {
+    PetscCall(KSPLogResidualHistory(ksp, res));
+    PetscCall(KSPLogErrorHistory(ksp));
+    PetscCall(KSPMonitor(ksp, ksp->its, res));
+  }
+
+  if (itcount) *itcount = it;
+
+  /* Form the solution (or the solution so far) */
+  PetscCall(KSPSSTEPGMRESBuildSoln(GRS(0), ksp->vec_sol, ksp->vec_sol, ksp, it - 1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_SSTEPGMRES(KSP ksp)
+{
+  PetscInt        its, itcount;
+  KSP_SSTEPGMRES *sgmres     = (KSP_SSTEPGMRES *)ksp->data;
+  PetscBool       guess_zero = ksp->guess_zero;
+
+  PetscFunctionBegin;
+  PetscCheck(!ksp->calc_sings || sgmres->Rsvd, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ORDER, "Must call KSPSetComputeSingularValues() before KSPSetUp() is called");
+
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its = 0;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+
+  /* the first block of each solve uses the monomial basis, its Ritz values give the basis of the next ones */
+  PetscCall(KSPSStepBasisCoefficients_Private(KSP_SSTEP_BASIS_MONOMIAL, 0, NULL, sgmres->s, sgmres->alpha, sgmres->beta, sgmres->gamma));
+  sgmres->ritz = PETSC_FALSE;
+
+  itcount           = 0;
+  sgmres->fullcycle = 0;
+  ksp->rnorm        = -1.0; /* special marker for KSPSSTEPGMRESCycle() */
+  while (!ksp->reason || (ksp->rnorm == -1 && ksp->reason == KSP_DIVERGED_PC_FAILED)) {
+    PetscCall(KSPInitialResidual(ksp, ksp->vec_sol, VEC_TEMP, VEC_TEMP_MATOP, VEC_VV(0), ksp->vec_rhs));
+    PetscCall(KSPSSTEPGMRESCycle(&its, ksp));
+    if (its == sgmres->max_k) sgmres->fullcycle++;
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree5(sgmres->C, sgmres->R, sgmres->C2, sgmres->R2, sgmres->M));
+  PetscCall(PetscFree4(sgmres->alpha, sgmres->beta, sgmres->gamma, sgmres->nrm2));
+  PetscCall(KSPReset_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPGMRES(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_SSTEPGMRES(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetBasisType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetBasisType_C", NULL));
+  PetscCall(KSPDestroy_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    KSPSSTEPGMRESBuildSoln - create the solution from the starting vector and the current iterates, see KSPGMRESBuildSoln()
+ */
+static PetscErrorCode KSPSSTEPGMRESBuildSoln(PetscScalar *nrs, Vec vs, Vec vdest, KSP ksp, PetscInt it)
+{
+  PetscScalar     tt;
+  PetscInt        ii, k, j;
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)(ksp->data);
+
+  PetscFunctionBegin;
+  /* If it is < 0, no gmres steps have been performed */
+  if (it < 0) {
+    PetscCall(VecCopy(vs, vdest)); /* VecCopy() is smart, exists immediately if vguess == vdest */
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (*HH(it, it) != 0.0) {
+    nrs[it] = *GRS(it) / *HH(it, it);
+  } else {
+    PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "You reached the break down in GMRES; HH(it,it) = 0");
+    ksp->reason = KSP_DIVERGED_BREAKDOWN;
+
+    PetscCall(PetscInfo(ksp, "Likely your matrix or preconditioner is singular. HH(it,it) is identically zero; it = %" PetscInt_FMT " GRS(it) = %g\n", it, (double)PetscAbsScalar(*GRS(it))));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (ii = 1; ii <= it; ii++) {
+    k  = it - ii;
+    tt = *GRS(k);
+    for (j = k + 1; j <= it; j++) tt = tt - *HH(k, j) * nrs[j];
+    if (*HH(k, k) == 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %" PetscInt_FMT, k);
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      PetscCall(PetscInfo(ksp, "Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %" PetscInt_FMT "\n", k));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    nrs[k] = tt / *HH(k, k);
+  }
+
+  /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
+  PetscCall(VecMAXPBY(VEC_TEMP, it + 1, nrs, 0, &VEC_VV(0)));
+
+  PetscCall(KSPUnwindPreconditioner(ksp, VEC_TEMP, VEC_TEMP_MATOP));
+  /* add solution to previous solution */
+  if (vdest != vs) PetscCall(VecCopy(vs, vdest));
+  PetscCall(VecAXPY(vdest, 1.0, VEC_TEMP));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Do the scalar work for the orthogonalization.  Return new residual norm.
+ */
+static PetscErrorCode KSPSSTEPGMRESUpdateHessenberg(KSP ksp, PetscInt it, PetscBool hapend, PetscReal *res)
+{
+  PetscScalar    *hh, *cc, *ss, tt;
+  PetscInt        j;
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)(ksp->data);
+
+  PetscFunctionBegin;
+  hh = HH(0, it);
+  cc = CC(0);
+  ss = SS(0);
+
+  /* Apply all the previously computed plane rotations to the new column of the Hessenberg matrix */
+  for (j = 1; j <= it; j++) {
+    tt  = *hh;
+    *hh = PetscConj(*cc) * tt + *ss * *(hh + 1);
+    hh++;
+    *hh = *cc++ * *hh - (*ss++ * tt);
+  }
+
+  /*
+    compute the new plane rotation, and apply it to:
+     1) the right-hand-side of the Hessenberg system
+     2) the new column of the Hessenberg matrix
+    thus obtaining the updated value of the residual
+  */
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(*hh) * *hh + PetscConj(*(hh + 1)) * *(hh + 1));
+    if (tt == 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "tt == 0.0");
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    *cc          = *hh / tt;
+    *ss          = *(hh + 1) / tt;
+    *GRS(it + 1) = -(*ss * *GRS(it));
+    *GRS(it)     = PetscConj(*cc) * *GRS(it);
+    *hh          = PetscConj(*cc) * *hh + *ss * *(hh + 1);
+    *res         = PetscAbsScalar(*GRS(it + 1));
+  } else {
+    /* happy breakdown: HH(it+1, it) = 0, therefore we don't need to apply another rotation matrix (so RH doesn't change) */
+    *res = 0.0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPBuildSolution_SSTEPGMRES(KSP ksp, Vec ptr, Vec *result)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!sgmres->sol_temp) PetscCall(VecDuplicate(ksp->vec_sol, &sgmres->sol_temp));
+    ptr = sgmres->sol_temp;
+  }
+  if (!sgmres->nrs) {
+    /* allocate the work area */
+    PetscCall(PetscMalloc1(sgmres->max_k, &sgmres->nrs));
+  }
+
+  PetscCall(KSPSSTEPGMRESBuildSoln(sgmres->nrs, ksp->vec_sol, ptr, ksp, sgmres->it));
+  if (result) *result = ptr;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_SSTEPGMRES(KSP ksp, PetscViewer viewer)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  const char     *cstr;
+  PetscBool       iascii, isstring;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERSTRING, &isstring));
+  switch (sgmres->cgstype) {
+  case (KSP_GMRES_CGS_REFINE_NEVER):
+    cstr = "block classical Gram-Schmidt and Cholesky QR";
+    break;
+  case (KSP_GMRES_CGS_REFINE_ALWAYS):
+    cstr = "block classical Gram-Schmidt and Cholesky QR, twice";
+    break;
+  case (KSP_GMRES_CGS_REFINE_IFNEEDED):
+    cstr = "block classical Gram-Schmidt and Cholesky QR, twice when needed";
+    break;
+  default:
+    SETERRQ(PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Unknown orthogonalization");
+  }
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  restart=%" PetscInt_FMT ", blocks of s=%" PetscInt_FMT " vectors in the %s basis, using %s\n", sgmres->max_k, sgmres->s, KSPSStepBasisTypes[sgmres->basistype], cstr));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  happy breakdown tolerance %g\n", (double)sgmres->haptol));
+  } else if (isstring) {
+    PetscCall(PetscViewerStringSPrintf(viewer, "%s restart %" PetscInt_FMT " s %" PetscInt_FMT, cstr, sgmres->max_k, sgmres->s));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPGMRES(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_SSTEPGMRES   *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+  PetscInt          s;
+  KSPSStepBasisType type;
+  PetscBool         flg;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSetFromOptions_GMRES(ksp, PetscOptionsObject));
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP s-step GMRES Options");
+  PetscCall(PetscOptionsInt("-ksp_sstep_size", "Number of Krylov vectors generated and orthogonalized together", "KSPSStepSetStepSize", sgmres->s, &s, &flg));
+  if (flg) PetscCall(KSPSStepSetStepSize(ksp, s));
+  PetscCall(PetscOptionsEnum("-ksp_sstep_basis_type", "Polynomial basis of the blocks of Krylov vectors", "KSPSStepSetBasisType", KSPSStepBasisTypes, (PetscEnum)sgmres->basistype, (PetscEnum *)&type, &flg));
+  if (flg) PetscCall(KSPSStepSetBasisType(ksp, type));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepSetStepSize_SSTEPGMRES(KSP ksp, PetscInt s)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(s >= 1, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Step size must be positive");
+  if (!ksp->setupstage) {
+    sgmres->s = s;
+  } else if (sgmres->s != s) {
+    sgmres->s       = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+    /* free the data structures, then create them again */
+    PetscCall(KSPReset_SSTEPGMRES(ksp));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepGetStepSize_SSTEPGMRES(KSP ksp, PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_SSTEPGMRES *)ksp->data)->s;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepSetBasisType_SSTEPGMRES(KSP ksp, KSPSStepBasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_SSTEPGMRES *)ksp->data)->basistype = type;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSStepGetBasisType_SSTEPGMRES(KSP ksp, KSPSStepBasisType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_SSTEPGMRES *)ksp->data)->basistype;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+     KSPSSTEPGMRES - Implements the s-step (communication avoiding) Generalized Minimal Residual method with restart
+
+   Options Database Keys:
++   -ksp_gmres_restart <restart> - the number of Krylov directions to orthogonalize against
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_gmres_preallocate - preallocate all the Krylov search directions initially (otherwise groups of vectors are allocated as needed)
+.   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - whether the block orthogonalization is done a second time (CholQR2)
+.   -ksp_sstep_size <s> - the number of Krylov vectors generated and orthogonalized together
+-   -ksp_sstep_basis_type <monomial,newton,chebyshev> - the polynomial basis in which the blocks are generated
+
+   Level: intermediate
+
+   Notes:
+   Each block of s Krylov vectors is generated with s applications of the operator and no inner product, then orthogonalized against
+   the previous ones and orthonormalized with block classical Gram-Schmidt and Cholesky QR, all the inner products being computed in a single
+   global reduction, or two if the orthogonalization is done twice. This replaces the 2 s or 3 s global reductions of s iterations of `KSPGMRES`,
+   which dominate on many processes, at the price of a less stable orthogonalization; for large s the blocks become ill-conditioned, which
+   the Newton or Chebyshev basis delay, see `KSPSStepSetBasisType()`. The residual norms and the iterates are the same as those of `KSPGMRES`
+   in exact arithmetic, and the convergence test is still done at every iteration.
+
+   A block that is numerically rank deficient is shortened; when its first vector is in the span of the previous ones a regular Arnoldi
+   step, with the orthogonalization set by `KSPGMRESSetOrthogonalization()`, is done instead.
+
+   Left and right preconditioning are supported, but not symmetric preconditioning.
+
+   References:
++  * - M. Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, University of California, Berkeley, 2010.
+-  * - T. Fukaya, Y. Nakatsukasa, Y. Yanagisawa, Y. Yamamoto, CholeskyQR2: a simple and communication-avoiding algorithm for computing a tall-skinny QR factorization on a large-scale parallel system, 2014.
+
+   Developer Note:
+   This object is subclassed off of `KSPGMRES`, see the source code in src/ksp/ksp/impls/gmres for comments on the structure of the code
+
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPGMRES`, `KSPPGMRES`, `KSPSSTEPCG`, `KSPSStepSetStepSize()`, `KSPSStepSetBasisType()`,
+          `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESSetCGSRefinementType()`
+M*/
+
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&sgmres));
+  ksp->data = (void *)sgmres;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_RIGHT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_RIGHT, 1));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+
+  ksp->ops->buildsolution                = KSPBuildSolution_SSTEPGMRES;
+  ksp->ops->setup                        = KSPSetUp_SSTEPGMRES;
+  ksp->ops->solve                        = KSPSolve_SSTEPGMRES;
+  ksp->ops->reset                        = KSPReset_SSTEPGMRES;
+  ksp->ops->destroy                      = KSPDestroy_SSTEPGMRES;
+  ksp->ops->view                         = KSPView_SSTEPGMRES;
+  ksp->ops->setfromoptions               = KSPSetFromOptions_SSTEPGMRES;
+  ksp->ops->computeextremesingularvalues = KSPComputeExtremeSingularValues_GMRES;
+  ksp->ops->computeeigenvalues           = KSPComputeEigenvalues_GMRES;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetPreAllocateVectors_C", KSPGMRESSetPreAllocateVectors_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetOrthogonalization_C", KSPGMRESSetOrthogonalization_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetOrthogonalization_C", KSPGMRESGetOrthogonalization_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetRestart_C", KSPGMRESSetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetRestart_C", KSPGMRESGetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetHapTol_C", KSPGMRESSetHapTol_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetCGSRefinementType_C", KSPGMRESSetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetCGSRefinementType_C", KSPGMRESGetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetStepSize_C", KSPSStepSetStepSize_SSTEPGMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetStepSize_C", KSPSStepGetStepSize_SSTEPGMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepSetBasisType_C", KSPSStepSetBasisType_SSTEPGMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPSStepGetBasisType_C", KSPSStepGetBasisType_SSTEPGMRES));
+
+  sgmres->haptol         = 1.0e-30;
+  sgmres->breakdowntol   = 0.1;
+  sgmres->q_preallocate  = 0;
+  sgmres->delta_allocate = SSTEPGMRES_DELTA_DIRECTIONS;
+  sgmres->orthog         = KSPGMRESClassicalGramSchmidtOrthogonalization;
+  sgmres->max_k          = SSTEPGMRES_DEFAULT_MAXK;
+  sgmres->cgstype        = KSP_GMRES_CGS_REFINE_IFNEEDED;
+  sgmres->s              = SSTEPGMRES_DEFAULT_S;
+  sgmres->basistype      = KSP_SSTEP_BASIS_NEWTON;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
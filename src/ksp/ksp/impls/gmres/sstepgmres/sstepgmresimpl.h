@@ -0,0 +1,34 @@
+#pragma once
+
+#define KSPGMRES_NO_MACROS
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+typedef struct {
+  KSPGMRESHEADER
+  PetscInt          s;                    /* number of Krylov vectors generated and orthogonalized together */
+  KSPSStepBasisType basistype;            /* polynomial basis of the blocks */
+  PetscReal        *alpha, *beta, *gamma; /* recurrence of the basis, see KSPSStepBasisCoefficients_Private() */
+  PetscBool         ritz;                 /* the recurrence has been computed from Ritz values in this solve */
+  PetscScalar      *C, *R;                /* block Gram-Schmidt coefficients and Cholesky factor of the block */
+  PetscScalar      *C2, *R2;              /* the same for the second pass, if any */
+  PetscScalar      *M;                    /* the new columns of the Hessenberg matrix */
+  PetscReal        *nrm2;                 /* squared norms of the block vectors before the Cholesky QR */
+} KSP_SSTEPGMRES;
+
+#define HH(a, b) (sgmres->hh_origin + (b) * (sgmres->max_k + 2) + (a))
+/* HH will be size (max_k+2)*(max_k+1)  -  think of HH as being stored columnwise for access purposes. */
+#define HES(a, b) (sgmres->hes_origin + (b) * (sgmres->max_k + 1) + (a))
+/* HES will be size (max_k + 1) * (max_k + 1) -  again, think of HES as being stored columnwise */
+#define CC(a)  (sgmres->cc_origin + (a)) /* CC will be length (max_k+1) - cosines */
+#define SS(a)  (sgmres->ss_origin + (a)) /* SS will be length (max_k+1) - sines */
+#define GRS(a) (sgmres->rs_origin + (a)) /* GRS will be length (max_k+2) - rt side */
+
+/* vector names */
+#define VEC_OFFSET     2
+#define VEC_TEMP       sgmres->vecs[0]              /* work space */
+#define VEC_TEMP_MATOP sgmres->vecs[1]              /* work space */
+#define VEC_VV(i)      sgmres->vecs[VEC_OFFSET + i] /* use to access othog basis vectors */
+
+#define SSTEPGMRES_DELTA_DIRECTIONS 10
+#define SSTEPGMRES_DEFAULT_MAXK     30
+#define SSTEPGMRES_DEFAULT_S        5
@@ -1270,10 +1270,13 @@ static PetscErrorCode KSPMatSolve_Private(KSP ksp, Mat B, Mat X)
 
   Level: intermediate
 
-  Note:
+  Notes:
   This is a stripped-down version of `KSPSolve()`, which only handles `-ksp_view`, `-ksp_converged_reason`, `-ksp_converged_rate`, and `-ksp_view_final_residual`.
 
-.seealso: [](ch_ksp), `KSPSolve()`, `MatMatSolve()`, `KSPMatSolveTranspose()`, `MATDENSE`, `KSPHPDDM`, `PCBJACOBI`, `PCASM`
+  `KSPPREONLY`, `KSPCG`, `KSPGMRES`, and `KSPHPDDM` solve for all the columns at once, with block Krylov methods for `KSPCG` and `KSPGMRES`, the other
+  types solve for one column at a time. `KSPSetMatSolveBatchSize()` limits the number of columns solved for at once.
+
+.seealso: [](ch_ksp), `KSPSolve()`, `MatMatSolve()`, `KSPMatSolveTranspose()`, `MATDENSE`, `KSPHPDDM`, `KSPCG`, `KSPGMRES`, `PCBJACOBI`, `PCASM`
 @*/
 PetscErrorCode KSPMatSolve(KSP ksp, Mat B, Mat X)
 {
@@ -0,0 +1,121 @@
+static char help[] = "Tests the block methods of KSPMatSolve() and KSPMatSolveTranspose() for KSPCG and KSPGMRES on a 2D Laplacian.\n\n\
+  -n <n>       : number of grid points in each direction\n\
+  -nrhs <nrhs> : number of right-hand sides\n\
+  -dup         : makes the last right-hand side a copy of the first one\n\
+  -nonsym      : adds a convection term, for KSPGMRES\n\
+  -transpose   : solves with the transposed operator\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **argv)
+{
+  Mat                A, B, X, R;
+  KSP                ksp;
+  PetscRandom        rnd;
+  PetscInt           n = 12, nrhs = 6, Istart, Iend, N;
+  PetscReal         *bnorm, *rnorm, rtol, err = 0.0;
+  PetscBool          dup = PETSC_FALSE, nonsym = PETSC_FALSE, transpose = PETSC_FALSE;
+  KSPConvergedReason reason;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nrhs", &nrhs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-dup", &dup, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-nonsym", &nonsym, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-transpose", &transpose, NULL));
+
+  N = n * n;
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, N, N, 5, NULL, 5, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt row = Istart; row < Iend; row++) {
+    PetscInt    i = row / n, j = row % n;
+    PetscScalar c = nonsym ? 0.4 : 0.0;
+
+    if (i > 0) PetscCall(MatSetValue(A, row, row - n, -1.0 - c, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, row, row + n, -1.0 + c, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, row, row - 1, -1.0 - c, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, row, row + 1, -1.0 + c, INSERT_VALUES));
+    PetscCall(MatSetValue(A, row, row, 4.0 + 0.01 * (row % 7), INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  /* random right-hand sides of very different norms */
+  PetscCall(MatCreateDense(PETSC_COMM_WORLD, Iend - Istart, PETSC_DECIDE, N, nrhs, NULL, &B));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+  PetscCall(MatSetRandom(B, rnd));
+  for (PetscInt k = 0; k < nrhs; k++) {
+    Vec b;
+
+    PetscCall(MatDenseGetColumnVecWrite(B, k, &b));
+    PetscCall(VecScale(b, PetscPowReal(10.0, (PetscReal)(k % 3) - 1)));
+    PetscCall(MatDenseRestoreColumnVecWrite(B, k, &b));
+  }
+  if (dup) {
+    PetscScalar *b;
+    PetscInt     lda;
+
+    PetscCall(MatDenseGetLDA(B, &lda));
+    PetscCall(MatDenseGetArray(B, &b));
+    PetscCall(PetscArraycpy(b + (nrhs - 1) * lda, b, Iend - Istart));
+    PetscCall(MatDenseRestoreArray(B, &b));
+  }
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &X));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetTolerances(ksp, 1e-8, PETSC_DEFAULT, PETSC_DEFAULT, 1000));
+  PetscCall(KSPSetFromOptions(ksp));
+  if (!transpose) PetscCall(KSPMatSolve(ksp, B, X));
+  else PetscCall(KSPMatSolveTranspose(ksp, B, X));
+  PetscCall(KSPGetConvergedReason(ksp, &reason));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Block solve converged: %s\n", reason > 0 ? "yes" : KSPConvergedReasons[reason]));
+
+  /* every column of the unpreconditioned residual must be small relative to its right-hand side */
+  PetscCall(KSPGetTolerances(ksp, &rtol, NULL, NULL, NULL));
+  if (!transpose) PetscCall(MatMatMult(A, X, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &R));
+  else PetscCall(MatTransposeMatMult(A, X, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &R));
+  PetscCall(MatAXPY(R, -1.0, B, SAME_NONZERO_PATTERN));
+  PetscCall(PetscMalloc2(nrhs, &bnorm, nrhs, &rnorm));
+  PetscCall(MatGetColumnNorms(B, NORM_2, bnorm));
+  PetscCall(MatGetColumnNorms(R, NORM_2, rnorm));
+  for (PetscInt k = 0; k < nrhs; k++) err = PetscMax(err, rnorm[k] / bnorm[k]);
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative residuals of the columns: %s\n", err < 10 * rtol ? "ok" : "too large"));
+  PetscCall(PetscInfo(ksp, "Largest relative residual of a column %g\n", (double)err));
+
+  PetscCall(PetscFree2(bnorm, rnorm));
+  PetscCall(MatDestroy(&R));
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(MatDestroy(&X));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 2}}
+      output_file: output/ex85_1.out
+
+      test:
+         suffix: cg
+         args: -ksp_type cg -pc_type {{none jacobi}} -ksp_norm_type {{preconditioned unpreconditioned natural}} -dup {{0 1}}
+
+      test:
+         suffix: gmres
+         args: -ksp_type gmres -ksp_gmres_restart 4 -nonsym -pc_type jacobi -ksp_pc_side {{left right}} -dup {{0 1}}
+
+      test:
+         suffix: gmres_transpose
+         args: -ksp_type gmres -ksp_gmres_restart 4 -nonsym -pc_type none -transpose
+
+      test:
+         suffix: batch
+         args: -ksp_type {{cg gmres}} -pc_type jacobi -ksp_matsolve_batch_size 4
+
+TEST*/
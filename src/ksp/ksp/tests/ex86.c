@@ -0,0 +1,108 @@
+static char help[] = "Solves a sequence of slowly changing convection-diffusion problems with the same KSP, to test the recycling of KSPGCRODR.\n\n\
+  -n <n>           : number of grid points in each direction\n\
+  -nsteps <nsteps> : number of linear systems in the sequence\n\
+  -same            : keeps the same operator for all the systems, only the right-hand side changes\n\n";
+
+#include <petscksp.h>
+
+static PetscErrorCode AssembleOperator(Mat A, PetscInt n, PetscInt step)
+{
+  PetscInt  Istart, Iend;
+  PetscReal c = 0.3 * (1.0 + 0.02 * step);
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt row = Istart; row < Iend; row++) {
+    PetscInt i = row / n, j = row % n;
+
+    if (i > 0) PetscCall(MatSetValue(A, row, row - n, -1.0 - c, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, row, row + n, -1.0 + c, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, row, row - 1, -1.0 - 0.5 * c, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, row, row + 1, -1.0 + 0.5 * c, INSERT_VALUES));
+    PetscCall(MatSetValue(A, row, row, 4.0 + 0.01 * step, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat                A;
+  Vec                x, b, r;
+  KSP                ksp;
+  PetscInt           n = 24, nsteps = 6, its, Istart, Iend;
+  PetscReal          bnorm, rnorm, rtol;
+  PetscBool          same = PETSC_FALSE;
+  KSPConvergedReason reason;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsteps", &nsteps, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-same", &same, NULL));
+
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, n * n, n * n, 5, NULL, 5, NULL, &A));
+  PetscCall(AssembleOperator(A, n, 0));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(b, &r));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetTolerances(ksp, 1e-8, PETSC_DEFAULT, PETSC_DEFAULT, 2000));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPGetTolerances(ksp, &rtol, NULL, NULL, NULL));
+  PetscCall(VecGetOwnershipRange(b, &Istart, &Iend));
+  for (PetscInt step = 0; step < nsteps; step++) {
+    if (step && !same) PetscCall(AssembleOperator(A, n, step));
+    /* a smooth right-hand side that changes with the step */
+    for (PetscInt row = Istart; row < Iend; row++) PetscCall(VecSetValue(b, row, PetscSinReal(0.1 * row + 0.5 * step) + 1.0, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(b));
+    PetscCall(VecAssemblyEnd(b));
+    PetscCall(KSPSolve(ksp, b, x));
+    PetscCall(KSPGetConvergedReason(ksp, &reason));
+    PetscCall(KSPGetIterationNumber(ksp, &its));
+    PetscCall(MatMult(A, x, r));
+    PetscCall(VecAYPX(r, -1.0, b));
+    PetscCall(VecNorm(r, NORM_2, &rnorm));
+    PetscCall(VecNorm(b, NORM_2, &bnorm));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Step %" PetscInt_FMT ": %s in %" PetscInt_FMT " iterations, relative residual %s\n", step, reason > 0 ? "converged" : KSPConvergedReasons[reason], its, rnorm < 1e3 * rtol * bnorm ? "ok" : "too large"));
+  }
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: gmres
+      args: -ksp_type gmres -pc_type jacobi
+
+   test:
+      suffix: poly
+      nsize: 2
+      args: -ksp_type gmres -pc_type poly -pc_poly_degree 8
+
+   testset:
+      requires: !complex
+      args: -ksp_type gcrodr -pc_type jacobi -ksp_gcrodr_recycle 8
+
+      test:
+         suffix: gcrodr
+         args: -ksp_pc_side {{left right}separate output}
+
+      test:
+         suffix: gcrodr_same
+         args: -same
+
+      test:
+         suffix: gcrodr_2
+         nsize: 2
+
+TEST*/
@@ -248,6 +248,47 @@ int main(int argc, char **args)
       args: -ksp_monitor_short -m 5 -n 5 -mat_view draw -ksp_gmres_cgs_refinement_type refine_always -nox
       output_file: output/ex2_2.out
 
+   test:
+      suffix: seqaij_omp
+      nsize: 2
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_omp -vec_omp_first_touch -omp_num_threads 3
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: seqaij_omp_ilu
+      requires: openmp
+      args: -m 60 -n 60 -pc_type ilu -ksp_rtol 1e-10 -mat_seqaij_omp -omp_num_threads 3
+
+   test:
+      suffix: sor_multicolor
+      nsize: 2
+      requires: openmp
+      args: -m 60 -n 60 -ksp_type cg -pc_type sor -pc_sor_local_symmetric -pc_sor_multicolor -ksp_rtol 1e-10 -mat_seqaij_omp -omp_num_threads 3
+
+   test:
+      suffix: seqaij_auto
+      nsize: 2
+      requires: defined(PETSC_USE_INFO) !mkl_sparse
+      args: -m 60 -n 60 -mat_seqaij_type auto -mat_seqaij_auto_min_nz 0 -ksp_type cg -pc_type jacobi -info :mat
+      filter: grep -E "MatMult\(\) with|Norm of error" | sed -e "s/ takes [0-9.e+-]* seconds//" | sort -b
+
+   test:
+      suffix: seqaij_index32
+      args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -mat_seqaij_index32
+      output_file: output/ex2_3.out
+
+   test:
+      suffix: aijsingleshadow
+      args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -mat_type aijsingleshadow
+      output_file: output/ex2_3.out
+
+   test:
+      suffix: aijsingleshadow_2
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_type aijsingleshadow
+      output_file: output/ex2_2.out
+
    test:
       suffix: bjacobi
       nsize: 4
@@ -365,6 +406,24 @@ int main(int argc, char **args)
       nsize: 4
       args: -ksp_monitor_short -ksp_type pipecg2 -m 15 -n 9 -ksp_norm_type {{preconditioned unpreconditioned natural}}
 
+   test:
+      suffix: sstepgmres
+      args: -ksp_monitor_short -ksp_type sstepgmres -m 9 -n 9 -ksp_sstep_basis_type {{monomial newton chebyshev}shared output}
+
+   test:
+      suffix: sstepgmres_2
+      nsize: 4
+      args: -ksp_monitor_short -ksp_type sstepgmres -m 15 -n 9 -ksp_gmres_restart 12 -ksp_sstep_size 4 -ksp_pc_side {{left right}separate output}
+
+   test:
+      suffix: sstepcg
+      args: -ksp_monitor_short -ksp_type sstepcg -m 9 -n 9 -ksp_norm_type {{preconditioned unpreconditioned natural}separate output} -ksp_sstep_basis_type {{monomial newton chebyshev}shared output}
+
+   test:
+      suffix: sstepcg_2
+      nsize: 4
+      args: -ksp_monitor_short -ksp_type sstepcg -m 15 -n 9 -ksp_sstep_size 3 -ksp_view
+
    test:
       suffix: hpddm
       nsize: 4
@@ -390,6 +449,67 @@ int main(int argc, char **args)
       nsize: 1
       args: -ksp_monitor -ksp_type gmres -pc_type bjacobi -sub_pc_type icc -ksp_pc_side symmetric -pc_bjacobi_blocks 2
 
+   testset:
+      nsize: 2
+      args: -ksp_monitor_short -m 16 -n 15 -pc_type bjacobi -pc_bjacobi_local_blocks 6 -sub_pc_type ilu
+      output_file: output/ex2_bjacobi_threads.out
+
+      test:
+         suffix: bjacobi_threads
+
+      test:
+         suffix: bjacobi_threads_4
+         requires: openmp defined(PETSC_HAVE_THREADSAFETY)
+         args: -pc_bjacobi_threads 4 -omp_num_threads 4
+
+   testset:
+      nsize: 2
+      args: -ksp_monitor_short -m 16 -n 15 -pc_type asm -pc_asm_local_blocks 6 -sub_pc_type lu
+      output_file: output/ex2_asm_threads.out
+
+      test:
+         suffix: asm_threads
+
+      test:
+         suffix: asm_threads_4
+         requires: openmp defined(PETSC_HAVE_THREADSAFETY)
+         args: -pc_asm_threads 4 -omp_num_threads 4
+
+   testset:
+      args: -ksp_monitor_short -m 16 -n 15 -ksp_type cg -pc_type fsai
+      test:
+         suffix: fsai
+         nsize: {{1 2}}
+         output_file: output/ex2_fsai.out
+      test:
+         suffix: fsai_levels
+         nsize: 2
+         args: -pc_fsai_levels 2 -ksp_type gmres -ksp_pc_side symmetric -ksp_view
+      test:
+         suffix: fsai_threads
+         requires: openmp
+         args: -pc_fsai_threads 3 -omp_num_threads 3
+         output_file: output/ex2_fsai.out
+      test:
+         suffix: fsai_gamg
+         nsize: 2
+         args: -pc_type gamg -mg_levels_pc_type fsai -mg_levels_ksp_type chebyshev
+
+   testset:
+      args: -ksp_monitor_short -m 16 -n 15 -pc_type poly
+      test:
+         suffix: poly_gmres
+         nsize: {{1 2}}
+         output_file: output/ex2_poly_gmres.out
+      test:
+         suffix: poly_chebyshev
+         nsize: {{1 2}}
+         args: -ksp_type cg -pc_poly_type chebyshev -pc_poly_degree 4
+         output_file: output/ex2_poly_chebyshev.out
+      test:
+         suffix: poly_chebyshev_eigenvalues
+         args: -ksp_type cg -pc_poly_type chebyshev -pc_poly_chebyshev_eigenvalues 0.1,8.1 -ksp_view
+
    test:
       suffix: help
       requires: !hpddm !complex !kokkos_kernels !amgx !ml !spai !hypre !viennacl !parms !h2opus !metis !parmetis !superlu_dist !mkl_sparse_optimize !mkl_sparse !mkl_pardiso !mkl_cpardiso !cuda !hip defined(PETSC_USE_LOG) defined(PETSC_USE_INFO) cxx
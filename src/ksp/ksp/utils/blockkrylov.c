@@ -0,0 +1,192 @@
+/*
+   Kernels shared by the block Krylov methods with which KSPCG and KSPGMRES implement KSPMatSolve(). A block of vectors is a MATDENSE
+   with the row layout of the operator, the small coefficient matrices are replicated on all processes and stored by columns
+*/
+#include <petsc/private/kspimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+   Applies the operator, or its transpose for KSPMatSolveTranspose(), to the block X; Y is created by the first call and reused afterwards,
+   so X must be the same Mat at each call
+*/
+PetscErrorCode KSPBlockMatMult_Private(KSP ksp, Mat A, Mat X, Mat *Y)
+{
+  PetscFunctionBegin;
+  if (!ksp->transpose_solve) PetscCall(MatMatMult(A, X, *Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, PETSC_DEFAULT, Y));
+  else PetscCall(MatTransposeMatMult(A, X, *Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, PETSC_DEFAULT, Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   C = X^H Y restricted to the local rows, C has leading dimension ldc; the caller sums the contributions of all processes, usually
+   together with other small products so that they need a single reduction
+*/
+PetscErrorCode KSPBlockDotLocal_Private(Mat X, Mat Y, PetscScalar C[], PetscInt ldc)
+{
+  const PetscScalar *x, *y;
+  PetscScalar        one = 1.0, zero = 0.0;
+  PetscInt           m, kx, ky, ldx, ldy;
+  PetscBLASInt       bm, bkx, bky, bldx, bldy, bldc;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetLocalSize(X, &m, NULL));
+  PetscCall(MatGetSize(X, NULL, &kx));
+  PetscCall(MatGetSize(Y, NULL, &ky));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(PetscBLASIntCast(m, &bm));
+  PetscCall(PetscBLASIntCast(kx, &bkx));
+  PetscCall(PetscBLASIntCast(ky, &bky));
+  PetscCall(PetscBLASIntCast(PetscMax(ldx, 1), &bldx));
+  PetscCall(PetscBLASIntCast(PetscMax(ldy, 1), &bldy));
+  PetscCall(PetscBLASIntCast(PetscMax(ldc, 1), &bldc));
+  PetscCall(MatDenseGetArrayRead(X, &x));
+  PetscCall(MatDenseGetArrayRead(Y, &y));
+  PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bkx, &bky, &bm, &one, x, &bldx, y, &bldy, &zero, C, &bldc));
+  PetscCall(MatDenseRestoreArrayRead(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(X, &x));
+  PetscCall(PetscLogFlops(2.0 * m * kx * ky));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   d_j = X_j^H Y_j, for the columns j of X and Y, restricted to the local rows
+*/
+PetscErrorCode KSPBlockColumnDotsLocal_Private(Mat X, Mat Y, PetscScalar d[])
+{
+  const PetscScalar *x, *y;
+  PetscInt           m, k, ldx, ldy;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetLocalSize(X, &m, NULL));
+  PetscCall(MatGetSize(X, NULL, &k));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(MatDenseGetArrayRead(X, &x));
+  PetscCall(MatDenseGetArrayRead(Y, &y));
+  for (PetscInt j = 0; j < k; j++) {
+    PetscScalar t = 0.0;
+
+    for (PetscInt i = 0; i < m; i++) t += PetscConj(x[i + j * ldx]) * y[i + j * ldy];
+    d[j] = t;
+  }
+  PetscCall(MatDenseRestoreArrayRead(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(X, &x));
+  PetscCall(PetscLogFlops(2.0 * m * k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Y = beta Y + alpha X C, with C of leading dimension ldc, X and Y must be different blocks
+*/
+PetscErrorCode KSPBlockUpdate_Private(Mat Y, PetscScalar beta, PetscScalar alpha, Mat X, const PetscScalar C[], PetscInt ldc)
+{
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscInt           m, k, s, ldx, ldy;
+  PetscBLASInt       bm, bk, bs, bldx, bldy, bldc;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetLocalSize(Y, &m, NULL));
+  PetscCall(MatGetSize(X, NULL, &k));
+  PetscCall(MatGetSize(Y, NULL, &s));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(PetscBLASIntCast(m, &bm));
+  PetscCall(PetscBLASIntCast(k, &bk));
+  PetscCall(PetscBLASIntCast(s, &bs));
+  PetscCall(PetscBLASIntCast(PetscMax(ldx, 1), &bldx));
+  PetscCall(PetscBLASIntCast(PetscMax(ldy, 1), &bldy));
+  PetscCall(PetscBLASIntCast(PetscMax(ldc, 1), &bldc));
+  PetscCall(MatDenseGetArrayRead(X, &x));
+  if (beta == 0.0) PetscCall(MatDenseGetArrayWrite(Y, &y));
+  else PetscCall(MatDenseGetArray(Y, &y));
+  PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bm, &bs, &bk, &alpha, x, &bldx, C, &bldc, &beta, y, &bldy));
+  if (beta == 0.0) PetscCall(MatDenseRestoreArrayWrite(Y, &y));
+  else PetscCall(MatDenseRestoreArray(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(X, &x));
+  PetscCall(PetscLogFlops(2.0 * m * k * s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The residual norm of a block given to the monitors and the convergence test: the largest norm of its s columns, each scaled by the
+   ratio of the largest initial norm to its own initial norm, so that the relative tolerance applies to each column. The initial norms
+   norms0 are set from norms when first is true, the columns with a zero initial residual do not count
+*/
+PetscErrorCode KSPBlockResidualNorm_Private(PetscInt s, const PetscReal norms[], PetscBool first, PetscReal norms0[], PetscReal *rnorm)
+{
+  PetscReal max0 = 0.0, r = 0.0;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < s; i++) {
+    if (first) norms0[i] = norms[i];
+    max0 = PetscMax(max0, norms0[i]);
+  }
+  for (PetscInt i = 0; i < s; i++) {
+    if (PetscIsInfOrNanReal(norms[i])) {
+      *rnorm = norms[i];
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    if (norms0[i] > 0.0) r = PetscMax(r, norms[i] / norms0[i]);
+  }
+  *rnorm = r * max0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Orthonormalizes a block W of s vectors from its s x s Gram matrix G = W^H W, or G = W^H A W for an A-orthonormalization, which is
+   overwritten. With the eigendecomposition of the Gram matrix scaled to a unit diagonal, the columns of W T are orthonormal and
+   W = (W T) S up to the eigenvalues below tol times the largest one, whose eigenvectors are dropped; rank is the number of columns of
+   T (s x rank) and of rows of S (rank x s), both stored with leading dimension s. The scaling makes the deflation independent of the
+   norms of the columns, so a column is only dropped when it is numerically a combination of the others. When indefinite is provided it
+   tells if G has eigenvalues below -tol times the largest one
+*/
+PetscErrorCode KSPBlockGramFactor_Private(PetscInt s, PetscScalar G[], PetscReal tol, PetscScalar T[], PetscScalar S[], PetscInt *rank, PetscBool *indefinite)
+{
+  PetscReal   *d, *lambda, lmax = 0.0;
+  PetscScalar *work;
+  PetscBLASInt bs, lwork, info;
+  PetscInt     r;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal *rwork;
+#endif
+
+  PetscFunctionBegin;
+  *rank = 0;
+  if (indefinite) *indefinite = PETSC_FALSE;
+  if (!s) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(s, &bs));
+  PetscCall(PetscBLASIntCast(5 * s, &lwork));
+  PetscCall(PetscMalloc3(s, &d, s, &lambda, 5 * s, &work));
+  for (PetscInt i = 0; i < s; i++) d[i] = PetscRealPart(G[i + i * s]) > 0.0 ? 1.0 / PetscSqrtReal(PetscRealPart(G[i + i * s])) : 0.0;
+  for (PetscInt j = 0; j < s; j++)
+    for (PetscInt i = 0; i < s; i++) G[i + j * s] *= d[i] * d[j];
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKsyev", LAPACKsyev_("V", "U", &bs, G, &bs, lambda, work, &lwork, &info));
+#else
+  PetscCall(PetscMalloc1(3 * s, &rwork));
+  PetscCallBLAS("LAPACKsyev", LAPACKsyev_("V", "U", &bs, G, &bs, lambda, work, &lwork, rwork, &info));
+  PetscCall(PetscFree(rwork));
+#endif
+  PetscCall(PetscFPTrapPop());
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in SYEV Lapack routine %d", (int)info);
+  for (PetscInt i = 0; i < s; i++) lmax = PetscMax(lmax, PetscAbsReal(lambda[i]));
+  if (indefinite) *indefinite = (PetscBool)(lambda[0] < -tol * lmax);
+  /* the eigenvalues are in ascending order, the columns of T are sorted by decreasing eigenvalues */
+  for (r = 0; r < s; r++) {
+    PetscInt  e = s - 1 - r;
+    PetscReal l = lambda[e];
+
+    if (!(l > tol * lmax)) break; /* also catches NaN */
+    l = PetscSqrtReal(l);
+    for (PetscInt i = 0; i < s; i++) {
+      T[i + r * s] = d[i] * G[i + e * s] / l;
+      S[r + i * s] = d[i] > 0.0 ? l * PetscConj(G[i + e * s]) / d[i] : 0.0;
+    }
+  }
+  *rank = r;
+  PetscCall(PetscFree3(d, lambda, work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
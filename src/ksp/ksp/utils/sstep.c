@@ -0,0 +1,225 @@
+/*
+   Interface and small dense kernels shared by the s-step (communication avoiding) Krylov methods KSPSSTEPGMRES and KSPSSTEPCG
+*/
+#include <petsc/private/kspimpl.h> /*I "petscksp.h" I*/
+
+/*
+   Coefficients of the three term recurrence v_{i+1} = (Op v_i - alpha_i v_i - beta_i v_{i-1}) / gamma_i, i = 0, ..., s-1, that generates
+   a block of s Krylov vectors from v_0, computed from n Ritz values of the operator. The matrix of the recurrence is the change of basis
+   matrix B, with B(i,i) = alpha_i, B(i+1,i) = gamma_i and B(i-1,i) = beta_i, such that Op [v_0, ..., v_{s-1}] = [v_0, ..., v_s] B.
+
+   Without Ritz values this is the monomial basis. The Newton basis uses the real parts of the Ritz values in Leja order as shifts, the
+   Chebyshev basis the Chebyshev polynomials on the interval spanned by them; when this interval is a point it is replaced by the Newton basis
+*/
+PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType type, PetscInt n, const PetscReal ritz[], PetscInt s, PetscReal alpha[], PetscReal beta[], PetscReal gamma[])
+{
+  PetscReal lmin, lmax, c, d;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < s; i++) {
+    alpha[i] = 0.0;
+    beta[i]  = 0.0;
+    gamma[i] = 1.0;
+  }
+  if (type == KSP_SSTEP_BASIS_MONOMIAL || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  lmin = lmax = ritz[0];
+  for (PetscInt i = 1; i < n; i++) {
+    lmin = PetscMin(lmin, ritz[i]);
+    lmax = PetscMax(lmax, ritz[i]);
+  }
+  c = 0.5 * (lmax + lmin);
+  d = 0.5 * (lmax - lmin);
+  if (type == KSP_SSTEP_BASIS_CHEBYSHEV && d > PETSC_SMALL * PetscAbsReal(c)) {
+    d *= 1.1; /* the extreme Ritz values lie inside the spectrum */
+    for (PetscInt i = 0; i < s; i++) {
+      alpha[i] = c;
+      beta[i]  = i ? 0.5 * d : 0.0;
+      gamma[i] = i ? 0.5 * d : d;
+    }
+  } else {
+    PetscReal *leja;
+    PetscBool *used;
+
+    /* the first shift has the largest magnitude, each next one maximizes the product of the distances to the previous ones */
+    PetscCall(PetscMalloc2(n, &leja, n, &used));
+    for (PetscInt i = 0; i < n; i++) used[i] = PETSC_FALSE;
+    for (PetscInt i = 0; i < n; i++) {
+      PetscInt  best    = -1;
+      PetscReal bestval = PETSC_MIN_REAL;
+
+      for (PetscInt k = 0; k < n; k++) {
+        PetscReal val = 0.0;
+
+        if (used[k]) continue;
+        if (!i) val = PetscAbsReal(ritz[k]);
+        else {
+          for (PetscInt j = 0; j < i; j++) val += PetscLogReal(PetscMax(PetscAbsReal(ritz[k] - leja[j]), PETSC_MIN_REAL));
+        }
+        if (best < 0 || val > bestval) {
+          best    = k;
+          bestval = val;
+        }
+      }
+      used[best] = PETSC_TRUE;
+      leja[i]    = ritz[best];
+    }
+    if (d == 0.0) d = PetscAbsReal(c) > 0.0 ? PetscAbsReal(c) : 1.0;
+    for (PetscInt i = 0; i < s; i++) {
+      alpha[i] = leja[i % n];
+      gamma[i] = d;
+    }
+    PetscCall(PetscFree2(leja, used));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Cholesky factorization G = R^H R, in place in the upper triangle, of an s x s Hermitian positive semi-definite matrix stored by columns
+   with leading dimension ld. The factorization stops at the first column i whose pivot is not larger than tol times ref[i], or than tol
+   times the diagonal entry of G when ref is NULL; rank is the number of columns factored, the entries above the diagonal of the column
+   where it stopped are computed anyway
+*/
+PetscErrorCode KSPSStepCholesky_Private(PetscInt s, PetscScalar G[], PetscInt ld, const PetscReal ref[], PetscReal tol, PetscInt *rank)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i = 0; i < s; i++) {
+    PetscReal d = PetscRealPart(G[i + i * ld]), gii = ref ? ref[i] : d;
+
+    for (PetscInt p = 0; p < i; p++) {
+      PetscScalar t = G[p + i * ld];
+
+      for (PetscInt q = 0; q < p; q++) t -= PetscConj(G[q + p * ld]) * G[q + i * ld];
+      G[p + i * ld] = t / G[p + p * ld];
+      d -= PetscRealPart(PetscConj(G[p + i * ld]) * G[p + i * ld]);
+    }
+    if (!(d > tol * gii)) break; /* also catches NaN */
+    G[i + i * ld] = PetscSqrtReal(d);
+  }
+  *rank = i;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solves R^H R x = b in place with the factor computed by KSPSStepCholesky_Private()
+*/
+PetscErrorCode KSPSStepCholeskySolve_Private(PetscInt s, const PetscScalar R[], PetscInt ld, PetscScalar b[])
+{
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < s; i++) {
+    for (PetscInt p = 0; p < i; p++) b[i] -= PetscConj(R[p + i * ld]) * b[p];
+    b[i] /= R[i + i * ld];
+  }
+  for (PetscInt i = s - 1; i >= 0; i--) {
+    for (PetscInt p = i + 1; p < s; p++) b[i] -= R[i + p * ld] * b[p];
+    b[i] /= R[i + i * ld];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPSStepSetStepSize - Sets the number of Krylov vectors that `KSPSSTEPGMRES` and `KSPSSTEPCG` generate and orthogonalize together
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- s   - the number of vectors in a block
+
+  Options Database Key:
+. -ksp_sstep_size <s> - the number of vectors in a block
+
+  Level: intermediate
+
+  Note:
+  The methods need one or two global reductions per block of s vectors instead of one or two per iteration, but the basis
+  becomes ill-conditioned as s grows, more quickly for the monomial basis, see `KSPSStepSetBasisType()`. The default is 5.
+
+.seealso: [](ch_ksp), `KSPSSTEPGMRES`, `KSPSSTEPCG`, `KSPSStepGetStepSize()`, `KSPSStepSetBasisType()`
+@*/
+PetscErrorCode KSPSStepSetStepSize(KSP ksp, PetscInt s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, s, 2);
+  PetscTryMethod(ksp, "KSPSStepSetStepSize_C", (KSP, PetscInt), (ksp, s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPSStepGetStepSize - Gets the number of Krylov vectors that `KSPSSTEPGMRES` and `KSPSSTEPCG` generate and orthogonalize together
+
+  Not Collective
+
+  Input Parameter:
+. ksp - the Krylov space context
+
+  Output Parameter:
+. s - the number of vectors in a block
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `KSPSSTEPGMRES`, `KSPSSTEPCG`, `KSPSStepSetStepSize()`
+@*/
+PetscErrorCode KSPSStepGetStepSize(KSP ksp, PetscInt *s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscAssertPointer(s, 2);
+  PetscUseMethod(ksp, "KSPSStepGetStepSize_C", (KSP, PetscInt *), (ksp, s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPSStepSetBasisType - Sets the polynomial basis in which `KSPSSTEPGMRES` and `KSPSSTEPCG` generate their blocks of Krylov vectors
+
+  Logically Collective
+
+  Input Parameters:
++ ksp  - the Krylov space context
+- type - the basis, `KSP_SSTEP_BASIS_MONOMIAL`, `KSP_SSTEP_BASIS_NEWTON` or `KSP_SSTEP_BASIS_CHEBYSHEV`
+
+  Options Database Key:
+. -ksp_sstep_basis_type <monomial,newton,chebyshev> - the basis
+
+  Level: intermediate
+
+  Note:
+  The default is `KSP_SSTEP_BASIS_NEWTON`. The Newton and Chebyshev bases need Ritz values of the operator, they are computed
+  from the first block of vectors of each `KSPSolve()`, which is generated in the monomial basis.
+
+.seealso: [](ch_ksp), `KSPSSTEPGMRES`, `KSPSSTEPCG`, `KSPSStepBasisType`, `KSPSStepGetBasisType()`, `KSPSStepSetStepSize()`
+@*/
+PetscErrorCode KSPSStepSetBasisType(KSP ksp, KSPSStepBasisType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(ksp, type, 2);
+  PetscTryMethod(ksp, "KSPSStepSetBasisType_C", (KSP, KSPSStepBasisType), (ksp, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPSStepGetBasisType - Gets the polynomial basis in which `KSPSSTEPGMRES` and `KSPSSTEPCG` generate their blocks of Krylov vectors
+
+  Not Collective
+
+  Input Parameter:
+. ksp - the Krylov space context
+
+  Output Parameter:
+. type - the basis
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `KSPSSTEPGMRES`, `KSPSSTEPCG`, `KSPSStepBasisType`, `KSPSStepSetBasisType()`
+@*/
+PetscErrorCode KSPSStepGetBasisType(KSP ksp, KSPSStepBasisType *type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscAssertPointer(type, 2);
+  PetscUseMethod(ksp, "KSPSStepGetBasisType_C", (KSP, KSPSStepBasisType *), (ksp, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -34,6 +34,7 @@ static PetscErrorCode PCView_ASM(PC pc, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  restriction/interpolation type - %s\n", PCASMTypes[osm->type]));
     if (osm->dm_subdomains) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: using DM to define subdomains\n"));
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: local solve composition type - %s\n", PCCompositeTypes[osm->loctype]));
+    if (osm->nthreads > 1) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: local blocks set up and solved concurrently by %" PetscInt_FMT " OpenMP threads\n", osm->nthreads));
     PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)pc), &rank));
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
@@ -409,16 +410,10 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_ASM(PC pc)
 {
-  PC_ASM            *osm = (PC_ASM *)pc->data;
-  PetscInt           i;
-  KSPConvergedReason reason;
+  PC_ASM *osm = (PC_ASM *)pc->data;
 
   PetscFunctionBegin;
-  for (i = 0; i < osm->n_local_true; i++) {
-    PetscCall(KSPSetUp(osm->ksp[i]));
-    PetscCall(KSPGetConvergedReason(osm->ksp[i], &reason));
-    if (reason == KSP_DIVERGED_PC_FAILED) pc->failedreason = PC_SUBPC_ERROR;
-  }
+  PetscCall(PCSetUpSubKSPs_Private(pc, osm->nthreads, osm->n_local_true, osm->ksp));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -449,32 +444,48 @@ static PetscErrorCode PCApply_ASM(PC pc, Vec x, Vec y)
   PetscCall(VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, forward));
   PetscCall(VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, forward));
 
-  /* restrict local RHS to the overlapping 0-block RHS */
-  PetscCall(VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
-  PetscCall(VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
-
-  /* do the local solves */
-  for (i = 0; i < n_local_true; ++i) {
-    /* solve the overlapping i-block */
-    PetscCall(PetscLogEventBegin(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
-    PetscCall(KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]));
-    PetscCall(KSPCheckSolve(osm->ksp[i], pc, osm->y[i]));
-    PetscCall(PetscLogEventEnd(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
-
-    if (osm->lprolongation && osm->type != PC_ASM_INTERPOLATE) { /* interpolate the non-overlapping i-block solution to the local solution (only for restrictive additive) */
-      PetscCall(VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
-      PetscCall(VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
-    } else { /* interpolate the overlapping i-block solution to the local solution */
-      PetscCall(VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
-      PetscCall(VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
+  if (osm->loctype == PC_COMPOSITE_ADDITIVE) {
+    /* the blocks are independent: restrict the local RHS to all of them, solve them, possibly concurrently, and add up their solutions */
+    for (i = 0; i < n_local_true; ++i) {
+      PetscCall(VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward));
+      PetscCall(VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward));
     }
+    PetscCall(PCSolveSubKSPs_Private(pc, osm->nthreads, n_local_true, osm->ksp, osm->x, osm->y, PETSC_FALSE));
+    for (i = 0; i < n_local_true; ++i) {
+      if (osm->lprolongation && osm->type != PC_ASM_INTERPOLATE) { /* interpolate the non-overlapping i-block solution to the local solution (only for restrictive additive) */
+        PetscCall(VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
+        PetscCall(VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
+      } else { /* interpolate the overlapping i-block solution to the local solution */
+        PetscCall(VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
+        PetscCall(VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
+      }
+    }
+  } else {
+    /* restrict local RHS to the overlapping 0-block RHS */
+    PetscCall(VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
+    PetscCall(VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
+
+    /* do the local solves */
+    for (i = 0; i < n_local_true; ++i) {
+      /* solve the overlapping i-block */
+      PetscCall(PetscLogEventBegin(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
+      PetscCall(KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]));
+      PetscCall(KSPCheckSolve(osm->ksp[i], pc, osm->y[i]));
+      PetscCall(PetscLogEventEnd(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
+
+      if (osm->lprolongation && osm->type != PC_ASM_INTERPOLATE) { /* interpolate the non-overlapping i-block solution to the local solution (only for restrictive additive) */
+        PetscCall(VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
+        PetscCall(VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
+      } else { /* interpolate the overlapping i-block solution to the local solution */
+        PetscCall(VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
+        PetscCall(VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
+      }
 
-    if (i < n_local_true - 1) {
-      /* restrict local RHS to the overlapping (i+1)-block RHS */
-      PetscCall(VecScatterBegin(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
-      PetscCall(VecScatterEnd(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
+      if (i < n_local_true - 1) {
+        /* restrict local RHS to the overlapping (i+1)-block RHS */
+        PetscCall(VecScatterBegin(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
+        PetscCall(VecScatterEnd(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
 
-      if (osm->loctype == PC_COMPOSITE_MULTIPLICATIVE) {
         /* update the overlapping (i+1)-block RHS using the current local solution */
         PetscCall(MatMult(osm->lmats[i + 1], osm->ly, osm->y[i + 1]));
         PetscCall(VecAXPBY(osm->x[i + 1], -1., 1., osm->y[i + 1]));
@@ -589,18 +600,13 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc, Vec x, Vec y)
   PetscCall(VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, forward));
   PetscCall(VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, forward));
 
-  /* Restrict local RHS to the overlapping 0-block RHS */
-  PetscCall(VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
-  PetscCall(VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward));
-
-  /* do the local solves */
+  /* Restrict the local RHS to all the overlapping blocks, solve them, possibly concurrently, and add up their solutions */
+  for (i = 0; i < n_local_true; ++i) {
+    PetscCall(VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward));
+    PetscCall(VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward));
+  }
+  PetscCall(PCSolveSubKSPs_Private(pc, osm->nthreads, n_local_true, osm->ksp, osm->x, osm->y, PETSC_TRUE));
   for (i = 0; i < n_local_true; ++i) {
-    /* solve the overlapping i-block */
-    PetscCall(PetscLogEventBegin(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
-    PetscCall(KSPSolveTranspose(osm->ksp[i], osm->x[i], osm->y[i]));
-    PetscCall(KSPCheckSolve(osm->ksp[i], pc, osm->y[i]));
-    PetscCall(PetscLogEventEnd(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0));
-
     if (osm->lprolongation && osm->type != PC_ASM_RESTRICT) { /* interpolate the non-overlapping i-block solution to the local solution */
       PetscCall(VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
       PetscCall(VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward));
@@ -608,12 +614,6 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc, Vec x, Vec y)
       PetscCall(VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
       PetscCall(VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse));
     }
-
-    if (i < n_local_true - 1) {
-      /* Restrict local RHS to the overlapping (i+1)-block RHS */
-      PetscCall(VecScatterBegin(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
-      PetscCall(VecScatterEnd(osm->lrestriction[i + 1], osm->lx, osm->x[i + 1], INSERT_VALUES, forward));
-    }
   }
   /* Add the local solution to the global solution including the ghost nodes */
   PetscCall(VecScatterBegin(osm->restriction, osm->ly, y, ADD_VALUES, reverse));
@@ -721,6 +721,10 @@ static PetscErrorCode PCSetFromOptions_ASM(PC pc, PetscOptionItems *PetscOptions
   if (flg) PetscCall(PCASMSetLocalType(pc, loctype));
   PetscCall(PetscOptionsFList("-pc_asm_sub_mat_type", "Subsolve Matrix Type", "PCASMSetSubMatType", MatList, NULL, sub_mat_type, 256, &flg));
   if (flg) PetscCall(PCASMSetSubMatType(pc, sub_mat_type));
+  PetscCall(PetscOptionsInt("-pc_asm_threads", "Number of OpenMP threads that set up and solve the local subdomains concurrently", "None", osm->nthreads, &osm->nthreads, NULL));
+#if !defined(PETSC_HAVE_OPENMP) || !defined(PETSC_HAVE_THREADSAFETY)
+  PetscCheck(osm->nthreads <= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP_SYS, "-pc_asm_threads requires PETSc configured with OpenMP and --with-threadsafety");
+#endif
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1226,7 +1230,8 @@ PetscErrorCode PCASMGetSubKSP(PC pc, PetscInt *n_local, PetscInt *first_local, K
 +  -pc_asm_blocks <blks> - Sets total blocks. Defaults to one block per MPI rank.
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets `PCASMType`, default is restrict. See `PCASMSetType()`
--  -pc_asm_local_type [additive, multiplicative] - Sets `PCCompositeType`, default is additive. See `PCASMSetLocalType()`
+.  -pc_asm_local_type [additive, multiplicative] - Sets `PCCompositeType`, default is additive. See `PCASMSetLocalType()`
+-  -pc_asm_threads <nt> - set up and solve the subdomains of each MPI rank concurrently on nt OpenMP threads, with the additive local type
 
    Level: beginner
 
@@ -1244,6 +1249,11 @@ PetscErrorCode PCASMGetSubKSP(PC pc, PetscInt *n_local, PetscInt *first_local, K
    To set the options on the solvers separate for each block call `PCASMGetSubKSP()`
    and set the options directly on the resulting `KSP` object (you can access its `PC` with `KSPGetPC()`)
 
+   With several subdomains per MPI rank, -pc_asm_threads lets idle cores factor and solve the subdomains, each OpenMP thread taking the
+   next subdomain not yet done; the restrictions and the sums of the subdomain solutions stay sequential. The subdomains must then be
+   solved by thread-safe `KSP` and `PC`, such as `KSPPREONLY` with `PCILU`, `PCLU` or `PCICC`, and PETSc must be configured with OpenMP and
+   --with-threadsafety.
+
     References:
 +   * - M Dryja, OB Widlund, An additive variant of the Schwarz alternating method for the case of many subregions
      Courant Institute, New York University Technical report
@@ -1281,6 +1291,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   osm->sort_indices  = PETSC_TRUE;
   osm->dm_subdomains = PETSC_FALSE;
   osm->sub_mat_type  = NULL;
+  osm->nthreads      = 1;
 
   pc->data                 = (void *)osm;
   pc->ops->apply           = PCApply_ASM;
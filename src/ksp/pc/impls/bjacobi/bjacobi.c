@@ -162,6 +162,10 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PC pc, PetscOptionItems *PetscOpt
   if (flg) PetscCall(PCBJacobiSetTotalBlocks(pc, blocks, NULL));
   PetscCall(PetscOptionsInt("-pc_bjacobi_local_blocks", "Local number of blocks", "PCBJacobiSetLocalBlocks", jac->n_local, &blocks, &flg));
   if (flg) PetscCall(PCBJacobiSetLocalBlocks(pc, blocks, NULL));
+  PetscCall(PetscOptionsInt("-pc_bjacobi_threads", "Number of OpenMP threads that set up and solve the local blocks concurrently", "None", jac->nthreads, &jac->nthreads, NULL));
+#if !defined(PETSC_HAVE_OPENMP) || !defined(PETSC_HAVE_THREADSAFETY)
+  PetscCheck(jac->nthreads <= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP_SYS, "-pc_bjacobi_threads requires PETSc configured with OpenMP and --with-threadsafety");
+#endif
   if (jac->ksp) {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
@@ -190,6 +194,7 @@ static PetscErrorCode PCView_BJacobi(PC pc, PetscViewer viewer)
   if (iascii) {
     if (pc->useAmat) PetscCall(PetscViewerASCIIPrintf(viewer, "  using Amat local matrix, number of blocks = %" PetscInt_FMT "\n", jac->n));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  number of blocks = %" PetscInt_FMT "\n", jac->n));
+    if (jac->nthreads > 1) PetscCall(PetscViewerASCIIPrintf(viewer, "  local blocks set up and solved concurrently by %" PetscInt_FMT " OpenMP threads\n", jac->nthreads));
     PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)pc), &rank));
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
@@ -488,7 +493,8 @@ PetscErrorCode PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt *
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_threads <nt> - set up and solve the blocks of each process concurrently on nt OpenMP threads
 
    Notes:
     See `PCJACOBI` for diagonal Jacobi, `PCVPBJACOBI` for variable point block, and `PCPBJACOBI` for fixed size point block
@@ -508,6 +514,10 @@ PetscErrorCode PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt *
 
      When multiple processes share a single block, each block encompasses exactly all the unknowns owned its set of processes.
 
+     With several blocks per process, -pc_bjacobi_threads lets idle cores factor and solve the blocks, each OpenMP thread taking the next
+         block not yet done. The blocks must then be solved by thread-safe `KSP` and `PC`, such as `KSPPREONLY` with `PCILU`, `PCLU` or `PCICC`,
+         and PETSc must be configured with OpenMP and --with-threadsafety.
+
    Level: beginner
 
 .seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCType`,
@@ -541,6 +551,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
   jac->g_lens      = NULL;
   jac->l_lens      = NULL;
   jac->psubcomm    = NULL;
+  jac->nthreads    = 1;
 
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCBJacobiGetSubKSP_C", PCBJacobiGetSubKSP_BJacobi));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCBJacobiSetTotalBlocks_C", PCBJacobiSetTotalBlocks_BJacobi));
@@ -842,20 +853,18 @@ static PetscErrorCode PCDestroy_BJacobi_Multiblock(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_BJacobi_Multiblock(PC pc)
 {
-  PC_BJacobi        *jac = (PC_BJacobi *)pc->data;
-  PetscInt           i, n_local = jac->n_local;
-  KSPConvergedReason reason;
+  PC_BJacobi *jac = (PC_BJacobi *)pc->data;
 
   PetscFunctionBegin;
-  for (i = 0; i < n_local; i++) {
-    PetscCall(KSPSetUp(jac->ksp[i]));
-    PetscCall(KSPGetConvergedReason(jac->ksp[i], &reason));
-    if (reason == KSP_DIVERGED_PC_FAILED) pc->failedreason = PC_SUBPC_ERROR;
-  }
+  PetscCall(PCSetUpSubKSPs_Private(pc, jac->nthreads, jac->n_local, jac->ksp));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc, Vec x, Vec y)
+/*
+   Solves with all the blocks, with their work vectors pointing to the subparts of the arrays of x and y; each block has its own
+   work vectors so that the solves may run concurrently
+*/
+static PetscErrorCode PCApplyOnBlocks_BJacobi_Multiblock(PC pc, Vec x, Vec y, PetscBool transpose)
 {
   PC_BJacobi            *jac = (PC_BJacobi *)pc->data;
   PetscInt               i, n_local = jac->n_local;
@@ -874,12 +883,9 @@ static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc, Vec x, Vec y)
     */
     PetscCall(VecPlaceArray(bjac->x[i], xin + bjac->starts[i]));
     PetscCall(VecPlaceArray(bjac->y[i], yin + bjac->starts[i]));
-
-    PetscCall(PetscLogEventBegin(PC_ApplyOnBlocks, jac->ksp[i], bjac->x[i], bjac->y[i], 0));
-    PetscCall(KSPSolve(jac->ksp[i], bjac->x[i], bjac->y[i]));
-    PetscCall(KSPCheckSolve(jac->ksp[i], pc, bjac->y[i]));
-    PetscCall(PetscLogEventEnd(PC_ApplyOnBlocks, jac->ksp[i], bjac->x[i], bjac->y[i], 0));
-
+  }
+  PetscCall(PCSolveSubKSPs_Private(pc, jac->nthreads, n_local, jac->ksp, bjac->x, bjac->y, transpose));
+  for (i = 0; i < n_local; i++) {
     PetscCall(VecResetArray(bjac->x[i]));
     PetscCall(VecResetArray(bjac->y[i]));
   }
@@ -888,6 +894,13 @@ static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc, Vec x, Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc, Vec x, Vec y)
+{
+  PetscFunctionBegin;
+  PetscCall(PCApplyOnBlocks_BJacobi_Multiblock(pc, x, y, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCApplySymmetricLeft_BJacobi_Multiblock(PC pc, Vec x, Vec y)
 {
   PC_BJacobi            *jac = (PC_BJacobi *)pc->data;
@@ -962,34 +975,8 @@ static PetscErrorCode PCApplySymmetricRight_BJacobi_Multiblock(PC pc, Vec x, Vec
 
 static PetscErrorCode PCApplyTranspose_BJacobi_Multiblock(PC pc, Vec x, Vec y)
 {
-  PC_BJacobi            *jac = (PC_BJacobi *)pc->data;
-  PetscInt               i, n_local = jac->n_local;
-  PC_BJacobi_Multiblock *bjac = (PC_BJacobi_Multiblock *)jac->data;
-  PetscScalar           *yin;
-  const PetscScalar     *xin;
-
   PetscFunctionBegin;
-  PetscCall(VecGetArrayRead(x, &xin));
-  PetscCall(VecGetArray(y, &yin));
-  for (i = 0; i < n_local; i++) {
-    /*
-       To avoid copying the subvector from x into a workspace we instead
-       make the workspace vector array point to the subpart of the array of
-       the global vector.
-    */
-    PetscCall(VecPlaceArray(bjac->x[i], xin + bjac->starts[i]));
-    PetscCall(VecPlaceArray(bjac->y[i], yin + bjac->starts[i]));
-
-    PetscCall(PetscLogEventBegin(PC_ApplyTransposeOnBlocks, jac->ksp[i], bjac->x[i], bjac->y[i], 0));
-    PetscCall(KSPSolveTranspose(jac->ksp[i], bjac->x[i], bjac->y[i]));
-    PetscCall(KSPCheckSolve(jac->ksp[i], pc, bjac->y[i]));
-    PetscCall(PetscLogEventEnd(PC_ApplyTransposeOnBlocks, jac->ksp[i], bjac->x[i], bjac->y[i], 0));
-
-    PetscCall(VecResetArray(bjac->x[i]));
-    PetscCall(VecResetArray(bjac->y[i]));
-  }
-  PetscCall(VecRestoreArrayRead(x, &xin));
-  PetscCall(VecRestoreArray(y, &yin));
+  PetscCall(PCApplyOnBlocks_BJacobi_Multiblock(pc, x, y, PETSC_TRUE));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
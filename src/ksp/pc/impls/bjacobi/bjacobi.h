@@ -17,6 +17,7 @@ typedef struct {
   PetscInt    *l_lens;         /* lens of each block */
   PetscInt    *g_lens;
   PetscSubcomm psubcomm; /* for multiple processors per block */
+  PetscInt     nthreads; /* number of OpenMP threads that set up and solve the blocks of this process concurrently */
 } PC_BJacobi;
 
 /*
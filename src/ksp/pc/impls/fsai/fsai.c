@@ -0,0 +1,350 @@
+/*
+   Factorized sparse approximate inverse, G^H G approximates the inverse of the SPD matrix A with G lower triangular and sparse
+*/
+#include <petsc/private/pcimpl.h> /*I "petscpc.h" I*/
+#include <petscblaslapack.h>
+#if PetscDefined(HAVE_OPENMP)
+  #include <omp.h>
+#endif
+
+typedef struct {
+  PetscInt  levels;   /* the pattern of G is the lower triangular part of the pattern of A^levels */
+  PetscInt  nthreads; /* number of OpenMP threads that compute the rows of G */
+  IS        is;       /* sorted global indices of the rows and columns of A coupled to the local rows of G */
+  Mat      *sub;      /* A(is, is) */
+  PetscInt *gi, *gj;  /* pattern of the local rows of G, column indices are positions in is */
+  PetscInt  maxlen;   /* largest number of nonzeros in a row of G */
+  Mat       G, Gt;    /* the factor and its Hermitian transpose, stored explicitly so that both products are forward SpMVs */
+  Vec       work;
+} PC_FSAI;
+
+/* computes the pattern of G, the index set of A needed by the local rows and the preallocated G */
+static PetscErrorCode PCFSAISetUpPattern(PC pc)
+{
+  PC_FSAI        *fsai = (PC_FSAI *)pc->data;
+  Mat             P = pc->pmat, Pk;
+  PetscInt        rstart, rend, cstart, cend, m, i, j, k, ncols, nidx, *idx, *dnz, *onz;
+  const PetscInt *cols;
+
+  PetscFunctionBegin;
+  if (fsai->levels > 1) PetscCall(MatMatMult(pc->pmat, pc->pmat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &P));
+  for (k = 2; k < fsai->levels; k++) {
+    PetscCall(MatMatMult(P, pc->pmat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Pk));
+    PetscCall(MatDestroy(&P));
+    P = Pk;
+  }
+  PetscCall(MatGetOwnershipRange(pc->pmat, &rstart, &rend));
+  PetscCall(MatGetOwnershipRangeColumn(pc->pmat, &cstart, &cend));
+  m = rend - rstart;
+  PetscCall(PetscMalloc1(m + 1, &fsai->gi));
+  PetscCall(PetscCalloc2(m, &dnz, m, &onz));
+  /* the pattern of row i of G is the sorted columns j <= i of row i of A^levels, always including the diagonal */
+  fsai->gi[0]  = 0;
+  fsai->maxlen = 0;
+  for (i = rstart; i < rend; i++) {
+    PetscInt len = 0;
+
+    if (fsai->levels) {
+      PetscCall(MatGetRow(P, i, &ncols, &cols, NULL));
+      for (j = 0; j < ncols && cols[j] < i; j++) len++;
+      PetscCall(MatRestoreRow(P, i, &ncols, &cols, NULL));
+    }
+    fsai->gi[i - rstart + 1] = fsai->gi[i - rstart] + len + 1;
+    fsai->maxlen             = PetscMax(fsai->maxlen, len + 1);
+  }
+  PetscCall(PetscMalloc1(fsai->gi[m], &fsai->gj));
+  for (i = rstart; i < rend; i++) {
+    PetscInt *gj = fsai->gj + fsai->gi[i - rstart], len = 0;
+
+    if (fsai->levels) {
+      PetscCall(MatGetRow(P, i, &ncols, &cols, NULL));
+      for (j = 0; j < ncols && cols[j] < i; j++) gj[len++] = cols[j];
+      PetscCall(MatRestoreRow(P, i, &ncols, &cols, NULL));
+    }
+    gj[len++] = i;
+    for (j = 0; j < len; j++) {
+      if (gj[j] >= cstart && gj[j] < cend) dnz[i - rstart]++;
+      else onz[i - rstart]++;
+    }
+  }
+  if (P != pc->pmat) PetscCall(MatDestroy(&P));
+
+  /* the rows of A needed by the local rows of G are the union of their patterns */
+  PetscCall(PetscMalloc1(fsai->gi[m], &idx));
+  PetscCall(PetscArraycpy(idx, fsai->gj, fsai->gi[m]));
+  nidx = fsai->gi[m];
+  PetscCall(PetscSortRemoveDupsInt(&nidx, idx));
+  for (k = 0; k < fsai->gi[m]; k++) PetscCall(PetscFindInt(fsai->gj[k], nidx, idx, &fsai->gj[k]));
+  PetscCall(ISCreateGeneral(PETSC_COMM_SELF, nidx, idx, PETSC_OWN_POINTER, &fsai->is));
+
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)pc), &fsai->G));
+  PetscCall(MatSetSizes(fsai->G, m, cend - cstart, PETSC_DETERMINE, PETSC_DETERMINE));
+  PetscCall(MatSetType(fsai->G, MATAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(fsai->G, 0, dnz));
+  PetscCall(MatMPIAIJSetPreallocation(fsai->G, 0, dnz, 0, onz));
+  PetscCall(MatSetOption(fsai->G, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE));
+  PetscCall(PetscFree2(dnz, onz));
+  PetscCall(MatCreateVecs(fsai->G, NULL, &fsai->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   computes the values of G from A(is, is), each row i being the solution of A(J, J) g = e_i, with J the pattern of the row, scaled so that
+   (G A G^H)_ii = 1
+
+   The rows are independent, so they are computed by OpenMP threads that each take the next row not yet computed. The threads only call
+   LAPACK and write to their own rows of gv; the values are inserted in G once they are all done.
+*/
+static PetscErrorCode PCFSAIComputeFactor(PC pc)
+{
+  PC_FSAI           *fsai = (PC_FSAI *)pc->data;
+  Mat                A;
+  PetscInt           rstart, rend, m, i, n, nfailed = 0, nonpos = -1, *cols;
+  const PetscInt    *ai, *aj, *gi = fsai->gi, *gj = fsai->gj, *idx;
+  const PetscScalar *aa;
+  PetscScalar       *gv, *work;
+  PetscBool          done;
+  int                nt = (int)PetscMax(fsai->nthreads, 1);
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateSubMatrices(pc->pmat, 1, &fsai->is, &fsai->is, fsai->sub ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, &fsai->sub));
+  A = fsai->sub[0];
+  PetscCall(MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ai, &aj, &done));
+  PetscCheck(done, PETSC_COMM_SELF, PETSC_ERR_SUP, "Cannot get the nonzero structure of the submatrix of type %s", ((PetscObject)A)->type_name);
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(MatGetOwnershipRange(pc->pmat, &rstart, &rend));
+  m = rend - rstart;
+  PetscCall(PetscMalloc2(gi[m], &gv, (size_t)nt * fsai->maxlen * (fsai->maxlen + 1), &work));
+
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(dynamic, 16) reduction(+:nfailed) if (nt > 1))
+  for (i = 0; i < m; i++) {
+    const PetscInt *J = gj + gi[i];
+    PetscInt        len = gi[i + 1] - gi[i], a, b, k, t = 0;
+    PetscScalar    *D, *x, *g = gv + gi[i];
+    PetscReal       diag;
+    PetscBLASInt    bn, one = 1, info;
+
+#if PetscDefined(HAVE_OPENMP)
+    t = omp_get_thread_num();
+#endif
+    D = work + (size_t)t * fsai->maxlen * (fsai->maxlen + 1);
+    x = D + len * len;
+    /* gathers A(J, J) by merging the sorted row of A with the sorted pattern */
+    for (a = 0; a < len; a++) {
+      for (b = 0; b < len; b++) D[a + b * len] = 0.0;
+      for (k = ai[J[a]], b = 0; k < ai[J[a] + 1] && b < len;) {
+        if (aj[k] < J[b]) k++;
+        else if (aj[k] > J[b]) b++;
+        else D[a + (b++) * len] = aa[k++];
+      }
+      x[a] = 0.0;
+    }
+    diag = PetscRealPart(D[len * len - 1]);
+    x[len - 1] = 1.0;
+    bn         = (PetscBLASInt)len;
+    LAPACKpotrf_("L", &bn, D, &bn, &info);
+    if (!info) LAPACKpotrs_("L", &bn, &one, D, &bn, x, &bn, &info);
+    if (!info && PetscRealPart(x[len - 1]) > 0.0) {
+      PetscReal s = 1.0 / PetscSqrtReal(PetscRealPart(x[len - 1]));
+
+      for (a = 0; a < len; a++) g[a] = PetscConj(x[a]) * s;
+    } else {
+      /* A(J, J) is not numerically positive definite, fall back to the Jacobi scaling for this row */
+      for (a = 0; a < len - 1; a++) g[a] = 0.0;
+      g[len - 1] = diag > 0.0 ? 1.0 / PetscSqrtReal(diag) : 0.0;
+      nfailed++;
+      if (diag <= 0.0) {
+        PetscPragmaOMP(critical)
+        nonpos = i;
+      }
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ai, &aj, &done));
+  PetscCheck(nonpos < 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "PCFSAI requires a symmetric positive definite matrix, row %" PetscInt_FMT " has a nonpositive diagonal entry", nonpos + rstart);
+  if (nfailed) PetscCall(PetscInfo(pc, "%" PetscInt_FMT " of %" PetscInt_FMT " local rows of the factor have been replaced by their Jacobi scaling\n", nfailed, m));
+
+  PetscCall(ISGetIndices(fsai->is, &idx));
+  PetscCall(PetscMalloc1(fsai->maxlen, &cols));
+  for (i = 0; i < m; i++) {
+    PetscInt row = i + rstart, len = gi[i + 1] - gi[i];
+
+    for (n = 0; n < len; n++) cols[n] = idx[gj[gi[i] + n]];
+    PetscCall(MatSetValues(fsai->G, 1, &row, len, cols, gv + gi[i], INSERT_VALUES));
+  }
+  PetscCall(PetscFree(cols));
+  PetscCall(ISRestoreIndices(fsai->is, &idx));
+  PetscCall(PetscFree2(gv, work));
+  PetscCall(MatAssemblyBegin(fsai->G, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(fsai->G, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatHermitianTranspose(fsai->G, fsai->Gt ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, &fsai->Gt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCReset_FSAI(PC pc)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  if (fsai->sub) PetscCall(MatDestroySubMatrices(1, &fsai->sub));
+  PetscCall(ISDestroy(&fsai->is));
+  PetscCall(PetscFree(fsai->gi));
+  PetscCall(PetscFree(fsai->gj));
+  PetscCall(MatDestroy(&fsai->G));
+  PetscCall(MatDestroy(&fsai->Gt));
+  PetscCall(VecDestroy(&fsai->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_FSAI(PC pc)
+{
+  PC_FSAI  *fsai = (PC_FSAI *)pc->data;
+  PetscBool isaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompareAny((PetscObject)pc->pmat, &isaij, MATSEQAIJ, MATMPIAIJ, ""));
+  PetscCheck(isaij, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "PCFSAI requires an AIJ matrix, not %s", ((PetscObject)pc->pmat)->type_name);
+  if (pc->setupcalled && pc->flag != SAME_NONZERO_PATTERN) PetscCall(PCReset_FSAI(pc));
+  if (!fsai->G) PetscCall(PCFSAISetUpPattern(pc));
+  PetscCall(PCFSAIComputeFactor(pc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->G, x, fsai->work));
+  PetscCall(MatMult(fsai->Gt, fsai->work, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMultTranspose(fsai->Gt, x, fsai->work));
+  PetscCall(MatMultTranspose(fsai->G, fsai->work, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplySymmetricLeft_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->G, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplySymmetricRight_FSAI(PC pc, Vec x, Vec y)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(fsai->Gt, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCDestroy_FSAI(PC pc)
+{
+  PetscFunctionBegin;
+  PetscCall(PCReset_FSAI(pc));
+  PetscCall(PetscFree(pc->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_FSAI(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_FSAI *fsai = (PC_FSAI *)pc->data;
+  PetscInt levels = fsai->levels;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "FSAI options");
+  PetscCall(PetscOptionsInt("-pc_fsai_levels", "The pattern of the factor is the lower triangular part of the pattern of A^levels", "None", levels, &levels, NULL));
+  PetscCheck(levels >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of levels %" PetscInt_FMT " must be nonnegative", levels);
+  if (levels != fsai->levels) {
+    PetscCall(PCReset_FSAI(pc));
+    fsai->levels = levels;
+  }
+  PetscCall(PetscOptionsInt("-pc_fsai_threads", "Number of OpenMP threads that compute the rows of the factor", "None", fsai->nthreads, &fsai->nthreads, NULL));
+#if !PetscDefined(HAVE_OPENMP)
+  PetscCheck(fsai->nthreads <= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP_SYS, "-pc_fsai_threads requires PETSc configured with OpenMP");
+#endif
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCView_FSAI(PC pc, PetscViewer viewer)
+{
+  PC_FSAI  *fsai = (PC_FSAI *)pc->data;
+  PetscBool iascii;
+  MatInfo   info;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  pattern of the factor from A^%" PetscInt_FMT "\n", fsai->levels));
+    if (fsai->nthreads > 1) PetscCall(PetscViewerASCIIPrintf(viewer, "  rows of the factor computed by %" PetscInt_FMT " OpenMP threads\n", fsai->nthreads));
+    if (fsai->G) {
+      PetscCall(MatGetInfo(fsai->G, MAT_GLOBAL_SUM, &info));
+      PetscCall(PetscViewerASCIIPrintf(viewer, "  nonzeros in the factor %g\n", info.nz_used));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+     PCFSAI - Factorized sparse approximate inverse preconditioner, M^{-1} = G^H G with G sparse and lower triangular such that G A G^H is
+     close to the identity
+
+   Options Database Keys:
++  -pc_fsai_levels <1> - the pattern of G is the lower triangular part of the pattern of A^levels, 0 gives the Jacobi preconditioner
+-  -pc_fsai_threads <1> - number of OpenMP threads that compute the rows of G
+
+   Level: intermediate
+
+   Notes:
+   Only for symmetric (Hermitian) positive definite matrices in `MATAIJ` format.
+
+   Applying the preconditioner is two sparse matrix-vector products, so unlike the triangular solves of `PCICC` or `PCILU` it is as parallel as
+   `MatMult()`. This makes it a scalable replacement for `PCJACOBI`, for example as smoother of `PCGAMG` with -mg_levels_pc_type fsai.
+   G^H is stored explicitly, so both products are forward products.
+
+   Each row of G is the solution of a small dense SPD system on the rows and columns of A in its pattern, so the rows are computed
+   independently. The rows and columns of A needed by the rows of a process, including those owned by other processes, are gathered once
+   with `MatCreateSubMatrices()`; the small systems are then solved with LAPACK, on -pc_fsai_threads OpenMP threads. Rows whose system
+   is not numerically positive definite are replaced by their Jacobi scaling, see -info.
+
+   With `KSPSetPCSide()` `PC_SYMMETRIC` the preconditioned operator is G A G^H.
+
+   References:
+.  * - L. Yu. Kolotilina and A. Yu. Yeremin, "Factorized sparse approximate inverse preconditionings I. Theory",
+   SIAM J. Matrix Anal. Appl., 1993.
+
+.seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCJACOBI`, `PCSPAI`, `PCICC`, `PCGAMG`
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_FSAI(PC pc)
+{
+  PC_FSAI *fsai;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&fsai));
+  fsai->levels   = 1;
+  fsai->nthreads = 1;
+  pc->data       = (void *)fsai;
+
+  pc->ops->apply               = PCApply_FSAI;
+  pc->ops->applytranspose      = PCApplyTranspose_FSAI;
+  pc->ops->applysymmetricleft  = PCApplySymmetricLeft_FSAI;
+  pc->ops->applysymmetricright = PCApplySymmetricRight_FSAI;
+  pc->ops->setup               = PCSetUp_FSAI;
+  pc->ops->reset               = PCReset_FSAI;
+  pc->ops->destroy             = PCDestroy_FSAI;
+  pc->ops->setfromoptions      = PCSetFromOptions_FSAI;
+  pc->ops->view                = PCView_FSAI;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,623 @@
+/*
+   Polynomial preconditioner, y = p(A) x with p a fixed polynomial approximating the inverse of A, computed once at setup
+*/
+#include <petsc/private/pcimpl.h>  /*I "petscpc.h" I*/
+#include <petsc/private/kspimpl.h> /* for KSPSetNoisy_Private() */
+#include <petscblaslapack.h>
+
+const char *const PCPolyTypes[] = {"gmres", "chebyshev", "PCPolyType", "PC_POLY_", NULL};
+
+typedef struct {
+  PCPolyType type;
+  PetscInt   degree;     /* degree of p, that is the number of products with A in each application */
+  PetscReal  emin, emax; /* interval of the Chebyshev polynomial */
+  PetscBool  userbounds; /* emin and emax were provided by the user, otherwise they are estimated at setup */
+  PetscInt   nroots;     /* number of roots of the GMRES residual polynomial 1 - x p(x), degree + 1 unless Arnoldi broke down */
+  PetscReal *re, *im;    /* Leja ordered roots, in real arithmetic the complex conjugate pairs are adjacent with the positive imaginary part first */
+  Vec        work[3];
+} PC_Poly;
+
+static inline Mat PCPolyGetOperator_Private(PC pc)
+{
+  return pc->useAmat ? pc->mat : pc->pmat;
+}
+
+/*
+   Runs m steps of Arnoldi with classical Gram-Schmidt and reorthogonalization from a fixed vector and returns the (m + 1) x m Hessenberg
+   matrix H with leading dimension m + 1. On a breakdown m is reduced to the dimension of the invariant subspace that was found.
+*/
+static PetscErrorCode PCPolyArnoldi(PC pc, PetscInt *m, PetscScalar *H)
+{
+  Mat          A = PCPolyGetOperator_Private(pc);
+  Vec         *V;
+  PetscScalar *h;
+  PetscReal    nrm, anrm;
+  PetscInt     k, j, ld = *m + 1;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicateVecs(((PC_Poly *)pc->data)->work[0], ld, &V));
+  PetscCall(PetscMalloc1(ld, &h));
+  PetscCall(PetscArrayzero(H, ld * *m));
+  PetscCall(KSPSetNoisy_Private(V[0]));
+  PetscCall(VecNormalize(V[0], NULL));
+  for (k = 0; k < *m; k++) {
+    PetscCall(MatMult(A, V[k], V[k + 1]));
+    PetscCall(VecNorm(V[k + 1], NORM_2, &anrm));
+    for (PetscInt pass = 0; pass < 2; pass++) {
+      PetscCall(VecMDot(V[k + 1], k + 1, V, h));
+      for (j = 0; j <= k; j++) {
+        H[j + k * ld] += h[j];
+        h[j] = -h[j];
+      }
+      PetscCall(VecMAXPY(V[k + 1], k + 1, h, V));
+    }
+    PetscCall(VecNorm(V[k + 1], NORM_2, &nrm));
+    H[k + 1 + k * ld] = nrm;
+    if (nrm <= 100 * PETSC_MACHINE_EPSILON * anrm) {
+      PetscCall(PetscInfo(pc, "Arnoldi found an invariant subspace of dimension %" PetscInt_FMT "\n", k + 1));
+      *m = k + 1;
+      break;
+    }
+    PetscCall(VecScale(V[k + 1], 1.0 / nrm));
+  }
+  PetscCall(PetscFree(h));
+  PetscCall(VecDestroyVecs(ld, &V));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* eigenvalues of the m x m matrix H with leading dimension ld, which is overwritten */
+static PetscErrorCode PCPolyEigenvalues(PetscInt m, PetscInt ld, PetscScalar *H, PetscReal *re, PetscReal *im)
+{
+  PetscBLASInt bm, bld, lwork, idummy = 1, info;
+  PetscScalar *work, sdummy = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(m, &bm));
+  PetscCall(PetscBLASIntCast(ld, &bld));
+  PetscCall(PetscBLASIntCast(5 * m, &lwork));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc1(lwork, &work));
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bm, H, &bld, re, im, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, &info));
+#else
+  {
+    PetscReal *rwork;
+
+    PetscCall(PetscMalloc2(lwork + m, &work, 2 * m, &rwork));
+    PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bm, H, &bld, work + lwork, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, rwork, &info));
+    for (PetscInt i = 0; i < m; i++) {
+      re[i] = PetscRealPart(work[lwork + i]);
+      im[i] = PetscImaginaryPart(work[lwork + i]);
+    }
+    PetscCall(PetscFree(rwork));
+  }
+#endif
+  PetscCall(PetscFPTrapPop());
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine %d", (int)info);
+  PetscCall(PetscFree(work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Modified Leja ordering of the roots, which keeps the partial products of the residual polynomial bounded in the application. The next
+   root is the one that maximizes the product of its distances to the roots already taken; in real arithmetic the conjugate of a complex root
+   is taken right after it.
+*/
+static PetscErrorCode PCPolyLejaOrder(PetscInt n, PetscReal *re, PetscReal *im)
+{
+  PetscReal *ore, *oim, *score;
+  PetscBool *taken;
+  PetscInt   i, j, k = 0, next;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc4(n, &ore, n, &oim, n, &score, n, &taken));
+  /* the first root is the one of largest modulus */
+  for (i = 0; i < n; i++) {
+    score[i] = PetscSqrtReal(re[i] * re[i] + im[i] * im[i]);
+    taken[i] = PETSC_FALSE;
+  }
+  while (k < n) {
+    next = -1;
+    for (i = 0; i < n; i++) {
+      if (!taken[i] && (next < 0 || score[i] > score[next] || (score[i] == score[next] && im[i] > im[next]))) next = i;
+    }
+    ore[k]      = re[next];
+    oim[k++]    = im[next];
+    taken[next] = PETSC_TRUE;
+#if !defined(PETSC_USE_COMPLEX)
+    if (im[next] != 0.0) {
+      for (i = 0; i < n; i++) {
+        if (!taken[i] && re[i] == re[next] && im[i] == -im[next]) break;
+      }
+      PetscCheck(i < n, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Complex eigenvalue without its conjugate");
+      oim[k - 1] = PetscAbsReal(im[next]);
+      ore[k]     = re[i];
+      oim[k++]   = -PetscAbsReal(im[i]);
+      taken[i]   = PETSC_TRUE;
+    }
+#endif
+    for (i = 0; i < n; i++) {
+      if (taken[i]) continue;
+      score[i] = 0.0;
+      for (j = 0; j < k; j++) {
+        PetscReal dist = PetscSqrtReal(PetscSqr(re[i] - ore[j]) + PetscSqr(im[i] - oim[j]));
+
+        score[i] += dist > 0.0 ? PetscLogReal(dist) : PETSC_MIN_REAL;
+      }
+    }
+  }
+  PetscCall(PetscArraycpy(re, ore, n));
+  PetscCall(PetscArraycpy(im, oim, n));
+  PetscCall(PetscFree4(ore, oim, score, taken));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_Poly(PC pc)
+{
+  PC_Poly     *poly = (PC_Poly *)pc->data;
+  Mat          A    = PCPolyGetOperator_Private(pc);
+  PetscInt     m = poly->degree + 1, i;
+  PetscScalar *H, *Hm, *f;
+  PetscReal   *re, *im;
+
+  PetscFunctionBegin;
+  if (!poly->work[0]) {
+    PetscCall(MatCreateVecs(A, &poly->work[0], NULL));
+    PetscCall(VecDuplicate(poly->work[0], &poly->work[1]));
+    PetscCall(VecDuplicate(poly->work[0], &poly->work[2]));
+  }
+  if (poly->type == PC_POLY_CHEBYSHEV && poly->userbounds) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMalloc3((m + 1) * m, &H, m * m, &Hm, m, &f));
+  PetscCall(PetscMalloc2(m, &re, m, &im));
+  PetscCall(PCPolyArnoldi(pc, &m, H));
+  for (PetscInt j = 0; j < m; j++) PetscCall(PetscArraycpy(Hm + j * m, H + j * (poly->degree + 2), m));
+  if (poly->type == PC_POLY_CHEBYSHEV) {
+    /* the Ritz values of the Hessenberg matrix give the interval, enlarged at the top so that p(A) stays positive definite */
+    PetscCall(PCPolyEigenvalues(m, m, Hm, re, im));
+    poly->emin = PETSC_MAX_REAL;
+    poly->emax = 0.0;
+    for (i = 0; i < m; i++) {
+      poly->emin = PetscMin(poly->emin, re[i]);
+      poly->emax = PetscMax(poly->emax, re[i]);
+    }
+    poly->emax *= 1.1;
+    PetscCheck(poly->emin > 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_CONV_FAILED, "The Chebyshev polynomial requires an operator with eigenvalues of positive real part, estimated smallest %g", (double)poly->emin);
+    PetscCall(PetscInfo(pc, "Chebyshev interval [%g, %g] from %" PetscInt_FMT " Arnoldi steps\n", (double)poly->emin, (double)poly->emax, m));
+    PetscCall(PetscFree2(re, im));
+  } else {
+    /*
+       the roots of the GMRES residual polynomial are the harmonic Ritz values, the eigenvalues of Hm + h^2 Hm^{-H} e_m e_m^T with
+       h = H(m + 1, m), obtained by adding h^2 Hm^{-H} e_m to the last column of Hm
+    */
+    PetscScalar  h = H[m + (m - 1) * (poly->degree + 2)];
+    PetscBLASInt bm, one = 1, *ipiv, info;
+    PetscInt     nc;
+
+    if (PetscAbsScalar(h) > 0.0) {
+      PetscScalar *LU;
+
+      PetscCall(PetscBLASIntCast(m, &bm));
+      PetscCall(PetscMalloc2(m * m, &LU, m, &ipiv));
+      PetscCall(PetscArraycpy(LU, Hm, m * m));
+      PetscCall(PetscArrayzero(f, m));
+      f[m - 1] = 1.0;
+      PetscCallBLAS("LAPACKgetrf", LAPACKgetrf_(&bm, &bm, LU, &bm, ipiv, &info));
+      PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Singular Hessenberg matrix, the operator may be singular");
+      PetscCallBLAS("LAPACKgetrs", LAPACKgetrs_("C", &bm, &one, LU, &bm, ipiv, f, &bm, &info));
+      PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine %d", (int)info);
+      for (i = 0; i < m; i++) Hm[i + (m - 1) * m] += PetscSqr(PetscAbsScalar(h)) * f[i];
+      PetscCall(PetscFree2(LU, ipiv));
+    }
+    PetscCall(PCPolyEigenvalues(m, m, Hm, re, im));
+    for (i = 0; i < m; i++) PetscCheck(re[i] != 0.0 || im[i] != 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_CONV_FAILED, "Zero harmonic Ritz value, the operator may be singular");
+    PetscCall(PCPolyLejaOrder(m, re, im));
+    for (i = 0, nc = 0; i < m; i++) nc += im[i] != 0.0 ? 1 : 0;
+    PetscCall(PetscInfo(pc, "GMRES polynomial of degree %" PetscInt_FMT " from %" PetscInt_FMT " harmonic Ritz values, %" PetscInt_FMT " of them complex\n", m - 1, m, nc));
+    PetscCall(PetscFree(poly->re));
+    PetscCall(PetscFree(poly->im));
+    poly->re     = re;
+    poly->im     = im;
+    poly->nroots = m;
+  }
+  PetscCall(PetscFree3(H, Hm, f));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   y = p(A) x with p(x) = (1 - prod_i (1 - x / theta_i)) / x, using that p_k = p_{k-1} + pi_{k-1} / theta_k with pi_k the partial products.
+   A complex conjugate pair of roots is applied at once in real arithmetic. The last root needs no product with A.
+*/
+static PetscErrorCode PCApply_Poly_GMRES(PC pc, Vec x, Vec y, PetscBool transpose)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+  Mat      A    = PCPolyGetOperator_Private(pc);
+  Vec      prod = poly->work[0], Aprod = poly->work[1], tmp = poly->work[2];
+  PetscInt i = 0, n = poly->nroots;
+
+  PetscFunctionBegin;
+  PetscCall(VecCopy(x, prod));
+  while (i < n) {
+#if !defined(PETSC_USE_COMPLEX)
+    if (poly->im[i] != 0.0) {
+      PetscReal a = poly->re[i], mod = a * a + poly->im[i] * poly->im[i];
+
+      /* the real quadratic factor 1 - 2 a x / mod + x^2 / mod */
+      if (!transpose) PetscCall(MatMult(A, prod, Aprod));
+      else PetscCall(MatMultTranspose(A, prod, Aprod));
+      PetscCall(VecAXPBY(Aprod, 2.0 * a, -1.0, prod));
+      PetscCall(VecAXPBY(y, 1.0 / mod, i ? 1.0 : 0.0, Aprod));
+      if (i < n - 2) {
+        if (!transpose) PetscCall(MatMult(A, Aprod, tmp));
+        else PetscCall(MatMultTranspose(A, Aprod, tmp));
+        PetscCall(VecAXPY(prod, -1.0 / mod, tmp));
+      }
+      i += 2;
+      continue;
+    }
+#endif
+    {
+      PetscScalar theta = poly->re[i];
+
+#if defined(PETSC_USE_COMPLEX)
+      theta = PetscCMPLX(poly->re[i], poly->im[i]);
+#endif
+      PetscCall(VecAXPBY(y, 1.0 / theta, i ? 1.0 : 0.0, prod));
+      if (i < n - 1) {
+        if (!transpose) PetscCall(MatMult(A, prod, Aprod));
+        else PetscCall(MatMultTranspose(A, prod, Aprod));
+        PetscCall(VecAXPY(prod, -1.0 / theta, Aprod));
+      }
+      i++;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y = p(A) x with degree steps of the Chebyshev iteration for A y = x from a zero initial guess, which needs no inner products */
+static PetscErrorCode PCApply_Poly_Chebyshev(PC pc, Vec x, Vec y, PetscBool transpose)
+{
+  PC_Poly  *poly = (PC_Poly *)pc->data;
+  Mat       A    = PCPolyGetOperator_Private(pc);
+  Vec       r = poly->work[0], d = poly->work[1], Ad = poly->work[2];
+  PetscReal theta = 0.5 * (poly->emax + poly->emin), delta = 0.5 * (poly->emax - poly->emin), sigma = theta / delta, rho = 1.0 / sigma, rhonew;
+
+  PetscFunctionBegin;
+  PetscCall(VecCopy(x, r));
+  PetscCall(VecAXPBY(d, 1.0 / theta, 0.0, r));
+  PetscCall(VecCopy(d, y));
+  for (PetscInt k = 0; k < poly->degree; k++) {
+    if (!transpose) PetscCall(MatMult(A, d, Ad));
+    else PetscCall(MatMultTranspose(A, d, Ad));
+    PetscCall(VecAXPY(r, -1.0, Ad));
+    rhonew = 1.0 / (2.0 * sigma - rho);
+    /* d = 2 rhonew / delta r + rhonew rho d and y = y + d */
+    PetscCall(VecAXPBYPCZ(y, 2.0 * rhonew / delta, rhonew * rho, 1.0, r, d));
+    PetscCall(VecAXPBY(d, 2.0 * rhonew / delta, rhonew * rho, r));
+    rho = rhonew;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_Poly(PC pc, Vec x, Vec y)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  if (poly->type == PC_POLY_GMRES) PetscCall(PCApply_Poly_GMRES(pc, x, y, PETSC_FALSE));
+  else PetscCall(PCApply_Poly_Chebyshev(pc, x, y, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_Poly(PC pc, Vec x, Vec y)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  if (poly->type == PC_POLY_GMRES) PetscCall(PCApply_Poly_GMRES(pc, x, y, PETSC_TRUE));
+  else PetscCall(PCApply_Poly_Chebyshev(pc, x, y, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCReset_Poly(PC pc)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(poly->re));
+  PetscCall(PetscFree(poly->im));
+  poly->nroots = 0;
+  for (PetscInt i = 0; i < 3; i++) PetscCall(VecDestroy(&poly->work[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCDestroy_Poly(PC pc)
+{
+  PetscFunctionBegin;
+  PetscCall(PCReset_Poly(pc));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolyGetType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetDegree_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolyGetDegree_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetEigenvalues_C", NULL));
+  PetscCall(PetscFree(pc->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_Poly(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_Poly   *poly = (PC_Poly *)pc->data;
+  PCPolyType type;
+  PetscInt   degree, neig = 2;
+  PetscReal  eminmax[2] = {0., 0.};
+  PetscBool  flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Polynomial preconditioner options");
+  PetscCall(PetscOptionsEnum("-pc_poly_type", "Type of polynomial", "PCPolySetType", PCPolyTypes, (PetscEnum)poly->type, (PetscEnum *)&type, &flg));
+  if (flg) PetscCall(PCPolySetType(pc, type));
+  PetscCall(PetscOptionsInt("-pc_poly_degree", "Degree of the polynomial, the number of products with the matrix in each application", "PCPolySetDegree", poly->degree, &degree, &flg));
+  if (flg) PetscCall(PCPolySetDegree(pc, degree));
+  PetscCall(PetscOptionsRealArray("-pc_poly_chebyshev_eigenvalues", "Extreme eigenvalues of the Chebyshev interval", "PCPolySetEigenvalues", eminmax, &neig, &flg));
+  if (flg) {
+    PetscCheck(neig == 2, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_INCOMP, "-pc_poly_chebyshev_eigenvalues: must specify 2 parameters, min and max eigenvalues");
+    PetscCall(PCPolySetEigenvalues(pc, eminmax[1], eminmax[0]));
+  }
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCView_Poly(PC pc, PetscViewer viewer)
+{
+  PC_Poly  *poly = (PC_Poly *)pc->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  %s polynomial of degree %" PetscInt_FMT "\n", PCPolyTypes[poly->type], poly->type == PC_POLY_GMRES && poly->nroots ? poly->nroots - 1 : poly->degree));
+    if (poly->type == PC_POLY_CHEBYSHEV && poly->emax > 0.0) PetscCall(PetscViewerASCIIPrintf(viewer, "  eigenvalue interval [%g, %g]%s\n", (double)poly->emin, (double)poly->emax, poly->userbounds ? "" : " estimated with Arnoldi"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCPolySetType_Poly(PC pc, PCPolyType type)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  if (type != poly->type) {
+    poly->type      = type;
+    pc->setupcalled = 0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCPolyGetType_Poly(PC pc, PCPolyType *type)
+{
+  PetscFunctionBegin;
+  *type = ((PC_Poly *)pc->data)->type;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCPolySetDegree_Poly(PC pc, PetscInt degree)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCheck(degree >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Degree %" PetscInt_FMT " must be nonnegative", degree);
+  if (degree != poly->degree) {
+    poly->degree    = degree;
+    pc->setupcalled = 0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCPolyGetDegree_Poly(PC pc, PetscInt *degree)
+{
+  PetscFunctionBegin;
+  *degree = ((PC_Poly *)pc->data)->degree;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCPolySetEigenvalues_Poly(PC pc, PetscReal emax, PetscReal emin)
+{
+  PC_Poly *poly = (PC_Poly *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCheck(emax > emin && emin > 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_INCOMP, "Maximum eigenvalue must be larger than minimum eigenvalue, which must be positive: max %g min %g", (double)emax, (double)emin);
+  poly->emax       = emax;
+  poly->emin       = emin;
+  poly->userbounds = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCPolySetType - Sets the type of polynomial of a `PCPOLY` preconditioner
+
+  Logically Collective
+
+  Input Parameters:
++ pc   - the preconditioner context
+- type - `PC_POLY_GMRES` or `PC_POLY_CHEBYSHEV`
+
+  Options Database Key:
+. -pc_poly_type <gmres,chebyshev> - the type of polynomial
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `PCPOLY`, `PCPolyType`, `PCPolyGetType()`, `PCPolySetDegree()`
+@*/
+PetscErrorCode PCPolySetType(PC pc, PCPolyType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(pc, type, 2);
+  PetscTryMethod(pc, "PCPolySetType_C", (PC, PCPolyType), (pc, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCPolyGetType - Gets the type of polynomial of a `PCPOLY` preconditioner
+
+  Not Collective
+
+  Input Parameter:
+. pc - the preconditioner context
+
+  Output Parameter:
+. type - the type of polynomial
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `PCPOLY`, `PCPolyType`, `PCPolySetType()`
+@*/
+PetscErrorCode PCPolyGetType(PC pc, PCPolyType *type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscAssertPointer(type, 2);
+  PetscUseMethod(pc, "PCPolyGetType_C", (PC, PCPolyType *), (pc, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCPolySetDegree - Sets the degree of the polynomial of a `PCPOLY` preconditioner
+
+  Logically Collective
+
+  Input Parameters:
++ pc     - the preconditioner context
+- degree - the degree, which is the number of products with the matrix in each application of the preconditioner
+
+  Options Database Key:
+. -pc_poly_degree <degree> - the degree of the polynomial
+
+  Level: intermediate
+
+  Note:
+  With `PC_POLY_GMRES` the polynomial is computed from degree + 1 Arnoldi steps, so its degree is smaller if Arnoldi finds an invariant
+  subspace.
+
+.seealso: [](ch_ksp), `PCPOLY`, `PCPolyGetDegree()`, `PCPolySetType()`
+@*/
+PetscErrorCode PCPolySetDegree(PC pc, PetscInt degree)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, degree, 2);
+  PetscTryMethod(pc, "PCPolySetDegree_C", (PC, PetscInt), (pc, degree));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCPolyGetDegree - Gets the degree of the polynomial of a `PCPOLY` preconditioner
+
+  Not Collective
+
+  Input Parameter:
+. pc - the preconditioner context
+
+  Output Parameter:
+. degree - the degree of the polynomial
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `PCPOLY`, `PCPolySetDegree()`
+@*/
+PetscErrorCode PCPolyGetDegree(PC pc, PetscInt *degree)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscAssertPointer(degree, 2);
+  PetscUseMethod(pc, "PCPolyGetDegree_C", (PC, PetscInt *), (pc, degree));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCPolySetEigenvalues - Sets the interval of the Chebyshev polynomial of a `PCPOLY` preconditioner
+
+  Logically Collective
+
+  Input Parameters:
++ pc   - the preconditioner context
+. emax - the eigenvalue maximum estimate
+- emin - the eigenvalue minimum estimate
+
+  Options Database Key:
+. -pc_poly_chebyshev_eigenvalues emin,emax - extreme eigenvalues
+
+  Level: intermediate
+
+  Note:
+  Without this call the interval is estimated at setup from the Ritz values of degree + 1 Arnoldi steps, with the largest one enlarged by
+  10 percent.
+
+.seealso: [](ch_ksp), `PCPOLY`, `PC_POLY_CHEBYSHEV`, `PCPolySetType()`, `KSPChebyshevSetEigenvalues()`
+@*/
+PetscErrorCode PCPolySetEigenvalues(PC pc, PetscReal emax, PetscReal emin)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(pc, emax, 2);
+  PetscValidLogicalCollectiveReal(pc, emin, 3);
+  PetscTryMethod(pc, "PCPolySetEigenvalues_C", (PC, PetscReal, PetscReal), (pc, emax, emin));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+     PCPOLY - Polynomial preconditioner, y = p(A) x with p a fixed polynomial computed at setup such that p(A) approximates the inverse of A
+
+   Options Database Keys:
++  -pc_poly_type <gmres,chebyshev> - the type of polynomial, see `PCPolySetType()`
+.  -pc_poly_degree <5> - the degree of p, that is the number of products with the matrix in each application, see `PCPolySetDegree()`
+-  -pc_poly_chebyshev_eigenvalues emin,emax - the interval of the Chebyshev polynomial, see `PCPolySetEigenvalues()`
+
+   Level: intermediate
+
+   Notes:
+   Applying the preconditioner only takes products with the matrix and vector updates, no inner products, so it adds no global
+   reduction to the iterations of the outer `KSP`.
+
+   `PC_POLY_GMRES`, the default, is the GMRES polynomial of Loe and Morgan: 1 - x p(x) is the residual polynomial of degree + 1 steps of GMRES
+   from a fixed vector, applied in product form with its roots, the harmonic Ritz values, in modified Leja order. It suits nonsymmetric
+   matrices, but p(A) need not be positive definite for symmetric positive definite matrices.
+
+   `PC_POLY_CHEBYSHEV` applies degree + 1 steps of the Chebyshev iteration from a zero initial guess. For symmetric positive definite matrices
+   p(A) is then symmetric positive definite, so it can be used with `KSPCG`. The interval is estimated with Arnoldi unless it is set with
+   `PCPolySetEigenvalues()`.
+
+   The setup runs degree + 1 steps of Arnoldi with the matrix, which is the only time inner products are needed. The polynomial is in the
+   preconditioning matrix, or in the operator with `PCSetUseAmat()`.
+
+   References:
+.  * - J. A. Loe and R. B. Morgan, "Toward efficient polynomial preconditioning for GMRES", Numer. Linear Algebra Appl., 2022.
+
+.seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCPolyType`, `PCPolySetType()`, `PCPolySetDegree()`, `PCPolySetEigenvalues()`,
+          `KSPCHEBYSHEV`, `PCJACOBI`
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_Poly(PC pc)
+{
+  PC_Poly *poly;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&poly));
+  poly->type   = PC_POLY_GMRES;
+  poly->degree = 5;
+  pc->data     = (void *)poly;
+
+  pc->ops->apply          = PCApply_Poly;
+  pc->ops->applytranspose = PCApplyTranspose_Poly;
+  pc->ops->setup          = PCSetUp_Poly;
+  pc->ops->reset          = PCReset_Poly;
+  pc->ops->destroy        = PCDestroy_Poly;
+  pc->ops->setfromoptions = PCSetFromOptions_Poly;
+  pc->ops->view           = PCView_Poly;
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetType_C", PCPolySetType_Poly));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolyGetType_C", PCPolyGetType_Poly));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetDegree_C", PCPolySetDegree_Poly));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolyGetDegree_C", PCPolyGetDegree_Poly));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCPolySetEigenvalues_C", PCPolySetEigenvalues_Poly));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
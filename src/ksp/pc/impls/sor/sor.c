@@ -43,7 +43,7 @@ static PetscErrorCode PCApplyTranspose_SOR(PC pc, Vec x, Vec y)
 
   PetscFunctionBegin;
   PetscCall(MatIsSymmetricKnown(pc->pmat, &set, &sym));
-  PetscCheck(set && sym && (jac->sym == SOR_SYMMETRIC_SWEEP || jac->sym == SOR_LOCAL_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
+  PetscCheck(set && sym && ((jac->sym & ~SOR_MULTICOLOR) == SOR_SYMMETRIC_SWEEP || (jac->sym & ~SOR_MULTICOLOR) == SOR_LOCAL_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
   PetscCall(MatSOR(pc->pmat, x, jac->omega, (MatSORType)flag, jac->fshift, jac->its, jac->lits, y));
   PetscCall(MatFactorGetError(pc->pmat, (MatFactorError *)&pc->failedreason));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -67,7 +67,7 @@ static PetscErrorCode PCApplyRichardson_SOR(PC pc, Vec b, Vec y, Vec w, PetscRea
 static PetscErrorCode PCSetFromOptions_SOR(PC pc, PetscOptionItems *PetscOptionsObject)
 {
   PC_SOR   *jac = (PC_SOR *)pc->data;
-  PetscBool flg;
+  PetscBool flg, multicolor;
   PetscReal omega;
 
   PetscFunctionBegin;
@@ -89,6 +89,9 @@ static PetscErrorCode PCSetFromOptions_SOR(PC pc, PetscOptionItems *PetscOptions
   if (flg) PetscCall(PCSORSetSymmetric(pc, SOR_LOCAL_BACKWARD_SWEEP));
   PetscCall(PetscOptionsBoolGroupEnd("-pc_sor_local_forward", "use forward sweep locally", "PCSORSetSymmetric", &flg));
   if (flg) PetscCall(PCSORSetSymmetric(pc, SOR_LOCAL_FORWARD_SWEEP));
+  multicolor = (jac->sym & SOR_MULTICOLOR) ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(PetscOptionsBool("-pc_sor_multicolor", "sweep the rows color by color, concurrently within a color", "PCSORSetSymmetric", multicolor, &multicolor, NULL));
+  jac->sym = multicolor ? (MatSORType)(jac->sym | SOR_MULTICOLOR) : (MatSORType)(jac->sym & ~SOR_MULTICOLOR);
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -114,6 +117,7 @@ static PetscErrorCode PCView_SOR(PC pc, PetscViewer viewer)
     else if (sym & SOR_LOCAL_FORWARD_SWEEP) sortype = "local_forward";
     else if (sym & SOR_LOCAL_BACKWARD_SWEEP) sortype = "local_backward";
     else sortype = "unknown";
+    if (sym & SOR_MULTICOLOR) PetscCall(PetscViewerASCIIPrintf(viewer, "  multicolor ordering of the rows\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  type = %s, iterations = %" PetscInt_FMT ", local iterations = %" PetscInt_FMT ", omega = %g\n", sortype, jac->its, jac->lits, (double)jac->omega));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -297,19 +301,23 @@ PetscErrorCode PCSORGetIterations(PC pc, PetscInt *its, PetscInt *lits)
     SOR_LOCAL_BACKWARD_SWEEP
     SOR_LOCAL_SYMMETRIC_SWEEP
 .ve
+  optionally ORd with `SOR_MULTICOLOR`
 
   Options Database Keys:
 + -pc_sor_symmetric       - Activates symmetric version
 . -pc_sor_backward        - Activates backward version
 . -pc_sor_local_forward   - Activates local forward version
 . -pc_sor_local_symmetric - Activates local symmetric version
-- -pc_sor_local_backward  - Activates local backward version
+. -pc_sor_local_backward  - Activates local backward version
+- -pc_sor_multicolor      - Adds `SOR_MULTICOLOR`, sweeps the rows color by color
 
-  Note:
+  Notes:
   To use the Eisenstat trick with SSOR, employ the PCEISENSTAT preconditioner,
   which can be chosen with the option
 .  -pc_type eisenstat - Activates Eisenstat trick
 
+  With `SOR_MULTICOLOR` the `MATAIJ` formats relax the rows of one color concurrently with the threads of `-mat_seqaij_omp`, see `MatSOR()`
+
   Level: intermediate
 
 .seealso: `PCSOR`, `PCEisenstatSetOmega()`, `PCSORSetIterations()`, `PCSORSetOmega()`
@@ -396,7 +404,8 @@ PetscErrorCode PCSORSetIterations(PC pc, PetscInt its, PetscInt lits)
 .  -pc_sor_omega <omega> - Sets omega
 .  -pc_sor_diagonal_shift <shift> - shift the diagonal entries; useful if the matrix has zeros on the diagonal
 .  -pc_sor_its <its> - Sets number of iterations   (default 1)
--  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+.  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+-  -pc_sor_multicolor - Sweeps the rows color by color, the rows of one color are relaxed concurrently for `MATAIJ` with `-mat_seqaij_omp`
 
    Level: beginner
 
@@ -31,6 +31,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_Redistribute(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_SVD(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Kaczmarz(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_FSAI(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_Poly(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Telescope(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Patch(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_LMVM(PC);
@@ -120,6 +122,8 @@ PetscErrorCode PCRegisterAll(void)
   PetscCall(PCRegister(PCSVD, PCCreate_SVD));
   PetscCall(PCRegister(PCGAMG, PCCreate_GAMG));
   PetscCall(PCRegister(PCKACZMARZ, PCCreate_Kaczmarz));
+  PetscCall(PCRegister(PCFSAI, PCCreate_FSAI));
+  PetscCall(PCRegister(PCPOLY, PCCreate_Poly));
   PetscCall(PCRegister(PCTELESCOPE, PCCreate_Telescope));
   PetscCall(PCRegister(PCPATCH, PCCreate_Patch));
   PetscCall(PCRegister(PCHMG, PCCreate_HMG));
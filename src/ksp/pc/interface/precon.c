@@ -1104,6 +1104,78 @@ PetscErrorCode PCSetUpOnBlocks(PC pc)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCSetUpSubKSPs_Private - calls KSPSetUp(), and so the factorizations, on the n sequential sub-KSP of the local blocks of PCBJACOBI or
+   PCASM, on nthreads OpenMP threads that each take the next block not yet set up
+
+   The first block is set up alone so that what PETSc initializes on first use (packages, ordering and solver lists) is done by a
+   single thread. pc is marked with PC_SUBPC_ERROR once all the blocks are set up.
+*/
+PetscErrorCode PCSetUpSubKSPs_Private(PC pc, PetscInt nthreads, PetscInt n, KSP ksp[])
+{
+  PetscErrorCode     ierr = PETSC_SUCCESS;
+  KSPConvergedReason reason;
+  PetscInt           i;
+
+  PetscFunctionBegin;
+  if (n) PetscCall(KSPSetUp(ksp[0]));
+  PetscPragmaOMP(parallel for num_threads((int)nthreads) schedule(dynamic, 1) if (nthreads > 1))
+  for (i = 1; i < n; i++) {
+    PetscErrorCode ierr_i = KSPSetUp(ksp[i]);
+
+    if (ierr_i) {
+      PetscPragmaOMP(critical)
+      ierr = ierr_i;
+    }
+  }
+  PetscCall(ierr);
+  for (i = 0; i < n; i++) {
+    PetscCall(KSPGetConvergedReason(ksp[i], &reason));
+    if (reason == KSP_DIVERGED_PC_FAILED) pc->failedreason = PC_SUBPC_ERROR;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   PCSolveSubKSPs_Private - solves with the n sequential sub-KSP of the local blocks of PCBJACOBI or PCASM, x[i] and y[i] being the
+   right-hand side and the solution of block i, on nthreads OpenMP threads that each take the next block not yet solved
+
+   The solves only share read-only data; their failures are checked with KSPCheckSolve(), which updates pc, once they are all done.
+   With a single thread each block is logged in PC_ApplyOnBlocks, otherwise the whole loop is.
+*/
+PetscErrorCode PCSolveSubKSPs_Private(PC pc, PetscInt nthreads, PetscInt n, KSP ksp[], Vec x[], Vec y[], PetscBool transpose)
+{
+  PetscLogEvent  event = transpose ? PC_ApplyTransposeOnBlocks : PC_ApplyOnBlocks;
+  PetscErrorCode ierr  = PETSC_SUCCESS;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (nthreads <= 1) {
+    for (i = 0; i < n; i++) {
+      PetscCall(PetscLogEventBegin(event, ksp[i], x[i], y[i], 0));
+      if (!transpose) PetscCall(KSPSolve(ksp[i], x[i], y[i]));
+      else PetscCall(KSPSolveTranspose(ksp[i], x[i], y[i]));
+      PetscCall(KSPCheckSolve(ksp[i], pc, y[i]));
+      PetscCall(PetscLogEventEnd(event, ksp[i], x[i], y[i], 0));
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscLogEventBegin(event, pc, 0, 0, 0));
+  PetscPragmaOMP(parallel for num_threads((int)nthreads) schedule(dynamic, 1))
+  for (i = 0; i < n; i++) {
+    PetscErrorCode ierr_i = !transpose ? KSPSolve(ksp[i], x[i], y[i]) : KSPSolveTranspose(ksp[i], x[i], y[i]);
+
+    if (ierr_i) {
+      PetscPragmaOMP(critical)
+      ierr = ierr_i;
+    }
+  }
+  PetscCall(PetscLogEventEnd(event, pc, 0, 0, 0));
+  PetscCall(ierr);
+  for (i = 0; i < n; i++) PetscCall(KSPCheckSolve(ksp[i], pc, y[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PCSetModifySubMatrices - Sets a user-defined routine for modifying the
   submatrices that arise within certain subdomain-based preconditioners such as `PCASM`
@@ -71,7 +71,8 @@
       PetscEnum, parameter :: MAT_FORM_EXPLICIT_TRANSPOSE = 24
       PetscEnum, parameter :: MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25
       PetscEnum, parameter :: MAT_SPD_ETERNAL = 26
-      PetscEnum, parameter :: MAT_OPTION_MAX = 27
+      PetscEnum, parameter :: MAT_THREAD_SAFE_SET_VALUES = 27
+      PetscEnum, parameter :: MAT_OPTION_MAX = 28
 !
 !  MatFactorShiftType
 !
@@ -160,6 +161,7 @@
       PetscEnum, parameter :: SOR_EISENSTAT=32
       PetscEnum, parameter :: SOR_APPLY_UPPER=64
       PetscEnum, parameter :: SOR_APPLY_LOWER=128
+      PetscEnum, parameter :: SOR_MULTICOLOR=256
 !
 !  MatOperation
 !
@@ -477,6 +479,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_EISENSTAT
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_UPPER
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_LOWER
+!DEC$ ATTRIBUTES DLLEXPORT::SOR_MULTICOLOR
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_SET_VALUES
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_GET_ROWMATOP_RESTORE_ROW
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT
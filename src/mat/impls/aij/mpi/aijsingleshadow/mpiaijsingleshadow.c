@@ -0,0 +1,156 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+/*@C
+  MatCreateMPIAIJSingleShadow - Creates a sparse parallel matrix whose local
+  portions are stored as `MATSEQAIJSINGLESHADOW` matrices (a matrix class that inherits
+  from SEQAIJ but uses single precision values in some operations).
+
+  Collective
+
+  Input Parameters:
++ comm  - MPI communicator
+. m     - number of local rows (or `PETSC_DECIDE` to have calculated if `M` is given)
+           This value should be the same as the local size used in creating the
+           y vector for the matrix-vector product y = Ax.
+. n     - This value should be the same as the local size used in creating the
+       x vector for the matrix-vector product y = Ax. (or `PETSC_DECIDE` to have
+       calculated if `N` is given) For square matrices `n` is almost always `m`.
+. M     - number of global rows (or `PETSC_DETERMINE` to have calculated if `m` is given)
+. N     - number of global columns (or `PETSC_DETERMINE` to have calculated if `n` is given)
+. d_nz  - number of nonzeros per row in DIAGONAL portion of local submatrix
+           (same value is used for all local rows)
+. d_nnz - array containing the number of nonzeros in the various rows of the
+           DIAGONAL portion of the local submatrix (possibly different for each row)
+           or `NULL`, if `d_nz` is used to specify the nonzero structure.
+           The size of this array is equal to the number of local rows, i.e `m`.
+. o_nz  - number of nonzeros per row in the OFF-DIAGONAL portion of local
+           submatrix (same value is used for all local rows).
+- o_nnz - array containing the number of nonzeros in the various rows of the
+           OFF-DIAGONAL portion of the local submatrix (possibly different for
+           each row) or `NULL`, if `o_nz` is used to specify the nonzero
+           structure. The size of this array is equal to the number
+           of local rows, i.e `m`.
+
+  Output Parameter:
+. A - the matrix
+
+  Level: intermediate
+
+  Notes:
+  If the *_nnz parameter is given then the *_nz parameter is ignored
+
+  When calling this routine with a single process communicator, a matrix of
+  type `MATSEQAIJSINGLESHADOW` is returned.  If a matrix of type `MATMPIAIJSINGLESHADOW` is desired
+  for this type of communicator, use the construction mechanism
+.vb
+   MatCreate(...,&A);
+   MatSetType(A,MPIAIJSINGLESHADOW);
+   MatMPIAIJSetPreallocation(A,...);
+.ve
+
+.seealso: [](ch_matrices), `Mat`, [Sparse Matrix Creation](sec_matsparse), `MATSEQAIJSINGLESHADOW`, `MATMPIAIJSINGLESHADOW`, `MATAIJSINGLESHADOW`, `MatCreate()`, `MatCreateSeqAIJSingleShadow()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateMPIAIJSingleShadow(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt M, PetscInt N, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[], Mat *A)
+{
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, M, N));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (size > 1) {
+    PetscCall(MatSetType(*A, MATMPIAIJSINGLESHADOW));
+    PetscCall(MatMPIAIJSetPreallocation(*A, d_nz, d_nnz, o_nz, o_nnz));
+  } else {
+    PetscCall(MatSetType(*A, MATSEQAIJSINGLESHADOW));
+    PetscCall(MatSeqAIJSetPreallocation(*A, d_nz, d_nnz));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingleShadow(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingleShadow_SeqAIJ(Mat, MatType, MatReuse, Mat *);
+
+static PetscErrorCode MatMPIAIJSetPreallocation_MPIAIJSingleShadow(Mat B, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetPreallocation_MPIAIJ(B, d_nz, d_nnz, o_nz, o_nnz));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingleShadow(b->A, MATSEQAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &b->A));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingleShadow(b->B, MATSEQAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &b->B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Converts the diagonal and off-diagonal blocks back to MATSEQAIJ, dropping their single precision shadows */
+static PetscErrorCode MatConvert_MPIAIJSingleShadow_MPIAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat         B = *newmat;
+  Mat_MPIAIJ *b;
+  PetscBool   flg;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  b = (Mat_MPIAIJ *)B->data;
+
+  if (b->A) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)b->A, MATSEQAIJSINGLESHADOW, &flg));
+    if (flg) PetscCall(MatConvert_SeqAIJSingleShadow_SeqAIJ(b->A, MATSEQAIJ, MAT_INPLACE_MATRIX, &b->A));
+  }
+  if (b->B) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)b->B, MATSEQAIJSINGLESHADOW, &flg));
+    if (flg) PetscCall(MatConvert_SeqAIJSingleShadow_SeqAIJ(b->B, MATSEQAIJ, MAT_INPLACE_MATRIX, &b->B));
+  }
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaijsingleshadow_mpiaij_C", NULL));
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSingleShadow(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat         B = *newmat;
+  Mat_MPIAIJ *b;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  b = (Mat_MPIAIJ *)B->data;
+
+  /* An assembled matrix, e.g. a Pmat converted in place, already has its diagonal and off-diagonal blocks */
+  if (b->A) PetscCall(MatConvert_SeqAIJ_SeqAIJSingleShadow(b->A, MATSEQAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &b->A));
+  if (b->B) PetscCall(MatConvert_SeqAIJ_SeqAIJSingleShadow(b->B, MATSEQAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &b->B));
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJSINGLESHADOW));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIAIJSingleShadow));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaijsingleshadow_mpiaij_C", MatConvert_MPIAIJSingleShadow_MPIAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSingleShadow(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATMPIAIJ));
+  PetscCall(MatConvert_MPIAIJ_MPIAIJSingleShadow(A, MATMPIAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATAIJSINGLESHADOW - "AIJSINGLESHADOW" - A matrix type to be used for sparse matrices whose `MatMult()`, `MatMultAdd()` and `MatSOR()`
+   read a single precision shadow of the nonzero values and accumulate in `PetscScalar`, see `MATSEQAIJSINGLESHADOW`.
+
+   The `PetscScalar` values are kept, so the shadow saves memory bandwidth in these kernels but adds 4 bytes per nonzero
+   to the memory footprint. `MatConvert()` to `MATAIJ` drops the shadow.
+
+   This matrix type is identical to `MATSEQAIJSINGLESHADOW` when constructed with a single process communicator,
+   and `MATMPIAIJSINGLESHADOW` otherwise.  As a result, for single process communicators,
+   `MatSeqAIJSetPreallocation()` is supported, and similarly `MatMPIAIJSetPreallocation()` is supported
+   for communicators controlling multiple processes.  It is recommended that you call both of
+   the above preallocation routines for simplicity.
+
+   Options Database Key:
+. -mat_type aijsingleshadow - sets the matrix type to `MATAIJSINGLESHADOW`
+
+  Level: intermediate
+
+.seealso: [](ch_matrices), `Mat`, `MatCreateMPIAIJSingleShadow()`, `MATSEQAIJSINGLESHADOW`, `MATMPIAIJSINGLESHADOW`, `MATSEQAIJ`, `MATMPIAIJ`, `MATSEQAIJSELL`, `MATMPIAIJSELL`
+M*/
@@ -68,6 +68,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIAIJSetUseScalableIncreaseOverlap_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsingleshadow_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaijsingleshadow_mpiaij_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijmkl_C", NULL));
 #endif
@@ -124,7 +126,7 @@ static PetscErrorCode MatRestoreRowIJ_MPIAIJ(Mat A, PetscInt oshift, PetscBool s
   Developer Note:
   Level: beginner
 
-    Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJMKL`, `MATAIJCRL`, `MATAIJKOKKOS`,and also automatically switches over to use inodes when
+    Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJSINGLESHADOW`, `MATAIJMKL`, `MATAIJCRL`, `MATAIJKOKKOS`,and also automatically switches over to use inodes when
    enough exist.
 
 .seealso: [](ch_matrices), `Mat`, `MATMPIAIJ`, `MATSEQAIJ`, `MatCreateAIJ()`, `MatCreateSeqAIJ()`, `MATSEQAIJ`, `MATMPIAIJ`
@@ -616,6 +618,82 @@ PetscErrorCode MatSetValues_MPIAIJ(Mat mat, PetscInt m, const PetscInt im[], Pet
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatSetValues() for MAT_THREAD_SAFE_SET_VALUES: the local rows are updated with atomic operations in the fixed nonzero
+   patterns of the diagonal and off-diagonal blocks, the off-process rows go to the stash of the calling thread.
+   Like MatSetValues_SeqAIJ_ThreadSafe() there is no PetscFunctionBegin, the global columns of the off-diagonal block are
+   found by bisection in the sorted garray instead of the colmap and, without --with-threadsafety, the stash is only
+   called in a critical section because it uses the error stack and may allocate traced memory. The errors are recorded
+   with MatThreadSafeSetError_Private() and raised by MatAssemblyBegin().
+*/
+static PetscErrorCode MatSetValues_MPIAIJ_ThreadSafe(Mat mat, PetscInt m, const PetscInt im[], PetscInt n, const PetscInt in[], const PetscScalar v[], InsertMode addv)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ *)mat->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)aij->A->data, *b = (Mat_SeqAIJ *)aij->B->data;
+  PetscScalar     value = 0.0;
+  PetscInt        i, j, row, col, low, high, t, nonew, rstart = mat->rmap->rstart, rend = mat->rmap->rend;
+  PetscInt        cstart = mat->cmap->rstart, cend = mat->cmap->rend, nb = aij->B->cmap->n;
+  const PetscInt *garray = aij->garray;
+  PetscBool       roworiented = aij->roworiented, ignorezeroentries = a->ignorezeroentries, found;
+  PetscErrorCode  ierr = PETSC_SUCCESS;
+
+  for (i = 0; i < m; i++) {
+    if (im[i] < 0) continue;
+    if (im[i] >= mat->rmap->N) {
+      MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_ROW, im[i], mat->rmap->N - 1, PETSC_SUCCESS);
+      return PETSC_SUCCESS;
+    }
+    if (im[i] >= rstart && im[i] < rend) {
+      row = im[i] - rstart;
+      for (j = 0; j < n; j++) {
+        if (in[j] < 0) continue;
+        if (in[j] >= mat->cmap->N) {
+          MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_COLUMN, in[j], mat->cmap->N - 1, PETSC_SUCCESS);
+          return PETSC_SUCCESS;
+        }
+        if (v) value = roworiented ? v[i * n + j] : v[i + j * m];
+        if (ignorezeroentries && value == 0.0 && addv == ADD_VALUES) continue;
+        if (in[j] >= cstart && in[j] < cend) {
+          found = MatSeqAIJSetValue_ThreadSafe_Private(a->j + a->i[row], a->a + a->i[row], a->ilen[row], in[j] - cstart, value, addv);
+          nonew = a->nonew;
+        } else {
+          for (low = 0, high = nb; low < high;) {
+            t = (low + high) / 2;
+            if (garray[t] < in[j]) low = t + 1;
+            else high = t;
+          }
+          col   = (low < nb && garray[low] == in[j]) ? low : -1;
+          found = col >= 0 ? MatSeqAIJSetValue_ThreadSafe_Private(b->j + b->i[row], b->a + b->i[row], b->ilen[row], col, value, addv) : PETSC_FALSE;
+          nonew = b->nonew;
+        }
+        if (!found && nonew != 1) {
+          MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_NEW_NONZERO, im[i], in[j], PETSC_SUCCESS);
+          return PETSC_SUCCESS;
+        }
+      }
+    } else {
+      if (mat->nooffprocentries) {
+        MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_OFF_PROC, im[i], 0, PETSC_SUCCESS);
+        return PETSC_SUCCESS;
+      }
+      if (!aij->donotstash) {
+#if !PetscDefined(HAVE_THREADSAFETY)
+        PetscPragmaOMP(critical)
+#endif
+        {
+          if (roworiented) ierr = MatStashValuesRow_Private(&mat->stash, im[i], n, in, v ? v + i * n : NULL, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));
+          else ierr = MatStashValuesCol_Private(&mat->stash, im[i], n, in, v ? v + i : NULL, m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));
+        }
+        if (ierr) {
+          MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_STASH, im[i], 0, ierr);
+          return PETSC_SUCCESS;
+        }
+      }
+    }
+  }
+  return PETSC_SUCCESS;
+}
+
 /*
     This function sets the j and ilen arrays (of the diagonal and off-diagonal part) of an MPIAIJ-matrix.
     The values in mat_i have to be sorted and the values in mat_j have to be sorted for each row (CSR-like).
@@ -1422,7 +1500,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_SYMMETRIC_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_SYMMETRIC_SWEEP | (flag & SOR_MULTICOLOR)), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_LOCAL_FORWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1438,7 +1516,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_FORWARD_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_FORWARD_SWEEP | (flag & SOR_MULTICOLOR)), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_LOCAL_BACKWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1454,7 +1532,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_BACKWARD_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_BACKWARD_SWEEP | (flag & SOR_MULTICOLOR)), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_EISENSTAT) {
     Vec xx1;
@@ -1706,6 +1784,22 @@ PetscErrorCode MatSetOption_MPIAIJ(Mat A, MatOption op, PetscBool flg)
   case MAT_STRUCTURE_ONLY:
     /* The option is handled directly by MatSetOption() */
     break;
+  case MAT_THREAD_SAFE_SET_VALUES:
+    MatCheckPreallocated(A, 1);
+    PetscCheck(!flg || A->assembled, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "MAT_THREAD_SAFE_SET_VALUES requires a matrix assembled with its final nonzero pattern");
+    PetscCall(MatSetOption(a->A, op, flg));
+    PetscCall(MatSetOption(a->B, op, flg));
+    PetscCall(MatStashSetThreadSafe_Private(&A->stash, flg));
+    PetscCall(MatThreadSafeSetUpErrors_Private(A, flg));
+    if (flg) {
+      if (!A->threadsafe_setvalues) A->setvalues_threadunsafe = A->ops->setvalues;
+      A->ops->setvalues = MatSetValues_MPIAIJ_ThreadSafe;
+    } else if (A->threadsafe_setvalues) {
+      A->ops->setvalues         = A->setvalues_threadunsafe;
+      A->setvalues_threadunsafe = NULL;
+    }
+    A->threadsafe_setvalues = flg;
+    break;
   default:
     SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "unknown option %d", op);
   }
@@ -5991,6 +6085,7 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSingleShadow(Mat, MatType, MatReuse, Mat *);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat, MatType, MatReuse, Mat *);
 #endif
@@ -6361,10 +6456,66 @@ static PetscErrorCode MatCOOStructDestroy_MPIAIJ(void *data)
   PetscCall(PetscFree(coo->Bjmap2));
   PetscCall(PetscFree(coo->Cperm1));
   PetscCall(PetscFree2(coo->sendbuf, coo->recvbuf));
+  for (PetscMPIInt i = 0; coo->reqs && i < coo->nsendranks + coo->nrecvranks; i++) PetscCallMPI(MPI_Request_free(&coo->reqs[i]));
+  PetscCall(PetscFree(coo->reqs));
+  PetscCall(PetscFree(coo->sendoffset));
   PetscCall(PetscFree(coo));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  MatCOOStructSetUpPlan_MPIAIJ - Creates persistent requests that send the packed remote values of MatSetValuesCOO() straight
+  from sendbuf and receive them straight into recvbuf, so that repeated assemblies (e.g., in a Newton loop) go through no
+  PetscSF machinery. The pack is done per destination rank and each send is started as soon as its part of sendbuf is ready.
+
+  The sf of MatSetPreallocationCOO_MPIAIJ() sends contiguous leafdata to contiguous rootdata. If the user selected another
+  PetscSF type, or the layout is not contiguous, no plan is created and MatSetValuesCOO_MPIAIJ() uses the sf.
+*/
+static PetscErrorCode MatCOOStructSetUpPlan_MPIAIJ(Mat mat, MatCOOStruct_MPIAIJ *coo)
+{
+  PetscSF            sf     = coo->sf;
+  PetscBool          contig = PETSC_TRUE, isbasic;
+  PetscMPIInt        rank, tag;
+  PetscInt           nranks, niranks;
+  const PetscInt    *roffset, *rmine, *ioffset, *irootloc;
+  const PetscMPIInt *ranks, *iranks;
+  MPI_Comm           comm;
+
+  PetscFunctionBegin;
+  coo->nsendranks = 0;
+  coo->nrecvranks = 0;
+  coo->sendoffset = NULL;
+  coo->reqs       = NULL;
+  PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFBASIC, &isbasic));
+  if (!isbasic) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscSFGetRootRanks(sf, &nranks, &ranks, &roffset, &rmine, NULL));
+  PetscCall(PetscSFGetLeafRanks(sf, &niranks, &iranks, &ioffset, &irootloc));
+
+  /* Leaves are sent in rank order from consecutive locations in sendbuf, roots of one rank are consecutive in recvbuf */
+  for (PetscInt i = 0; i < nranks; i++) {
+    if (ranks[i] == rank) contig = PETSC_FALSE;
+    for (PetscInt k = roffset[i]; k < roffset[i + 1]; k++) contig = (PetscBool)(contig && rmine[k] == k);
+  }
+  for (PetscInt i = 0; i < niranks; i++) {
+    if (iranks[i] == rank) contig = PETSC_FALSE;
+    for (PetscInt k = ioffset[i]; k < ioffset[i + 1]; k++) contig = (PetscBool)(contig && irootloc[k] == irootloc[ioffset[i]] + k - ioffset[i]);
+  }
+  if (!contig) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMPIIntCast(nranks, &coo->nsendranks));
+  PetscCall(PetscMPIIntCast(niranks, &coo->nrecvranks));
+  PetscCall(PetscMalloc1(nranks + 1, &coo->sendoffset));
+  PetscCall(PetscArraycpy(coo->sendoffset, roffset, nranks + 1));
+  PetscCall(PetscMalloc1(nranks + niranks, &coo->reqs));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag));
+  for (PetscInt i = 0; i < nranks; i++) PetscCallMPI(MPIU_Send_init(coo->sendbuf + roffset[i], roffset[i + 1] - roffset[i], MPIU_SCALAR, ranks[i], tag, comm, &coo->reqs[i]));
+  for (PetscInt i = 0; i < niranks; i++) PetscCallMPI(MPIU_Recv_init(coo->recvbuf + irootloc[ioffset[i]], ioffset[i + 1] - ioffset[i], MPIU_SCALAR, iranks[i], tag, comm, &coo->reqs[nranks + i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat, PetscCount coo_n, PetscInt coo_i[], PetscInt coo_j[])
 {
   MPI_Comm             comm;
@@ -6705,6 +6856,7 @@ PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat, PetscCount coo_n, PetscInt
   coo->Cperm1  = Cperm1;
   // Allocate in preallocation. If not used, it has zero cost on host
   PetscCall(PetscMalloc2(coo->sendlen, &coo->sendbuf, coo->recvlen, &coo->recvbuf));
+  PetscCall(MatCOOStructSetUpPlan_MPIAIJ(mat, coo));
   PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
   PetscCall(PetscContainerSetPointer(container, coo));
   PetscCall(PetscContainerSetUserDestroy(container, MatCOOStructDestroy_MPIAIJ));
@@ -6747,11 +6899,20 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
   PetscCall(MatSeqAIJGetArray(A, &Aa)); /* Might read and write matrix values */
   PetscCall(MatSeqAIJGetArray(B, &Ba));
 
-  /* Pack entries to be sent to remote */
-  for (PetscCount i = 0; i < coo->sendlen; i++) sendbuf[i] = v[Cperm1[i]];
+  if (coo->reqs) {
+    /* Receive straight into recvbuf and start the send to a rank as soon as its entries are packed */
+    if (coo->nrecvranks) PetscCallMPI(MPI_Startall(coo->nrecvranks, coo->reqs + coo->nsendranks));
+    for (PetscMPIInt r = 0; r < coo->nsendranks; r++) {
+      for (PetscInt i = coo->sendoffset[r]; i < coo->sendoffset[r + 1]; i++) sendbuf[i] = v[Cperm1[i]];
+      PetscCallMPI(MPI_Start(&coo->reqs[r]));
+    }
+  } else {
+    /* Pack entries to be sent to remote */
+    for (PetscCount i = 0; i < coo->sendlen; i++) sendbuf[i] = v[Cperm1[i]];
 
-  /* Send remote entries to their owner and overlap the communication with local computation */
-  PetscCall(PetscSFReduceWithMemTypeBegin(coo->sf, MPIU_SCALAR, PETSC_MEMTYPE_HOST, sendbuf, PETSC_MEMTYPE_HOST, recvbuf, MPI_REPLACE));
+    /* Send remote entries to their owner and overlap the communication with local computation */
+    PetscCall(PetscSFReduceWithMemTypeBegin(coo->sf, MPIU_SCALAR, PETSC_MEMTYPE_HOST, sendbuf, PETSC_MEMTYPE_HOST, recvbuf, MPI_REPLACE));
+  }
   /* Add local entries to A and B */
   for (PetscCount i = 0; i < coo->Annz; i++) { /* All nonzeros in A are either zero'ed or added with a value (i.e., initialized) */
     PetscScalar sum = 0.0;                     /* Do partial summation first to improve numerical stability */
@@ -6763,7 +6924,9 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
     for (PetscCount k = Bjmap1[i]; k < Bjmap1[i + 1]; k++) sum += v[Bperm1[k]];
     Ba[i] = (imode == INSERT_VALUES ? 0.0 : Ba[i]) + sum;
   }
-  PetscCall(PetscSFReduceEnd(coo->sf, MPIU_SCALAR, sendbuf, recvbuf, MPI_REPLACE));
+  if (coo->reqs) {
+    if (coo->nsendranks + coo->nrecvranks) PetscCallMPI(MPI_Waitall(coo->nsendranks + coo->nrecvranks, coo->reqs, MPI_STATUSES_IGNORE));
+  } else PetscCall(PetscSFReduceEnd(coo->sf, MPIU_SCALAR, sendbuf, recvbuf, MPI_REPLACE));
 
   /* Add received remote entries to A and B */
   for (PetscCount i = 0; i < coo->Annz2; i++) {
@@ -6842,6 +7005,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatDiagonalScaleLocal_C", MatDiagonalScaleLocal_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijperm_C", MatConvert_MPIAIJ_MPIAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsell_C", MatConvert_MPIAIJ_MPIAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsingleshadow_C", MatConvert_MPIAIJ_MPIAIJSingleShadow));
 #if defined(PETSC_HAVE_CUDA)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijcusparse_C", MatConvert_MPIAIJ_MPIAIJCUSPARSE));
 #endif
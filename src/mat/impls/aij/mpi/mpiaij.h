@@ -82,6 +82,9 @@ typedef struct {
   PetscCount  *Cperm1;                     /* [sendlen] Permutation to fill MPI send buffer. 'C' for communication */
   PetscScalar *sendbuf, *recvbuf;          /* Buffers for remote values in MatSetValuesCOO() */
   PetscInt     sendlen, recvlen;           /* Lengths (in unit of PetscScalar) of send/recvbuf */
+  PetscMPIInt  nsendranks, nrecvranks;     /* Number of ranks to send remote values to and to receive them from */
+  PetscInt    *sendoffset;                 /* [nsendranks+1] Offsets of the ranks in sendbuf */
+  MPI_Request *reqs;                       /* [nsendranks+nrecvranks] Persistent requests on send/recvbuf, NULL to communicate with sf instead */
 } MatCOOStruct_MPIAIJ;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
@@ -25,6 +25,7 @@ static PetscErrorCode MatSeqAIJSetTypeFromOptions(Mat A)
   PetscObjectOptionsBegin((PetscObject)A);
   PetscCall(PetscOptionsFList("-mat_seqaij_type", "Matrix SeqAIJ type", "MatSeqAIJSetType", MatSeqAIJList, "seqaij", type, 256, &flg));
   if (flg) PetscCall(MatSeqAIJSetType(A, type));
+  PetscCall(PetscOptionsInt("-mat_seqaij_auto_min_nz", "Smallest number of nonzeros for which -mat_seqaij_type auto times the candidates", "MatSeqAIJSetType", ((Mat_SeqAIJ *)A->data)->autominnz, &((Mat_SeqAIJ *)A->data)->autominnz, NULL));
   PetscOptionsEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -596,6 +597,44 @@ static PetscErrorCode MatSetValues_SeqAIJ_SortedFull(Mat A, PetscInt m, const Pe
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatSetValues() for MAT_THREAD_SAFE_SET_VALUES: the nonzero pattern is fixed and the values are updated with atomic operations.
+   Nothing here may write to data shared by the threads, hence a->a is accessed directly instead of with MatSeqAIJGetArray()
+   and no flops are logged; MatAssemblyEnd() increases the object state. There is no PetscFunctionBegin since the error stack
+   is not thread safe in PETSc configured without --with-threadsafety, the errors are recorded with MatThreadSafeSetError_Private()
+   and raised by MatAssemblyBegin().
+*/
+static PetscErrorCode MatSetValues_SeqAIJ_ThreadSafe(Mat A, PetscInt m, const PetscInt im[], PetscInt n, const PetscInt in[], const PetscScalar v[], InsertMode is)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscInt    k, l, row, col;
+  PetscScalar value = 0.0;
+
+  for (k = 0; k < m; k++) { /* loop over added rows */
+    row = im[k];
+    if (row < 0) continue;
+    if (row >= A->rmap->n) {
+      MatThreadSafeSetError_Private(A, MAT_THREADSAFE_ERROR_ROW, row, A->rmap->n - 1, PETSC_SUCCESS);
+      return PETSC_SUCCESS;
+    }
+    for (l = 0; l < n; l++) { /* loop over added columns */
+      col = in[l];
+      if (col < 0) continue;
+      if (col >= A->cmap->n) {
+        MatThreadSafeSetError_Private(A, MAT_THREADSAFE_ERROR_COLUMN, col, A->cmap->n - 1, PETSC_SUCCESS);
+        return PETSC_SUCCESS;
+      }
+      if (v) value = a->roworiented ? v[l + k * n] : v[k + l * m];
+      if (value == 0.0 && a->ignorezeroentries && is == ADD_VALUES) continue;
+      if (!MatSeqAIJSetValue_ThreadSafe_Private(a->j + a->i[row], a->a + a->i[row], a->ilen[row], col, value, is) && a->nonew != 1) {
+        MatThreadSafeSetError_Private(A, MAT_THREADSAFE_ERROR_NEW_NONZERO, row, col, PETSC_SUCCESS);
+        return PETSC_SUCCESS;
+      }
+    }
+  }
+  return PETSC_SUCCESS;
+}
+
 static PetscErrorCode MatGetValues_SeqAIJ(Mat A, PetscInt m, const PetscInt im[], PetscInt n, const PetscInt in[], PetscScalar v[])
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
@@ -716,7 +755,13 @@ static PetscErrorCode MatView_SeqAIJ_ASCII(Mat A, PetscViewer viewer)
   }
 
   PetscCall(PetscViewerGetFormat(viewer, &format));
-  if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+  if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO && a->trstart) PetscCall(PetscViewerASCIIPrintf(viewer, "using OpenMP kernels with %" PetscInt_FMT " threads\n", a->nthreads));
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO && a->autotype) PetscCall(PetscViewerASCIIPrintf(viewer, "MatMult() format will be selected at the first product\n"));
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO && a->autotuned) PetscCall(PetscViewerASCIIPrintf(viewer, "MatMult() format %s selected by timing the candidates\n", ((PetscObject)A)->type_name));
+    if (format != PETSC_VIEWER_ASCII_FACTOR_INFO && a->j32) PetscCall(PetscViewerASCIIPrintf(viewer, "using 32-bit column indices in the kernels\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   /* trigger copy to CPU if needed */
   PetscCall(MatSeqAIJGetArrayRead(A, &av));
@@ -1092,11 +1137,153 @@ PetscErrorCode MatView_SeqAIJ(Mat A, PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatSeqAIJSplitRowsByNonzeros_Private - Splits m rows with row offsets ii[] into nt contiguous chunks holding
+   (roughly) the same number of nonzeros; rstart[t] is the first row of chunk t and rstart[nt] = m
+*/
+PetscErrorCode MatSeqAIJSplitRowsByNonzeros_Private(PetscInt m, const PetscInt ii[], PetscInt nt, PetscInt rstart[])
+{
+  PetscInt   t, row = 0;
+  PetscInt64 nz = m ? ii[m] - ii[0] : 0;
+
+  PetscFunctionBegin;
+  rstart[0] = 0;
+  for (t = 1; t < nt; t++) {
+    const PetscInt64 target = (m ? ii[0] : 0) + (nz * t) / nt;
+
+    while (row < m && ii[row] < target) row++;
+    rstart[t] = row;
+  }
+  rstart[nt] = m;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJSetUpThreadPartition_Private - Computes the row partition used by the OpenMP kernels; it is called
+   once the nonzero structure (and the compressed row format) of the matrix is known
+*/
+PetscErrorCode MatSeqAIJSetUpThreadPartition_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(a->trstart));
+  if (a->nthreads <= 1 || !a->i) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(a->nthreads + 1, &a->trstart));
+  if (a->compressedrow.use) PetscCall(MatSeqAIJSplitRowsByNonzeros_Private(a->compressedrow.nrows, a->compressedrow.i, a->nthreads, a->trstart));
+  else PetscCall(MatSeqAIJSplitRowsByNonzeros_Private(A->rmap->n, a->i, a->nthreads, a->trstart));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Places the a and j arrays with the row partition and thread mapping of the OpenMP kernels, so that on NUMA machines the
+   pages of each chunk of rows are in the memory domain of the thread that multiplies them.
+
+   After the preallocation (assembled is PETSC_FALSE) the threads zero the arrays, splitting the preallocated rows; this is the
+   partition of the kernels when the preallocation is exact. Otherwise, once MatAssemblyEnd() has moved the rows to remove the
+   unused space or MatSetValues() has reallocated the arrays, the threads copy their rows of the partition computed by
+   MatSeqAIJSetUpThreadPartition_Private() into new arrays of the assembled size.
+*/
+static PetscErrorCode MatSeqAIJFirstTouch_Private(Mat A, PetscBool assembled)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt *ii, *rstart;
+  PetscInt       *trstart = NULL, *aj = a->j, *nj = NULL, *ni = NULL, t;
+  MatScalar      *aa = a->a, *na = NULL;
+  int             nt = (int)a->nthreads;
+
+  PetscFunctionBegin;
+  if (!assembled) {
+    ii = a->i;
+    PetscCall(PetscMalloc1(a->nthreads + 1, &trstart));
+    PetscCall(MatSeqAIJSplitRowsByNonzeros_Private(A->rmap->n, ii, a->nthreads, trstart));
+    rstart = trstart;
+  } else {
+    ii     = a->compressedrow.use ? a->compressedrow.i : a->i;
+    rstart = a->trstart;
+    PetscCall(PetscMalloc3(a->nz, &na, a->nz, &nj, A->rmap->n + 1, &ni));
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt k;
+
+    if (!assembled) {
+      for (k = ii[rstart[t]]; k < ii[rstart[t + 1]]; k++) {
+        aa[k] = 0.0;
+        aj[k] = 0;
+      }
+    } else {
+      for (k = ii[rstart[t]]; k < ii[rstart[t + 1]]; k++) {
+        na[k] = aa[k];
+        nj[k] = aj[k];
+      }
+    }
+  }
+  PetscCall(PetscFree(trstart));
+  if (assembled) {
+    PetscCall(PetscArraycpy(ni, a->i, A->rmap->n + 1));
+    PetscCall(MatSeqXAIJFreeAIJ(A, &a->a, &a->j, &a->i));
+    a->a            = na;
+    a->j            = nj;
+    a->i            = ni;
+    a->singlemalloc = PETSC_TRUE;
+    a->free_a       = PETSC_TRUE;
+    a->free_ij      = PETSC_TRUE;
+    a->maxnz        = a->nz;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+static PetscErrorCode MatSeqAIJFreeIndex32_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_64BIT_INDICES)
+  PetscCall(PetscFree(a->j32));
+#else
+  a->j32 = NULL; /* it is a->j */
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJSetUpIndex32_Private - Sets up the 32-bit column indices read by MatMult(), MatMultAdd(), MatMultTransposeAdd()
+   and MatSOR() with -mat_seqaij_index32. With 32-bit PetscInt they are the PetscInt indices themselves and nothing is
+   allocated; with 64-bit PetscInt a copy is made when the local number of columns fits in 32 bits. The PetscInt indices
+   cannot be freed since they are read directly by many other operations, such as MatGetRow() and the factorizations.
+*/
+PetscErrorCode MatSeqAIJSetUpIndex32_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJFreeIndex32_Private(A));
+  if (!a->index32 || !a->i || !a->j || A->structure_only) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_USE_64BIT_INDICES)
+  if (A->cmap->n > PETSC_INT32_MAX) {
+    PetscCall(PetscInfo(A, "Not using 32-bit column indices since there are %" PetscInt_FMT " local columns\n", A->cmap->n));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  {
+    PetscInt nz = a->i[A->rmap->n];
+
+    PetscCall(PetscMalloc1(nz, &a->j32));
+    for (PetscInt k = 0; k < nz; k++) a->j32[k] = (PetscInt32)a->j[k];
+  }
+#else
+  a->j32 = a->j;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
 {
   Mat_SeqAIJ *a      = (Mat_SeqAIJ *)A->data;
   PetscInt    fshift = 0, i, *ai = a->i, *aj = a->j, *imax = a->imax;
-  PetscInt    m = A->rmap->n, *ip, N, *ailen = a->ilen, rmax = 0;
+  PetscInt    m = A->rmap->n, *ip, N, *ailen = a->ilen, rmax = 0, reallocs = a->reallocs;
   MatScalar  *aa    = a->a, *ap;
   PetscReal   ratio = 0.6;
 
@@ -1152,6 +1339,12 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
   a->rmax             = rmax;
 
   if (!A->structure_only) PetscCall(MatCheckCompressedRow(A, a->nonzerorowcnt, &a->compressedrow, a->i, m, ratio));
+  PetscCall(MatSeqAIJSetUpThreadPartition_Private(A));
+#if defined(PETSC_HAVE_OPENMP)
+  /* the rows are no longer where MatSeqAIJSetPreallocation() had the threads place them */
+  if ((fshift || reallocs) && a->trstart && !A->structure_only && a->free_a && a->free_ij) PetscCall(MatSeqAIJFirstTouch_Private(A, PETSC_TRUE));
+#endif
+  PetscCall(MatSeqAIJSetUpIndex32_Private(A));
   PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1223,6 +1416,10 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(ISDestroy(&a->icol));
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
+  PetscCall(PetscFree(a->trstart));
+  PetscCall(PetscFree2(a->solve_levels, a->solve_rows));
+  PetscCall(PetscFree2(a->sor_colorptr, a->sor_colorrows));
+  PetscCall(MatSeqAIJFreeIndex32_Private(A));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
   PetscCall(PetscFree(A->data));
 
@@ -1243,6 +1440,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsingleshadow_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmkl_C", NULL));
 #endif
@@ -1288,6 +1486,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatFactorGetSolverType_C", NULL));
   /* these calls do not belong here: the subclasses Duplicate/Destroy are wrong */
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsell_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsingleshadow_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijperm_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijviennacl_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqdense_C", NULL));
@@ -1350,6 +1549,20 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A, MatOption op, PetscBool flg)
   case MAT_FORM_EXPLICIT_TRANSPOSE:
     A->form_explicit_transpose = flg;
     break;
+  case MAT_THREAD_SAFE_SET_VALUES:
+    if (flg) {
+      PetscCheck(PetscDefined(HAVE_OPENMP), PETSC_COMM_SELF, PETSC_ERR_SUP, "MAT_THREAD_SAFE_SET_VALUES requires PETSc configured with OpenMP");
+      PetscCheck(A->assembled, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "MAT_THREAD_SAFE_SET_VALUES requires a matrix assembled with its final nonzero pattern");
+      PetscCheck(!A->structure_only, PETSC_COMM_SELF, PETSC_ERR_SUP, "MAT_THREAD_SAFE_SET_VALUES is not for MAT_STRUCTURE_ONLY matrices");
+      if (!A->threadsafe_setvalues) A->setvalues_threadunsafe = A->ops->setvalues;
+      A->ops->setvalues = MatSetValues_SeqAIJ_ThreadSafe;
+    } else if (A->threadsafe_setvalues) {
+      A->ops->setvalues         = A->setvalues_threadunsafe;
+      A->setvalues_threadunsafe = NULL;
+    }
+    A->threadsafe_setvalues = flg;
+    PetscCall(MatThreadSafeSetUpErrors_Private(A, flg));
+    break;
   default:
     SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "unknown option %d", op);
   }
@@ -1424,16 +1637,27 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A, Vec xx, Vec zz, Vec yy)
   } else {
     ii = a->i;
   }
-  for (i = 0; i < m; i++) {
-    idx = a->j + ii[i];
-    v   = aa + ii[i];
-    n   = ii[i + 1] - ii[i];
-    if (usecprow) {
-      alpha = x[ridx[i]];
-    } else {
-      alpha = x[i];
+  if (a->j32) {
+    for (i = 0; i < m; i++) {
+      const PetscInt32 *idx32 = a->j32 + ii[i];
+
+      v     = aa + ii[i];
+      n     = ii[i + 1] - ii[i];
+      alpha = usecprow ? x[ridx[i]] : x[i];
+      for (j = 0; j < n; j++) y[idx32[j]] += alpha * v[j];
+    }
+  } else {
+    for (i = 0; i < m; i++) {
+      idx = a->j + ii[i];
+      v   = aa + ii[i];
+      n   = ii[i + 1] - ii[i];
+      if (usecprow) {
+        alpha = x[ridx[i]];
+      } else {
+        alpha = x[i];
+      }
+      for (j = 0; j < n; j++) y[idx[j]] += alpha * v[j];
     }
-    for (j = 0; j < n; j++) y[idx[j]] += alpha * v[j];
   }
 #endif
   PetscCall(PetscLogFlops(2.0 * a->nz));
@@ -1453,6 +1677,218 @@ PetscErrorCode MatMultTranspose_SeqAIJ(Mat A, Vec xx, Vec yy)
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
 
+/*
+   MatSeqAIJSelectType_Private - Converts A in place to the MATSEQAIJ subtype with the fastest MatMult(), as requested with
+   MatSeqAIJSetType(A, "auto"). It is called at the first product, so the candidates are timed on the actual matrix and
+   input vector; one untimed product per candidate builds the auxiliary data structures of the subtypes.
+*/
+static PetscErrorCode MatSeqAIJSelectType_Private(Mat A, Vec xx)
+{
+  Mat_SeqAIJ *a       = (Mat_SeqAIJ *)A->data;
+  MatType     types[] = {MATSEQAIJ, MATSEQAIJPERM, MATSEQAIJSELL,
+#if defined(PETSC_HAVE_MKL_SPARSE)
+                         MATSEQAIJMKL
+#endif
+  };
+  const PetscInt ntypes = PETSC_STATIC_ARRAY_LENGTH(types), its = 5;
+  PetscInt       t, k, best = 0;
+  PetscLogDouble t0, t1, tbest = PETSC_MAX_REAL;
+  PetscReal      avg;
+  Vec            w;
+
+  PetscFunctionBegin;
+  a->autotype = PETSC_FALSE;
+  avg         = a->nonzerorowcnt ? (PetscReal)a->nz / a->nonzerorowcnt : 0.0;
+  PetscCall(PetscInfo(A, "Selecting MatMult() format: %" PetscInt_FMT " nonzeros, %" PetscInt_FMT " nonzero rows, average row length %g, maximum row length %" PetscInt_FMT "\n", a->nz, a->nonzerorowcnt, (double)avg, a->rmax));
+  /* timings of small matrices are dominated by noise and call overhead */
+  if (a->nz < a->autominnz) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatCreateVecs(A, NULL, &w));
+  for (t = 0; t < ntypes; t++) {
+    Mat       B = A;
+    PetscBool sell;
+
+    if (t) {
+      /* sliced ELLPACK pads each slice to its longest row, which does not pay off for very irregular row lengths */
+      PetscCall(PetscStrcmp(types[t], MATSEQAIJSELL, &sell));
+      if (sell && a->rmax > 8 * avg) continue;
+      PetscCall(MatConvert(A, types[t], MAT_INITIAL_MATRIX, &B));
+      ((Mat_SeqAIJ *)B->data)->autotype = PETSC_FALSE;
+    }
+    PetscUseTypeMethod(B, mult, xx, w);
+    PetscCall(PetscTime(&t0));
+    for (k = 0; k < its; k++) PetscUseTypeMethod(B, mult, xx, w);
+    PetscCall(PetscTime(&t1));
+    PetscCall(PetscInfo(A, "MatMult() with %s takes %g seconds\n", types[t], (t1 - t0) / its));
+    if (t1 - t0 < tbest) {
+      tbest = t1 - t0;
+      best  = t;
+    }
+    if (B != A) PetscCall(MatDestroy(&B));
+  }
+  PetscCall(VecDestroy(&w));
+  PetscCall(PetscInfo(A, "Using %s for MatMult()\n", types[best]));
+  if (best) PetscCall(MatSeqAIJSetType(A, types[best]));
+  a->autotuned = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z = y + A x over the (compressed) rows using the 32-bit column indices; y may be NULL for z = A x */
+static inline void MatMultAdd_SeqAIJ_Index32_Kernel(PetscInt m, const PetscInt ii[], const PetscInt ridx[], const PetscInt32 j32[], const MatScalar a_a[], const PetscScalar x[], const PetscScalar y[], PetscScalar z[])
+{
+  PetscInt i;
+
+  for (i = 0; i < m; i++) {
+    const PetscInt    n   = ii[i + 1] - ii[i];
+    const PetscInt32 *aj  = j32 + ii[i];
+    const MatScalar  *aa  = a_a + ii[i];
+    const PetscInt    row = ridx ? ridx[i] : i;
+    PetscScalar       sum = y ? y[row] : 0.0;
+
+    PetscSparseDensePlusDot(sum, x, aa, aj, n);
+    z[row] = sum;
+  }
+}
+
+static PetscErrorCode MatMult_SeqAIJ_Index32(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (a->compressedrow.use) {
+    PetscCall(PetscArrayzero(y, A->rmap->n));
+    MatMultAdd_SeqAIJ_Index32_Kernel(a->compressedrow.nrows, a->compressedrow.i, a->compressedrow.rindex, a->j32, a_a, x, NULL, y);
+  } else MatMultAdd_SeqAIJ_Index32_Kernel(A->rmap->n, a->i, NULL, a->j32, a_a, x, NULL, y);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_Index32(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (a->compressedrow.use) {
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, A->rmap->n));
+    MatMultAdd_SeqAIJ_Index32_Kernel(a->compressedrow.nrows, a->compressedrow.i, a->compressedrow.rindex, a->j32, a_a, x, y, z);
+  } else MatMultAdd_SeqAIJ_Index32_Kernel(A->rmap->n, a->i, NULL, a->j32, a_a, x, y, z);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   The OpenMP kernels give thread t the rows [trstart[t], trstart[t+1]); with schedule(static, 1) and exactly nthreads
+   iterations the same thread always gets the same chunk, so the data it touches stays in its memory domain
+*/
+static inline PetscBool MatSeqAIJUseOpenMP_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  return (PetscBool)(a->trstart && a->trstart[a->nthreads] == (a->compressedrow.use ? a->compressedrow.nrows : A->rmap->n));
+}
+
+static PetscErrorCode MatMult_SeqAIJ_OpenMP(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+  const PetscInt    *ii, *ridx = NULL, *trstart = a->trstart;
+  PetscInt           t;
+  PetscBool          usecprow = a->compressedrow.use;
+  int                nt       = (int)a->nthreads;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (usecprow) {
+    PetscCall(PetscArrayzero(y, A->rmap->n));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else ii = a->i;
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt i;
+
+    for (i = trstart[t]; i < trstart[t + 1]; i++) {
+      const PetscInt   n  = ii[i + 1] - ii[i];
+      const PetscInt  *aj = a->j + ii[i];
+      const MatScalar *aa = a_a + ii[i];
+      PetscScalar      sum = 0.0;
+
+      PetscSparseDensePlusDot(sum, x, aa, aj, n);
+      y[usecprow ? ridx[i] : i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_OpenMP(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+  const PetscInt    *ii, *ridx = NULL, *trstart = a->trstart;
+  PetscInt           t;
+  PetscBool          usecprow = a->compressedrow.use;
+  int                nt       = (int)a->nthreads;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (usecprow) {
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, A->rmap->n));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else ii = a->i;
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt i;
+
+    for (i = trstart[t]; i < trstart[t + 1]; i++) {
+      const PetscInt   n   = ii[i + 1] - ii[i];
+      const PetscInt  *aj  = a->j + ii[i];
+      const MatScalar *aa  = a_a + ii[i];
+      const PetscInt   row = usecprow ? ridx[i] : i;
+      PetscScalar      sum = y[row];
+
+      PetscSparseDensePlusDot(sum, x, aa, aj, n);
+      z[row] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
@@ -1470,6 +1906,23 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->autotype) {
+    PetscCall(MatSeqAIJSelectType_Private(A, xx));
+    if (A->ops->mult != MatMult_SeqAIJ) {
+      PetscUseTypeMethod(A, mult, xx, yy);
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (MatSeqAIJUseOpenMP_Private(A)) {
+    PetscCall(MatMult_SeqAIJ_OpenMP(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  if (a->j32) {
+    PetscCall(MatMult_SeqAIJ_Index32(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMult_SeqAIJ_Inode(A, xx, yy));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -1629,6 +2082,23 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   PetscBool          usecprow = a->compressedrow.use;
 
   PetscFunctionBegin;
+  if (a->autotype) {
+    PetscCall(MatSeqAIJSelectType_Private(A, xx));
+    if (A->ops->multadd != MatMultAdd_SeqAIJ) {
+      PetscUseTypeMethod(A, multadd, xx, yy, zz);
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (MatSeqAIJUseOpenMP_Private(A)) {
+    PetscCall(MatMultAdd_SeqAIJ_OpenMP(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  if (a->j32) {
+    PetscCall(MatMultAdd_SeqAIJ_Index32(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMultAdd_SeqAIJ_Inode(A, xx, yy, zz));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -1873,7 +2343,7 @@ static PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A, PetscInt nblo
 /*
    Negative shift indicates do not generate an error if there is a zero diagonal, just invert it anyways
 */
-static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
+PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
   PetscInt         i, *diag, m = A->rmap->n;
@@ -1916,17 +2386,158 @@ static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscSc
 }
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/frelax.h>
+#define SOR_INDEX  PetscInt
+#define SOR_SUFFIX _Index
+#include "../src/mat/impls/aij/seq/aijsorsweeps.h"
+#undef SOR_INDEX
+#undef SOR_SUFFIX
+#define SOR_INDEX  PetscInt32
+#define SOR_SUFFIX _Index32
+#include "../src/mat/impls/aij/seq/aijsorsweeps.h"
+#undef SOR_INDEX
+#undef SOR_SUFFIX
+
+/*
+   Colors the graph of A + A^T with MatColoring so that rows of one color do not couple to each other and can be relaxed
+   concurrently. The rows are cached by color until the nonzero pattern of A changes.
+*/
+static PetscErrorCode MatSeqAIJSetUpSORColoring_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data;
+  Mat             G = A, At;
+  MatColoring     mc;
+  ISColoring      iscoloring;
+  IS             *isc;
+  PetscInt        m = A->rmap->n, nc, c, k, n;
+  const PetscInt *rows;
+  PetscBool       set, flg;
+
+  PetscFunctionBegin;
+  if (a->sor_ncolors && a->sor_colorstate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree2(a->sor_colorptr, a->sor_colorrows));
+  PetscCall(MatIsStructurallySymmetricKnown(A, &set, &flg));
+  if (!set || !flg) {
+    PetscCall(MatTranspose(A, MAT_INITIAL_MATRIX, &At));
+    PetscCall(MatAXPY(At, 1.0, A, DIFFERENT_NONZERO_PATTERN));
+    G = At;
+  }
+  PetscCall(MatColoringCreate(G, &mc));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetType(mc, MATCOLORINGGREEDY));
+  PetscCall(MatColoringSetWeightType(mc, MAT_COLORING_WEIGHT_LEXICAL));
+  PetscCall(PetscObjectSetOptionsPrefix((PetscObject)mc, ((PetscObject)A)->prefix));
+  PetscCall(MatColoringSetFromOptions(mc));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  if (G != A) PetscCall(MatDestroy(&At));
+
+  PetscCall(ISColoringGetIS(iscoloring, PETSC_USE_POINTER, &nc, &isc));
+  PetscCall(PetscMalloc2(nc + 1, &a->sor_colorptr, m, &a->sor_colorrows));
+  a->sor_colorptr[0] = 0;
+  for (c = 0; c < nc; c++) {
+    PetscCall(ISGetLocalSize(isc[c], &n));
+    PetscCall(ISGetIndices(isc[c], &rows));
+    for (k = 0; k < n; k++) a->sor_colorrows[a->sor_colorptr[c] + k] = rows[k];
+    PetscCall(ISRestoreIndices(isc[c], &rows));
+    a->sor_colorptr[c + 1] = a->sor_colorptr[c] + n;
+  }
+  PetscCall(ISColoringRestoreIS(iscoloring, PETSC_USE_POINTER, &isc));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  PetscCheck(a->sor_colorptr[nc] == m, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Coloring covers %" PetscInt_FMT " of %" PetscInt_FMT " rows", a->sor_colorptr[nc], m);
+  a->sor_ncolors    = nc;
+  a->sor_colorstate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Multicolor SOR with %" PetscInt_FMT " colors and %" PetscInt_FMT " threads\n", nc, a->nthreads));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Forward, backward and symmetric sweeps in color order. The rows of one color are independent so each color is
+   a parallel loop over the threads of -mat_seqaij_omp; the result does not depend on the number of threads.
+*/
+static PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  const MatScalar   *aa, *idiag, *mdiag;
+  const PetscInt    *ai = a->i, *aj = a->j, *colorptr, *colorrows;
+  PetscInt           nc;
+  PetscBool          forward  = (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+  PetscBool          backward = (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCheck(!(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)), PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_MULTICOLOR only supports forward, backward and symmetric sweeps");
+  PetscCall(MatSeqAIJSetUpSORColoring_Private(A));
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  nc        = a->sor_ncolors;
+  colorptr  = a->sor_colorptr;
+  colorrows = a->sor_colorrows;
+  idiag     = a->idiag;
+  mdiag     = a->mdiag;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(VecSet(xx, 0.0));
+  PetscCall(VecGetArray(xx, &x));
+  PetscPragmaOMP(parallel num_threads((int)a->nthreads))
+  {
+    for (PetscInt it = 0; it < its; it++) {
+      if (forward) {
+        for (PetscInt c = 0; c < nc; c++) {
+          PetscPragmaOMP(for schedule(static))
+          for (PetscInt k = colorptr[c]; k < colorptr[c + 1]; k++) {
+            const PetscInt   i = colorrows[k], n = ai[i + 1] - ai[i];
+            const PetscInt  *idx = aj + ai[i];
+            const MatScalar *v   = aa + ai[i];
+            PetscScalar      sum = b[i];
+
+            PetscSparseDenseMinusDot(sum, x, v, idx, n);
+            x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+          }
+        }
+      }
+      if (backward) {
+        for (PetscInt c = nc - 1; c >= 0; c--) {
+          PetscPragmaOMP(for schedule(static))
+          for (PetscInt k = colorptr[c]; k < colorptr[c + 1]; k++) {
+            const PetscInt   i = colorrows[k], n = ai[i + 1] - ai[i];
+            const PetscInt  *idx = aj + ai[i];
+            const MatScalar *v   = aa + ai[i];
+            PetscScalar      sum = b[i];
+
+            PetscSparseDenseMinusDot(sum, x, v, idx, n);
+            x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+          }
+        }
+      }
+    }
+  }
+  PetscCall(PetscLogFlops(its * ((forward ? 2.0 : 0.0) + (backward ? 2.0 : 0.0)) * a->nz));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
   PetscScalar       *x, d, sum, *t, scale;
   const MatScalar   *v, *idiag = NULL, *mdiag, *aa;
-  const PetscScalar *b, *bs, *xb, *ts;
+  const PetscScalar *b, *bs, *ts;
   PetscInt           n, m = A->rmap->n, i;
   const PetscInt    *idx, *diag;
+  PetscBool          index32 = (a->j32 && flag != SOR_APPLY_UPPER && flag != SOR_APPLY_LOWER && !(flag & SOR_EISENSTAT)) ? PETSC_TRUE : PETSC_FALSE;
 
   PetscFunctionBegin;
-  if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
+  if (flag & SOR_MULTICOLOR) {
+    PetscCall(MatSOR_SeqAIJ_Multicolor(A, bb, omega, flag, fshift, its * lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!index32 && a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     PetscCall(MatSOR_SeqAIJ_Inode(A, bb, omega, flag, fshift, its, lits, xx));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
@@ -2009,82 +2620,8 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
     PetscCall(VecRestoreArrayRead(bb, &b));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
-  if (flag & SOR_ZERO_INITIAL_GUESS) {
-    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
-      for (i = 0; i < m; i++) {
-        n   = diag[i] - a->i[i];
-        idx = a->j + a->i[i];
-        v   = aa + a->i[i];
-        sum = b[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        t[i] = sum;
-        x[i] = sum * idiag[i];
-      }
-      xb = t;
-      PetscCall(PetscLogFlops(a->nz));
-    } else xb = b;
-    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
-      for (i = m - 1; i >= 0; i--) {
-        n   = a->i[i + 1] - diag[i] - 1;
-        idx = a->j + diag[i] + 1;
-        v   = aa + diag[i] + 1;
-        sum = xb[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        if (xb == b) {
-          x[i] = sum * idiag[i];
-        } else {
-          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-        }
-      }
-      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
-    }
-    its--;
-  }
-  while (its--) {
-    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
-      for (i = 0; i < m; i++) {
-        /* lower */
-        n   = diag[i] - a->i[i];
-        idx = a->j + a->i[i];
-        v   = aa + a->i[i];
-        sum = b[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        t[i] = sum; /* save application of the lower-triangular part */
-        /* upper */
-        n   = a->i[i + 1] - diag[i] - 1;
-        idx = a->j + diag[i] + 1;
-        v   = aa + diag[i] + 1;
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-      }
-      xb = t;
-      PetscCall(PetscLogFlops(2.0 * a->nz));
-    } else xb = b;
-    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
-      for (i = m - 1; i >= 0; i--) {
-        sum = xb[i];
-        if (xb == b) {
-          /* whole matrix (no checkpointing available) */
-          n   = a->i[i + 1] - a->i[i];
-          idx = a->j + a->i[i];
-          v   = aa + a->i[i];
-          PetscSparseDenseMinusDot(sum, x, v, idx, n);
-          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
-        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
-          n   = a->i[i + 1] - diag[i] - 1;
-          idx = a->j + diag[i] + 1;
-          v   = aa + diag[i] + 1;
-          PetscSparseDenseMinusDot(sum, x, v, idx, n);
-          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-        }
-      }
-      if (xb == b) {
-        PetscCall(PetscLogFlops(2.0 * a->nz));
-      } else {
-        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
-      }
-    }
-  }
+  if (index32) PetscCall(MatSOR_SeqAIJ_Sweeps_Index32(A, a->j32, aa, b, omega, flag, its, x));
+  else PetscCall(MatSOR_SeqAIJ_Sweeps_Index(A, a->j, aa, b, omega, flag, its, x));
   PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
   PetscCall(VecRestoreArray(xx, &x));
   PetscCall(VecRestoreArrayRead(bb, &b));
@@ -3621,6 +4158,7 @@ static PetscErrorCode MatSeqAIJSetColumnIndices_SeqAIJ(Mat mat, PetscInt *indice
   for (i = 0; i < nz; i++) aij->j[i] = indices[i];
   aij->nz = nz;
   for (i = 0; i < n; i++) aij->ilen[i] = aij->imax[i];
+  PetscCall(MatSeqAIJSetUpIndex32_Private(mat));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -3676,6 +4214,7 @@ PetscErrorCode MatSeqAIJCompactOutExtraColumns_SeqAIJ(Mat mat, ISLocalToGlobalMa
   PetscCall(PetscLayoutCreateFromSizes(PetscObjectComm((PetscObject)mat), ec, ec, 1, &mat->cmap));
   PetscCall(ISLocalToGlobalMappingCreate(PETSC_COMM_SELF, mat->cmap->bs, mat->cmap->n, garray, PETSC_OWN_POINTER, mapping));
   PetscCall(ISLocalToGlobalMappingSetType(*mapping, ISLOCALTOGLOBALMAPPINGHASH));
+  PetscCall(MatSeqAIJSetUpIndex32_Private(mat));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -3842,7 +4381,9 @@ PetscErrorCode MatRetrieveValues(Mat mat)
 
   Options Database Keys:
 + -mat_no_inode            - Do not use inodes
-- -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_seqaij_omp          - Use OpenMP threads in `MatMult()` and `MatMultAdd()`, see `MATSEQAIJ`
+- -mat_seqaij_index32      - Use 32-bit column indices in `MatMult()` and `MatSOR()`, useful with 64-bit indices, see `MATSEQAIJ`
 
   Level: intermediate
 
@@ -4001,6 +4542,9 @@ PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat B, PetscInt nz, const PetscI
     }
     b->i[0] = 0;
     for (i = 1; i < B->rmap->n + 1; i++) b->i[i] = b->i[i - 1] + b->imax[i - 1];
+#if defined(PETSC_HAVE_OPENMP)
+    if (b->nthreads > 1 && !B->structure_only) PetscCall(MatSeqAIJFirstTouch_Private(B, PETSC_FALSE));
+#endif
     if (B->structure_only) {
       b->singlemalloc = PETSC_FALSE;
       b->free_a       = PETSC_FALSE;
@@ -4292,12 +4836,32 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A, Mat B, PetscReal fill,
    MATSEQAIJ - MATSEQAIJ = "seqaij" - A matrix type to be used for sequential sparse matrices,
    based on compressed sparse row format.
 
-   Options Database Key:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+   Options Database Keys:
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_seqaij_omp  - use OpenMP threads (as many as given by -omp_num_threads) in `MatMult()` and `MatMultAdd()`, requires PETSc configured with OpenMP
+- -mat_seqaij_index32 - use 32-bit column indices in `MatMult()`, `MatMultAdd()`, `MatMultTransposeAdd()` and `MatSOR()`
 
    Level: beginner
 
    Notes:
+    With `-mat_seqaij_omp` the rows are split at assembly time into one contiguous chunk per thread, each holding
+    about the same number of nonzeros. This also applies to the diagonal and off-diagonal blocks of `MATMPIAIJ`
+    matrices, so hybrid MPI+OpenMP runs can use all the cores of a memory domain in `MatMult()`. The preallocated
+    storage is first touched by the threads, and copied by them with the partition of the assembled matrix if the first
+    assembly removes unused preallocated space, so that on NUMA machines each thread reads its rows from local memory;
+    use `-vec_omp_first_touch` to also place the vector arrays (see `VECSEQ`).
+
+    The option also applies to the `MATSOLVERPETSC` LU and ILU factors, for example of `PCILU` in the blocks of
+    `PCBJACOBI` or `PCASM`: after each numerical factorization the rows of L and U are grouped into level sets, whose
+    rows do not depend on each other, and `MatSolve()` runs each level on the threads. This is skipped (see `-info`)
+    when the levels hold on average fewer rows than threads.
+
+    With `-mat_seqaij_index32` a PETSc configured with `--with-64-bit-indices` stores, at assembly time, a copy of the
+    column indices as 32-bit integers when the number of local columns fits, and the kernels listed above read that copy.
+    This halves the index traffic of these memory bound operations at the cost of 4 bytes per nonzero; the `PetscInt`
+    indices cannot be freed since many other operations and external packages read them directly. With 32-bit `PetscInt`
+    the kernels read the `PetscInt` indices through the same code path and nothing is allocated.
+
     `MatSetValues()` may be called for this matrix type with a `NULL` argument for the numerical values,
     in this case the values associated with the rows and columns one passes in are set to zero
     in the matrix
@@ -4326,7 +4890,7 @@ M*/
   Level: beginner
 
    Note:
-   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
+   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJSINGLESHADOW`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
    enough exist.
 
 .seealso: [](ch_matrices), `Mat`, `MatCreateAIJ()`, `MatCreateSeqAIJ()`, `MATSEQAIJ`, `MATMPIAIJ`, `MATSELL`, `MATSEQSELL`, `MATMPISELL`
@@ -4827,6 +5391,24 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   b->idiagvalid         = PETSC_FALSE;
   b->ibdiagvalid        = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
+  b->nthreads           = 1;
+  b->trstart            = NULL;
+  b->autominnz          = 10000;
+#if defined(PETSC_HAVE_OPENMP)
+  {
+    PetscBool useomp = PETSC_FALSE;
+
+    PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+    PetscCall(PetscOptionsBool("-mat_seqaij_omp", "Use OpenMP threads in MatMult() and MatMultAdd()", "None", useomp, &useomp, NULL));
+    PetscOptionsEnd();
+    if (useomp) b->nthreads = PetscMax(PetscNumOMPThreads, 1);
+  }
+#endif
+  b->index32 = PETSC_FALSE;
+  b->j32     = NULL;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsBool("-mat_seqaij_index32", "Use 32-bit column indices in MatMult() and MatSOR()", "None", b->index32, &b->index32, NULL));
+  PetscOptionsEnd();
 
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
 #if defined(PETSC_HAVE_MATLAB)
@@ -4840,6 +5422,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqbaij_C", MatConvert_SeqAIJ_SeqBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijperm_C", MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsell_C", MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsingleshadow_C", MatConvert_SeqAIJ_SeqAIJSingleShadow));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmkl_C", MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -4977,6 +5560,12 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C, Mat A, MatDuplicateOption cpva
     }
     c->nonzerorowcnt = a->nonzerorowcnt;
     C->nonzerostate  = A->nonzerostate;
+    c->nthreads      = a->nthreads;
+    c->autotype      = a->autotype;
+    c->autominnz     = a->autominnz;
+    PetscCall(MatSeqAIJSetUpThreadPartition_Private(C));
+    c->index32 = a->index32;
+    PetscCall(MatSeqAIJSetUpIndex32_Private(C));
 
     PetscCall(MatDuplicate_SeqAIJ_Inode(A, cpvalues, &C));
   }
@@ -5416,11 +6005,23 @@ PetscFunctionList MatSeqAIJList = NULL;
 + mat    - the matrix object
 - matype - matrix type
 
-  Options Database Key:
-. -mat_seqaij_type  <method> - for example seqaijcrl
+  Options Database Keys:
++ -mat_seqaij_type  <method> - for example seqaijcrl, or auto
+- -mat_seqaij_auto_min_nz <nz> - smallest number of nonzeros for which auto times the candidates
 
   Level: intermediate
 
+  Note:
+  With `matype` "auto" the matrix stays a `MATSEQAIJ` until its first `MatMult()` or `MatMultAdd()`. That product first
+  times a few products with `MATSEQAIJ` (with its inode or OpenMP kernels), `MATSEQAIJPERM`, `MATSEQAIJSELL` and, when
+  available, `MATSEQAIJMKL` on the matrix and then converts the matrix to the fastest of them. Matrices with fewer
+  nonzeros than `-mat_seqaij_auto_min_nz` (default 10000) stay `MATSEQAIJ`. The choice is reported by `MatView()` with
+  `PETSC_VIEWER_ASCII_INFO`, for example `-ksp_view`, and with `-info`.
+
+  Since the choice depends on timings, it is not reproducible: it can differ from one run to the next, and each
+  sequential matrix, for example the diagonal and off-diagonal blocks of every process of a `MATMPIAIJ`, makes its own
+  choice. The subtypes can round the products differently, so results may differ in round-off between runs.
+
 .seealso: [](ch_matrices), `Mat`, `PCSetType()`, `VecSetType()`, `MatCreate()`, `MatType`
 @*/
 PetscErrorCode MatSeqAIJSetType(Mat mat, MatType matype)
@@ -5430,6 +6031,13 @@ PetscErrorCode MatSeqAIJSetType(Mat mat, MatType matype)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscCall(PetscStrcmp(matype, "auto", &sametype));
+  if (sametype) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)mat, MATSEQAIJ, &sametype));
+    PetscCheck(sametype, PetscObjectComm((PetscObject)mat), PETSC_ERR_SUP, "Automatic selection of the subtype requires a MATSEQAIJ matrix, not %s", ((PetscObject)mat)->type_name);
+    ((Mat_SeqAIJ *)mat->data)->autotype = PETSC_TRUE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscObjectTypeCompare((PetscObject)mat, matype, &sametype));
   if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
 
@@ -5489,6 +6097,7 @@ PetscErrorCode MatSeqAIJRegisterAll(void)
   PetscCall(MatSeqAIJRegister(MATSEQAIJCRL, MatConvert_SeqAIJ_SeqAIJCRL));
   PetscCall(MatSeqAIJRegister(MATSEQAIJPERM, MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(MatSeqAIJRegister(MATSEQAIJSELL, MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJSINGLESHADOW, MatConvert_SeqAIJ_SeqAIJSingleShadow));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatSeqAIJRegister(MATSEQAIJMKL, MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -161,6 +161,30 @@ typedef struct {
   PetscHMapIJV   ht;
   PetscInt      *dnz;
   struct _MatOps cops;
+
+  /* OpenMP kernels, see -mat_seqaij_omp */
+  PetscInt  nthreads; /* number of threads used by the kernels, 1 means the sequential kernels are used */
+  PetscInt *trstart;  /* trstart[t] is the first row handled by thread t (in compressed row numbering if it is used), length nthreads+1 */
+
+  /* selection of the MatMult() format, see MatSeqAIJSetType() */
+  PetscBool autotype;  /* convert to the fastest subtype at the first MatMult() or MatMultAdd() */
+  PetscBool autotuned; /* the current subtype was selected by timing the candidates */
+  PetscInt  autominnz; /* matrices with fewer nonzeros are not timed and stay MATSEQAIJ */
+
+  /* level scheduled MatSolve() of LU factors with OpenMP threads, see MatSeqAIJSetUpSolveLevels_Private() */
+  PetscInt  solve_nlevels[2]; /* number of level sets of L and U */
+  PetscInt *solve_levels;     /* level l of L is solve_rows[solve_levels[l]..solve_levels[l+1]), then the solve_nlevels[1]+1 offsets of U */
+  PetscInt *solve_rows;       /* rows of L then rows of U, sorted by level, length 2n */
+
+  /* multicolor MatSOR() with OpenMP threads, see SOR_MULTICOLOR */
+  PetscObjectState sor_colorstate; /* nonzero state of the matrix when the coloring was computed */
+  PetscInt         sor_ncolors;    /* number of colors, 0 if the coloring has not been computed */
+  PetscInt        *sor_colorptr;   /* rows of color c are sor_colorrows[sor_colorptr[c]..sor_colorptr[c+1]) */
+  PetscInt        *sor_colorrows;  /* rows sorted by color, length m */
+
+  /* 32-bit column indices read by the bandwidth bound kernels, see -mat_seqaij_index32; a copy only with 64-bit PetscInt */
+  PetscBool   index32;
+  PetscInt32 *j32;
 } Mat_SeqAIJ;
 
 typedef struct {
@@ -263,6 +287,52 @@ static inline PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA, MatScalar **a, PetscInt *
     } \
   } while (0)
 
+/*
+    Adds (or inserts) value at column col of a row with the nrow sorted column indices rp[] and values ap[] using atomic
+    operations, so several threads may update the same row, see MAT_THREAD_SAFE_SET_VALUES.
+    Returns PETSC_FALSE if col is not in the nonzero pattern of the row, nothing is changed then.
+*/
+static inline PetscBool MatSeqAIJSetValue_ThreadSafe_Private(const PetscInt rp[], MatScalar ap[], PetscInt nrow, PetscInt col, PetscScalar value, InsertMode is)
+{
+  PetscInt low = 0, high = nrow, t, i;
+
+  while (high - low > 5) {
+    t = (low + high) / 2;
+    if (rp[t] > col) high = t;
+    else low = t;
+  }
+  for (i = low; i < high; i++) {
+    if (rp[i] >= col) break;
+  }
+  if (i == high || rp[i] != col) return PETSC_FALSE;
+#if defined(PETSC_USE_COMPLEX)
+  {
+    PetscReal *p = (PetscReal *)&ap[i], re = PetscRealPart(value), im = PetscImaginaryPart(value);
+
+    if (is == ADD_VALUES) {
+      PetscPragmaOMP(atomic update)
+      p[0] += re;
+      PetscPragmaOMP(atomic update)
+      p[1] += im;
+    } else {
+      PetscPragmaOMP(atomic write)
+      p[0] = re;
+      PetscPragmaOMP(atomic write)
+      p[1] = im;
+    }
+  }
+#else
+  if (is == ADD_VALUES) {
+    PetscPragmaOMP(atomic update)
+    ap[i] += value;
+  } else {
+    PetscPragmaOMP(atomic write)
+    ap[i] = value;
+  }
+#endif
+  return PETSC_TRUE;
+}
+
 PETSC_INTERN PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat, PetscInt, const PetscInt *);
 PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat, PetscCount, PetscInt[], PetscInt[]);
 
@@ -286,6 +356,7 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat, PetscScalar, PetscScalar);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Inode(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat, MatOption, PetscBool);
@@ -338,6 +409,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Scalable_fast(Mat,
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_ScatterMap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat, Mat, PetscReal, Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat, Mat, PetscReal, Mat);
@@ -345,13 +417,16 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat, Mat, PetscRea
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_ScatterMap(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_ScatterMap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_ScatterMap(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ_matmattransposemult(Mat, Mat, PetscReal, Mat);
@@ -412,6 +487,7 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat, MatType, MatReuse, Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingleShadow(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat, PetscReal, IS, IS);
@@ -433,6 +509,10 @@ PETSC_INTERN PetscErrorCode MatDestroySubMatrices_Dummy(PetscInt, Mat *[]);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat, IS, IS, PetscInt, MatReuse, Mat *);
 
 PETSC_INTERN PetscErrorCode MatSeqAIJCompactOutExtraColumns_SeqAIJ(Mat, ISLocalToGlobalMapping *);
+PETSC_INTERN PetscErrorCode MatSeqAIJSplitRowsByNonzeros_Private(PetscInt, const PetscInt[], PetscInt, PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpThreadPartition_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpIndex32_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpSolveLevels_Private(Mat);
 PETSC_INTERN PetscErrorCode MatSetSeqAIJWithArrays_private(MPI_Comm, PetscInt, PetscInt, PetscInt[], PetscInt[], PetscScalar[], MatType, Mat);
 
 /*
@@ -609,6 +609,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSetUpSolveLevels_Private(C));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -3200,6 +3201,134 @@ PetscErrorCode MatSolve_SeqAIJ(Mat A, Vec bb, Vec xx)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Forward and backward substitutions of MatSolve_SeqAIJ() over the level sets of L and U: the rows of a level only
+   depend on rows of the previous levels so each level is split between the threads, with a barrier between levels
+*/
+static PetscErrorCode MatSolve_SeqAIJ_OpenMP(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  IS                 iscol = a->col, isrow = a->row;
+  const PetscInt     n = A->rmap->n, nt = a->nthreads, nlevl = a->solve_nlevels[0], nlevu = a->solve_nlevels[1];
+  const PetscInt    *ai = a->i, *aj = a->j, *adiag = a->diag, *r, *c;
+  const PetscInt    *levl = a->solve_levels, *levu = a->solve_levels + nlevl + 1, *rowl = a->solve_rows, *rowu = a->solve_rows + n;
+  PetscScalar       *x, *tmp = a->solve_work;
+  const PetscScalar *b;
+  const MatScalar   *aa = a->a;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(isrow, &r));
+  PetscCall(ISGetIndices(iscol, &c));
+
+  PetscPragmaOMP(parallel num_threads(nt))
+  {
+    PetscInt l, k;
+
+    /* forward solve the lower triangular */
+    for (l = 0; l < nlevl; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (k = levl[l]; k < levl[l + 1]; k++) {
+        const PetscInt   i  = rowl[k], nz = ai[i + 1] - ai[i];
+        const PetscInt  *vi = aj + ai[i];
+        const MatScalar *v  = aa + ai[i];
+        PetscScalar      sum = b[r[i]];
+
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        tmp[i] = sum;
+      }
+    }
+    /* backward solve the upper triangular */
+    for (l = 0; l < nlevu; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (k = levu[l]; k < levu[l + 1]; k++) {
+        const PetscInt   i  = rowu[k], nz = adiag[i] - adiag[i + 1] - 1;
+        const PetscInt  *vi = aj + adiag[i + 1] + 1;
+        const MatScalar *v  = aa + adiag[i + 1] + 1;
+        PetscScalar      sum = tmp[i];
+
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        x[c[i]] = tmp[i] = sum * v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+    }
+  }
+
+  PetscCall(ISRestoreIndices(isrow, &r));
+  PetscCall(ISRestoreIndices(iscol, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*
+   MatSeqAIJSetUpSolveLevels_Private - with -mat_seqaij_omp, computes the level sets of the L and U factors of B and
+   switches MatSolve() to MatSolve_SeqAIJ_OpenMP() when the levels hold enough rows to keep the threads busy
+
+   The level of a row of L is one more than the largest level of the rows it depends on, and similarly for U from the
+   last row up. The rows of each level are stored in increasing order so that the sweeps still read the factor forward.
+*/
+PetscErrorCode MatSeqAIJSetUpSolveLevels_Private(Mat B)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ *)B->data;
+  const PetscInt  n = B->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  PetscInt        i, k, l, *level[2], nlev[2] = {0, 0};
+  PetscBool       useit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(b->solve_levels, b->solve_rows));
+  b->solve_nlevels[0] = b->solve_nlevels[1] = 0;
+  if (b->nthreads <= 1 || !n || !b->solve_work) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMalloc2(n, &level[0], n, &level[1]));
+  /* L(i,:) without the unit diagonal is stored in bj[bi[i]..bi[i+1]) */
+  for (i = 0; i < n; i++) {
+    l = 0;
+    for (k = bi[i]; k < bi[i + 1]; k++) l = PetscMax(l, level[0][bj[k]] + 1);
+    level[0][i] = l;
+    nlev[0]     = PetscMax(nlev[0], l + 1);
+  }
+  /* U(i,:) without the diagonal is stored in bj[bdiag[i+1]+1..bdiag[i]) */
+  for (i = n - 1; i >= 0; i--) {
+    l = 0;
+    for (k = bdiag[i + 1] + 1; k < bdiag[i]; k++) l = PetscMax(l, level[1][bj[k]] + 1);
+    level[1][i] = l;
+    nlev[1]     = PetscMax(nlev[1], l + 1);
+  }
+
+  /* use the levels only if each one has on average enough rows for all the threads */
+  useit = (PetscBool)(nlev[0] * b->nthreads <= n && nlev[1] * b->nthreads <= n);
+  PetscCall(PetscInfo(B, "%" PetscInt_FMT " rows, %" PetscInt_FMT " levels in L and %" PetscInt_FMT " in U, %s the %" PetscInt_FMT " threads\n", n, nlev[0], nlev[1], useit ? "using" : "not using", b->nthreads));
+  if (useit) {
+    PetscCall(PetscMalloc2(nlev[0] + nlev[1] + 2, &b->solve_levels, 2 * n, &b->solve_rows));
+    b->solve_nlevels[0] = nlev[0];
+    b->solve_nlevels[1] = nlev[1];
+    for (l = 0; l < 2; l++) {
+      PetscInt *ptr = b->solve_levels + (l ? nlev[0] + 1 : 0), *rows = b->solve_rows + (l ? n : 0);
+
+      /* bucket the rows by level, keeping them in increasing order */
+      PetscCall(PetscArrayzero(ptr, nlev[l] + 1));
+      for (i = 0; i < n; i++) ptr[level[l][i] + 1]++;
+      for (k = 0; k < nlev[l]; k++) ptr[k + 1] += ptr[k];
+      for (i = 0; i < n; i++) rows[ptr[level[l][i]]++] = i;
+      for (k = nlev[l]; k > 0; k--) ptr[k] = ptr[k - 1];
+      ptr[0] = 0;
+    }
+    B->ops->solve = MatSolve_SeqAIJ_OpenMP;
+  }
+  PetscCall(PetscFree2(level[0], level[1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  PetscFunctionReturn(PETSC_SUCCESS);
+#endif
+}
+
 #if 0
 // unused
 /*
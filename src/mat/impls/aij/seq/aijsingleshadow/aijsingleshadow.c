@@ -0,0 +1,338 @@
+/*
+  Defines basic operations for the MATSEQAIJSINGLESHADOW matrix class.
+  This class is derived from the MATSEQAIJ class, but maintains a "shadow" copy
+  of the nonzero values stored in single precision. MatMult(), MatMultAdd() and
+  MatSOR() stream this copy and accumulate in PetscScalar, all the other
+  operations use the PetscScalar values of MATSEQAIJ. The shadow only reduces
+  the memory bandwidth of these kernels, it adds to the memory footprint.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  float           *a;     /* The single precision copy of the nonzero values */
+  PetscInt         nz;    /* Length of a[] */
+  PetscObjectState state; /* State of the matrix when the copy was last made */
+} Mat_SeqAIJSingleShadow;
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingleShadow_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJSINGLESHADOW to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat               B = *newmat;
+  Mat_SeqAIJSingleShadow *aijsingleshadow;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  aijsingleshadow = (Mat_SeqAIJSingleShadow *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->destroy = MatDestroy_SeqAIJ;
+  B->ops->mult    = MatMult_SeqAIJ;
+  B->ops->multadd = MatMultAdd_SeqAIJ;
+  B->ops->sor     = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijsingleshadow_seqaij_C", NULL));
+  if (aijsingleshadow) PetscCall(PetscFree(aijsingleshadow->a));
+  PetscCall(PetscFree(B->spptr));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJSingleShadow(Mat A)
+{
+  Mat_SeqAIJSingleShadow *aijsingleshadow = (Mat_SeqAIJSingleShadow *)A->spptr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this SeqAIJSingleShadow matrix will not have an spptr pointer. */
+  if (aijsingleshadow) {
+    PetscCall(PetscFree(aijsingleshadow->a));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsingleshadow_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Build or update the single precision values if and only if needed; the ObjectState tells when this needs to be done */
+static PetscErrorCode MatSeqAIJSingleShadow_build_shadow(Mat A)
+{
+  Mat_SeqAIJ       *a         = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingleShadow *aijsingleshadow = (Mat_SeqAIJSingleShadow *)A->spptr;
+  PetscInt          k, nz     = A->rmap->n ? a->i[A->rmap->n] : 0;
+  const MatScalar  *aa;
+  PetscObjectState  state;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (aijsingleshadow->a && aijsingleshadow->state == state && aijsingleshadow->nz == nz) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscLogEventBegin(MAT_Convert, A, 0, 0, 0));
+  if (aijsingleshadow->nz != nz || !aijsingleshadow->a) {
+    PetscCall(PetscFree(aijsingleshadow->a));
+    PetscCall(PetscMalloc1(nz, &aijsingleshadow->a));
+    aijsingleshadow->nz = nz;
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (k = 0; k < nz; k++) aijsingleshadow->a[k] = (float)PetscRealPart(aa[k]);
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(PetscLogEventEnd(MAT_Convert, A, 0, 0, 0));
+
+  /* Record the ObjectState so that we can tell when the copy needs updating; MatSeqAIJGetArrayRead() does not change it */
+  PetscCall(PetscObjectStateGet((PetscObject)A, &aijsingleshadow->state));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z = y + A x over the (compressed) rows with the single precision values; y may be NULL for z = A x */
+static inline void MatMultAdd_SeqAIJSingleShadow_Kernel(PetscInt m, const PetscInt ii[], const PetscInt ridx[], const PetscInt aj[], const float a_a[], const PetscScalar x[], const PetscScalar y[], PetscScalar z[])
+{
+  PetscInt i, k;
+
+  for (i = 0; i < m; i++) {
+    const PetscInt row = ridx ? ridx[i] : i;
+    PetscScalar    sum = y ? y[row] : 0.0;
+
+    for (k = ii[i]; k < ii[i + 1]; k++) sum += (PetscScalar)a_a[k] * x[aj[k]];
+    z[row] = sum;
+  }
+}
+
+static PetscErrorCode MatMult_SeqAIJSingleShadow(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a         = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingleShadow  *aijsingleshadow = (Mat_SeqAIJSingleShadow *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSingleShadow_build_shadow(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (a->compressedrow.use) {
+    PetscCall(PetscArrayzero(y, A->rmap->n));
+    MatMultAdd_SeqAIJSingleShadow_Kernel(a->compressedrow.nrows, a->compressedrow.i, a->compressedrow.rindex, a->j, aijsingleshadow->a, x, NULL, y);
+  } else MatMultAdd_SeqAIJSingleShadow_Kernel(A->rmap->n, a->i, NULL, a->j, aijsingleshadow->a, x, NULL, y);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJSingleShadow(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a         = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingleShadow  *aijsingleshadow = (Mat_SeqAIJSingleShadow *)A->spptr;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSingleShadow_build_shadow(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (a->compressedrow.use) {
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, A->rmap->n));
+    MatMultAdd_SeqAIJSingleShadow_Kernel(a->compressedrow.nrows, a->compressedrow.i, a->compressedrow.rindex, a->j, aijsingleshadow->a, x, y, z);
+  } else MatMultAdd_SeqAIJSingleShadow_Kernel(A->rmap->n, a->i, NULL, a->j, aijsingleshadow->a, x, y, z);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The forward, backward and symmetric sweeps of MatSOR_SeqAIJ() with the single precision off-diagonal values.
+   The inverse of the diagonal is computed in PetscScalar by MatInvertDiagonal_SeqAIJ() and is not rounded.
+*/
+static PetscErrorCode MatSOR_SeqAIJSingleShadow(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a         = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingleShadow  *aijsingleshadow = (Mat_SeqAIJSingleShadow *)A->spptr;
+  PetscScalar       *x, sum, *t;
+  const MatScalar   *idiag, *mdiag;
+  const float       *aa;
+  const PetscScalar *b, *xb;
+  PetscInt           m = A->rmap->n, i, k;
+  const PetscInt    *diag, *ai = a->i, *aj = a->j;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & (SOR_EISENSTAT | SOR_MULTICOLOR))) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  its = its * lits;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+  PetscCall(MatSeqAIJSingleShadow_build_shadow(A));
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+  aa    = aijsingleshadow->a;
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum = b[i];
+        for (k = ai[i]; k < diag[i]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i];
+        for (k = diag[i] + 1; k < ai[i + 1]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+        if (xb == b) x[i] = sum * idiag[i];
+        else x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum = b[i];
+        for (k = ai[i]; k < diag[i]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+        t[i] = sum; /* save application of the lower-triangular part */
+        for (k = diag[i] + 1; k < ai[i + 1]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          for (k = ai[i]; k < ai[i + 1]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          for (k = diag[i] + 1; k < ai[i + 1]; k++) sum -= (PetscScalar)aa[k] * x[aj[k]];
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(xb == b ? 2.0 * a->nz : a->nz));
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJSingleShadow converts a SeqAIJ matrix into a
+ * SeqAIJSingleShadow matrix.  This routine is called by the MatCreate_SeqAIJSingleShadow()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJSingleShadow one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingleShadow(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat               B = *newmat;
+  Mat_SeqAIJSingleShadow *aijsingleshadow;
+  PetscBool         sametype;
+
+  PetscFunctionBegin;
+  PetscCheck(!PetscDefined(USE_COMPLEX), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "MATSEQAIJSINGLESHADOW is not available for complex numbers");
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aijsingleshadow));
+  B->spptr = (void *)aijsingleshadow;
+
+  /* Set function pointers for methods that we inherit from AIJ but override; MatDuplicate_SeqAIJ() creates the
+     duplicate with this type, whose single precision values are made as needed */
+  B->ops->destroy = MatDestroy_SeqAIJSingleShadow;
+  B->ops->mult    = MatMult_SeqAIJSingleShadow;
+  B->ops->multadd = MatMultAdd_SeqAIJSingleShadow;
+  B->ops->sor     = MatSOR_SeqAIJSingleShadow;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijsingleshadow_seqaij_C", MatConvert_SeqAIJSingleShadow_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJSINGLESHADOW));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  MatCreateSeqAIJSingleShadow - Creates a sparse matrix of type `MATSEQAIJSINGLESHADOW`.
+
+  Collective
+
+  Input Parameters:
++ comm - MPI communicator, set to `PETSC_COMM_SELF`
+. m    - number of rows
+. n    - number of columns
+. nz   - number of nonzeros per row (same for all rows)
+- nnz  - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or `NULL`
+
+  Output Parameter:
+. A - the matrix
+
+  Level: intermediate
+
+  Notes:
+  If `nnz` is given then `nz` is ignored
+
+  Because `MATSEQAIJSINGLESHADOW` is a subtype of `MATSEQAIJ`, the option `-mat_seqaij_type seqaijsingleshadow` can be used to make
+  sequential `MATSEQAIJ` matrices default to being instances of `MATSEQAIJSINGLESHADOW`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJSINGLESHADOW`, `MatCreate()`, `MatCreateMPIAIJSingleShadow()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateSeqAIJSingleShadow(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, m, n));
+  PetscCall(MatSetType(*A, MATSEQAIJSINGLESHADOW));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJSINGLESHADOW - MATSEQAIJSINGLESHADOW = "seqaijsingleshadow" - A matrix type for sequential sparse matrices whose
+   `MatMult()`, `MatMultAdd()` and `MatSOR()` use a copy of the nonzero values rounded to single precision.
+
+   Options Database Key:
+. -mat_type seqaijsingleshadow - sets the matrix type to `MATSEQAIJSINGLESHADOW` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ` and keeps its `PetscScalar` values, which are used for all the other operations,
+   such as `MatGetRow()`, `MatGetDiagonal()` and the factorizations. The single precision copy is a shadow made the first
+   time one of the operations above is called after the values changed; the products and the sweeps accumulate in
+   `PetscScalar` and `MatSOR()` keeps the inverse of the diagonal in `PetscScalar`. These memory bound kernels then read
+   4 bytes instead of 8 per nonzero value.
+
+   The shadow only saves memory bandwidth, not memory: the matrix stores 4 bytes per nonzero more than a `MATSEQAIJ`,
+   about 1.5 times its values. Use a `MATSEQAIJ` matrix of a PETSc configured with `--with-precision=single` when the
+   footprint matters.
+
+   It is intended for matrices only used to build preconditioners, for example `Pmat` in `KSPSetOperators()` with
+   `PCSOR`, `PCJACOBI`, `PCILU` or the smoothers of `PCGAMG` and `PCMG`. A matrix can be changed in place with
+   `MatConvert`(A,`MATAIJSINGLESHADOW`,`MAT_INPLACE_MATRIX`,&A), and back with `MATAIJ`, which drops the shadow. It is
+   not available for complex numbers and only saves memory traffic when `PetscReal` is `double`.
+
+.seealso: [](ch_matrices), `Mat`, `MatCreateSeqAIJSingleShadow()`, `MATAIJSINGLESHADOW`, `MATMPIAIJSINGLESHADOW`, `MATSEQAIJ`, `MATSEQAIJSELL`, `MATSEQAIJPERM`
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingleShadow(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingleShadow(A, MATSEQAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,98 @@
+/*
+   used by SEQAIJ to share the sweeps of MatSOR() between the PetscInt column indices and the 32-bit column indices
+   of -mat_seqaij_index32
+
+     define SOR_INDEX  to PetscInt or PetscInt32, the type of the column indices
+            SOR_SUFFIX to the suffix of the function name
+
+   Applies the forward, backward or symmetric sweeps, with or without a zero initial guess; a->idiag[] must be valid
+*/
+static PetscErrorCode PetscConcat(MatSOR_SeqAIJ_Sweeps, SOR_SUFFIX)(Mat A, const SOR_INDEX aj[], const MatScalar aa[], const PetscScalar b[], PetscReal omega, MatSORType flag, PetscInt its, PetscScalar x[])
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar        sum, *t = a->ssor_work;
+  const MatScalar   *v, *idiag = a->idiag, *mdiag = a->mdiag;
+  const PetscScalar *xb;
+  const PetscInt    *diag = a->diag, *ai = a->i;
+  const SOR_INDEX   *idx;
+  PetscInt           n, m = A->rmap->n, i;
+
+  PetscFunctionBegin;
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        n   = diag[i] - ai[i];
+        idx = aj + ai[i];
+        v   = aa + ai[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        n   = ai[i + 1] - diag[i] - 1;
+        idx = aj + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        sum = xb[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        if (xb == b) {
+          x[i] = sum * idiag[i];
+        } else {
+          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        /* lower */
+        n   = diag[i] - ai[i];
+        idx = aj + ai[i];
+        v   = aa + ai[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        t[i] = sum; /* save application of the lower-triangular part */
+        /* upper */
+        n   = ai[i + 1] - diag[i] - 1;
+        idx = aj + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          n   = ai[i + 1] - ai[i];
+          idx = aj + ai[i];
+          v   = aa + ai[i];
+          PetscSparseDenseMinusDot(sum, x, v, idx, n);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = ai[i + 1] - diag[i] - 1;
+          idx = aj + diag[i] + 1;
+          v   = aa + diag[i] + 1;
+          PetscSparseDenseMinusDot(sum, x, v, idx, n);
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      } else {
+        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -1950,6 +1950,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSetUpSolveLevels_Private(C));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
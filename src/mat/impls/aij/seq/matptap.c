@@ -50,6 +50,14 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* "scattermap" */
+  PetscCall(PetscStrcmp(alg, "scattermap", &flg));
+  if (flg) {
+    PetscCall(MatPtAPSymbolic_SeqAIJ_SeqAIJ_ScatterMap(A, P, fill, C));
+    C->ops->productnumeric = MatProductNumeric_PtAP;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* hypre */
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
@@ -186,6 +194,156 @@ PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat A, Mat P, PetscReal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+typedef struct {
+  Mat        AP;    /* A*P, computed with the "scattermap" algorithm */
+  PetscCount nprod; /* number of products P_km*AP_kn */
+  PetscInt  *map;   /* [nprod] location in the values of C of each product, in the order the numeric phase computes them */
+} MatPtAPScatterMap_SeqAIJ;
+
+static PetscErrorCode MatDestroy_SeqAIJ_PtAPScatterMap(void *data)
+{
+  MatPtAPScatterMap_SeqAIJ *ptap = (MatPtAPScatterMap_SeqAIJ *)data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ptap->AP));
+  PetscCall(PetscFree(ptap->map));
+  PetscCall(PetscFree(ptap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  C = P^T*(A*P) where both products stream through scatter maps recorded here, see MatMatMultSymbolic_SeqAIJ_SeqAIJ_ScatterMap().
+  Row k of P and row k of AP contribute P_km*AP_kn to C_mn, so no transpose of P is needed: the products are bucketed by
+  their row m of C, each bucket is sorted by column, and its distinct columns give the row of C and the scatter map.
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_ScatterMap(Mat A, Mat P, PetscReal fill, Mat C)
+{
+  MatPtAPScatterMap_SeqAIJ *ptap;
+  Mat_SeqAIJ               *a = (Mat_SeqAIJ *)A->data, *p = (Mat_SeqAIJ *)P->data, *ap, *c;
+  const PetscInt           *pi = p->i, *pj = p->j, *api, *apj;
+  PetscInt                  am = A->rmap->n, pm = P->rmap->n, pn = P->cmap->n, k, j, l, m, q, start, end, nz, nprodi;
+  PetscInt                 *ci, *cj, *bcol, *bprod, *next;
+  PetscScalar              *ca;
+  PetscCount                nprod = 0;
+  PetscReal                 afill;
+  const char               *prefix;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 4);
+  PetscCheck(!C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Product data not empty");
+
+  PetscCall(PetscNew(&ptap));
+  PetscCall(MatProductCreate(A, P, NULL, &ptap->AP));
+  PetscCall(MatGetOptionsPrefix(C, &prefix));
+  PetscCall(MatSetOptionsPrefix(ptap->AP, prefix));
+  PetscCall(MatAppendOptionsPrefix(ptap->AP, "inner_AP_"));
+  PetscCall(MatProductSetType(ptap->AP, MATPRODUCT_AB));
+  PetscCall(MatProductSetAlgorithm(ptap->AP, MATPRODUCTALGORITHMSCATTERMAP));
+  PetscCall(MatProductSetFill(ptap->AP, fill));
+  PetscCall(MatProductSetFromOptions(ptap->AP));
+  PetscCall(MatProductSymbolic(ptap->AP));
+  ap  = (Mat_SeqAIJ *)ptap->AP->data;
+  api = ap->i;
+  apj = ap->j;
+
+  for (k = 0; k < pm; k++) nprod += (PetscCount)(pi[k + 1] - pi[k]) * (api[k + 1] - api[k]);
+  PetscCheck(nprod <= PETSC_MAX_INT, PETSC_COMM_SELF, PETSC_ERR_SUP, "%" PetscCount_FMT " products do not fit the scatter map, use another MatProductAlgorithm", nprod);
+  PetscCall(PetscMalloc1(nprod, &ptap->map));
+  ptap->nprod = nprod;
+
+  /* bucket the products by their row of C: bcol[] holds their columns and bprod[] their numbers in the order of the numeric phase */
+  PetscCall(PetscCalloc1(pn + 1, &ci));
+  for (k = 0; k < pm; k++) {
+    for (j = pi[k]; j < pi[k + 1]; j++) ci[pj[j] + 1] += api[k + 1] - api[k];
+  }
+  for (m = 0; m < pn; m++) ci[m + 1] += ci[m];
+  PetscCall(PetscMalloc3(nprod, &bcol, nprod, &bprod, pn, &next));
+  PetscCall(PetscArraycpy(next, ci, pn));
+  for (k = 0, nprodi = 0; k < pm; k++) {
+    for (j = pi[k]; j < pi[k + 1]; j++) {
+      for (l = api[k]; l < api[k + 1]; l++) {
+        q        = next[pj[j]]++;
+        bcol[q]  = apj[l];
+        bprod[q] = nprodi++;
+      }
+    }
+  }
+
+  /* sort each bucket by column and compress its distinct columns in place to the front of bcol[], which becomes cj[] */
+  for (m = 0, nz = 0, start = 0; m < pn; m++) {
+    end = ci[m + 1];
+    PetscCall(PetscSortIntWithArray(end - start, bcol + start, bprod + start));
+    ci[m] = nz;
+    for (q = start; q < end; q++) {
+      if (nz == ci[m] || bcol[nz - 1] != bcol[q]) bcol[nz++] = bcol[q];
+      ptap->map[bprod[q]] = nz - 1;
+    }
+    start = end;
+  }
+  ci[pn] = nz;
+  PetscCall(PetscMalloc1(nz + 1, &cj));
+  PetscCall(PetscArraycpy(cj, bcol, nz));
+  PetscCall(PetscFree3(bcol, bprod, next));
+  PetscCall(PetscCalloc1(nz + 1, &ca));
+
+  PetscCall(MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A), pn, pn, ci, cj, ca, ((PetscObject)A)->type_name, C));
+  PetscCall(MatSetBlockSizes(C, PetscAbs(P->cmap->bs), PetscAbs(P->cmap->bs)));
+  c          = (Mat_SeqAIJ *)C->data;
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  afill = (PetscReal)nz / (a->i[am] + pi[pm] + 1.e-5);
+  if (afill < 1.0) afill = 1.0;
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+  PetscCall(PetscInfo(C, "Scatter map of %" PetscCount_FMT " products into %" PetscInt_FMT " nonzeros\n", nprod, nz));
+
+  C->product->data    = ptap;
+  C->product->destroy = MatDestroy_SeqAIJ_PtAPScatterMap;
+  C->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_ScatterMap;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_ScatterMap(Mat A, Mat P, Mat C)
+{
+  MatPtAPScatterMap_SeqAIJ *ptap;
+  Mat_SeqAIJ               *p = (Mat_SeqAIJ *)P->data, *ap, *c = (Mat_SeqAIJ *)C->data;
+  const PetscInt           *pi = p->i, *api, *map;
+  PetscInt                  pm = P->rmap->n, k, j, l;
+  const PetscScalar        *pa, *apa;
+  PetscScalar              *ca;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  ptap = (MatPtAPScatterMap_SeqAIJ *)C->product->data;
+  PetscCheck(ptap, PetscObjectComm((PetscObject)C), PETSC_ERR_ARG_WRONGSTATE, "PtAP cannot be reused. Do not call MatProductClear()");
+  PetscCall(MatProductNumeric(ptap->AP));
+  ap  = (Mat_SeqAIJ *)ptap->AP->data;
+  api = ap->i;
+  PetscCall(MatSeqAIJGetArrayRead(P, &pa));
+  PetscCall(MatSeqAIJGetArrayRead(ptap->AP, &apa));
+  PetscCall(MatSeqAIJGetArrayWrite(C, &ca));
+
+  PetscCall(PetscArrayzero(ca, c->i[C->rmap->n]));
+  map = ptap->map;
+  for (k = 0; k < pm; k++) {
+    for (j = pi[k]; j < pi[k + 1]; j++) {
+      const PetscScalar pkm = pa[j];
+
+      for (l = api[k]; l < api[k + 1]; l++) ca[*map++] += pkm * apa[l];
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * ptap->nprod));
+  PetscCall(MatSeqAIJRestoreArrayRead(P, &pa));
+  PetscCall(MatSeqAIJRestoreArrayRead(ptap->AP, &apa));
+  PetscCall(MatSeqAIJRestoreArrayWrite(C, &ca));
+  PetscCall(MatAssemblyBegin(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat A, Mat P, Mat C)
 {
   Mat_SeqAIJ *a  = (Mat_SeqAIJ *)A->data;
@@ -40,6 +40,9 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
 
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingleShadow(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSingleShadow(Mat);
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMKL(Mat);
@@ -152,6 +155,10 @@ PetscErrorCode MatRegisterAll(void)
   PetscCall(MatRegister(MATMPIAIJSELL, MatCreate_MPIAIJSELL));
   PetscCall(MatRegister(MATSEQAIJSELL, MatCreate_SeqAIJSELL));
 
+  PetscCall(MatRegisterRootName(MATAIJSINGLESHADOW, MATSEQAIJSINGLESHADOW, MATMPIAIJSINGLESHADOW));
+  PetscCall(MatRegister(MATMPIAIJSINGLESHADOW, MatCreate_MPIAIJSingleShadow));
+  PetscCall(MatRegister(MATSEQAIJSINGLESHADOW, MatCreate_SeqAIJSingleShadow));
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL, MATMPIAIJMKL));
   PetscCall(MatRegister(MATMPIAIJMKL, MatCreate_MPIAIJMKL));
@@ -7,6 +7,9 @@
 #include <petsc/private/matimpl.h> /*I "petscmat.h" I*/
 #include <petsc/private/isimpl.h>
 #include <petsc/private/vecimpl.h>
+#if PetscDefined(HAVE_OPENMP)
+  #include <omp.h>
+#endif
 
 /* Logging support */
 PetscClassId MAT_CLASSID;
@@ -1405,6 +1408,7 @@ PetscErrorCode MatDestroy(Mat *A)
   PetscCall(PetscFree((*A)->defaultrandtype));
   PetscCall(PetscFree((*A)->bsizes));
   PetscCall(PetscFree((*A)->solvertype));
+  PetscCall(PetscFree((*A)->threadsafe_errors));
   for (PetscInt i = 0; i < MAT_FACTOR_NUM_TYPES; i++) PetscCall(PetscFree((*A)->preferredordering[i]));
   if ((*A)->redundant && (*A)->redundant->matseq[0] == *A) (*A)->redundant->matseq[0] = NULL;
   PetscCall(MatDestroy_Redundant(&(*A)->redundant));
@@ -1419,6 +1423,98 @@ PetscErrorCode MatDestroy(Mat *A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatThreadSafeSetError_Private - Records an error of the calling OpenMP thread in MatSetValues() with MAT_THREAD_SAFE_SET_VALUES,
+   it is raised after the parallel region by MatAssemblyBegin()
+
+   Input Parameters:
++  mat  - the matrix
+.  type - the kind of error
+.  row  - the row of the entry, or the row or column that is too large
+.  col  - the column of the entry, or the largest valid row or column
+-  ierr - the error code of the stash, for MAT_THREADSAFE_ERROR_STASH
+
+   Note:
+   This is called by the threads, so it neither uses the error stack nor allocates memory. Only the first error of each thread
+   is kept; threads beyond the ones counted by MatThreadSafeSetUpErrors_Private() share the last record.
+*/
+void MatThreadSafeSetError_Private(Mat mat, MatThreadSafeErrorType type, PetscInt row, PetscInt col, PetscErrorCode ierr)
+{
+  MatThreadSafeError *err;
+  int                 t = 0;
+
+#if PetscDefined(HAVE_OPENMP)
+  t = omp_get_thread_num();
+#endif
+  if (t >= mat->nthreadsafe_errors) t = (int)mat->nthreadsafe_errors - 1;
+  err = &mat->threadsafe_errors[t];
+  PetscPragmaOMP(critical(MatThreadSafeError))
+  if (err->type == MAT_THREADSAFE_ERROR_NONE) {
+    err->type = type;
+    err->row  = row;
+    err->col  = col;
+    err->ierr = ierr;
+  }
+}
+
+/* Raises the first error recorded by MatThreadSafeSetError_Private(), in the order of the threads, and clears them all */
+static PetscErrorCode MatThreadSafeCheckErrors_Private(Mat mat)
+{
+  MatThreadSafeError err = {MAT_THREADSAFE_ERROR_NONE, 0, 0, PETSC_SUCCESS};
+  PetscInt           t, tfirst = -1;
+
+  PetscFunctionBegin;
+  for (t = 0; t < mat->nthreadsafe_errors; t++) {
+    if (mat->threadsafe_errors[t].type != MAT_THREADSAFE_ERROR_NONE && tfirst < 0) {
+      tfirst = t;
+      err    = mat->threadsafe_errors[t];
+    }
+    mat->threadsafe_errors[t].type = MAT_THREADSAFE_ERROR_NONE;
+  }
+  switch (err.type) {
+  case MAT_THREADSAFE_ERROR_NONE:
+    break;
+  case MAT_THREADSAFE_ERROR_INSERTMODE:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Cannot mix add values and insert values, in MatSetValues() from OpenMP thread %" PetscInt_FMT, tfirst);
+  case MAT_THREADSAFE_ERROR_ROW:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Row too large: row %" PetscInt_FMT " max %" PetscInt_FMT ", in MatSetValues() from OpenMP thread %" PetscInt_FMT, err.row, err.col, tfirst);
+  case MAT_THREADSAFE_ERROR_COLUMN:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Column too large: col %" PetscInt_FMT " max %" PetscInt_FMT ", in MatSetValues() from OpenMP thread %" PetscInt_FMT, err.row, err.col, tfirst);
+  case MAT_THREADSAFE_ERROR_NEW_NONZERO:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Inserting a new nonzero at global row/column (%" PetscInt_FMT ", %" PetscInt_FMT ") into matrix with MAT_THREAD_SAFE_SET_VALUES, in MatSetValues() from OpenMP thread %" PetscInt_FMT, err.row, err.col, tfirst);
+  case MAT_THREADSAFE_ERROR_OFF_PROC:
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Setting off process row %" PetscInt_FMT " even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set, in MatSetValues() from OpenMP thread %" PetscInt_FMT, err.row, tfirst);
+  case MAT_THREADSAFE_ERROR_STASH:
+    SETERRQ(PETSC_COMM_SELF, err.ierr, "Stashing off process row %" PetscInt_FMT " failed, in MatSetValues() from OpenMP thread %" PetscInt_FMT, err.row, tfirst);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatThreadSafeSetUpErrors_Private - Allocates one record per OpenMP thread for the errors of MatSetValues() with
+   MAT_THREAD_SAFE_SET_VALUES, or frees them after raising
+   the errors still recorded
+
+   Input Parameters:
++  mat - the matrix
+-  flg - whether MAT_THREAD_SAFE_SET_VALUES is set
+*/
+PetscErrorCode MatThreadSafeSetUpErrors_Private(Mat mat, PetscBool flg)
+{
+  PetscFunctionBegin;
+  if (mat->nthreadsafe_errors) PetscCall(MatThreadSafeCheckErrors_Private(mat));
+  PetscCall(PetscFree(mat->threadsafe_errors));
+  mat->nthreadsafe_errors = 0;
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+#if PetscDefined(HAVE_OPENMP)
+  mat->nthreadsafe_errors = PetscMax(PetscMax(omp_get_max_threads(), omp_get_num_procs()), PetscNumOMPThreads);
+#else
+  mat->nthreadsafe_errors = 1;
+#endif
+  PetscCall(PetscCalloc1(mat->nthreadsafe_errors, &mat->threadsafe_errors));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 // PetscClangLinter pragma disable: -fdoc-section-header-unknown
 /*@C
   MatSetValues - Inserts or adds a block of values into a matrix.
@@ -1457,15 +1553,39 @@ PetscErrorCode MatDestroy(Mat *A)
   The routine `MatSetValuesBlocked()` may offer much better efficiency
   for users of block sparse formats (`MATSEQBAIJ` and `MATMPIBAIJ`).
 
+  With `MAT_THREAD_SAFE_SET_VALUES` set, calls from an OpenMP parallel region skip the argument checks and the logging, and their
+  errors are raised by the next `MatAssemblyBegin()`.
+
   Developer Notes:
   This is labeled with C so does not automatically generate Fortran stubs and interfaces
   because it requires multiple Fortran interfaces depending on which arguments are scalar or arrays.
 
+  With `MAT_THREAD_SAFE_SET_VALUES` the thread safe implementation is called before `PetscFunctionBeginHot` since the error
+  stack, the logging and the other state of the matrix are shared by the threads. `MatAssemblyBegin()` marks the matrix as
+  not assembled. The threads record their errors with `MatThreadSafeSetError_Private()` instead of calling `SETERRQ()`.
+
 .seealso: [](ch_matrices), `Mat`, `MatSetOption()`, `MatAssemblyBegin()`, `MatAssemblyEnd()`, `MatSetValuesBlocked()`, `MatSetValuesLocal()`,
           `InsertMode`, `INSERT_VALUES`, `ADD_VALUES`
 @*/
 PetscErrorCode MatSetValues(Mat mat, PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const PetscScalar v[], InsertMode addv)
 {
+#if PetscDefined(HAVE_OPENMP)
+  if (mat && mat->threadsafe_setvalues && omp_in_parallel()) {
+    InsertMode mode;
+
+    PetscPragmaOMP(atomic read)
+    mode = mat->insertmode;
+    if (mode != addv) {
+      if (mode != NOT_SET_VALUES) {
+        MatThreadSafeSetError_Private(mat, MAT_THREADSAFE_ERROR_INSERTMODE, 0, 0, PETSC_SUCCESS);
+        return PETSC_SUCCESS;
+      }
+      PetscPragmaOMP(atomic write)
+      mat->insertmode = addv;
+    }
+    return (m && n) ? (*mat->ops->setvalues)(mat, m, idxm, n, idxn, v, addv) : PETSC_SUCCESS;
+  }
+#endif
   PetscFunctionBeginHot;
   PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
   PetscValidType(mat, 1);
@@ -4136,6 +4256,7 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat, Vec b, Vec y, Vec x)
 .     `SOR_APPLY_UPPER`, `SOR_APPLY_LOWER` - applies
   upper/lower triangular part of matrix to
   vector (with omega)
+.     `SOR_MULTICOLOR` - sweep the rows color by color, may be combined with the sweeps above
 -     `SOR_ZERO_INITIAL_GUESS` - zero initial guess
 
   Level: developer
@@ -4150,6 +4271,11 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat, Vec b, Vec y, Vec x)
 
   For `MATBAIJ`, `MATSBAIJ`, and `MATAIJ` matrices with Inodes this does a block SOR smoothing, otherwise it does a pointwise smoothing
 
+  With `SOR_MULTICOLOR` a `MATSEQAIJ` matrix (or the diagonal block of a `MATMPIAIJ` matrix) is colored once with `MatColoring`,
+  the coloring is kept until the nonzero pattern changes. The rows of one color do not couple, so they are relaxed concurrently
+  by the threads of `-mat_seqaij_omp`. This is a different ordering than the natural one, hence the convergence differs from
+  the plain sweeps. Other matrix types ignore the flag.
+
   Most users should employ the `KSP` interface for linear solvers
   instead of working directly with matrix algebra routines such as this.
   See, e.g., `KSPCreate()`.
@@ -5680,6 +5806,7 @@ PetscErrorCode MatAssemblyBegin(Mat mat, MatAssemblyType type)
   PetscValidType(mat, 1);
   MatCheckPreallocated(mat, 1);
   PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix.\nDid you forget to call MatSetUnfactored()?");
+  if (mat->nthreadsafe_errors) PetscCall(MatThreadSafeCheckErrors_Private(mat));
   if (mat->assembled) {
     mat->was_assembled = PETSC_TRUE;
     mat->assembled     = PETSC_FALSE;
@@ -5908,6 +6035,15 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
   single call to `MatSetValues()`, preallocation is perfect, row oriented, `INSERT_VALUES` is used. Common
   with finite difference schemes with non-periodic boundary conditions.
 
+  `MAT_THREAD_SAFE_SET_VALUES` - `MatSetValues()` may be called concurrently by the OpenMP threads of a process, for example from a
+  threaded element loop. The matrix must already be assembled with its final nonzero pattern, values are added (or inserted) with
+  atomic operations, entries outside the pattern are ignored if `MAT_NEW_NONZERO_LOCATIONS` is `PETSC_FALSE` and generate an
+  error otherwise. The errors of the calls from the threads are raised by the next `MatAssemblyBegin()`. Off-process entries go
+  to a stash per thread that is merged by `MatAssemblyBegin()`. All threads must use the same `InsertMode`. Currently supported
+  for `MATSEQAIJ` and `MATMPIAIJ` only and requires PETSc configured with `--with-openmp`. Calling other PETSc functions from the
+  threads requires PETSc configured with `--with-threadsafety`. Setting the option to `PETSC_FALSE` restores the previous
+  `MatSetValues()` implementation.
+
   Developer Notes:
   `MAT_SYMMETRY_ETERNAL`, `MAT_STRUCTURAL_SYMMETRY_ETERNAL`, and `MAT_SPD_ETERNAL` are used by `MatAssemblyEnd()` and in other
   places where otherwise the value of `MAT_SYMMETRIC`, `MAT_STRUCTURALLY_SYMMETRIC` or `MAT_SPD` would need to be changed back
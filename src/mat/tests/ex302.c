@@ -0,0 +1,138 @@
+static char help[] = "Tests MAT_THREAD_SAFE_SET_VALUES: assembles a finite element Laplacian from OpenMP threads.\n\
+  -n <n>        : number of elements in each direction\n\
+  -nthreads <t> : number of threads in the element loop\n\
+  -new_nonzero  : the first element of the first process also adds an entry outside the nonzero pattern\n\n";
+
+#include <petscmat.h>
+
+/*
+   Computes the stiffness of element e of an n x n grid of bilinear elements, the value depends on the element so that an error shows.
+   It is called by the OpenMP threads, so it does not call PETSc: the error stack is not thread safe without --with-threadsafety.
+*/
+static void ElementStiffness(PetscInt n, PetscInt e, PetscInt idx[], PetscScalar ke[])
+{
+  PetscInt    ex = e % n, ey = e / n, i, j;
+  PetscScalar s = 1.0 + 0.01 * e;
+
+  idx[0] = ey * (n + 1) + ex;
+  idx[1] = idx[0] + 1;
+  idx[2] = idx[1] + n + 1;
+  idx[3] = idx[0] + n + 1;
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 4; j++) ke[4 * i + j] = s * (i == j ? 4.0 : ((i + j) % 2 ? -1.0 : -2.0)) / 6.0;
+  }
+}
+
+int main(int argc, char **args)
+{
+  Mat         A, B;
+  PetscInt       n = 8, nthreads = 1, N, nel, e, estart, eend, ne, nfailed = 0, idx[4];
+  PetscScalar    ke[16];
+  PetscMPIInt    size, rank;
+  PetscReal      norm;
+  PetscBool      newnonzero = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nthreads", &nthreads, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-new_nonzero", &newnonzero, NULL));
+  N   = (n + 1) * (n + 1);
+  nel = n * n;
+
+  /* every process assembles a contiguous range of elements, so elements on the boundaries add to rows of the neighbors */
+  ne = PETSC_DECIDE;
+  PetscCall(PetscSplitOwnership(PETSC_COMM_WORLD, &ne, &nel));
+  PetscCallMPI(MPI_Scan(&ne, &eend, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  estart = eend - ne;
+
+  /* reference matrix assembled sequentially */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, N, N, 9, NULL, 9, NULL, &B));
+  for (e = estart; e < eend; e++) {
+    ElementStiffness(n, e, idx, ke);
+    PetscCall(MatSetValues(B, 4, idx, 4, idx, ke, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+  /* the nonzero pattern must be assembled before the values can be added concurrently */
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &A));
+  PetscCall(MatSetOption(A, MAT_THREAD_SAFE_SET_VALUES, PETSC_TRUE));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_TRUE));
+  /* MatSetValues() returns an error code from the threads, it is checked once they are done */
+  PetscPragmaOMP(parallel for num_threads((int)nthreads) schedule(static) private(idx, ke) reduction(+:nfailed))
+  for (e = estart; e < eend; e++) {
+    PetscInt    col = N - 1;
+    PetscScalar one = 1.0;
+
+    ElementStiffness(n, e, idx, ke);
+    if (MatSetValues(A, 4, idx, 4, idx, ke, ADD_VALUES)) nfailed++;
+    if (newnonzero && !rank && e == estart && MatSetValues(A, 1, idx, 1, &col, &one, ADD_VALUES)) nfailed++;
+  }
+  PetscCheck(!nfailed, PETSC_COMM_SELF, PETSC_ERR_LIB, "MatSetValues() failed for %" PetscInt_FMT " elements", nfailed);
+  if (newnonzero) {
+    /* the threads do not raise errors, MatAssemblyBegin() does and then starts afresh */
+    PetscCall(PetscPushErrorHandler(PetscReturnErrorHandler, NULL));
+    ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+    PetscCall(PetscPopErrorHandler());
+    PetscCheck(ierr == (rank ? PETSC_SUCCESS : PETSC_ERR_ARG_OUTOFRANGE), PETSC_COMM_SELF, PETSC_ERR_PLIB, "MatAssemblyBegin() returned %d", (int)ierr);
+    if (ierr) {
+      PetscCall(PetscPrintf(PETSC_COMM_SELF, "The new nonzero added by a thread is an error of MatAssemblyBegin()\n"));
+      PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    }
+  } else PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  /* unsetting the option restores the usual MatSetValues() */
+  PetscCall(MatSetOption(A, MAT_THREAD_SAFE_SET_VALUES, PETSC_FALSE));
+  for (e = estart; e < eend; e++) {
+    ElementStiffness(n, e, idx, ke);
+    PetscCall(MatSetValues(A, 4, idx, 4, idx, ke, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatAXPY(A, -2.0, B, SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(A, NORM_FROBENIUS, &norm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Norm of the difference %g\n", norm < 1.e-12 ? 0.0 : (double)norm));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      requires: openmp
+      output_file: output/ex302_1.out
+
+      test:
+         suffix: 1
+         args: -n 8
+
+      test:
+         suffix: 2
+         nsize: 3
+         args: -n 8
+
+      test:
+         suffix: threads
+         nsize: 2
+         args: -n 16 -nthreads 4 -omp_num_threads 4
+
+      test:
+         suffix: threads_seq
+         args: -n 16 -nthreads 4 -omp_num_threads 4
+
+   test:
+      suffix: new_nonzero
+      requires: openmp
+      nsize: 2
+      args: -n 16 -nthreads 4 -omp_num_threads 4 -new_nonzero
+
+TEST*/
@@ -0,0 +1,138 @@
+static char help[] = "Benchmarks repeated assembly of a finite element matrix with MatSetValuesCOO() against MatSetValues() and MatAssemblyBegin/End().\n\
+  -n <n>       : number of elements in each direction\n\
+  -dof <d>     : number of unknowns per node\n\
+  -nrepeat <r> : number of assemblies, as in a Newton or time stepping loop\n\
+Use -log_view to compare the stages.\n\n";
+
+#include <petscmat.h>
+
+/* Node numbers of element e of an n x n grid of bilinear elements */
+static void ElementNodes(PetscInt n, PetscInt e, PetscInt idx[])
+{
+  PetscInt ex = e % n, ey = e / n;
+
+  idx[0] = ey * (n + 1) + ex;
+  idx[1] = idx[0] + 1;
+  idx[2] = idx[1] + n + 1;
+  idx[3] = idx[0] + n + 1;
+}
+
+/* Element matrix of element e in the assembly it, the values change with both so that an error shows */
+static void ElementMatrix(PetscInt dof, PetscInt e, PetscInt it, PetscScalar ke[])
+{
+  PetscInt    i, j, a, b, nd = 4 * dof;
+  PetscScalar s = 1.0 + 0.01 * e + 0.1 * it;
+
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 4; j++) {
+      PetscScalar k = s * (i == j ? 4.0 : ((i + j) % 2 ? -1.0 : -2.0)) / 6.0;
+
+      for (a = 0; a < dof; a++) {
+        for (b = 0; b < dof; b++) ke[(i * dof + a) * nd + j * dof + b] = a == b ? k : 0.1 * k;
+      }
+    }
+  }
+}
+
+int main(int argc, char **args)
+{
+  Mat           A, B;
+  PetscInt      n = 8, dof = 1, nrepeat = 3, N, nel, ne, e, estart, eend, it, i, j, a, nd, nodes[4], *idx, *coo_i, *coo_j;
+  PetscScalar  *ke, *v;
+  PetscReal     norm, anorm;
+  PetscLogStage stagecoo, stagesv;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dof", &dof, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nrepeat", &nrepeat, NULL));
+  PetscCall(PetscLogStageRegister("COO assembly", &stagecoo));
+  PetscCall(PetscLogStageRegister("MatSetValues assembly", &stagesv));
+  N   = (n + 1) * (n + 1) * dof;
+  nel = n * n;
+  nd  = 4 * dof;
+
+  /* every process assembles a contiguous range of elements, so elements on the boundaries add to rows of the neighbors */
+  ne = PETSC_DECIDE;
+  PetscCall(PetscSplitOwnership(PETSC_COMM_WORLD, &ne, &nel));
+  PetscCallMPI(MPI_Scan(&ne, &eend, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  estart = eend - ne;
+
+  /* the COO entries are the element matrices one after the other */
+  PetscCall(PetscMalloc5(nd, &idx, nd * nd, &ke, ne * nd * nd, &coo_i, ne * nd * nd, &coo_j, ne * nd * nd, &v));
+  for (e = estart; e < eend; e++) {
+    ElementNodes(n, e, nodes);
+    for (i = 0; i < 4; i++) {
+      for (a = 0; a < dof; a++) idx[i * dof + a] = nodes[i] * dof + a;
+    }
+    for (i = 0; i < nd; i++) {
+      for (j = 0; j < nd; j++) {
+        coo_i[((e - estart) * nd + i) * nd + j] = idx[i];
+        coo_j[((e - estart) * nd + i) * nd + j] = idx[j];
+      }
+    }
+  }
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetBlockSize(A, dof));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetPreallocationCOO(A, ne * nd * nd, coo_i, coo_j));
+
+  PetscCall(PetscLogStagePush(stagecoo));
+  for (it = 0; it < nrepeat; it++) {
+    for (e = estart; e < eend; e++) ElementMatrix(dof, e, it, v + (e - estart) * nd * nd);
+    PetscCall(MatSetValuesCOO(A, v, INSERT_VALUES));
+  }
+  PetscCall(PetscLogStagePop());
+
+  /* the same nonzero pattern, as it is after the first Newton step */
+  PetscCall(MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &B));
+  PetscCall(PetscLogStagePush(stagesv));
+  for (it = 0; it < nrepeat; it++) {
+    PetscCall(MatZeroEntries(B));
+    for (e = estart; e < eend; e++) {
+      ElementNodes(n, e, nodes);
+      ElementMatrix(dof, e, it, ke);
+      PetscCall(MatSetValuesBlocked(B, 4, nodes, 4, nodes, ke, ADD_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(PetscLogStagePop());
+
+  PetscCall(MatNorm(A, NORM_FROBENIUS, &anorm));
+  PetscCall(MatAXPY(B, -1.0, A, SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(B, NORM_FROBENIUS, &norm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Relative norm of the difference %g\n", norm / anorm < 1.e-12 ? 0.0 : (double)(norm / anorm)));
+
+  PetscCall(PetscFree5(idx, ke, coo_i, coo_j, v));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/ex303_1.out
+
+      test:
+         suffix: 1
+         args: -n 8
+
+      test:
+         suffix: 2
+         nsize: 3
+         args: -n 8 -dof 2
+
+      test:
+         suffix: 2_sf_neighbor
+         nsize: 3
+         requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+         args: -n 8 -dof 2 -sf_type neighbor
+
+TEST*/
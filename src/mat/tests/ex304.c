@@ -0,0 +1,95 @@
+static char help[] = "Tests MatConvert() of an AIJ matrix to MATAIJSINGLESHADOW and back.\n\
+  -n <n> : number of grid points in each direction\n\n";
+
+#include <petscmat.h>
+
+int main(int argc, char **args)
+{
+  Mat         A, B, C;
+  PetscInt    n = 10, Istart, Iend, Ii, i, j, J;
+  PetscScalar v;
+  PetscBool   flg;
+  MatType     type;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+
+  /* five point Laplacian; its values are exact in single precision so the products of the shadow are exact too */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, n * n, n * n, 5, NULL, 5, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (Ii = Istart; Ii < Iend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    if (j < n - 1) {
+      J = Ii + 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    v = 4.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  /* convert a copy in place to the shadow type and back */
+  PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(MatConvert(B, MATAIJSINGLESHADOW, MAT_INPLACE_MATRIX, &B));
+  PetscCall(MatGetType(B, &type));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Converted to %s\n", type));
+  PetscCall(MatMultEqual(A, B, 5, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() of %s differs", type);
+  PetscCall(MatMultAddEqual(A, B, 5, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMultAdd() of %s differs", type);
+
+  PetscCall(MatConvert(B, MATAIJ, MAT_INITIAL_MATRIX, &C));
+  PetscCall(MatGetType(C, &type));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Converted back to a new %s\n", type));
+  PetscCall(MatMultEqual(A, C, 5, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() of %s differs", type);
+  PetscCall(MatDestroy(&C));
+
+  PetscCall(MatConvert(B, MATAIJ, MAT_INPLACE_MATRIX, &B));
+  PetscCall(MatGetType(B, &type));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Converted back in place to %s\n", type));
+  PetscCall(MatMultEqual(A, B, 5, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() of %s differs", type);
+
+  /* the converted matrix is a plain AIJ matrix again: change the values and compare */
+  PetscCall(MatScale(A, 0.5));
+  PetscCall(MatScale(B, 0.5));
+  PetscCall(MatShift(A, 1.0));
+  PetscCall(MatShift(B, 1.0));
+  PetscCall(MatMultEqual(A, B, 5, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() of %s differs after changing the values", type);
+
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      requires: !complex
+
+   test:
+      suffix: 2
+      nsize: 2
+      requires: !complex
+
+TEST*/
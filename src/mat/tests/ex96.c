@@ -326,6 +326,19 @@ int main(int argc, char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm rowmerge -inner_offdiag_mat_product_algorithm rowmerge
      output_file: output/ex96_1.out
 
+   test:
+     suffix: seq_scattermap
+     requires: defined(PETSC_USE_INFO)
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scattermap -matptap_via scattermap -info :mat
+     filter: grep "Scatter map" | sort -b
+
+   test:
+     suffix: nonscalable_scattermap
+     nsize: 3
+     requires: defined(PETSC_USE_INFO)
+     args: -Mx 10 -My 5 -Mz 10 -matptap_via nonscalable -inner_C_loc_mat_product_algorithm scattermap -inner_C_oth_mat_product_algorithm scattermap -info :mat
+     filter: grep "Scatter map" | sort -b
+
    test:
      suffix: allatonce
      nsize: 3
@@ -1,5 +1,8 @@
 
 #include <petsc/private/matimpl.h>
+#if PetscDefined(HAVE_OPENMP)
+  #include <omp.h>
+#endif
 
 #define DEFAULT_STASH_SIZE 10000
 
@@ -77,6 +80,9 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
 
+  stash->nthreadstash = 0;
+  stash->threadstash  = NULL;
+
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_reproduce", &stash->reproduce, NULL));
 #if !defined(PETSC_HAVE_MPIUNI)
   flg = PETSC_FALSE;
@@ -104,6 +110,7 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
 PetscErrorCode MatStashDestroy_Private(MatStash *stash)
 {
   PetscFunctionBegin;
+  PetscCall(MatStashSetThreadSafe_Private(stash, PETSC_FALSE));
   PetscCall(PetscMatStashSpaceDestroy(&stash->space_head));
   if (stash->ScatterDestroy) PetscCall((*stash->ScatterDestroy)(stash));
   stash->space = NULL;
@@ -205,6 +212,87 @@ PetscErrorCode MatStashSetInitialSize_Private(MatStash *stash, PetscInt max)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatStashSetThreadSafe_Private - Gives each OpenMP thread its own stash so that MatStashValuesRow_Private() and
+   MatStashValuesCol_Private() can be called concurrently, see MAT_THREAD_SAFE_SET_VALUES
+
+   Input Parameters:
+   stash - the stash
+   flg   - use one stash per thread
+
+   Note:
+   The per-thread stashes are appended to the stash when the assembly starts, so the thread that stashed a value does
+   not matter to the receiving process.
+*/
+PetscErrorCode MatStashSetThreadSafe_Private(MatStash *stash, PetscBool flg)
+{
+  PetscInt t;
+
+  PetscFunctionBegin;
+  for (t = 0; t < stash->nthreadstash; t++) PetscCall(PetscMatStashSpaceDestroy(&stash->threadstash[t].space_head));
+  PetscCall(PetscFree(stash->threadstash));
+  stash->nthreadstash = 0;
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+#if PetscDefined(HAVE_OPENMP)
+  stash->nthreadstash = PetscMax(PetscMax(omp_get_max_threads(), omp_get_num_procs()), PetscNumOMPThreads);
+#else
+  SETERRQ(stash->comm, PETSC_ERR_SUP, "Thread safe stashing requires PETSc configured with OpenMP");
+#endif
+  PetscCall(PetscCalloc1(stash->nthreadstash, &stash->threadstash));
+  for (t = 0; t < stash->nthreadstash; t++) {
+    stash->threadstash[t].bs       = stash->bs;
+    stash->threadstash[t].umax     = stash->umax;
+    stash->threadstash[t].reallocs = -1;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Returns the stash of the calling thread */
+static inline PetscErrorCode MatStashGetThreadStash_Private(MatStash *stash, MatStash **tstash)
+{
+  PetscFunctionBegin;
+  *tstash = stash;
+#if PetscDefined(HAVE_OPENMP)
+  if (stash->nthreadstash) {
+    int t = omp_get_thread_num();
+
+    PetscCheck(t < stash->nthreadstash, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Thread %d stashes values but the stash was set up for %" PetscInt_FMT " threads, use -omp_num_threads", t, stash->nthreadstash);
+    *tstash = &stash->threadstash[t];
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Appends the values stashed by the threads to the stash */
+static PetscErrorCode MatStashMergeThreadStash_Private(MatStash *stash)
+{
+  PetscInt t;
+
+  PetscFunctionBegin;
+  for (t = 0; t < stash->nthreadstash; t++) {
+    MatStash *tstash = &stash->threadstash[t];
+
+    if (!tstash->space_head) continue;
+    if (stash->space) stash->space->next = tstash->space_head;
+    else stash->space_head = tstash->space_head;
+    stash->space = tstash->space;
+    stash->n += tstash->n;
+    stash->nmax += tstash->nmax;
+    stash->reallocs += tstash->reallocs + 1;
+    if (tstash->n) {
+      PetscInt bs2     = stash->bs * stash->bs;
+      PetscInt oldnmax = ((int)(tstash->n * 1.1) + 5) * bs2;
+      if (oldnmax > tstash->oldnmax) tstash->oldnmax = oldnmax;
+    }
+    tstash->space_head = NULL;
+    tstash->space      = NULL;
+    tstash->nmax       = 0;
+    tstash->n          = 0;
+    tstash->reallocs   = -1;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* MatStashExpand_Private - Expand the stash. This function is called
    when the space in the stash is not sufficient to add the new values
    being inserted into the stash.
@@ -256,9 +344,11 @@ static PetscErrorCode MatStashExpand_Private(MatStash *stash, PetscInt incr)
 PetscErrorCode MatStashValuesRow_Private(MatStash *stash, PetscInt row, PetscInt n, const PetscInt idxn[], const PetscScalar values[], PetscBool ignorezeroentries)
 {
   PetscInt           i, k, cnt = 0;
-  PetscMatStashSpace space = stash->space;
+  PetscMatStashSpace space;
 
   PetscFunctionBegin;
+  if (stash->nthreadstash) PetscCall(MatStashGetThreadStash_Private(stash, &stash));
+  space = stash->space;
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) PetscCall(MatStashExpand_Private(stash, n));
   space = stash->space;
@@ -294,9 +384,11 @@ PetscErrorCode MatStashValuesRow_Private(MatStash *stash, PetscInt row, PetscInt
 PetscErrorCode MatStashValuesCol_Private(MatStash *stash, PetscInt row, PetscInt n, const PetscInt idxn[], const PetscScalar values[], PetscInt stepval, PetscBool ignorezeroentries)
 {
   PetscInt           i, k, cnt = 0;
-  PetscMatStashSpace space = stash->space;
+  PetscMatStashSpace space;
 
   PetscFunctionBegin;
+  if (stash->nthreadstash) PetscCall(MatStashGetThreadStash_Private(stash, &stash));
+  space = stash->space;
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) PetscCall(MatStashExpand_Private(stash, n));
   space = stash->space;
@@ -453,6 +545,7 @@ static PetscErrorCode MatStashScatterBegin_Ref(Mat mat, MatStash *stash, PetscIn
   PetscMatStashSpace space, space_next;
 
   PetscFunctionBegin;
+  PetscCall(MatStashMergeThreadStash_Private(stash));
   { /* make sure all processors are either in INSERTMODE or ADDMODE */
     InsertMode addv;
     PetscCall(MPIU_Allreduce((PetscEnum *)&mat->insertmode, (PetscEnum *)&addv, 1, MPIU_ENUM, MPI_BOR, PetscObjectComm((PetscObject)mat)));
@@ -827,6 +920,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat, MatStash *stash, PetscIn
     PetscCheck(addv != (ADD_VALUES | INSERT_VALUES), PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Some processors inserted others added");
   }
 
+  PetscCall(MatStashMergeThreadStash_Private(stash));
   PetscCall(MatStashBlockTypeSetUp(stash));
   PetscCall(MatStashSortCompress_Private(stash, mat->insertmode));
   PetscCall(PetscSegBufferGetSize(stash->segsendblocks, &nblocks));
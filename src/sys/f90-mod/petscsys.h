@@ -149,6 +149,7 @@
       PetscEnum, parameter :: PETSC_BUILDTWOSIDED_ALLREDUCE = 0
       PetscEnum, parameter :: PETSC_BUILDTWOSIDED_IBARRIER = 1
       PetscEnum, parameter :: PETSC_BUILDTWOSIDED_REDSCATTER = 2
+      PetscEnum, parameter :: PETSC_BUILDTWOSIDED_HIERARCHICAL = 3
 
       type tPetscSubcomm
         sequence
@@ -210,6 +211,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_ALLREDUCE
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_IBARRIER
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_REDSCATTER
+!DEC$ ATTRIBUTES DLLEXPORT::PETSC_BUILDTWOSIDED_HIERARCHICAL
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_GENERAL
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_CONTIGUOUS
 !DEC$ ATTRIBUTES DLLEXPORT::PETSC_SUBCOMM_INTERLACED
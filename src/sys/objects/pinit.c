@@ -357,6 +357,12 @@ PETSC_EXTERN PetscMPIInt MPIAPI Petsc_Counter_Attr_Delete_Fn(MPI_Comm comm, Pets
   PetscFunctionBegin;
   PetscCallMPI(PetscInfo(NULL, "Deleting counter data in an MPI_Comm %ld\n", (long)comm));
   PetscCallMPI(PetscFree(counter->iflags));
+  if (counter->nodes) {
+    PetscCallMPI(MPI_Comm_free(&counter->nodes->nodecomm));
+    if (counter->nodes->leadercomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&counter->nodes->leadercomm));
+    PetscCallMPI(PetscFree(counter->nodes->nodeinfo));
+    PetscCallMPI(PetscFree(counter->nodes));
+  }
   while (comms) {
     PetscCallMPI(MPI_Comm_free(&comms->comm));
     pcomm = comms;
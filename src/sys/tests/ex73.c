@@ -0,0 +1,137 @@
+static char help[] = "A benchmark for testing the radix sorts of PetscSortInt(), PetscSortInt64(), PetscSortIntWithArray(), PetscSortIntWithIntCountArrayPair(), and the parallel sort PetscParallelSortInt()\n\
+  The arrays are filled with random numbers of both signs, compared with the results of PetscIntSortSemiOrdered().\n\
+  Usage:\n\
+   mpirun -n <np> ./ex73 -n <local length of the arrays to sort>, default=100000 \n\
+                         -r <repeat times for each sort>, default=5 \n\
+                         -d <average duplicates for each unique integer>, default=1, i.e., no duplicates \n\n";
+
+#include <petscis.h>
+#include <petsctime.h>
+
+int main(int argc, char **argv)
+{
+  PetscInt       i, l, n = 100000, r = 5, d = 1, N;
+  PetscInt      *XR, *X, *X1, *Y, *Y1, sum[2];
+  PetscInt64    *XR64, *X64;
+  PetscCount    *Z;
+  PetscReal      val;
+  PetscRandom    rdm;
+  PetscLogDouble time[5] = {0, 0, 0, 0, 0};
+  PetscMPIInt    size, rank;
+  PetscLayout    map;
+  PetscBool      sorted;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, (char *)0, help));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-r", &r, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-d", &d, NULL));
+  PetscCheck(n >= 1 && r >= 1 && d >= 1 && d <= n, PETSC_COMM_WORLD, PETSC_ERR_SUP, "Wrong input n=%" PetscInt_FMT ",r=%" PetscInt_FMT ",d=%" PetscInt_FMT ". They must be >=1 and n>=d", n, r, d);
+
+  PetscCall(PetscMalloc5(n, &XR, n, &X, n, &X1, n, &Y, n, &Y1));
+  PetscCall(PetscMalloc3(n, &XR64, n, &X64, n, &Z));
+  PetscCall(PetscRandomCreate(PETSC_COMM_SELF, &rdm));
+  PetscCall(PetscRandomSetSeed(rdm, 0x12345678 + 76543 * rank));
+  PetscCall(PetscRandomSeed(rdm));
+  PetscCall(PetscRandomSetFromOptions(rdm));
+  PetscCall(PetscRandomSetInterval(rdm, -1.0, 1.0));
+  for (i = 0; i < n; ++i) {
+    PetscCall(PetscRandomGetValueReal(rdm, &val));
+    XR[i] = (PetscInt)(val * (PetscReal)PETSC_MAX_INT);
+    if (d > 1) XR[i] = XR[i] % (n / d);
+    XR64[i] = (PetscInt64)XR[i] * (PetscInt64)(PETSC_INT64_MAX / PETSC_MAX_INT);
+  }
+
+  /* Sequential sorts, checked against PetscIntSortSemiOrdered() which does not use a radix sort */
+  for (l = 0; l < r; l++) {
+    PetscCall(PetscArraycpy(X, XR, n));
+    PetscCall(PetscArraycpy(X1, XR, n));
+    PetscCall(PetscIntSortSemiOrdered(n, X1));
+    PetscCall(PetscTimeSubtract(&time[0]));
+    PetscCall(PetscSortInt(n, X));
+    PetscCall(PetscTimeAdd(&time[0]));
+    for (i = 0; i < n; i++) PetscCheck(X[i] == X1[i], PETSC_COMM_SELF, PETSC_ERR_PLIB, "PetscSortInt() X[%" PetscInt_FMT "]:%" PetscInt_FMT " does not match %" PetscInt_FMT, i, X[i], X1[i]);
+
+    PetscCall(PetscArraycpy(X64, XR64, n));
+    PetscCall(PetscTimeSubtract(&time[1]));
+    PetscCall(PetscSortInt64(n, X64));
+    PetscCall(PetscTimeAdd(&time[1]));
+    for (i = 0; i < n; i++) PetscCheck(X64[i] == (PetscInt64)X1[i] * (PetscInt64)(PETSC_INT64_MAX / PETSC_MAX_INT), PETSC_COMM_SELF, PETSC_ERR_PLIB, "PetscSortInt64() produced wrong results!");
+
+    /* the satellite arrays hold the original positions, so they must end up sorted along with X */
+    PetscCall(PetscArraycpy(X, XR, n));
+    for (i = 0; i < n; i++) Y[i] = i;
+    PetscCall(PetscTimeSubtract(&time[2]));
+    PetscCall(PetscSortIntWithArray(n, X, Y));
+    PetscCall(PetscTimeAdd(&time[2]));
+    for (i = 0; i < n; i++) PetscCheck(X[i] == X1[i] && XR[Y[i]] == X[i], PETSC_COMM_SELF, PETSC_ERR_PLIB, "PetscSortIntWithArray() produced wrong results!");
+
+    PetscCall(PetscArraycpy(X, XR, n));
+    for (i = 0; i < n; i++) {
+      Y1[i] = i;
+      Z[i]  = n - i;
+    }
+    PetscCall(PetscTimeSubtract(&time[3]));
+    PetscCall(PetscSortIntWithIntCountArrayPair(n, X, Y1, Z));
+    PetscCall(PetscTimeAdd(&time[3]));
+    for (i = 0; i < n; i++) PetscCheck(X[i] == X1[i] && XR[Y1[i]] == X[i] && Z[i] == n - Y1[i], PETSC_COMM_SELF, PETSC_ERR_PLIB, "PetscSortIntWithIntCountArrayPair() produced wrong results!");
+  }
+
+  /* Parallel sort of the keys of all processes, to the same layout, checked by the sum of the keys */
+  PetscCall(PetscLayoutCreateFromSizes(PETSC_COMM_WORLD, n, PETSC_DECIDE, 1, &map));
+  PetscCall(PetscLayoutGetSize(map, &N));
+  for (l = 0; l < r; l++) {
+    PetscCall(PetscArraycpy(X, XR, n));
+    PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+    PetscCall(PetscTimeSubtract(&time[4]));
+    PetscCall(PetscParallelSortInt(map, map, X, X));
+    PetscCall(PetscTimeAdd(&time[4]));
+    PetscCall(PetscParallelSortedInt(PETSC_COMM_WORLD, n, X, &sorted));
+    PetscCheck(sorted, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "PetscParallelSortInt() produced wrong results!");
+    for (i = 0, sum[0] = 0, sum[1] = 0; i < n; i++) {
+      sum[0] += XR[i] % 1000;
+      sum[1] += X[i] % 1000;
+    }
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, sum, 2, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+    PetscCheck(sum[0] == sum[1], PETSC_COMM_WORLD, PETSC_ERR_PLIB, "PetscParallelSortInt() lost keys!");
+  }
+  PetscCall(PetscLayoutDestroy(&map));
+
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSortInt()                      with %" PetscInt_FMT " integers, %" PetscInt_FMT " duplicate(s) per unique value took %g seconds\n", n, d, time[0] / r));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSortInt64()                    with %" PetscInt_FMT " integers, %" PetscInt_FMT " duplicate(s) per unique value took %g seconds\n", n, d, time[1] / r));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSortIntWithArray()             with %" PetscInt_FMT " integers, %" PetscInt_FMT " duplicate(s) per unique value took %g seconds\n", n, d, time[2] / r));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSortIntWithIntCountArrayPair() with %" PetscInt_FMT " integers, %" PetscInt_FMT " duplicate(s) per unique value took %g seconds\n", n, d, time[3] / r));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscParallelSortInt()              with %" PetscInt_FMT " integers on %d processes took %g seconds, %g integers per second\n", N, size, time[4] / r, (double)(N * r) / time[4]));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "SUCCEEDED\n"));
+
+  PetscCall(PetscRandomDestroy(&rdm));
+  PetscCall(PetscFree3(XR64, X64, Z));
+  PetscCall(PetscFree5(XR, X, X1, Y, Y1));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+     filter: grep -vE "took"
+     output_file: output/ex73_1.out
+
+     test:
+       suffix: 1
+       nsize: {{1 3}}
+       args: -n 2000 -r 2
+
+     test:
+       suffix: 1_dups
+       nsize: 4
+       args: -n 2000 -r 2 -d 50
+
+     test:
+       suffix: 1_small
+       nsize: 3
+       args: -n 20 -r 2 -d 4
+
+TEST*/
@@ -200,4 +200,21 @@ int main(int argc, char **argv)
       args: -verbose -build_twosided redscatter
       output_file: output/ex8_1.out
 
+   testset:
+      nsize: 4
+      args: -verbose -build_twosided hierarchical
+      output_file: output/ex8_1.out
+
+      test:
+         suffix: hierarchical
+         args: -build_twosided_node_size {{1 2 3}}
+
+      test:
+         suffix: hierarchical_shared
+         requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+      test:
+         suffix: f_hierarchical
+         args: -build_twosided_f -build_twosided_node_size 2
+
 TEST*/
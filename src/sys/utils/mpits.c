@@ -4,7 +4,7 @@
 PetscLogEvent PETSC_BuildTwoSided;
 PetscLogEvent PETSC_BuildTwoSidedF;
 
-const char *const PetscBuildTwoSidedTypes[] = {"ALLREDUCE", "IBARRIER", "REDSCATTER", "PetscBuildTwoSidedType", "PETSC_BUILDTWOSIDED_", NULL};
+const char *const PetscBuildTwoSidedTypes[] = {"ALLREDUCE", "IBARRIER", "REDSCATTER", "HIERARCHICAL", "PetscBuildTwoSidedType", "PETSC_BUILDTWOSIDED_", NULL};
 
 static PetscBuildTwoSidedType _twosided_type = PETSC_BUILDTWOSIDED_NOTSET;
 
@@ -220,6 +220,198 @@ static PetscErrorCode PetscCommBuildTwoSided_RedScatter(MPI_Comm comm, PetscMPII
 }
 #endif
 
+/*
+  Split comm into nodes for PetscCommBuildTwoSided_Hierarchical(). The ranks of a node are those sharing memory, or consecutive
+  blocks of -build_twosided_node_size ranks, which also allows testing the algorithm on a single node
+*/
+static PetscErrorCode PetscCommBuildTwoSidedSetUpNodes_Private(MPI_Comm comm, PetscCommCounter *counter)
+{
+  struct PetscCommNodes *nodes;
+  PetscMPIInt            size, rank, nrank, nsize, nnodes, *granks, *sizes, *displs, *allranks, n, i;
+  PetscInt               nodesize = 0;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-build_twosided_node_size", &nodesize, NULL));
+  PetscCall(PetscNew(&nodes));
+  if (nodesize > 0) {
+    PetscCallMPI(MPI_Comm_split(comm, (PetscMPIInt)(rank / nodesize), rank, &nodes->nodecomm));
+  } else {
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+    PetscCallMPI(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodes->nodecomm));
+#else
+    PetscCallMPI(MPI_Comm_split(comm, rank, rank, &nodes->nodecomm));
+#endif
+  }
+  PetscCallMPI(MPI_Comm_rank(nodes->nodecomm, &nrank));
+  PetscCallMPI(MPI_Comm_size(nodes->nodecomm, &nsize));
+  PetscCallMPI(MPI_Comm_split(comm, nrank ? MPI_UNDEFINED : 0, rank, &nodes->leadercomm));
+
+  /* Node leaders learn the node of every rank, to route the messages */
+  PetscCall(PetscMalloc1(nsize, &granks));
+  PetscCallMPI(MPI_Gather(&rank, 1, MPI_INT, granks, 1, MPI_INT, 0, nodes->nodecomm));
+  if (!nrank) {
+    PetscCallMPI(MPI_Comm_size(nodes->leadercomm, &nnodes));
+    PetscCall(PetscMalloc3(nnodes, &sizes, nnodes, &displs, size, &allranks));
+    PetscCallMPI(MPI_Allgather(&nsize, 1, MPI_INT, sizes, 1, MPI_INT, nodes->leadercomm));
+    displs[0] = 0;
+    for (n = 1; n < nnodes; n++) displs[n] = displs[n - 1] + sizes[n - 1];
+    PetscCallMPI(MPI_Allgatherv(granks, nsize, MPI_INT, allranks, sizes, displs, MPI_INT, nodes->leadercomm));
+    PetscCall(PetscMalloc1(2 * size, &nodes->nodeinfo));
+    for (n = 0; n < nnodes; n++) {
+      for (i = 0; i < sizes[n]; i++) {
+        nodes->nodeinfo[2 * allranks[displs[n] + i]]     = n;
+        nodes->nodeinfo[2 * allranks[displs[n] + i] + 1] = i;
+      }
+    }
+    PetscCall(PetscFree3(sizes, displs, allranks));
+  }
+  PetscCall(PetscFree(granks));
+  PetscCall(PetscInfo(NULL, "Rank %d is rank %d of a node of %d ranks for PetscCommBuildTwoSided()\n", rank, nrank, nsize));
+  counter->nodes = nodes;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Sort the nrec records of in[], which begin with their source and destination ranks, by the bucket nodeinfo[2*dest+which] of
+  their destination into out[]. Return the size in bytes of each bucket and their offsets
+*/
+static PetscErrorCode PetscCommBuildTwoSidedSortRecords_Private(PetscMPIInt nrec, size_t recbytes, const char *in, const PetscMPIInt *nodeinfo, PetscMPIInt which, PetscMPIInt nbuckets, char *out, PetscMPIInt *sizes, PetscMPIInt *displs)
+{
+  PetscMPIInt i, b, dest, *pos;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(nbuckets + 1, &pos));
+  for (i = 0; i < nrec; i++) {
+    PetscCall(PetscMemcpy(&dest, in + i * recbytes + sizeof(PetscMPIInt), sizeof(PetscMPIInt)));
+    pos[nodeinfo[2 * dest + which] + 1]++;
+  }
+  for (b = 0; b < nbuckets; b++) pos[b + 1] += pos[b];
+  for (b = 0; b < nbuckets; b++) {
+    PetscCall(PetscMPIIntCast((pos[b + 1] - pos[b]) * recbytes, &sizes[b]));
+    PetscCall(PetscMPIIntCast(pos[b] * recbytes, &displs[b]));
+  }
+  for (i = 0; i < nrec; i++) {
+    PetscCall(PetscMemcpy(&dest, in + i * recbytes + sizeof(PetscMPIInt), sizeof(PetscMPIInt)));
+    b = nodeinfo[2 * dest + which];
+    PetscCall(PetscMemcpy(out + pos[b]++ * recbytes, in + i * recbytes, recbytes));
+  }
+  PetscCall(PetscFree(pos));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscCommBuildTwoSided_Hierarchical(MPI_Comm comm, PetscMPIInt count, MPI_Datatype dtype, PetscMPIInt nto, const PetscMPIInt *toranks, const void *todata, PetscMPIInt *nfrom, PetscMPIInt **fromranks, void *fromdata)
+{
+  PetscMPIInt            rank, tag, flg, nrank, nsize, nbytes, nrecvs, nsends = 0, *sizes = NULL, *displs = NULL, *franks, i;
+  MPI_Aint               lb, unitbytes;
+  size_t                 recbytes, databytes;
+  char                  *tdata = (char *)todata, *fdata, *sbuf, *nbuf = NULL, *obuf = NULL, *rbuf;
+  PetscCommCounter      *counter;
+  struct PetscCommNodes *nodes;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscCommDuplicate(comm, &comm, &tag));
+  PetscCallMPI(MPI_Comm_get_attr(comm, Petsc_Counter_keyval, &counter, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Inner PETSc communicator does not have its tag/name counter attribute set");
+  if (!counter->nodes) PetscCall(PetscCommBuildTwoSidedSetUpNodes_Private(comm, counter));
+  nodes = counter->nodes;
+  PetscCallMPI(MPI_Comm_rank(nodes->nodecomm, &nrank));
+  PetscCallMPI(MPI_Comm_size(nodes->nodecomm, &nsize));
+  PetscCallMPI(MPI_Type_get_extent(dtype, &lb, &unitbytes));
+  PetscCheck(lb == 0, comm, PETSC_ERR_SUP, "Datatype with nonzero lower bound %ld", (long)lb);
+  databytes = (size_t)count * (size_t)unitbytes;
+  recbytes  = 2 * sizeof(PetscMPIInt) + databytes;
+
+  /* Gather the records {source rank, destination rank, data} of the node on its leader */
+  PetscCall(PetscMalloc(nto * recbytes, &sbuf));
+  for (i = 0; i < nto; i++) {
+    PetscCall(PetscMemcpy(sbuf + i * recbytes, &rank, sizeof(PetscMPIInt)));
+    PetscCall(PetscMemcpy(sbuf + i * recbytes + sizeof(PetscMPIInt), &toranks[i], sizeof(PetscMPIInt)));
+    PetscCall(PetscMemcpy(sbuf + i * recbytes + 2 * sizeof(PetscMPIInt), tdata + i * databytes, databytes));
+  }
+  PetscCall(PetscMPIIntCast(nto * recbytes, &nbytes));
+  if (!nrank) PetscCall(PetscMalloc2(nsize, &sizes, nsize + 1, &displs));
+  PetscCallMPI(MPI_Gather(&nbytes, 1, MPI_INT, sizes, 1, MPI_INT, 0, nodes->nodecomm));
+  if (!nrank) {
+    displs[0] = 0;
+    for (i = 0; i < nsize; i++) displs[i + 1] = displs[i] + sizes[i];
+    PetscCall(PetscMalloc(displs[nsize], &nbuf));
+  }
+  PetscCallMPI(MPI_Gatherv(sbuf, nbytes, MPI_BYTE, nbuf, sizes, displs, MPI_BYTE, 0, nodes->nodecomm));
+  PetscCall(PetscFree(sbuf));
+
+  /* Exchange the records between node leaders, which find how many nodes send to them with a reduction of the length of the number of nodes */
+  if (!nrank) {
+    PetscMPIInt    nnodes, node, nrec, ntotal, *nsizes, *ndispls, *iflags, len;
+    MPI_Request   *reqs;
+    MPI_Status     status;
+    PetscSegBuffer seg;
+    char          *buf, *ibuf;
+
+    PetscCallMPI(MPI_Comm_size(nodes->leadercomm, &nnodes));
+    PetscCallMPI(MPI_Comm_rank(nodes->leadercomm, &node));
+    nrec = (PetscMPIInt)(displs[nsize] / recbytes);
+    PetscCall(PetscMalloc(displs[nsize], &obuf));
+    PetscCall(PetscMalloc4(nnodes, &nsizes, nnodes, &ndispls, nnodes, &iflags, nnodes, &reqs));
+    PetscCall(PetscCommBuildTwoSidedSortRecords_Private(nrec, recbytes, nbuf, nodes->nodeinfo, 0, nnodes, obuf, nsizes, ndispls));
+    for (i = 0; i < nnodes; i++) iflags[i] = (i != node && nsizes[i]) ? 1 : 0;
+#if defined(PETSC_HAVE_MPI_REDUCE_SCATTER_BLOCK)
+    PetscCallMPI(MPI_Reduce_scatter_block(iflags, &nrecvs, 1, MPI_INT, MPI_SUM, nodes->leadercomm));
+#else
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, iflags, nnodes, MPI_INT, MPI_SUM, nodes->leadercomm));
+    nrecvs = iflags[node];
+#endif
+    for (i = 0; i < nnodes; i++) {
+      if (i != node && nsizes[i]) PetscCallMPI(MPI_Isend(obuf + ndispls[i], nsizes[i], MPI_BYTE, i, tag, nodes->leadercomm, &reqs[nsends++]));
+    }
+    PetscCall(PetscSegBufferCreate(1, displs[nsize] + 1, &seg));
+    PetscCall(PetscSegBufferGet(seg, nsizes[node], &buf));
+    PetscCall(PetscMemcpy(buf, obuf + ndispls[node], nsizes[node]));
+    ntotal = nsizes[node];
+    for (i = 0; i < nrecvs; i++) {
+      PetscCallMPI(MPI_Probe(MPI_ANY_SOURCE, tag, nodes->leadercomm, &status));
+      PetscCallMPI(MPI_Get_count(&status, MPI_BYTE, &len));
+      PetscCall(PetscSegBufferGet(seg, len, &buf));
+      PetscCallMPI(MPI_Recv(buf, len, MPI_BYTE, status.MPI_SOURCE, tag, nodes->leadercomm, MPI_STATUS_IGNORE));
+      ntotal += len;
+    }
+    PetscCallMPI(MPI_Waitall(nsends, reqs, MPI_STATUSES_IGNORE));
+    PetscCall(PetscSegBufferExtractAlloc(seg, &ibuf));
+    PetscCall(PetscSegBufferDestroy(&seg));
+    PetscCall(PetscFree(obuf));
+
+    /* Sort the records arrived at the node by destination rank */
+    PetscCall(PetscMalloc(ntotal, &obuf));
+    PetscCall(PetscCommBuildTwoSidedSortRecords_Private((PetscMPIInt)(ntotal / recbytes), recbytes, ibuf, nodes->nodeinfo, 1, nsize, obuf, sizes, displs));
+    PetscCall(PetscFree(ibuf));
+    PetscCall(PetscFree4(nsizes, ndispls, iflags, reqs));
+  }
+  PetscCall(PetscFree(nbuf));
+
+  /* Scatter the records to their destination ranks on the node */
+  PetscCallMPI(MPI_Scatter(sizes, 1, MPI_INT, &nbytes, 1, MPI_INT, 0, nodes->nodecomm));
+  PetscCall(PetscMalloc(nbytes, &rbuf));
+  PetscCallMPI(MPI_Scatterv(obuf, sizes, displs, MPI_BYTE, rbuf, nbytes, MPI_BYTE, 0, nodes->nodecomm));
+  PetscCall(PetscFree(obuf));
+  PetscCall(PetscFree2(sizes, displs));
+  nrecvs = (PetscMPIInt)(nbytes / recbytes);
+  PetscCall(PetscMalloc1(nrecvs, &franks));
+  PetscCall(PetscMalloc(nrecvs * databytes, &fdata));
+  for (i = 0; i < nrecvs; i++) {
+    PetscCall(PetscMemcpy(&franks[i], rbuf + i * recbytes, sizeof(PetscMPIInt)));
+    PetscCall(PetscMemcpy(fdata + i * databytes, rbuf + i * recbytes + 2 * sizeof(PetscMPIInt), databytes));
+  }
+  PetscCall(PetscFree(rbuf));
+  PetscCall(PetscCommDestroy(&comm));
+
+  *nfrom             = nrecvs;
+  *fromranks         = franks;
+  *(void **)fromdata = fdata;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscCommBuildTwoSided - discovers communicating ranks given one-sided information, moving constant-sized data in the process (often message lengths)
 
@@ -238,9 +430,10 @@ static PetscErrorCode PetscCommBuildTwoSided_RedScatter(MPI_Comm comm, PetscMPII
 . fromranks - ranks receiving messages from (length `nfrom`, caller should `PetscFree()`)
 - fromdata  - packed data from each rank, each with count entries of type dtype (length nfrom, caller responsible for `PetscFree()`)
 
-  Options Database Key:
-. -build_twosided <allreduce|ibarrier|redscatter> - algorithm to set up two-sided communication. Default is allreduce for communicators with <= 1024 ranks,
+  Options Database Keys:
++ -build_twosided <allreduce|ibarrier|redscatter|hierarchical> - algorithm to set up two-sided communication. Default is allreduce for communicators with <= 1024 ranks,
                    otherwise ibarrier.
+- -build_twosided_node_size <n>                                  - with hierarchical, group the ranks into nodes of `n` consecutive ranks instead of the ranks sharing memory
 
   Level: developer
 
@@ -283,6 +476,9 @@ PetscErrorCode PetscCommBuildTwoSided(MPI_Comm comm, PetscMPIInt count, MPI_Data
 #else
     SETERRQ(comm, PETSC_ERR_PLIB, "MPI implementation does not provide MPI_Reduce_scatter_block (part of MPI-2.2)");
 #endif
+  case PETSC_BUILDTWOSIDED_HIERARCHICAL:
+    PetscCall(PetscCommBuildTwoSided_Hierarchical(comm, count, dtype, nto, toranks, todata, nfrom, fromranks, fromdata));
+    break;
   default:
     SETERRQ(comm, PETSC_ERR_PLIB, "Unknown method for building two-sided communication");
   }
@@ -519,6 +715,7 @@ PetscErrorCode PetscCommBuildTwoSidedFReq(MPI_Comm comm, PetscMPIInt count, MPI_
 #endif
   case PETSC_BUILDTWOSIDED_ALLREDUCE:
   case PETSC_BUILDTWOSIDED_REDSCATTER:
+  case PETSC_BUILDTWOSIDED_HIERARCHICAL:
     f = PetscCommBuildTwoSidedFReq_Reference;
     break;
   default:
@@ -240,6 +240,83 @@
     } \
   } while (0)
 
+/*
+   LSD radix sort, used instead of quicksort for arrays of at least PETSC_RADIXSORT_MIN integers. The keys are sorted by bytes,
+   from the least significant one, with their sign bit flipped so that the order of the unsigned keys is that of the signed keys.
+   The bytes that are the same in all keys, e.g., the high bytes of indices much smaller than the integer range, are skipped.
+   The satellite arrays Y[] and Z[], which can be NULL, are moved along with the keys. Each call allocates a scratch copy of the
+   arrays, so shorter arrays are left to quicksort: below about 1000 random keys it is as fast, with no allocation (measured
+   with -O2 and a copy of both sorts, the radix sort including its allocation)
+*/
+#define PETSC_RADIXSORT_MIN 1024
+
+#if defined(PETSC_USE_64BIT_INDICES)
+typedef uint64_t PetscUInt_Private;
+#else
+typedef uint32_t PetscUInt_Private;
+#endif
+
+#define RadixSortDefine(FuncName, KeyType, UKeyType, YType, ZType) \
+  static PetscErrorCode FuncName(PetscCount n, KeyType X[], YType Y[], ZType Z[]) \
+  { \
+    const UKeyType sign = (UKeyType)1 << (8 * sizeof(KeyType) - 1); \
+    PetscCount     count[sizeof(KeyType)][256], i, c, s, t; \
+    KeyType       *xbuf, *xsrc = X, *xdst, *xt; \
+    YType         *ybuf = NULL, *ysrc = Y, *ydst, *yt; \
+    ZType         *zbuf = NULL, *zsrc = Z, *zdst, *zt; \
+    size_t         d; \
+\
+    PetscFunctionBegin; \
+    PetscCall(PetscArrayzero(&count[0][0], sizeof(KeyType) * 256)); \
+    for (i = 0; i < n; i++) { \
+      const UKeyType u = (UKeyType)X[i] ^ sign; \
+      for (d = 0; d < sizeof(KeyType); d++) count[d][(u >> (8 * d)) & 0xff]++; \
+    } \
+    PetscCall(PetscMalloc1(n, &xbuf)); \
+    if (Y) PetscCall(PetscMalloc1(n, &ybuf)); \
+    if (Z) PetscCall(PetscMalloc1(n, &zbuf)); \
+    xdst = xbuf; \
+    ydst = ybuf; \
+    zdst = zbuf; \
+    for (d = 0; d < sizeof(KeyType); d++) { \
+      if (count[d][(((UKeyType)xsrc[0] ^ sign) >> (8 * d)) & 0xff] == n) continue; \
+      for (c = 0, s = 0; c < 256; c++) { \
+        t           = count[d][c]; \
+        count[d][c] = s; \
+        s += t; \
+      } \
+      for (i = 0; i < n; i++) { \
+        const PetscCount j = count[d][(((UKeyType)xsrc[i] ^ sign) >> (8 * d)) & 0xff]++; \
+        xdst[j]            = xsrc[i]; \
+        if (Y) ydst[j] = ysrc[i]; \
+        if (Z) zdst[j] = zsrc[i]; \
+      } \
+      xt   = xsrc; \
+      xsrc = xdst; \
+      xdst = xt; \
+      yt   = ysrc; \
+      ysrc = ydst; \
+      ydst = yt; \
+      zt   = zsrc; \
+      zsrc = zdst; \
+      zdst = zt; \
+    } \
+    if (xsrc != X) { \
+      PetscCall(PetscArraycpy(X, xsrc, n)); \
+      if (Y) PetscCall(PetscArraycpy(Y, ysrc, n)); \
+      if (Z) PetscCall(PetscArraycpy(Z, zsrc, n)); \
+    } \
+    PetscCall(PetscFree(xbuf)); \
+    PetscCall(PetscFree(ybuf)); \
+    PetscCall(PetscFree(zbuf)); \
+    PetscFunctionReturn(PETSC_SUCCESS); \
+  }
+
+RadixSortDefine(RadixSortInt_Private, PetscInt, PetscUInt_Private, PetscInt, PetscInt)
+RadixSortDefine(RadixSortIntCount_Private, PetscInt, PetscUInt_Private, PetscInt, PetscCount)
+RadixSortDefine(RadixSortInt64_Private, PetscInt64, uint64_t, PetscInt64, PetscInt64)
+RadixSortDefine(RadixSortCount_Private, PetscCount, size_t, PetscCount, PetscCount)
+
 /*@
   PetscSortedInt - Determines whether the `PetscInt` array is sorted.
 
@@ -304,6 +381,8 @@ PetscErrorCode PetscSortedInt64(PetscInt n, const PetscInt64 X[], PetscBool *sor
   is completely random. There are exceptions to this and so it is __highly__ recommended that the user benchmark their
   code to see which routine is fastest.
 
+  Arrays of at least 1024 entries are sorted with a least-significant-digit radix sort, whose cost is linear in `n`.
+
   Level: intermediate
 
 .seealso: `PetscIntSortSemiOrdered()`, `PetscSortReal()`, `PetscSortIntWithPermutation()`
@@ -314,6 +393,10 @@ PetscErrorCode PetscSortInt(PetscInt n, PetscInt X[])
 
   PetscFunctionBegin;
   if (n) PetscAssertPointer(X, 2);
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortInt_Private(n, X, NULL, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort1(PetscSortInt, X, n, pivot, t1);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -328,7 +411,8 @@ PetscErrorCode PetscSortInt(PetscInt n, PetscInt X[])
 - X - array of integers
 
   Notes:
-  This function sorts `PetscCount`s assumed to be in completely random order
+  This function sorts `PetscCount`s assumed to be in completely random order. Arrays of at least 1024 entries are sorted
+  with a least-significant-digit radix sort.
 
   Level: intermediate
 
@@ -340,6 +424,10 @@ PetscErrorCode PetscSortInt64(PetscInt n, PetscInt64 X[])
 
   PetscFunctionBegin;
   if (n) PetscAssertPointer(X, 2);
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortInt64_Private(n, X, NULL, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort1(PetscSortInt64, X, n, pivot, t1);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -354,7 +442,8 @@ PetscErrorCode PetscSortInt64(PetscInt n, PetscInt64 X[])
 - X - array of integers
 
   Notes:
-  This function sorts `PetscCount`s assumed to be in completely random order
+  This function sorts `PetscCount`s assumed to be in completely random order. Arrays of at least 1024 entries are sorted
+  with a least-significant-digit radix sort.
 
   Level: intermediate
 
@@ -366,6 +455,10 @@ PetscErrorCode PetscSortCount(PetscInt n, PetscCount X[])
 
   PetscFunctionBegin;
   if (n) PetscAssertPointer(X, 2);
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortCount_Private(n, X, NULL, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort1(PetscSortCount, X, n, pivot, t1);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -611,6 +704,11 @@ PetscErrorCode PetscFindMPIInt(PetscMPIInt key, PetscInt n, const PetscMPIInt X[
 . X - array of integers
 - Y - second array of integers
 
+  Note:
+  Arrays of at least 1024 entries are sorted with a least-significant-digit radix sort, which is stable: entries with equal
+  values in `X` keep their relative order in `Y`. The quicksort used for shorter arrays does not, so the order of the entries
+  of `Y` that have equal values in `X` depends on `n`.
+
   Level: intermediate
 
 .seealso: `PetscIntSortSemiOrderedWithArray()`, `PetscSortReal()`, `PetscSortIntWithPermutation()`, `PetscSortInt()`, `PetscSortIntWithCountArray()`
@@ -620,6 +718,10 @@ PetscErrorCode PetscSortIntWithArray(PetscInt n, PetscInt X[], PetscInt Y[])
   PetscInt pivot, t1, t2;
 
   PetscFunctionBegin;
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortInt_Private(n, X, Y, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort2(PetscSortIntWithArray, X, Y, n, pivot, t1, t2);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -636,6 +738,11 @@ PetscErrorCode PetscSortIntWithArray(PetscInt n, PetscInt X[], PetscInt Y[])
 . Y - second array of integers (first array of the pair)
 - Z - third array of integers  (second array of the pair)
 
+  Note:
+  Arrays of at least 1024 entries are sorted with a least-significant-digit radix sort, which is stable: entries with equal
+  values in `X` keep their relative order in `Y` and `Z`. The quicksort used for shorter arrays does not, so the order of the
+  entries of `Y` and `Z` that have equal values in `X` depends on `n`.
+
   Level: intermediate
 
 .seealso: `PetscSortReal()`, `PetscSortIntWithPermutation()`, `PetscSortIntWithArray()`, `PetscIntSortSemiOrdered()`, `PetscSortIntWithIntCountArrayPair()`
@@ -645,6 +752,10 @@ PetscErrorCode PetscSortIntWithArrayPair(PetscInt n, PetscInt X[], PetscInt Y[],
   PetscInt pivot, t1, t2, t3;
 
   PetscFunctionBegin;
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortInt_Private(n, X, Y, Z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort3(PetscSortIntWithArrayPair, X, Y, Z, n, pivot, t1, t2, t3);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -660,6 +771,11 @@ PetscErrorCode PetscSortIntWithArrayPair(PetscInt n, PetscInt X[], PetscInt Y[],
 . X - array of integers
 - Y - second array of PetscCounts (signed integers)
 
+  Note:
+  Arrays of at least 1024 entries are sorted with a least-significant-digit radix sort, which is stable: entries with equal
+  values in `X` keep their relative order in `Y`. The quicksort used for shorter arrays does not, so the order of the entries
+  of `Y` that have equal values in `X` depends on `n`.
+
   Level: intermediate
 
 .seealso: `PetscIntSortSemiOrderedWithArray()`, `PetscSortReal()`, `PetscSortIntPermutation()`, `PetscSortInt()`, `PetscSortIntWithArray()`
@@ -670,6 +786,10 @@ PetscErrorCode PetscSortIntWithCountArray(PetscCount n, PetscInt X[], PetscCount
   PetscCount t2;
 
   PetscFunctionBegin;
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortIntCount_Private(n, X, NULL, Y));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort2(PetscSortIntWithCountArray, X, Y, n, pivot, t1, t2);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -688,9 +808,13 @@ PetscErrorCode PetscSortIntWithCountArray(PetscCount n, PetscInt X[], PetscCount
 
   Level: intermediate
 
-  Note:
+  Notes:
   Usually X, Y are matrix row/column indices, and Z is a permutation array and therefore Z's type is PetscCount to allow 2B+ nonzeros even with 32-bit PetscInt.
 
+  Arrays of at least 1024 entries are sorted with a least-significant-digit radix sort, which is stable: entries with equal
+  values in `X` keep their relative order in `Y` and `Z`. The quicksort used for shorter arrays does not, so the order of the
+  entries of `Y` and `Z` that have equal values in `X` depends on `n`.
+
 .seealso: `PetscSortReal()`, `PetscSortIntPermutation()`, `PetscSortIntWithArray()`, `PetscIntSortSemiOrdered()`, `PetscSortIntWithArrayPair()`
 @*/
 PetscErrorCode PetscSortIntWithIntCountArrayPair(PetscCount n, PetscInt X[], PetscInt Y[], PetscCount Z[])
@@ -699,6 +823,10 @@ PetscErrorCode PetscSortIntWithIntCountArrayPair(PetscCount n, PetscInt X[], Pet
   PetscCount t3;            /* temp for Z[] */
 
   PetscFunctionBegin;
+  if (n >= PETSC_RADIXSORT_MIN) {
+    PetscCall(RadixSortIntCount_Private(n, X, Y, Z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   QuickSort3(PetscSortIntWithIntCountArrayPair, X, Y, Z, n, pivot, t1, t2, t3);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
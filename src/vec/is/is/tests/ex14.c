@@ -0,0 +1,103 @@
+static char help[] = "Tests ISGlobalToLocalMappingApply() and ISGlobalToLocalMappingApplyBlock() of the ISLocalToGlobalMapping types against ISLOCALTOGLOBALMAPPINGBASIC.\n\n\
+  -n <n>   : number of local block indices\n\
+  -bs <bs> : block size\n\
+  -m <m>   : number of global indices to map\n\n";
+
+#include <petscis.h>
+
+/* Maps m global indices with all the modes, block and not, with the indices unsorted, sorted, and in place */
+static PetscErrorCode TestApply(ISLocalToGlobalMapping ltog, ISLocalToGlobalMapping ref, PetscInt m, const PetscInt g[], PetscInt *nerr)
+{
+  PetscInt *gs, *out, *outref, *inplace, k, t, b, nout, noutref;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc4(m, &gs, m, &out, m, &outref, m, &inplace));
+  PetscCall(PetscArraycpy(gs, g, m));
+  PetscCall(PetscSortInt(m, gs));
+  for (k = 0; k < 2; k++) {
+    const PetscInt *in = k ? gs : g;
+
+    for (t = 0; t < 2; t++) {
+      ISGlobalToLocalMappingMode mode = t ? IS_GTOLM_DROP : IS_GTOLM_MASK;
+
+      for (b = 0; b < 2; b++) {
+        PetscErrorCode (*apply)(ISLocalToGlobalMapping, ISGlobalToLocalMappingMode, PetscInt, const PetscInt[], PetscInt *, PetscInt[]) = b ? ISGlobalToLocalMappingApplyBlock : ISGlobalToLocalMappingApply;
+
+        PetscCall(apply(ref, mode, m, in, &noutref, outref));
+        PetscCall(apply(ltog, mode, m, in, NULL, out));
+        PetscCall(apply(ltog, mode, m, in, &nout, NULL));
+        *nerr += nout != noutref;
+        PetscCall(PetscArraycpy(inplace, in, m));
+        PetscCall(apply(ltog, mode, m, inplace, NULL, inplace));
+        for (PetscInt i = 0; i < noutref; i++) *nerr += (out[i] != outref[i]) + (inplace[i] != outref[i]);
+      }
+    }
+  }
+  PetscCall(PetscFree4(gs, out, outref, inplace));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  ISLocalToGlobalMapping ltog, ref;
+  PetscInt               n = 1000, bs = 1, m = 2000, i, j, len, *idx, *g, nerr = 0;
+  PetscRandom            rnd;
+  PetscReal              v;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscRandomCreate(PETSC_COMM_SELF, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+
+  /* Runs of random lengths at random places, some of them negative or overlapping the previous ones */
+  PetscCall(PetscMalloc1(n, &idx));
+  for (i = 0; i < n; i += len) {
+    PetscInt first;
+
+    PetscCall(PetscRandomGetValueReal(rnd, &v));
+    len = PetscMin(1 + (PetscInt)(v * 20), n - i);
+    PetscCall(PetscRandomGetValueReal(rnd, &v));
+    first = (PetscInt)(v * 4 * n);
+    PetscCall(PetscRandomGetValueReal(rnd, &v));
+    for (j = 0; j < len; j++) idx[i + j] = v < 0.1 ? -1 - j : first + j;
+  }
+  PetscCall(ISLocalToGlobalMappingCreate(PETSC_COMM_SELF, bs, n, idx, PETSC_COPY_VALUES, &ltog));
+  PetscCall(ISLocalToGlobalMappingSetFromOptions(ltog));
+  PetscCall(ISLocalToGlobalMappingCreate(PETSC_COMM_SELF, bs, n, idx, PETSC_OWN_POINTER, &ref));
+  PetscCall(ISLocalToGlobalMappingSetType(ref, ISLOCALTOGLOBALMAPPINGBASIC));
+
+  /* Global indices, including some negative ones and some past the mapped ones; small arrays are looked up one by one */
+  PetscCall(PetscMalloc1(m, &g));
+  for (i = 0; i < m; i++) {
+    PetscCall(PetscRandomGetValueReal(rnd, &v));
+    g[i] = (PetscInt)(v * 5 * n * bs) - n * bs / 10;
+  }
+  PetscCall(TestApply(ltog, ref, m, g, &nerr));
+  PetscCall(TestApply(ltog, ref, PetscMin(m, 10), g, &nerr));
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "Global to local mapping: %s\n", nerr ? "FAILED" : "ok"));
+
+  PetscCall(PetscFree(g));
+  PetscCall(ISLocalToGlobalMappingDestroy(&ltog));
+  PetscCall(ISLocalToGlobalMappingDestroy(&ref));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      args: -bs {{1 3}} -islocaltoglobalmapping_type {{hash runs}}
+      output_file: output/ex14_1.out
+
+      test:
+         suffix: 1
+
+      test:
+         suffix: 1_small
+         args: -n 7 -m 300
+
+TEST*/
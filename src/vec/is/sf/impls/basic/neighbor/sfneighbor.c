@@ -18,6 +18,7 @@ typedef struct {
   PetscSFAint  *rootdispls, *leafdispls; /* displs for non-distinguished ranks */
   PetscMPIInt  *rootweights, *leafweights;
   PetscInt      rootdegree, leafdegree;
+  PetscBool     persistent; /* Use persistent neighborhood collectives, if MPI has them */
 } PetscSF_Neighbor;
 
 /*===================================================================================*/
@@ -74,6 +75,51 @@ static PetscErrorCode PetscSFGetDistComm_Neighbor(PetscSF sf, PetscSFDirection d
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Start the neighborhood alltoallv of the link in the given direction. With -sf_neighbor_persistent, the request is a persistent one,
+   init'ed on first use and again only when the root/leaf buffers bound to it change, so that repeated communication just calls MPI_Start() */
+static PetscErrorCode PetscSFLinkStartNeighborAlltoallv_Neighbor(PetscSF sf, PetscSFLink link, PetscSFDirection direction, MPI_Datatype unit, void *rootbuf, void *leafbuf, MPI_Request *req)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor *)sf->data;
+  MPI_Comm          distcomm;
+
+  PetscFunctionBegin;
+  /* OpenMPI-3.0 ran into error with rootdegree = leafdegree = 0, so we skip the call in this case */
+  if (!dat->rootdegree && !dat->leafdegree) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFGetDistComm_Neighbor(sf, direction, &distcomm));
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  if (dat->persistent) {
+    const PetscMemType rootmtype_mpi = link->rootmtype_mpi;
+    const PetscInt     rootdirect_mpi = link->rootdirect_mpi;
+    PetscBool         *inited         = &link->rootreqsinited[direction][rootmtype_mpi][rootdirect_mpi];
+    const void       **nbrrootbuf     = &link->nbrrootbuf[direction][rootmtype_mpi][rootdirect_mpi];
+    const void       **nbrleafbuf     = &link->nbrleafbuf[direction][rootmtype_mpi][rootdirect_mpi];
+
+    if (*inited && (*nbrrootbuf != rootbuf || *nbrleafbuf != leafbuf)) {
+      if (*req != MPI_REQUEST_NULL) PetscCallMPI(MPI_Request_free(req));
+      *inited = PETSC_FALSE;
+    }
+    if (!*inited) {
+      if (direction == PETSCSF_ROOT2LEAF) {
+        PetscCallMPI(MPIU_Neighbor_alltoallv_init(rootbuf, dat->rootcounts, dat->rootdispls, unit, leafbuf, dat->leafcounts, dat->leafdispls, unit, distcomm, MPI_INFO_NULL, req));
+      } else {
+        PetscCallMPI(MPIU_Neighbor_alltoallv_init(leafbuf, dat->leafcounts, dat->leafdispls, unit, rootbuf, dat->rootcounts, dat->rootdispls, unit, distcomm, MPI_INFO_NULL, req));
+      }
+      *nbrrootbuf = rootbuf;
+      *nbrleafbuf = leafbuf;
+      *inited     = PETSC_TRUE;
+    }
+    PetscCallMPI(MPI_Start(req));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCallMPI(MPIU_Ineighbor_alltoallv(rootbuf, dat->rootcounts, dat->rootdispls, unit, leafbuf, dat->leafcounts, dat->leafdispls, unit, distcomm, req));
+  } else {
+    PetscCallMPI(MPIU_Ineighbor_alltoallv(leafbuf, dat->leafcounts, dat->leafdispls, unit, rootbuf, dat->rootcounts, dat->rootdispls, unit, distcomm, req));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*===================================================================================*/
 /*              Implementations of SF public APIs                                    */
 /*===================================================================================*/
@@ -139,13 +185,13 @@ static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
   PetscFunctionBegin;
   PetscCheck(!dat->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
   PetscCall(PetscFree6(dat->rootdispls, dat->rootcounts, dat->rootweights, dat->leafdispls, dat->leafcounts, dat->leafweights));
+  PetscCall(PetscSFReset_Basic(sf)); /* Common part, also frees the requests, which might be persistent ones on the communicators below */
   for (i = 0; i < 2; i++) {
     if (dat->initialized[i]) {
       PetscCallMPI(MPI_Comm_free(&dat->comms[i]));
       dat->initialized[i] = PETSC_FALSE;
     }
   }
-  PetscCall(PetscSFReset_Basic(sf)); /* Common part */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -160,8 +206,7 @@ static PetscErrorCode PetscSFDestroy_Neighbor(PetscSF sf)
 static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
 {
   PetscSFLink       link;
-  PetscSF_Neighbor *dat      = (PetscSF_Neighbor *)sf->data;
-  MPI_Comm          distcomm = MPI_COMM_NULL;
+  PetscSF_Neighbor *dat     = (PetscSF_Neighbor *)sf->data;
   void             *rootbuf = NULL, *leafbuf = NULL;
   MPI_Request      *req;
 
@@ -170,11 +215,9 @@ static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf, MPI_Datatype unit,
   PetscCall(PetscSFLinkPackRootData(sf, link, PETSCSF_REMOTE, rootdata));
   /* Do neighborhood alltoallv for remote ranks */
   PetscCall(PetscSFLinkCopyRootBufferInCaseNotUseGpuAwareMPI(sf, link, PETSC_TRUE /* device2host before sending */));
-  PetscCall(PetscSFGetDistComm_Neighbor(sf, PETSCSF_ROOT2LEAF, &distcomm));
   PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_ROOT2LEAF, &rootbuf, &leafbuf, &req, NULL));
   PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, PETSCSF_ROOT2LEAF));
-  /* OpenMPI-3.0 ran into error with rootdegree = leafdegree = 0, so we skip the call in this case */
-  if (dat->rootdegree || dat->leafdegree) PetscCallMPI(MPIU_Ineighbor_alltoallv(rootbuf, dat->rootcounts, dat->rootdispls, unit, leafbuf, dat->leafcounts, dat->leafdispls, unit, distcomm, req));
+  PetscCall(PetscSFLinkStartNeighborAlltoallv_Neighbor(sf, link, PETSCSF_ROOT2LEAF, unit, rootbuf, leafbuf, req));
   PetscCall(PetscLogMPIMessages(dat->rootdegree, dat->rootcounts, unit, dat->leafdegree, dat->leafcounts, unit));
   PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata, leafdata, op));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -183,20 +226,18 @@ static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf, MPI_Datatype unit,
 static inline PetscErrorCode PetscSFLeafToRootBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op, PetscSFOperation sfop, PetscSFLink *out)
 {
   PetscSFLink       link;
-  PetscSF_Neighbor *dat      = (PetscSF_Neighbor *)sf->data;
-  MPI_Comm          distcomm = MPI_COMM_NULL;
+  PetscSF_Neighbor *dat     = (PetscSF_Neighbor *)sf->data;
   void             *rootbuf = NULL, *leafbuf = NULL;
-  MPI_Request      *req = NULL;
+  MPI_Request      *req     = NULL;
 
   PetscFunctionBegin;
   PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, sfop, &link));
   PetscCall(PetscSFLinkPackLeafData(sf, link, PETSCSF_REMOTE, leafdata));
   /* Do neighborhood alltoallv for remote ranks */
   PetscCall(PetscSFLinkCopyLeafBufferInCaseNotUseGpuAwareMPI(sf, link, PETSC_TRUE /* device2host before sending */));
-  PetscCall(PetscSFGetDistComm_Neighbor(sf, PETSCSF_LEAF2ROOT, &distcomm));
   PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_LEAF2ROOT, &rootbuf, &leafbuf, &req, NULL));
   PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, PETSCSF_LEAF2ROOT));
-  if (dat->rootdegree || dat->leafdegree) PetscCallMPI(MPIU_Ineighbor_alltoallv(leafbuf, dat->leafcounts, dat->leafdispls, unit, rootbuf, dat->rootcounts, dat->rootdispls, unit, distcomm, req));
+  PetscCall(PetscSFLinkStartNeighborAlltoallv_Neighbor(sf, link, PETSCSF_LEAF2ROOT, unit, rootbuf, leafbuf, req));
   PetscCall(PetscLogMPIMessages(dat->leafdegree, dat->leafcounts, unit, dat->rootdegree, dat->rootcounts, unit));
   *out = link;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -212,6 +253,49 @@ static PetscErrorCode PetscSFReduceBegin_Neighbor(PetscSF sf, MPI_Datatype unit,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Same as PetscSFBcastMultipleBegin_Basic() but with a neighborhood alltoallv */
+static PetscErrorCode PetscSFBcastMultipleBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **rootdata, void **leafdata, MPI_Op op)
+{
+  PetscSFLink       link;
+  PetscSF_Neighbor *dat     = (PetscSF_Neighbor *)sf->data;
+  void             *rootbuf = NULL, *leafbuf = NULL;
+  MPI_Request      *req;
+  MPI_Datatype      munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkCreate(sf, munit, PETSC_MEMTYPE_HOST, rootdata[0], PETSC_MEMTYPE_HOST, leafdata[0], op, PETSCSF_BCAST_MULTIPLE, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkSetUpUnitLink(sf, link, unit));
+  PetscCall(PetscSFLinkPackRootDataMultiple(sf, link, n, rootdata));
+  PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_ROOT2LEAF, &rootbuf, &leafbuf, &req, NULL));
+  PetscCall(PetscSFLinkStartNeighborAlltoallv_Neighbor(sf, link, PETSCSF_ROOT2LEAF, link->unit, rootbuf, leafbuf, req));
+  PetscCall(PetscLogMPIMessages(dat->rootdegree, dat->rootcounts, link->unit, dat->leafdegree, dat->leafcounts, link->unit));
+  PetscCall(PetscSFLinkScatterLocalMultiple(sf, link, PETSCSF_ROOT2LEAF, n, (void **)rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceMultipleBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **leafdata, void **rootdata, MPI_Op op)
+{
+  PetscSFLink       link;
+  PetscSF_Neighbor *dat     = (PetscSF_Neighbor *)sf->data;
+  void             *rootbuf = NULL, *leafbuf = NULL;
+  MPI_Request      *req     = NULL;
+  MPI_Datatype      munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkCreate(sf, munit, PETSC_MEMTYPE_HOST, rootdata[0], PETSC_MEMTYPE_HOST, leafdata[0], op, PETSCSF_REDUCE_MULTIPLE, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkSetUpUnitLink(sf, link, unit));
+  PetscCall(PetscSFLinkPackLeafDataMultiple(sf, link, n, leafdata));
+  PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_LEAF2ROOT, &rootbuf, &leafbuf, &req, NULL));
+  PetscCall(PetscSFLinkStartNeighborAlltoallv_Neighbor(sf, link, PETSCSF_LEAF2ROOT, link->unit, rootbuf, leafbuf, req));
+  PetscCall(PetscLogMPIMessages(dat->leafdegree, dat->leafcounts, link->unit, dat->rootdegree, dat->rootcounts, link->unit));
+  PetscCall(PetscSFLinkScatterLocalMultiple(sf, link, PETSCSF_LEAF2ROOT, n, rootdata, (void **)leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscSFFetchAndOpBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, void *rootdata, PetscMemType leafmtype, const void *leafdata, void *leafupdate, MPI_Op op)
 {
   PetscSFLink link = NULL;
@@ -247,6 +331,20 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Neighbor(PetscSF sf, MPI_Datatype uni
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Neighbor(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Neighbor options");
+  PetscCall(PetscOptionsBool("-sf_neighbor_persistent", "Use persistent neighborhood collectives (MPI-4) for repeated communication", "PetscSFSetFromOptions", dat->persistent, &dat->persistent, NULL));
+  PetscOptionsHeadEnd();
+#if !defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  if (dat->persistent) PetscCall(PetscInfo(sf, "MPI has no persistent neighborhood collectives, -sf_neighbor_persistent is ignored\n"));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
 {
   PetscSF_Neighbor *dat;
@@ -255,17 +353,23 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
   sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
   sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
   sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
+  sf->ops->BcastMultipleEnd     = PetscSFBcastMultipleEnd_Basic;
+  sf->ops->ReduceMultipleEnd    = PetscSFReduceMultipleEnd_Basic;
   sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
   sf->ops->View                 = PetscSFView_Basic;
 
   sf->ops->SetUp           = PetscSFSetUp_Neighbor;
   sf->ops->Reset           = PetscSFReset_Neighbor;
   sf->ops->Destroy         = PetscSFDestroy_Neighbor;
+  sf->ops->SetFromOptions  = PetscSFSetFromOptions_Neighbor;
   sf->ops->BcastBegin      = PetscSFBcastBegin_Neighbor;
   sf->ops->ReduceBegin     = PetscSFReduceBegin_Neighbor;
   sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Neighbor;
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Neighbor;
 
+  sf->ops->BcastMultipleBegin  = PetscSFBcastMultipleBegin_Neighbor;
+  sf->ops->ReduceMultipleBegin = PetscSFReduceMultipleBegin_Neighbor;
+
   PetscCall(PetscNew(&dat));
   sf->data = (void *)dat;
   PetscFunctionReturn(PETSC_SUCCESS);
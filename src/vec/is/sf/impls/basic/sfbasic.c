@@ -2,6 +2,99 @@
 #include <../src/vec/is/sf/impls/basic/sfpack.h>
 #include <petsc/private/viewerimpl.h>
 
+/* Find the remote ranks on my node and tell each of them where it finds the data I pack for it in my shared buffers, see PetscSFLinkCreate_MPI().
+   Only the ranks that have such remote ranks take part in the shared memory windows, the others keep communicating with MPI only */
+static PetscErrorCode PetscSFSetUpShm_Basic(PetscSF sf)
+{
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscShmComm   pshmcomm;
+  MPI_Comm       comm, nodecomm;
+  MPI_Group      nodegroup, shmgroup;
+  PetscMPIInt    shmsize, tag[2], n = 0, nranks, *ranks;
+  PetscInt       i, nrootshm = 0, nleafshm = 0, *disps;
+  MPI_Request   *reqs;
+
+  PetscFunctionBegin;
+  #if defined(PETSC_HAVE_NVSHMEM)
+  if (sf->use_nvshmem) PetscFunctionReturn(PETSC_SUCCESS);
+  #endif
+  /* Getting a tag is collective on the SF, so get them before the ranks without remote ranks on their node drop out */
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[0]));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[1]));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscShmCommGet(comm, &pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &nodecomm));
+  PetscCallMPI(MPI_Comm_size(nodecomm, &shmsize));
+  if (shmsize == 1) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMalloc4(bas->niranks, &bas->ishmranks, bas->niranks, &bas->ishmdisps, sf->nranks, &bas->shmranks, sf->nranks, &bas->shmdisps));
+  for (i = 0; i < bas->niranks; i++) {
+    bas->ishmranks[i] = MPI_PROC_NULL;
+    if (i >= bas->ndiranks) PetscCall(PetscShmCommGlobalToLocal(pshmcomm, bas->iranks[i], &bas->ishmranks[i]));
+    if (bas->ishmranks[i] != MPI_PROC_NULL) nrootshm++;
+  }
+  for (i = 0; i < sf->nranks; i++) {
+    bas->shmranks[i] = MPI_PROC_NULL;
+    if (i >= sf->ndranks) PetscCall(PetscShmCommGlobalToLocal(pshmcomm, sf->ranks[i], &bas->shmranks[i]));
+    if (bas->shmranks[i] != MPI_PROC_NULL) nleafshm++;
+  }
+  /* The graph is symmetric in that a rank is one of my root ranks if and only if I am one of its leaf ranks, so the ranks of my node I
+     communicate with all get into my shmcomm */
+  PetscCallMPI(MPI_Comm_split(nodecomm, (nrootshm || nleafshm) ? 0 : MPI_UNDEFINED, 0, &bas->shmcomm));
+  if (bas->shmcomm == MPI_COMM_NULL) {
+    PetscCall(PetscFree4(bas->ishmranks, bas->ishmdisps, bas->shmranks, bas->shmdisps));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  /* Translate the ranks in nodecomm to ranks in shmcomm */
+  PetscCallMPI(MPI_Comm_group(nodecomm, &nodegroup));
+  PetscCallMPI(MPI_Comm_group(bas->shmcomm, &shmgroup));
+  PetscCall(PetscMPIIntCast(PetscMax(bas->niranks, sf->nranks), &nranks));
+  PetscCall(PetscMalloc1(nranks, &ranks));
+  PetscCall(PetscMPIIntCast(bas->niranks, &nranks));
+  PetscCall(PetscArraycpy(ranks, bas->ishmranks, nranks));
+  PetscCallMPI(MPI_Group_translate_ranks(nodegroup, nranks, ranks, shmgroup, bas->ishmranks));
+  PetscCall(PetscMPIIntCast(sf->nranks, &nranks));
+  PetscCall(PetscArraycpy(ranks, bas->shmranks, nranks));
+  PetscCallMPI(MPI_Group_translate_ranks(nodegroup, nranks, ranks, shmgroup, bas->shmranks));
+  PetscCall(PetscFree(ranks));
+  PetscCallMPI(MPI_Group_free(&nodegroup));
+  PetscCallMPI(MPI_Group_free(&shmgroup));
+
+  /* My remote roots for an incoming rank are packed at its offset in my root buffer, my remote leaves for a root rank at its offset in my leaf
+     buffer, which follows the root buffer */
+  PetscCall(PetscMalloc2(nrootshm + nleafshm, &disps, 2 * (nrootshm + nleafshm), &reqs));
+  for (i = bas->ndiranks; i < bas->niranks; i++) {
+    if (bas->ishmranks[i] == MPI_PROC_NULL) continue;
+    disps[n] = bas->ioffset[i] - bas->ioffset[bas->ndiranks];
+    PetscCallMPI(MPIU_Isend(&disps[n], 1, MPIU_INT, bas->iranks[i], tag[0], comm, &reqs[2 * n]));
+    PetscCallMPI(MPIU_Irecv(&bas->ishmdisps[i], 1, MPIU_INT, bas->iranks[i], tag[1], comm, &reqs[2 * n + 1]));
+    n++;
+  }
+  for (i = sf->ndranks; i < sf->nranks; i++) {
+    if (bas->shmranks[i] == MPI_PROC_NULL) continue;
+    disps[n] = bas->rootbuflen[PETSCSF_REMOTE] + sf->roffset[i] - sf->roffset[sf->ndranks];
+    PetscCallMPI(MPIU_Isend(&disps[n], 1, MPIU_INT, sf->ranks[i], tag[1], comm, &reqs[2 * n]));
+    PetscCallMPI(MPIU_Irecv(&bas->shmdisps[i], 1, MPIU_INT, sf->ranks[i], tag[0], comm, &reqs[2 * n + 1]));
+    n++;
+  }
+  PetscCallMPI(MPI_Waitall(2 * n, reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscFree2(disps, reqs));
+
+  /* Ranks on my node are not reached with MPI requests anymore */
+  bas->nrootreqs -= nrootshm;
+  sf->nleafreqs -= nleafshm;
+  bas->shm = PETSC_TRUE;
+  PetscCall(PetscInfo(sf, "Communicate with %" PetscInt_FMT " root ranks and %" PetscInt_FMT " leaf ranks through shared memory\n", nleafshm, nrootshm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  PetscCall(PetscInfo(sf, "MPI has no process shared memory, -sf_basic_shared_memory is ignored\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+#endif
+}
+
 /*===================================================================================*/
 /*              SF public interface implementations                                  */
 /*===================================================================================*/
@@ -81,6 +174,7 @@ PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   /* Setup fields related to packing, such as rootbuflen[] */
   PetscCall(PetscSFSetUpPackFields(sf));
   PetscCall(PetscFree2(rootreqs, leafreqs));
+  if (bas->use_shm) PetscCall(PetscSFSetUpShm_Basic(sf));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -108,6 +202,10 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
   }
   bas->avail = NULL;
   PetscCall(PetscSFResetPackFields(sf));
+  PetscCall(PetscFree4(bas->ishmranks, bas->ishmdisps, bas->shmranks, bas->shmdisps));
+  if (bas->shm) PetscCallMPI(MPI_Comm_free(&bas->shmcomm));
+  bas->shm       = PETSC_FALSE;
+  bas->nshmlinks = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -264,6 +362,10 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit,
   PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
   /* This implementation could be changed to unpack as receives arrive, at the cost of non-determinism */
   PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_LEAF2ROOT));
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  /* Fetch-and-op works in place in rootbuf, which the leaves on my node then read directly, so it needs their data there */
+  if (link->shmbufs && PetscMemTypeHost(link->rootmtype)) PetscCall(PetscSFLinkGatherShm_MPI(sf, link, PETSCSF_LEAF2ROOT));
+#endif
   /* Do fetch-and-op, the (remote) update results are in rootbuf */
   PetscCall(PetscSFLinkFetchAndOpRemote(sf, link, rootdata, op));
   /* Bcast rootbuf to leafupdate */
@@ -275,6 +377,69 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Bcast of n arrays with a link whose unit is made of one unit of each array, so that the data of all arrays for a rank goes in one message */
+static PetscErrorCode PetscSFBcastMultipleBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **rootdata, void **leafdata, MPI_Op op)
+{
+  PetscSFLink  link = NULL;
+  MPI_Datatype munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkCreate(sf, munit, PETSC_MEMTYPE_HOST, rootdata[0], PETSC_MEMTYPE_HOST, leafdata[0], op, PETSCSF_BCAST_MULTIPLE, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkSetUpUnitLink(sf, link, unit));
+  PetscCall(PetscSFLinkPackRootDataMultiple(sf, link, n, rootdata));
+  PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  PetscCall(PetscSFLinkScatterLocalMultiple(sf, link, PETSCSF_ROOT2LEAF, n, (void **)rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFBcastMultipleEnd_Basic(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **rootdata, void **leafdata, MPI_Op op)
+{
+  PetscSFLink  link = NULL;
+  MPI_Datatype munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkGetInUse(sf, munit, rootdata[0], leafdata[0], PETSC_OWN_POINTER, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  PetscCall(PetscSFLinkUnpackLeafDataMultiple(sf, link, n, leafdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceMultipleBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **leafdata, void **rootdata, MPI_Op op)
+{
+  PetscSFLink  link = NULL;
+  MPI_Datatype munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkCreate(sf, munit, PETSC_MEMTYPE_HOST, rootdata[0], PETSC_MEMTYPE_HOST, leafdata[0], op, PETSCSF_REDUCE_MULTIPLE, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkSetUpUnitLink(sf, link, unit));
+  PetscCall(PetscSFLinkPackLeafDataMultiple(sf, link, n, leafdata));
+  PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  PetscCall(PetscSFLinkScatterLocalMultiple(sf, link, PETSCSF_LEAF2ROOT, n, rootdata, (void **)leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFReduceMultipleEnd_Basic(PetscSF sf, MPI_Datatype unit, PetscInt n, const void **leafdata, void **rootdata, MPI_Op op)
+{
+  PetscSFLink  link = NULL;
+  MPI_Datatype munit;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreateMultipleUnit_Private(unit, n, &munit));
+  PetscCall(PetscSFLinkGetInUse(sf, munit, rootdata[0], leafdata[0], PETSC_OWN_POINTER, &link));
+  PetscCallMPI(MPI_Type_free(&munit));
+  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  PetscCall(PetscSFLinkUnpackRootDataMultiple(sf, link, n, rootdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF sf, PetscInt *niranks, const PetscMPIInt **iranks, const PetscInt **ioffset, const PetscInt **irootloc)
 {
   PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
@@ -433,6 +598,17 @@ PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF sf, PetscI
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Basic options");
+  PetscCall(PetscOptionsBool("-sf_basic_shared_memory", "Communicate with ranks on the same node through shared memory instead of MPI", "PetscSFSetFromOptions", bas->use_shm, &bas->use_shm, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
 {
   PetscSF_Basic *dat;
@@ -442,12 +618,17 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->Reset                = PetscSFReset_Basic;
   sf->ops->Destroy              = PetscSFDestroy_Basic;
   sf->ops->View                 = PetscSFView_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
   sf->ops->BcastBegin           = PetscSFBcastBegin_Basic;
   sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
   sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
   sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
   sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->BcastMultipleBegin   = PetscSFBcastMultipleBegin_Basic;
+  sf->ops->BcastMultipleEnd     = PetscSFBcastMultipleEnd_Basic;
+  sf->ops->ReduceMultipleBegin  = PetscSFReduceMultipleBegin_Basic;
+  sf->ops->ReduceMultipleEnd    = PetscSFReduceMultipleEnd_Basic;
   sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
   sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
 
@@ -20,7 +20,15 @@ typedef struct _n_PetscSFLink *PetscSFLink;
   PetscBool      rootdups[2];      /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */ \
   PetscInt       nrootreqs;        /* Number of MPI requests */ \
   PetscSFLink    avail;            /* One or more entries per MPI Datatype, lazily constructed */ \
-  PetscSFLink    inuse             /* Buffers being used for transactions that have not yet completed */
+  PetscSFLink    inuse;            /* Buffers being used for transactions that have not yet completed */ \
+  PetscBool      use_shm;          /* Try to communicate with remote ranks on my node through shared memory instead of MPI */ \
+  PetscBool      shm;              /* Do ranks on my node communicate through shared memory in this SF? */ \
+  MPI_Comm       shmcomm;          /* Communicator of the ranks on my node that communicate with others of my node, if shm */ \
+  PetscMPIInt   *ishmranks;        /* [niranks] Rank in shmcomm of each remote incoming rank on my node, MPI_PROC_NULL for the others */ \
+  PetscInt      *ishmdisps;        /* [niranks] Offset (in units) in its shared buffers of the leaves that rank packed for my roots */ \
+  PetscMPIInt   *shmranks;         /* [nranks] Rank in shmcomm of each remote rank on my node owning roots of my leaves, MPI_PROC_NULL for the others */ \
+  PetscInt      *shmdisps;         /* [nranks] Offset (in units) in its shared buffers of the roots that rank packed for my leaves */ \
+  PetscInt       nshmlinks         /* Number of links created with buffers in shared memory */
 
 typedef struct {
   SFBASICHEADER;
@@ -70,6 +78,8 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFDestroy_Basic(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFBcastEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFReduceEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFBcastMultipleEnd_Basic(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFReduceMultipleEnd_Basic(PetscSF, MPI_Datatype, PetscInt, const void **, void **, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF, PetscInt, const PetscInt *, PetscSF *);
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF, PetscInt *, const PetscMPIInt **, const PetscInt **, const PetscInt **);
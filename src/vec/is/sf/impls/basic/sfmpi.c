@@ -39,9 +39,111 @@ static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link,
     PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, direction));
     PetscCallMPI(MPI_Startall_isend(buflen, link->unit, nreqs, reqs));
   }
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  if (link->shmbufs) { /* Tell the ranks on my node that my data is packed */
+    PetscCallMPI(MPI_Win_sync(link->shmwin));
+    link->shmflags[link->shmrank][0]++;
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+/* Allocate the remote root and leaf buffers of a new link in a window shared by the ranks of the shmcomm of the SF, so that each of them can read
+   the data I packed for it directly from my buffers. The buffers of a rank follow its two counters, see PetscSFLinkWaitShm_MPI(). Collective on
+   the shmcomm, whose ranks create their links in the same order */
+static PetscErrorCode PetscSFLinkSetUpShm_MPI(PetscSF sf, PetscSFLink link)
+{
+  PetscSF_Basic *bas  = (PetscSF_Basic *)sf->data;
+  const size_t   hdr  = PetscMax((size_t)PETSC_MEMALIGN, 2 * sizeof(PetscInt64)); /* Keep the buffers aligned after the counters */
+  MPI_Aint       size = (bas->rootbuflen[PETSCSF_REMOTE] + sf->leafbuflen[PETSCSF_REMOTE]) * link->unitbytes + hdr + PETSC_MEMALIGN, segsize;
+  PetscMPIInt    shmsize, dispunit;
+  MPI_Info       info;
+  char          *base;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(bas->shmcomm, &shmsize));
+  PetscCallMPI(MPI_Comm_rank(bas->shmcomm, &link->shmrank));
+  PetscCallMPI(MPI_Info_create(&info));
+  PetscCallMPI(MPI_Info_set(info, "alloc_shared_noncontig", "true")); /* Let MPI place the buffers of each rank in memory close to it */
+  PetscCallMPI(MPI_Win_allocate_shared(size, 1, info, bas->shmcomm, &base, &link->shmwin));
+  PetscCallMPI(MPI_Info_free(&info));
+  PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, link->shmwin));
+  PetscCall(PetscMalloc2(shmsize, &link->shmbufs, shmsize, &link->shmflags));
+  for (PetscMPIInt r = 0; r < shmsize; r++) {
+    /* The segments are mapped at page boundaries in all processes, so their alignment, hence the padding, is the same everywhere */
+    PetscCallMPI(MPI_Win_shared_query(link->shmwin, r, &segsize, &dispunit, &base));
+    base += (PETSC_MEMALIGN - (PETSC_UINTPTR_T)base % PETSC_MEMALIGN) % PETSC_MEMALIGN;
+    link->shmflags[r] = (PetscInt64 *)base;
+    link->shmbufs[r]  = base + hdr;
+  }
+  link->shmflags[link->shmrank][0] = link->shmflags[link->shmrank][1] = 0;
+  link->shmrootbuf                 = link->shmbufs[link->shmrank];
+  link->shmleafbuf                 = link->shmrootbuf + bas->rootbuflen[PETSCSF_REMOTE] * link->unitbytes;
+  link->shmid                      = bas->nshmlinks++;
+  /* Make the zeroed counters visible before anyone polls them; this is the only synchronization of all ranks of the shmcomm */
+  PetscCallMPI(MPI_Win_sync(link->shmwin));
+  PetscCallMPI(MPI_Barrier(bas->shmcomm));
+  PetscCallMPI(MPI_Win_sync(link->shmwin));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Each rank counts in its shared segment the communications it started on the link (counter 0) and the operations it finished with it (counter 1),
+   see PetscSFLinkReclaim(). Wait until the ranks on my node owning roots of my leaves (if rootranks) and those with leaves on my roots (if leafranks)
+   have reached my count k, i.e., until they have packed the data I read from their buffers (k = 0), or have read the data I packed for them in the
+   previous operation (k = 1). Only the ranks that communicate synchronize, with no collective call on the node */
+static PetscErrorCode PetscSFLinkWaitShm_MPI(PetscSF sf, PetscSFLink link, PetscInt k, PetscBool rootranks, PetscBool leafranks)
+{
+  PetscSF_Basic   *bas   = (PetscSF_Basic *)sf->data;
+  const PetscInt64 count = link->shmflags[link->shmrank][k];
+  PetscInt         i;
+
+  PetscFunctionBegin;
+  if (rootranks) {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (bas->shmranks[i] == MPI_PROC_NULL) continue;
+      while (((volatile PetscInt64 *)link->shmflags[bas->shmranks[i]])[k] < count) PetscCallMPI(MPI_Win_sync(link->shmwin));
+    }
+  }
+  if (leafranks) {
+    for (i = bas->ndiranks; i < bas->niranks; i++) {
+      if (bas->ishmranks[i] == MPI_PROC_NULL) continue;
+      while (((volatile PetscInt64 *)link->shmflags[bas->ishmranks[i]])[k] < count) PetscCallMPI(MPI_Win_sync(link->shmwin));
+    }
+  }
+  PetscCallMPI(MPI_Win_sync(link->shmwin));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Copy the data the ranks on my node packed for me from their shared buffers to my own remote buffer, as if it was received with MPI. The host
+   data is usually unpacked directly from their buffers, see PetscSFLinkUnpackRootData_Private(), so this is only needed when the data then goes to
+   the device, or when it is updated in place by PetscSFFetchAndOpEnd_Basic() */
+PetscErrorCode PetscSFLinkGatherShm_MPI(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
+{
+  PetscSF_Basic *bas       = (PetscSF_Basic *)sf->data;
+  size_t         unitbytes = link->unitbytes;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    char *leafbuf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (bas->shmranks[i] == MPI_PROC_NULL) continue;
+      PetscCall(PetscMemcpy(leafbuf + (sf->roffset[i] - sf->roffset[sf->ndranks]) * unitbytes, link->shmbufs[bas->shmranks[i]] + bas->shmdisps[i] * unitbytes, (sf->roffset[i + 1] - sf->roffset[i]) * unitbytes));
+    }
+  } else {
+    char *rootbuf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+
+    for (i = bas->ndiranks; i < bas->niranks; i++) {
+      if (bas->ishmranks[i] == MPI_PROC_NULL) continue;
+      PetscCall(PetscMemcpy(rootbuf + (bas->ioffset[i] - bas->ioffset[bas->ndiranks]) * unitbytes, link->shmbufs[bas->ishmranks[i]] + bas->ishmdisps[i] * unitbytes, (bas->ioffset[i + 1] - bas->ioffset[i]) * unitbytes));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 static PetscErrorCode PetscSFLinkWaitRequests_MPI(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
 {
   PetscSF_Basic     *bas           = (PetscSF_Basic *)sf->data;
@@ -51,6 +153,12 @@ static PetscErrorCode PetscSFLinkWaitRequests_MPI(PetscSF sf, PetscSFLink link,
   PetscFunctionBegin;
   PetscCallMPI(MPI_Waitall(bas->nrootreqs, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi], MPI_STATUSES_IGNORE));
   PetscCallMPI(MPI_Waitall(sf->nleafreqs, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi], MPI_STATUSES_IGNORE));
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  if (link->shmbufs) { /* Wait for the ranks on my node sending to me to have packed their data. Only device data needs it in my own buffer */
+    PetscCall(PetscSFLinkWaitShm_MPI(sf, link, 0, (PetscBool)(direction == PETSCSF_ROOT2LEAF), (PetscBool)(direction == PETSCSF_LEAF2ROOT)));
+    if (PetscMemTypeDevice(direction == PETSCSF_ROOT2LEAF ? link->leafmtype : link->rootmtype)) PetscCall(PetscSFLinkGatherShm_MPI(sf, link, direction));
+  }
+#endif
   if (direction == PETSCSF_ROOT2LEAF) {
     PetscCall(PetscSFLinkCopyLeafBufferInCaseNotUseGpuAwareMPI(sf, link, PETSC_FALSE /* host2device after recving */));
   } else {
@@ -163,13 +271,15 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
     } else if (sfop == PETSCSF_REDUCE) {
       leafdirect[i] = sf->leafcontig[i];                                                    /* Pack leaves */
       rootdirect[i] = (bas->rootcontig[i] && op == MPI_REPLACE) ? PETSC_TRUE : PETSC_FALSE; /* Unpack roots */
-    } else {                                                                                /* PETSCSF_FETCH */
+    } else {                                                                                /* PETSCSF_FETCH, or PETSCSF_BCAST/REDUCE_MULTIPLE that pack several arrays together */
       rootdirect[i] = PETSC_FALSE;                                                          /* FETCH always need a separate rootbuf */
       leafdirect[i] = PETSC_FALSE;                                                          /* We also force allocating a separate leafbuf so that leafdata and leafupdate can share mpi requests */
     }
   }
 
-  if (sf->use_gpu_aware_mpi) {
+  /* With shared memory communication on my node, remote data always goes through the buffers on host in the shared memory window of the link */
+  if (bas->shm) rootdirect[PETSCSF_REMOTE] = leafdirect[PETSCSF_REMOTE] = PETSC_FALSE;
+  if (sf->use_gpu_aware_mpi && !bas->shm) {
     rootmtype_mpi = rootmtype;
     leafmtype_mpi = leafmtype;
   } else {
@@ -179,7 +289,7 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
   rootdirect_mpi = rootdirect[PETSCSF_REMOTE] && (rootmtype_mpi == rootmtype) ? 1 : 0;
   leafdirect_mpi = leafdirect[PETSCSF_REMOTE] && (leafmtype_mpi == leafmtype) ? 1 : 0;
 
-  direction = (sfop == PETSCSF_BCAST) ? PETSCSF_ROOT2LEAF : PETSCSF_LEAF2ROOT;
+  direction = (sfop == PETSCSF_BCAST || sfop == PETSCSF_BCAST_MULTIPLE) ? PETSCSF_ROOT2LEAF : PETSCSF_LEAF2ROOT;
   nrootreqs = bas->nrootreqs;
   nleafreqs = sf->nleafreqs;
 
@@ -230,6 +340,9 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
     }
   link->StartCommunication  = PetscSFLinkStartRequests_MPI;
   link->FinishCommunication = PetscSFLinkWaitRequests_MPI;
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  if (bas->shm) PetscCall(PetscSFLinkSetUpShm_MPI(sf, link));
+#endif
 #if defined(PETSC_HAVE_MPIX_STREAM)
   if (sf->use_stream_aware_mpi && (PetscMemTypeDevice(rootmtype_mpi) || PetscMemTypeDevice(leafmtype_mpi))) {
     link->StartCommunication  = PetscSFLinkStartEnqueue_MPIX_Stream;
@@ -260,6 +373,8 @@ found:
     if (bas->rootbuflen[i]) {
       if (rootdirect[i]) { /* Aha, we disguise rootdata as rootbuf */
         link->rootbuf[i][rootmtype] = (char *)rootdata + bas->rootstart[i] * link->unitbytes;
+      } else if (i == PETSCSF_REMOTE && PetscMemTypeHost(rootmtype) && link->shmbufs) {
+        link->rootbuf[i][rootmtype] = link->shmrootbuf;
       } else { /* Have to have a separate rootbuf */
         if (!link->rootbuf_alloc[i][rootmtype]) PetscCall(PetscSFMalloc(sf, rootmtype, bas->rootbuflen[i] * link->unitbytes, (void **)&link->rootbuf_alloc[i][rootmtype]));
         link->rootbuf[i][rootmtype] = link->rootbuf_alloc[i][rootmtype];
@@ -269,6 +384,8 @@ found:
     if (sf->leafbuflen[i]) {
       if (leafdirect[i]) {
         link->leafbuf[i][leafmtype] = (char *)leafdata + sf->leafstart[i] * link->unitbytes;
+      } else if (i == PETSCSF_REMOTE && PetscMemTypeHost(leafmtype) && link->shmbufs) {
+        link->leafbuf[i][leafmtype] = link->shmleafbuf;
       } else {
         if (!link->leafbuf_alloc[i][leafmtype]) PetscCall(PetscSFMalloc(sf, leafmtype, sf->leafbuflen[i] * link->unitbytes, (void **)&link->leafbuf_alloc[i][leafmtype]));
         link->leafbuf[i][leafmtype] = link->leafbuf_alloc[i][leafmtype];
@@ -278,11 +395,15 @@ found:
 
 #if defined(PETSC_HAVE_DEVICE)
   /* Allocate buffers on host for buffering data on device in cast not use_gpu_aware_mpi */
-  if (PetscMemTypeDevice(rootmtype) && PetscMemTypeHost(rootmtype_mpi)) {
+  if (PetscMemTypeDevice(rootmtype) && PetscMemTypeHost(rootmtype_mpi) && link->shmbufs) {
+    link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = link->shmrootbuf;
+  } else if (PetscMemTypeDevice(rootmtype) && PetscMemTypeHost(rootmtype_mpi)) {
     if (!link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]) PetscCall(PetscMalloc(bas->rootbuflen[PETSCSF_REMOTE] * link->unitbytes, &link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
     link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
   }
-  if (PetscMemTypeDevice(leafmtype) && PetscMemTypeHost(leafmtype_mpi)) {
+  if (PetscMemTypeDevice(leafmtype) && PetscMemTypeHost(leafmtype_mpi) && link->shmbufs) {
+    link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = link->shmleafbuf;
+  } else if (PetscMemTypeDevice(leafmtype) && PetscMemTypeHost(leafmtype_mpi)) {
     if (!link->leafbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]) PetscCall(PetscMalloc(sf->leafbuflen[PETSCSF_REMOTE] * link->unitbytes, &link->leafbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
     link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = link->leafbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
   }
@@ -307,6 +428,10 @@ found:
   link->rootmtype_mpi  = rootmtype_mpi;
   link->leafmtype_mpi  = leafmtype_mpi;
 
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  /* Do not overwrite my shared buffers before the ranks on my node are done with the previous operation on the link */
+  if (link->shmbufs) PetscCall(PetscSFLinkWaitShm_MPI(sf, link, 1, PETSC_TRUE, PETSC_TRUE));
+#endif
   link->next = bas->inuse;
   bas->inuse = link;
   *mylink    = link;
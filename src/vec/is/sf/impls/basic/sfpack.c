@@ -192,23 +192,26 @@
   { \
     const Type    *u = (const Type *)src; \
     Type          *v = (Type *)dst; \
-    PetscInt       i, j, k, s, t, X, Y, bs = link->bs; \
+    const Type    *u2; \
+    PetscInt       i, j, k, r, s, t, X, Y, bs = link->bs; \
     const PetscInt M   = (EQ) ? 1 : bs / BS; \
     const PetscInt MBS = M * BS; \
     PetscFunctionBegin; \
     if (!srcIdx) { /* src is contiguous */ \
       u += srcStart * MBS; \
       PetscCall(CPPJoin4(UnpackAnd##Opname, Type, BS, EQ)(link, count, dstStart, dstOpt, dstIdx, dst, u)); \
-    } else if (srcOpt && !dstIdx) { /* src is 3D, dst is contiguous */ \
-      u += srcOpt->start[0] * MBS; \
+    } else if (srcOpt && !dstIdx) { /* src is 3D or made of runs, dst is contiguous */ \
       v += dstStart * MBS; \
-      X = srcOpt->X[0]; \
-      Y = srcOpt->Y[0]; \
-      for (k = 0; k < srcOpt->dz[0]; k++) \
-        for (j = 0; j < srcOpt->dy[0]; j++) { \
-          for (i = 0; i < srcOpt->dx[0] * MBS; i++) OpApply(Op, v[i], u[(X * Y * k + X * j) * MBS + i]); \
-          v += srcOpt->dx[0] * MBS; \
-        } \
+      for (r = 0; r < srcOpt->n; r++) { \
+        u2 = u + srcOpt->start[r] * MBS; \
+        X  = srcOpt->X[r]; \
+        Y  = srcOpt->Y[r]; \
+        for (k = 0; k < srcOpt->dz[r]; k++) \
+          for (j = 0; j < srcOpt->dy[r]; j++) { \
+            for (i = 0; i < srcOpt->dx[r] * MBS; i++) OpApply(Op, v[i], u2[(X * Y * k + X * j) * MBS + i]); \
+            v += srcOpt->dx[r] * MBS; \
+          } \
+      } \
     } else { /* all other cases */ \
       for (i = 0; i < count; i++) { \
         s = (!srcIdx ? srcStart + i : srcIdx[i]) * MBS; \
@@ -358,9 +361,10 @@ DEF_IntegerType(PetscInt, 1, 1)   /* unit = 1 MPIU_INT  */
   DEF_IntegerType(PetscInt, 2, 0) /* unit = 2*n MPIU_INTs, n>1 */
   DEF_IntegerType(PetscInt, 4, 0) /* unit = 4*n MPIU_INTs, n>1 */
   DEF_IntegerType(PetscInt, 8, 0) /* unit = 8*n MPIU_INTs, n>1. Routines with bigger BS are tried first. */
+  DEF_IntegerType(PetscInt, 3, 1) /* unit = 3 MPIU_INTs, such as coordinates or vector fields in 3D */
 
 #if defined(PETSC_USE_64BIT_INDICES) /* Do not need (though it is OK) to generate redundant functions if PetscInt is int */
-  DEF_IntegerType(int, 1, 1) DEF_IntegerType(int, 2, 1) DEF_IntegerType(int, 4, 1) DEF_IntegerType(int, 8, 1) DEF_IntegerType(int, 1, 0) DEF_IntegerType(int, 2, 0) DEF_IntegerType(int, 4, 0) DEF_IntegerType(int, 8, 0)
+  DEF_IntegerType(int, 1, 1) DEF_IntegerType(int, 2, 1) DEF_IntegerType(int, 4, 1) DEF_IntegerType(int, 8, 1) DEF_IntegerType(int, 1, 0) DEF_IntegerType(int, 2, 0) DEF_IntegerType(int, 4, 0) DEF_IntegerType(int, 8, 0) DEF_IntegerType(int, 3, 1)
 #endif
 
   /* The typedefs are used to get a typename without space that CPPJoin can handle */
@@ -370,7 +374,7 @@ DEF_IntegerType(SignedChar, 1, 1) DEF_IntegerType(SignedChar, 2, 1) DEF_IntegerT
   typedef unsigned char UnsignedChar;
 DEF_IntegerType(UnsignedChar, 1, 1) DEF_IntegerType(UnsignedChar, 2, 1) DEF_IntegerType(UnsignedChar, 4, 1) DEF_IntegerType(UnsignedChar, 8, 1) DEF_IntegerType(UnsignedChar, 1, 0) DEF_IntegerType(UnsignedChar, 2, 0) DEF_IntegerType(UnsignedChar, 4, 0) DEF_IntegerType(UnsignedChar, 8, 0)
 
-  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0)
+  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0) DEF_RealType(PetscReal, 3, 1)
 #if defined(PETSC_HAVE_COMPLEX)
     DEF_ComplexType(PetscComplex, 1, 1) DEF_ComplexType(PetscComplex, 2, 1) DEF_ComplexType(PetscComplex, 4, 1) DEF_ComplexType(PetscComplex, 8, 1) DEF_ComplexType(PetscComplex, 1, 0) DEF_ComplexType(PetscComplex, 2, 0) DEF_ComplexType(PetscComplex, 4, 0) DEF_ComplexType(PetscComplex, 8, 0)
 #endif
@@ -392,7 +396,16 @@ DEF_PairType(PairType(int, int), 1, 1) DEF_PairType(PairType(PetscInt, PetscInt)
     typedef int DumbInt; /* To have a different name than 'int' used above. The name is used to make routine names. */
 DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 4, 1) DEF_DumbType(DumbInt, 8, 1) DEF_DumbType(DumbInt, 1, 0) DEF_DumbType(DumbInt, 2, 0) DEF_DumbType(DumbInt, 4, 0) DEF_DumbType(DumbInt, 8, 0)
 
-  PetscErrorCode PetscSFLinkDestroy(PetscSF sf, PetscSFLink link)
+  static PetscErrorCode PetscSFLinkDestroyUnitLink_Private(PetscSFLink *unitlink)
+{
+  PetscFunctionBegin;
+  if (!*unitlink) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!(*unitlink)->isbuiltin) PetscCallMPI(MPI_Type_free(&(*unitlink)->unit));
+  PetscCall(PetscFree(*unitlink));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSFLinkDestroy(PetscSF sf, PetscSFLink link)
 {
   PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
   PetscInt       i, nreqs = (bas->nrootreqs + sf->nleafreqs) * 8;
@@ -412,7 +425,15 @@ DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 4,
       PetscCall(PetscFree(link->rootbuf_alloc[i][PETSC_MEMTYPE_HOST]));
       PetscCall(PetscFree(link->leafbuf_alloc[i][PETSC_MEMTYPE_HOST]));
     }
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+    if (link->shmbufs) { /* Collective on the shmcomm of the SF, whose ranks destroy links in the order of their creation, see PetscSFLinkReclaim() */
+      PetscCallMPI(MPI_Win_unlock_all(link->shmwin));
+      PetscCallMPI(MPI_Win_free(&link->shmwin));
+      PetscCall(PetscFree2(link->shmbufs, link->shmflags));
+    }
+#endif
   }
+  PetscCall(PetscSFLinkDestroyUnitLink_Private(&link->unitlink));
   PetscCall(PetscFree(link));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -455,16 +476,20 @@ PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf, PetscSFLink link,
     if (rootreqs && bas->rootbuflen[PETSCSF_REMOTE] && !link->rootreqsinited[direction][rootmtype_mpi][rootdirect_mpi]) {
       PetscCall(PetscSFGetRootInfo_Basic(sf, &nrootranks, &ndrootranks, NULL, &rootoffset, NULL));
       if (direction == PETSCSF_LEAF2ROOT) {
-        for (i = ndrootranks, j = 0; i < nrootranks; i++, j++) {
+        for (i = ndrootranks, j = 0; i < nrootranks; i++) {
+          if (bas->shm && bas->ishmranks[i] != MPI_PROC_NULL) continue; /* Ranks on my node communicate through shared memory */
           disp = (rootoffset[i] - rootoffset[ndrootranks]) * link->unitbytes;
           cnt  = rootoffset[i + 1] - rootoffset[i];
           PetscCallMPI(MPIU_Recv_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi] + disp, cnt, unit, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
+          j++;
         }
       } else { /* PETSCSF_ROOT2LEAF */
-        for (i = ndrootranks, j = 0; i < nrootranks; i++, j++) {
+        for (i = ndrootranks, j = 0; i < nrootranks; i++) {
+          if (bas->shm && bas->ishmranks[i] != MPI_PROC_NULL) continue;
           disp = (rootoffset[i] - rootoffset[ndrootranks]) * link->unitbytes;
           cnt  = rootoffset[i + 1] - rootoffset[i];
           PetscCallMPI(MPIU_Send_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi] + disp, cnt, unit, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
+          j++;
         }
       }
       link->rootreqsinited[direction][rootmtype_mpi][rootdirect_mpi] = PETSC_TRUE;
@@ -473,16 +498,20 @@ PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf, PetscSFLink link,
     if (leafreqs && sf->leafbuflen[PETSCSF_REMOTE] && !link->leafreqsinited[direction][leafmtype_mpi][leafdirect_mpi]) {
       PetscCall(PetscSFGetLeafInfo_Basic(sf, &nleafranks, &ndleafranks, NULL, &leafoffset, NULL, NULL));
       if (direction == PETSCSF_LEAF2ROOT) {
-        for (i = ndleafranks, j = 0; i < nleafranks; i++, j++) {
+        for (i = ndleafranks, j = 0; i < nleafranks; i++) {
+          if (bas->shm && bas->shmranks[i] != MPI_PROC_NULL) continue;
           disp = (leafoffset[i] - leafoffset[ndleafranks]) * link->unitbytes;
           cnt  = leafoffset[i + 1] - leafoffset[i];
           PetscCallMPI(MPIU_Send_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi] + disp, cnt, unit, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
+          j++;
         }
       } else { /* PETSCSF_ROOT2LEAF */
-        for (i = ndleafranks, j = 0; i < nleafranks; i++, j++) {
+        for (i = ndleafranks, j = 0; i < nleafranks; i++) {
+          if (bas->shm && bas->shmranks[i] != MPI_PROC_NULL) continue;
           disp = (leafoffset[i] - leafoffset[ndleafranks]) * link->unitbytes;
           cnt  = leafoffset[i + 1] - leafoffset[i];
           PetscCallMPI(MPIU_Recv_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi] + disp, cnt, unit, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
+          j++;
         }
       }
       link->leafreqsinited[direction][leafmtype_mpi][leafdirect_mpi] = PETSC_TRUE;
@@ -525,14 +554,24 @@ PetscErrorCode PetscSFLinkGetInUse(PetscSF sf, MPI_Datatype unit, const void *ro
 PetscErrorCode PetscSFLinkReclaim(PetscSF sf, PetscSFLink *mylink)
 {
   PetscSF_Basic *bas  = (PetscSF_Basic *)sf->data;
-  PetscSFLink    link = *mylink;
+  PetscSFLink    link = *mylink, *p = &bas->avail;
 
   PetscFunctionBegin;
   link->rootdata = NULL;
   link->leafdata = NULL;
-  link->next     = bas->avail;
-  bas->avail     = link;
-  *mylink        = NULL;
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  if (link->shmbufs) { /* Tell the ranks on my node that I am done with their buffers, see PetscSFLinkCreate_MPI() */
+    PetscCallMPI(MPI_Win_sync(link->shmwin));
+    link->shmflags[link->shmrank][1]++;
+  }
+#endif
+  /* Links with shared memory windows are kept in the order of their creation, so that all ranks of a node pick the same one in PetscSFLinkCreate_MPI() */
+  if (link->shmbufs) {
+    while (*p && (*p)->shmid < link->shmid) p = &(*p)->next;
+  }
+  link->next = *p;
+  *p         = link;
+  *mylink    = NULL;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -610,6 +649,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscReal % 8 == 0) PackInit_RealType_PetscReal_8_0(link);
     else if (nPetscReal == 4) PackInit_RealType_PetscReal_4_1(link);
     else if (nPetscReal % 4 == 0) PackInit_RealType_PetscReal_4_0(link);
+    else if (nPetscReal == 3) PackInit_RealType_PetscReal_3_1(link);
     else if (nPetscReal == 2) PackInit_RealType_PetscReal_2_1(link);
     else if (nPetscReal % 2 == 0) PackInit_RealType_PetscReal_2_0(link);
     else if (nPetscReal == 1) PackInit_RealType_PetscReal_1_1(link);
@@ -626,6 +666,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscInt % 8 == 0) PackInit_IntegerType_PetscInt_8_0(link);
     else if (nPetscInt == 4) PackInit_IntegerType_PetscInt_4_1(link);
     else if (nPetscInt % 4 == 0) PackInit_IntegerType_PetscInt_4_0(link);
+    else if (nPetscInt == 3) PackInit_IntegerType_PetscInt_3_1(link);
     else if (nPetscInt == 2) PackInit_IntegerType_PetscInt_2_1(link);
     else if (nPetscInt % 2 == 0) PackInit_IntegerType_PetscInt_2_0(link);
     else if (nPetscInt == 1) PackInit_IntegerType_PetscInt_1_1(link);
@@ -643,6 +684,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nInt % 8 == 0) PackInit_IntegerType_int_8_0(link);
     else if (nInt == 4) PackInit_IntegerType_int_4_1(link);
     else if (nInt % 4 == 0) PackInit_IntegerType_int_4_0(link);
+    else if (nInt == 3) PackInit_IntegerType_int_3_1(link);
     else if (nInt == 2) PackInit_IntegerType_int_2_1(link);
     else if (nInt % 2 == 0) PackInit_IntegerType_int_2_0(link);
     else if (nInt == 1) PackInit_IntegerType_int_1_1(link);
@@ -1045,6 +1087,30 @@ PetscErrorCode PetscSFLinkPackLeafData(PetscSF sf, PetscSFLink link, PetscSFScop
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Unpack buf packed as in PetscSFLinkPackMultiple_Private() to the n arrays. With shared memory communication, the segment of a rank on my node
+   with shmranks[i] != MPI_PROC_NULL is read directly from its shared buffers at shmdisps[i] instead of from buf; shmranks[] is NULL otherwise */
+static PetscErrorCode PetscSFLinkUnpackMultiple_Private(PetscSF sf, PetscSFLink unitlink, PetscInt nranks, const PetscInt *offset, PetscInt start, const PetscInt *idx, PetscBool dups, PetscInt n, void **data, const char *buf, const PetscMPIInt *shmranks, const PetscInt *shmdisps, char **shmbufs, MPI_Op op)
+{
+  const size_t unitbytes = unitlink->unitbytes;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *);
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetUnpackAndOp(unitlink, PETSC_MEMTYPE_HOST, op, dups, &UnpackAndOp));
+  for (PetscInt i = 0; i < nranks; i++) {
+    PetscInt        disp = offset[i] - offset[0], cnt = offset[i + 1] - offset[i];
+    const PetscInt *ridx = idx ? idx + offset[i] : NULL;
+    const char     *seg  = (shmranks && shmranks[i] != MPI_PROC_NULL) ? shmbufs[shmranks[i]] + n * shmdisps[i] * unitbytes : buf + n * disp * unitbytes;
+
+    for (PetscInt j = 0; j < n; j++) {
+      const char *rbuf = seg + j * cnt * unitbytes;
+
+      if (UnpackAndOp) PetscCall((*UnpackAndOp)(unitlink, cnt, start + disp, NULL, ridx, data[j], rbuf));
+      else PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, unitlink, cnt, start + disp, ridx, data[j], rbuf, op));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscSFLinkUnpackRootData_Private(PetscSF sf, PetscSFLink link, PetscSFScope scope, void *rootdata, MPI_Op op)
 {
   const PetscInt *rootindices = NULL;
@@ -1055,7 +1121,11 @@ static PetscErrorCode PetscSFLinkUnpackRootData_Private(PetscSF sf, PetscSFLink
   PetscSFPackOpt opt                                                                                                     = NULL;
 
   PetscFunctionBegin;
-  if (!link->rootdirect[scope]) { /* If rootdata works directly as rootbuf, skip unpacking */
+  if (scope == PETSCSF_REMOTE && link->shmbufs && PetscMemTypeHost(rootmtype)) { /* Read the data of the ranks on my node from their buffers */
+    const PetscInt *idx = bas->rootcontig[scope] ? NULL : bas->irootloc;
+
+    PetscCall(PetscSFLinkUnpackMultiple_Private(sf, link, bas->niranks - bas->ndiranks, bas->ioffset + bas->ndiranks, bas->rootstart[scope], idx, bas->rootdups[scope], 1, &rootdata, link->rootbuf[scope][rootmtype], bas->ishmranks + bas->ndiranks, bas->ishmdisps + bas->ndiranks, link->shmbufs, op));
+  } else if (!link->rootdirect[scope]) { /* If rootdata works directly as rootbuf, skip unpacking */
     PetscCall(PetscSFLinkGetUnpackAndOp(link, rootmtype, op, bas->rootdups[scope], &UnpackAndOp));
     if (UnpackAndOp) {
       PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, rootmtype, scope, &count, &start, &opt, &rootindices));
@@ -1078,7 +1148,12 @@ static PetscErrorCode PetscSFLinkUnpackLeafData_Private(PetscSF sf, PetscSFLink
   PetscSFPackOpt opt                                                                                                     = NULL;
 
   PetscFunctionBegin;
-  if (!link->leafdirect[scope]) { /* If leafdata works directly as rootbuf, skip unpacking */
+  if (scope == PETSCSF_REMOTE && link->shmbufs && PetscMemTypeHost(leafmtype)) {
+    PetscSF_Basic  *bas = (PetscSF_Basic *)sf->data;
+    const PetscInt *idx = sf->leafcontig[scope] ? NULL : sf->rmine;
+
+    PetscCall(PetscSFLinkUnpackMultiple_Private(sf, link, sf->nranks - sf->ndranks, sf->roffset + sf->ndranks, sf->leafstart[scope], idx, sf->leafdups[scope], 1, &leafdata, link->leafbuf[scope][leafmtype], bas->shmranks + sf->ndranks, bas->shmdisps + sf->ndranks, link->shmbufs, op));
+  } else if (!link->leafdirect[scope]) { /* If leafdata works directly as rootbuf, skip unpacking */
     PetscCall(PetscSFLinkGetUnpackAndOp(link, leafmtype, op, sf->leafdups[scope], &UnpackAndOp));
     if (UnpackAndOp) {
       PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, leafmtype, scope, &count, &start, &opt, &leafindices));
@@ -1229,8 +1304,186 @@ PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF sf, PetscSFLink link, void *ro
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*=============================================================================
+              Pack/Unpack/Scatter routines for several arrays at once
+ ============================================================================*/
+
+/* The unit of the link of PETSCSF_BCAST/REDUCE_MULTIPLE on n arrays of type unit. Messages and buffers of the link then have n times more data
+   than those of a link of type unit, with the data of each rank in the same place */
+PetscErrorCode PetscSFCreateMultipleUnit_Private(MPI_Datatype unit, PetscInt n, MPI_Datatype *munit)
+{
+  PetscMPIInt nn;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMPIIntCast(n, &nn));
+  PetscCallMPI(MPI_Type_contiguous(nn, unit, munit));
+  PetscCallMPI(MPI_Type_commit(munit));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The link of PETSCSF_BCAST/REDUCE_MULTIPLE only communicates. Arrays are packed and unpacked with the kernels of a host link of their unit,
+   which we keep on the link */
+PetscErrorCode PetscSFLinkSetUpUnitLink(PetscSF sf, PetscSFLink link, MPI_Datatype unit)
+{
+  PetscBool match = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (link->unitlink) PetscCall(MPIPetsc_Type_compare(unit, link->unitlink->unit, &match));
+  if (!match) {
+    PetscCall(PetscSFLinkDestroyUnitLink_Private(&link->unitlink));
+    PetscCall(PetscNew(&link->unitlink));
+    PetscCall(PetscSFLinkSetUp_Host(sf, link->unitlink, unit));
+    link->unitlink->rootmtype = PETSC_MEMTYPE_HOST;
+    link->unitlink->leafmtype = PETSC_MEMTYPE_HOST;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the remote part of n arrays to buf. The segment of buf for a rank holds the packed entries of the rank of data[0], then those of data[1] and
+   so on. Input nranks and offset[] are those of the remote ranks, idx[] is NULL when the indices are contiguous from start */
+static PetscErrorCode PetscSFLinkPackMultiple_Private(PetscSFLink unitlink, PetscInt nranks, const PetscInt *offset, PetscInt start, const PetscInt *idx, PetscInt n, const void **data, char *buf)
+{
+  const size_t unitbytes = unitlink->unitbytes;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < nranks; i++) {
+    PetscInt disp = offset[i] - offset[0], cnt = offset[i + 1] - offset[i];
+
+    for (PetscInt j = 0; j < n; j++) PetscCall((*unitlink->h_Pack)(unitlink, cnt, start + disp, NULL, idx ? idx + offset[i] : NULL, data[j], buf + (n * disp + j * cnt) * unitbytes));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack n rootdata arrays to the remote root buffer of a PETSCSF_BCAST_MULTIPLE link */
+PetscErrorCode PetscSFLinkPackRootDataMultiple(PetscSF sf, PetscSFLink link, PetscInt n, const void **rootdata)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  if (bas->rootbuflen[PETSCSF_REMOTE]) {
+    const PetscInt *idx = bas->rootcontig[PETSCSF_REMOTE] ? NULL : bas->irootloc;
+
+    PetscCall(PetscSFLinkPackMultiple_Private(link->unitlink, bas->niranks - bas->ndiranks, bas->ioffset + bas->ndiranks, bas->rootstart[PETSCSF_REMOTE], idx, n, rootdata, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack n leafdata arrays to the remote leaf buffer of a PETSCSF_REDUCE_MULTIPLE link */
+PetscErrorCode PetscSFLinkPackLeafDataMultiple(PetscSF sf, PetscSFLink link, PetscInt n, const void **leafdata)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  if (sf->leafbuflen[PETSCSF_REMOTE]) {
+    const PetscInt *idx = sf->leafcontig[PETSCSF_REMOTE] ? NULL : sf->rmine;
+
+    PetscCall(PetscSFLinkPackMultiple_Private(link->unitlink, sf->nranks - sf->ndranks, sf->roffset + sf->ndranks, sf->leafstart[PETSCSF_REMOTE], idx, n, leafdata, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the remote root buffer of a PETSCSF_REDUCE_MULTIPLE link to n rootdata arrays */
+PetscErrorCode PetscSFLinkUnpackRootDataMultiple(PetscSF sf, PetscSFLink link, PetscInt n, void **rootdata, MPI_Op op)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (bas->rootbuflen[PETSCSF_REMOTE]) {
+    const PetscInt *idx = bas->rootcontig[PETSCSF_REMOTE] ? NULL : bas->irootloc;
+
+    PetscCall(PetscSFLinkUnpackMultiple_Private(sf, link->unitlink, bas->niranks - bas->ndiranks, bas->ioffset + bas->ndiranks, bas->rootstart[PETSCSF_REMOTE], idx, bas->rootdups[PETSCSF_REMOTE], n, rootdata, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->shmbufs ? bas->ishmranks + bas->ndiranks : NULL, link->shmbufs ? bas->ishmdisps + bas->ndiranks : NULL, link->shmbufs, op));
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFLinkLogFlopsAfterUnpackRootData(sf, link->unitlink, PETSCSF_REMOTE, op));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the remote leaf buffer of a PETSCSF_BCAST_MULTIPLE link to n leafdata arrays */
+PetscErrorCode PetscSFLinkUnpackLeafDataMultiple(PetscSF sf, PetscSFLink link, PetscInt n, void **leafdata, MPI_Op op)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (sf->leafbuflen[PETSCSF_REMOTE]) {
+    const PetscInt *idx = sf->leafcontig[PETSCSF_REMOTE] ? NULL : sf->rmine;
+
+    PetscCall(PetscSFLinkUnpackMultiple_Private(sf, link->unitlink, sf->nranks - sf->ndranks, sf->roffset + sf->ndranks, sf->leafstart[PETSCSF_REMOTE], idx, sf->leafdups[PETSCSF_REMOTE], n, leafdata, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->shmbufs ? bas->shmranks + sf->ndranks : NULL, link->shmbufs ? bas->shmdisps + sf->ndranks : NULL, link->shmbufs, op));
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFLinkLogFlopsAfterUnpackLeafData(sf, link->unitlink, PETSCSF_REMOTE, op));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Local scatter of n arrays of a PETSCSF_BCAST/REDUCE_MULTIPLE link, which needs no buffer since all data is on host */
+PetscErrorCode PetscSFLinkScatterLocalMultiple(PetscSF sf, PetscSFLink link, PetscSFDirection direction, PetscInt n, void **rootdata, void **leafdata, MPI_Op op)
+{
+  PetscFunctionBegin;
+  for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFLinkScatterLocal(sf, link->unitlink, direction, rootdata[j], leafdata[j], op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Minimal average length of the runs of contiguous indices for which we pack/unpack run by run, see PetscSFCreatePackOptRuns() */
+#define PETSCSF_PACKOPT_MIN_RUN 8
+
+/*
+  Create pack/unpack optimizations made of the runs of contiguous indices in idx[], when they are long enough on average to make a copy per
+  run cheaper than the indirect accesses. Unlike the 3D plans, runs may span several ranks.
+
+   Input Parameters:
+  +  n       - Number of destination ranks
+  .  offset  - [n+1] For the i-th rank, its associated indices are idx[offset[i], offset[i+1]). offset[0] needs not to be 0.
+  -  idx     - [*]   Array storing indices
+
+   Output Parameters:
+  +  opt     - Pack optimizations. NULL if no optimizations.
+*/
+static PetscErrorCode PetscSFCreatePackOptRuns(PetscInt n, const PetscInt *offset, const PetscInt *idx, PetscSFPackOpt *out)
+{
+  PetscInt       i, r, nruns, m = n ? offset[n] - offset[0] : 0;
+  PetscSFPackOpt opt;
+
+  PetscFunctionBegin;
+  *out = NULL;
+  if (!m) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i = offset[0] + 1, nruns = 1; i < offset[n]; i++) {
+    if (idx[i] != idx[i - 1] + 1) nruns++;
+  }
+  if (m < PETSCSF_PACKOPT_MIN_RUN * nruns) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMalloc1(1, &opt));
+  PetscCall(PetscMalloc1(7 * nruns + 2, &opt->array));
+  opt->n = opt->array[0] = nruns;
+  opt->offset            = opt->array + 1;
+  opt->start             = opt->array + nruns + 2;
+  opt->dx                = opt->array + 2 * nruns + 2;
+  opt->dy                = opt->array + 3 * nruns + 2;
+  opt->dz                = opt->array + 4 * nruns + 2;
+  opt->X                 = opt->array + 5 * nruns + 2;
+  opt->Y                 = opt->array + 6 * nruns + 2;
+  opt->runs              = PETSC_TRUE;
+
+  opt->offset[0] = 0;
+  for (i = offset[0], r = 0; r < nruns; r++) {
+    opt->start[r] = idx[i];
+    i++;
+    while (i < offset[n] && idx[i] == idx[i - 1] + 1) i++;
+    opt->offset[r + 1] = i - offset[0];
+    opt->dx[r]         = opt->offset[r + 1] - opt->offset[r];
+    opt->dy[r]         = 1;
+    opt->dz[r]         = 1;
+    opt->X[r]          = opt->dx[r];
+    opt->Y[r]          = 1;
+  }
+  *out = opt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
-  Create per-rank pack/unpack optimizations based on indice patterns
+  Create per-rank pack/unpack optimizations based on indice patterns, or optimizations based on runs of contiguous indices if there are no such patterns
 
    Input Parameters:
   +  n       - Number of destination ranks
@@ -1257,6 +1510,7 @@ static PetscErrorCode PetscSFCreatePackOpt(PetscInt n, const PetscInt *offset, c
   opt->dz                = opt->array + 4 * n + 2;
   opt->X                 = opt->array + 5 * n + 2;
   opt->Y                 = opt->array + 6 * n + 2;
+  opt->runs              = PETSC_FALSE;
 
   for (r = 0; r < n; r++) {            /* For each destination rank */
     m     = offset[r + 1] - offset[r]; /* Total number of indices for this rank. We want to see if m can be factored into dx*dy*dz */
@@ -1320,7 +1574,7 @@ finish:
   if (!n || !optimizable) {
     PetscCall(PetscFree(opt->array));
     PetscCall(PetscFree(opt));
-    *out = NULL;
+    PetscCall(PetscSFCreatePackOptRuns(n, offset, idx, out));
   } else {
     opt->offset[0] = 0;
     for (r = 0; r < n; r++) opt->offset[r + 1] = opt->offset[r] + opt->dx[r] * opt->dy[r] * opt->dz[r];
@@ -47,6 +47,7 @@ struct _n_PetscSFPackOpt {
   PetscInt *start;        /* [n] First index */
   PetscInt *dx, *dy, *dz; /* [n] Lengths of the submatrix in X, Y, Z dimension. */
   PetscInt *X, *Y;        /* [n] Lengths of the outer matrix in X, Y. We do not care Z. */
+  PetscBool runs;         /* The submatrices are runs of contiguous indices (dy=dz=1), one per run instead of one per rank. Only used on host */
 };
 
 /* An abstract class that defines a communication link, which includes how to pack/unpack data and send/recv buffers
@@ -191,7 +192,18 @@ struct _n_PetscSFLink {
   MPI_Request *leafreqs[2][2][2];       /* Leaf requests in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi] */
   PetscBool    rootreqsinited[2][2][2]; /* Are root requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][rootdirect_mpi]*/
   PetscBool    leafreqsinited[2][2][2]; /* Are leaf requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi]*/
+  const void  *nbrrootbuf[2][2][2];     /* Root/leaf buffers the persistent neighborhood collective of SFNeighbor was init'ed with, in layout of rootreqs[][][]. */
+  const void  *nbrleafbuf[2][2][2];     /* ... The request is init'ed again when one of them changes */
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  MPI_Win shmwin; /* With shared memory communication on my node, the window holding the counters and the remote root and leaf buffers, */
+#endif
+  char       **shmbufs;                 /* ... the start of the buffers of each rank of the shmcomm of the SF, */
+  PetscInt64 **shmflags;                /* ... its two counters, of the communications it started and of the operations it finished on the link, */
+  PetscMPIInt  shmrank;                 /* ... my rank in that shmcomm, */
+  char        *shmrootbuf, *shmleafbuf; /* ... my remote root and leaf buffers, */
+  PetscInt     shmid;                   /* ... and the order of creation of the link. See PetscSFLinkCreate_MPI() */
   MPI_Request *reqs;                    /* An array of length (nrootreqs+nleafreqs)*8. Pointers in rootreqs[][][] and leafreqs[][][] point here */
+  PetscSFLink  unitlink;                /* For PETSCSF_BCAST/REDUCE_MULTIPLE, whose unit is made of one unit of each array, a host link for that unit */
   PetscSFLink  next;
 
   PetscBool use_nvshmem; /* Does this link use nvshem (vs. MPI) for communication? */
@@ -240,11 +252,23 @@ PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafData(PetscSF, PetscSFLink, Pets
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpRemote(PetscSF, PetscSFLink, void *, MPI_Op);
 
 PETSC_INTERN PetscErrorCode PetscSFLinkScatterLocal(PetscSF, PetscSFLink, PetscSFDirection, void *, void *, MPI_Op);
+
+/* Do the same with the several arrays of PETSCSF_BCAST/REDUCE_MULTIPLE, whose link has a unit made of n units */
+PETSC_INTERN PetscErrorCode PetscSFCreateMultipleUnit_Private(MPI_Datatype, PetscInt, MPI_Datatype *);
+PETSC_INTERN PetscErrorCode PetscSFLinkSetUpUnitLink(PetscSF, PetscSFLink, MPI_Datatype);
+PETSC_INTERN PetscErrorCode PetscSFLinkPackRootDataMultiple(PetscSF, PetscSFLink, PetscInt, const void **);
+PETSC_INTERN PetscErrorCode PetscSFLinkPackLeafDataMultiple(PetscSF, PetscSFLink, PetscInt, const void **);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackRootDataMultiple(PetscSF, PetscSFLink, PetscInt, void **, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafDataMultiple(PetscSF, PetscSFLink, PetscInt, void **, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFLinkScatterLocalMultiple(PetscSF, PetscSFLink, PetscSFDirection, PetscInt, void **, void **, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF, PetscSFLink, void *, const void *, void *, MPI_Op);
 
 PETSC_INTERN PetscErrorCode PetscSFSetUpPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFResetPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFLinkCreate_MPI(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, const void *, MPI_Op, PetscSFOperation, PetscSFLink *);
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+PETSC_INTERN PetscErrorCode PetscSFLinkGatherShm_MPI(PetscSF, PetscSFLink, PetscSFDirection);
+#endif
 
 #if defined(PETSC_HAVE_CUDA)
 PETSC_INTERN PetscErrorCode PetscSFLinkSetUp_CUDA(PetscSF, PetscSFLink, MPI_Datatype);
@@ -376,6 +400,7 @@ static inline PetscErrorCode PetscSFLinkGetRootPackOptAndIndices(PetscSF sf, Pet
     1) opt == NULL && indices == NULL ==> indices are contiguous.
     2) opt != NULL ==> indices are in 3D but not contiguous. On host, indices != NULL since indices are already available and we do not
        want to enforce all operations to use opt; but on device, indices = NULL since we do not want to copy indices to device.
+    3) Plans made of runs of indices may have many submatrices, which device kernels would search linearly, so on device we use indices instead.
   */
   if (!bas->rootcontig[scope]) {
     offset = (scope == PETSCSF_LOCAL) ? 0 : bas->ioffset[bas->ndiranks];
@@ -384,7 +409,7 @@ static inline PetscErrorCode PetscSFLinkGetRootPackOptAndIndices(PetscSF sf, Pet
       *indices = bas->irootloc + offset;
     } else {
       size_t size;
-      if (bas->rootpackopt[scope]) {
+      if (bas->rootpackopt[scope] && !bas->rootpackopt[scope]->runs) {
         if (!bas->rootpackopt_d[scope]) {
           PetscCall(PetscMalloc1(1, &bas->rootpackopt_d[scope]));
           PetscCall(PetscArraycpy(bas->rootpackopt_d[scope], bas->rootpackopt[scope], 1)); /* Make pointers in bas->rootpackopt_d[] still work on host */
@@ -426,7 +451,7 @@ static inline PetscErrorCode PetscSFLinkGetLeafPackOptAndIndices(PetscSF sf, Pet
       *indices = sf->rmine + offset;
     } else {
       size_t size;
-      if (sf->leafpackopt[scope]) {
+      if (sf->leafpackopt[scope] && !sf->leafpackopt[scope]->runs) {
         if (!sf->leafpackopt_d[scope]) {
           PetscCall(PetscMalloc1(1, &sf->leafpackopt_d[scope]));
           PetscCall(PetscArraycpy(sf->leafpackopt_d[scope], sf->leafpackopt[scope], 1));
@@ -1600,6 +1600,194 @@ PetscErrorCode PetscSFReduceEnd(PetscSF sf, MPI_Datatype unit, const void *leafd
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Can the n arrays go through the fused implementation of the type, which packs them in the same messages and needs them on host, instead of one
+  communication per array? The answer must be the same on all processes, so with device support we agree on it
+*/
+static PetscErrorCode PetscSFUseMultiple_Private(PetscSF sf, PetscBool hasmethod, PetscInt n, const void **data, void **update, PetscBool *use)
+{
+  PetscMemType mtype;
+
+  PetscFunctionBegin;
+  *use = (PetscBool)(hasmethod && n > 1);
+  if (!PetscDefined(HAVE_DEVICE) || !hasmethod || n < 2) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt j = 0; j < n && *use; j++) {
+    PetscCall(PetscGetMemType(data[j], &mtype));
+    if (PetscMemTypeDevice(mtype)) *use = PETSC_FALSE;
+    PetscCall(PetscGetMemType(update[j], &mtype));
+    if (PetscMemTypeDevice(mtype)) *use = PETSC_FALSE;
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, use, 1, MPIU_BOOL, MPI_LAND, PetscObjectComm((PetscObject)sf)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastMultipleBegin - begin pointwise broadcasts of several root arrays to leaf arrays on the same star forest, to be concluded with a call to
+  `PetscSFBcastMultipleEnd()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest on which to communicate
+. unit     - data type associated with each node, the same for all arrays
+. n        - number of arrays
+. rootdata - the `n` buffers to broadcast
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - the `n` buffers to be reduced with values from each leaf's respective root
+
+  Level: intermediate
+
+  Notes:
+  This is equivalent to `PetscSFBcastBegin()` on each pair of arrays, but `PETSCSFBASIC` and `PETSCSFNEIGHBOR` pack the data of all arrays for a
+  process in one message, so that the number of messages is that of a single broadcast.
+
+  Data in device memory and other `PetscSFType` use one broadcast per array. With device support, the processes agree on this with a reduction.
+
+.seealso: `PetscSF`, `PetscSFBcastMultipleEnd()`, `PetscSFBcastBegin()`, `PetscSFReduceMultipleBegin()`, `VecScatterBeginMultiple()`
+@*/
+PetscErrorCode PetscSFBcastMultipleBegin(PetscSF sf, MPI_Datatype unit, PetscInt n, const void *rootdata[], void *leafdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of arrays %" PetscInt_FMT " cannot be negative", n);
+  if (n) {
+    PetscAssertPointer(rootdata, 4);
+    PetscAssertPointer(leafdata, 5);
+  }
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFUseMultiple_Private(sf, sf->ops->BcastMultipleBegin ? PETSC_TRUE : PETSC_FALSE, n, rootdata, leafdata, &use));
+  if (use) {
+    if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastBegin, sf, 0, 0, 0));
+    PetscUseTypeMethod(sf, BcastMultipleBegin, unit, n, rootdata, leafdata, op);
+    if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastBegin, sf, 0, 0, 0));
+  } else {
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFBcastBegin(sf, unit, rootdata[j], leafdata[j], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastMultipleEnd - end broadcasts started with `PetscSFBcastMultipleBegin()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. unit     - data type
+. n        - number of arrays
+. rootdata - the `n` buffers to broadcast
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - the `n` buffers to be reduced with values from each leaf's respective root
+
+  Level: intermediate
+
+.seealso: `PetscSF`, `PetscSFBcastMultipleBegin()`, `PetscSFBcastEnd()`
+@*/
+PetscErrorCode PetscSFBcastMultipleEnd(PetscSF sf, MPI_Datatype unit, PetscInt n, const void *rootdata[], void *leafdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCall(PetscSFUseMultiple_Private(sf, sf->ops->BcastMultipleEnd ? PETSC_TRUE : PETSC_FALSE, n, rootdata, leafdata, &use));
+  if (use) {
+    if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastEnd, sf, 0, 0, 0));
+    PetscUseTypeMethod(sf, BcastMultipleEnd, unit, n, rootdata, leafdata, op);
+    if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  } else {
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFBcastEnd(sf, unit, rootdata[j], leafdata[j], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceMultipleBegin - begin reductions of several leaf arrays into root arrays on the same star forest, to be completed with a call to
+  `PetscSFReduceMultipleEnd()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. unit     - data type, the same for all arrays
+. n        - number of arrays
+. leafdata - the `n` arrays of values to reduce
+- op       - reduction operation
+
+  Output Parameter:
+. rootdata - the `n` arrays of results of reduction of values from all leaves of each root
+
+  Level: intermediate
+
+  Note:
+  This is equivalent to `PetscSFReduceBegin()` on each pair of arrays, but may send fewer messages, see `PetscSFBcastMultipleBegin()`.
+
+.seealso: `PetscSF`, `PetscSFReduceMultipleEnd()`, `PetscSFReduceBegin()`, `PetscSFBcastMultipleBegin()`, `VecScatterBeginMultiple()`
+@*/
+PetscErrorCode PetscSFReduceMultipleBegin(PetscSF sf, MPI_Datatype unit, PetscInt n, const void *leafdata[], void *rootdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of arrays %" PetscInt_FMT " cannot be negative", n);
+  if (n) {
+    PetscAssertPointer(leafdata, 4);
+    PetscAssertPointer(rootdata, 5);
+  }
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFUseMultiple_Private(sf, sf->ops->ReduceMultipleBegin ? PETSC_TRUE : PETSC_FALSE, n, leafdata, rootdata, &use));
+  if (use) {
+    if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_ReduceBegin, sf, 0, 0, 0));
+    PetscUseTypeMethod(sf, ReduceMultipleBegin, unit, n, leafdata, rootdata, op);
+    if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_ReduceBegin, sf, 0, 0, 0));
+  } else {
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFReduceBegin(sf, unit, leafdata[j], rootdata[j], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceMultipleEnd - end reductions started with `PetscSFReduceMultipleBegin()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. unit     - data type
+. n        - number of arrays
+. leafdata - the `n` arrays of values to reduce
+- op       - reduction operation
+
+  Output Parameter:
+. rootdata - the `n` arrays of results of reduction of values from all leaves of each root
+
+  Level: intermediate
+
+.seealso: `PetscSF`, `PetscSFReduceMultipleBegin()`, `PetscSFReduceEnd()`
+@*/
+PetscErrorCode PetscSFReduceMultipleEnd(PetscSF sf, MPI_Datatype unit, PetscInt n, const void *leafdata[], void *rootdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCall(PetscSFUseMultiple_Private(sf, sf->ops->ReduceMultipleEnd ? PETSC_TRUE : PETSC_FALSE, n, leafdata, rootdata, &use));
+  if (use) {
+    if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_ReduceEnd, sf, 0, 0, 0));
+    PetscUseTypeMethod(sf, ReduceMultipleEnd, unit, n, leafdata, rootdata, op);
+    if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_ReduceEnd, sf, 0, 0, 0));
+  } else {
+    for (PetscInt j = 0; j < n; j++) PetscCall(PetscSFReduceEnd(sf, unit, leafdata[j], rootdata[j], op));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscSFFetchAndOpBegin - begin operation that fetches values from root and updates atomically by applying operation using my leaf value,
   to be completed with `PetscSFFetchAndOpEnd()`
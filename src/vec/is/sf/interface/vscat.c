@@ -38,6 +38,43 @@ functionend:
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Error checking to make sure these vectors match the vectors used
+   to create the vector scatter context. -1 in the from_n and to_n indicate the
+   vector lengths are unknown (for example with mapped scatters) and thus
+   no error checking is performed.
+*/
+static PetscErrorCode VecScatterCheckSizes_Private(VecScatter sf, Vec x, Vec y, ScatterMode mode)
+{
+  PetscInt to_n, from_n;
+
+  PetscFunctionBegin;
+  if (sf->vscat.from_n >= 0 && sf->vscat.to_n >= 0) {
+    PetscCall(VecGetLocalSize(x, &from_n));
+    PetscCall(VecGetLocalSize(y, &to_n));
+    if (mode & SCATTER_REVERSE) {
+      PetscCheck(to_n == sf->vscat.from_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter reverse and vector to != sf from size)", to_n, sf->vscat.from_n);
+      PetscCheck(from_n == sf->vscat.to_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter reverse and vector from != sf to size)", from_n, sf->vscat.to_n);
+    } else {
+      PetscCheck(to_n == sf->vscat.to_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter forward and vector to != sf to size)", to_n, sf->vscat.to_n);
+      PetscCheck(from_n == sf->vscat.from_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter forward and vector from != sf from size)", from_n, sf->vscat.from_n);
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Map the InsertMode of VecScatterBegin/End to an MPI_Op of PetscSF */
+static PetscErrorCode VecScatterGetMPIOp_Private(VecScatter sf, InsertMode addv, MPI_Op *mop)
+{
+  PetscFunctionBegin;
+  if (addv == INSERT_VALUES) *mop = MPI_REPLACE;
+  else if (addv == ADD_VALUES) *mop = MPIU_SUM; /* Petsc defines its own MPI datatype and SUM operation for __float128 etc. */
+  else if (addv == MAX_VALUES) *mop = MPIU_MAX;
+  else if (addv == MIN_VALUES) *mop = MPIU_MIN;
+  else SETERRQ(PetscObjectComm((PetscObject)sf), PETSC_ERR_SUP, "Unsupported InsertMode %d in VecScatterBegin/End", addv);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode VecScatterBegin_Internal(VecScatter sf, Vec x, Vec y, InsertMode addv, ScatterMode mode)
 {
   PetscSF      wsf = NULL; /* either sf or its local part */
@@ -61,11 +98,7 @@ static PetscErrorCode VecScatterBegin_Internal(VecScatter sf, Vec x, Vec y, Inse
   }
 
   /* Note xdata/ydata is always recorded on sf (not lsf) above */
-  if (addv == INSERT_VALUES) mop = MPI_REPLACE;
-  else if (addv == ADD_VALUES) mop = MPIU_SUM; /* Petsc defines its own MPI datatype and SUM operation for __float128 etc. */
-  else if (addv == MAX_VALUES) mop = MPIU_MAX;
-  else if (addv == MIN_VALUES) mop = MPIU_MIN;
-  else SETERRQ(PetscObjectComm((PetscObject)sf), PETSC_ERR_SUP, "Unsupported InsertMode %d in VecScatterBegin/End", addv);
+  PetscCall(VecScatterGetMPIOp_Private(sf, addv, &mop));
 
   if (mode & SCATTER_REVERSE) { /* REVERSE indicates leaves to root scatter. Note that x and y are swapped in input */
     PetscCall(PetscSFReduceWithMemTypeBegin(wsf, sf->vscat.unit, xmtype, sf->vscat.xdata, ymtype, sf->vscat.ydata, mop));
@@ -86,11 +119,7 @@ static PetscErrorCode VecScatterEnd_Internal(VecScatter sf, Vec x, Vec y, Insert
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)sf), &size));
   wsf = ((mode & SCATTER_FORWARD_LOCAL) && size > 1) ? sf->vscat.lsf : sf;
 
-  if (addv == INSERT_VALUES) mop = MPI_REPLACE;
-  else if (addv == ADD_VALUES) mop = MPIU_SUM;
-  else if (addv == MAX_VALUES) mop = MPIU_MAX;
-  else if (addv == MIN_VALUES) mop = MPIU_MIN;
-  else SETERRQ(PetscObjectComm((PetscObject)sf), PETSC_ERR_SUP, "Unsupported InsertMode %d in VecScatterBegin/End", addv);
+  PetscCall(VecScatterGetMPIOp_Private(sf, addv, &mop));
 
   if (mode & SCATTER_REVERSE) { /* reverse scatter sends leaves to roots. Note that x and y are swapped in input */
     PetscCall(PetscSFReduceEnd(wsf, sf->vscat.unit, sf->vscat.xdata, sf->vscat.ydata, mop));
@@ -1288,31 +1317,11 @@ PetscErrorCode VecScatterCreateToZero(Vec vin, VecScatter *ctx, Vec *vout)
 @*/
 PetscErrorCode VecScatterBegin(VecScatter sf, Vec x, Vec y, InsertMode addv, ScatterMode mode)
 {
-  PetscInt to_n, from_n;
-
   PetscFunctionBegin;
   PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
   PetscValidHeaderSpecific(x, VEC_CLASSID, 2);
   PetscValidHeaderSpecific(y, VEC_CLASSID, 3);
-  if (PetscDefined(USE_DEBUG)) {
-    /*
-     Error checking to make sure these vectors match the vectors used
-     to create the vector scatter context. -1 in the from_n and to_n indicate the
-     vector lengths are unknown (for example with mapped scatters) and thus
-     no error checking is performed.
-     */
-    if (sf->vscat.from_n >= 0 && sf->vscat.to_n >= 0) {
-      PetscCall(VecGetLocalSize(x, &from_n));
-      PetscCall(VecGetLocalSize(y, &to_n));
-      if (mode & SCATTER_REVERSE) {
-        PetscCheck(to_n == sf->vscat.from_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter reverse and vector to != sf from size)", to_n, sf->vscat.from_n);
-        PetscCheck(from_n == sf->vscat.to_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter reverse and vector from != sf to size)", from_n, sf->vscat.to_n);
-      } else {
-        PetscCheck(to_n == sf->vscat.to_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter forward and vector to != sf to size)", to_n, sf->vscat.to_n);
-        PetscCheck(from_n == sf->vscat.from_n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vector wrong size %" PetscInt_FMT " for scatter %" PetscInt_FMT " (scatter forward and vector from != sf from size)", from_n, sf->vscat.from_n);
-      }
-    }
-  }
+  if (PetscDefined(USE_DEBUG)) PetscCall(VecScatterCheckSizes_Private(sf, x, y, mode));
 
   sf->vscat.logging = PETSC_TRUE;
   PetscCall(PetscLogEventBegin(VEC_ScatterBegin, sf, x, y, 0));
@@ -1360,3 +1369,152 @@ PetscErrorCode VecScatterEnd(VecScatter sf, Vec x, Vec y, InsertMode addv, Scatt
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+static PetscErrorCode VecScatterBeginMultiple_Internal(VecScatter sf, PetscInt n, Vec x[], Vec y[], InsertMode addv, ScatterMode mode)
+{
+  PetscSF     wsf = NULL;
+  MPI_Op      mop = MPI_OP_NULL;
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc2(n, &sf->vscat.xdatas, n, &sf->vscat.ydatas));
+  sf->vscat.nv = n;
+  for (PetscInt j = 0; j < n; j++) {
+    PetscMemType mtype;
+
+    if (x[j] != y[j]) PetscCall(VecLockReadPush(x[j]));
+    PetscCall(VecGetArrayReadAndMemType(x[j], &sf->vscat.xdatas[j], &mtype));
+    PetscCall(VecGetArrayAndMemType(y[j], &sf->vscat.ydatas[j], &mtype));
+    PetscCall(VecLockWriteSet(y[j], PETSC_TRUE));
+  }
+
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)sf), &size));
+  if ((mode & SCATTER_FORWARD_LOCAL) && size > 1) {
+    if (!sf->vscat.lsf) PetscCall(PetscSFCreateLocalSF_Private(sf, &sf->vscat.lsf));
+    wsf = sf->vscat.lsf;
+  } else {
+    wsf = sf;
+  }
+  PetscCall(VecScatterGetMPIOp_Private(sf, addv, &mop));
+
+  if (mode & SCATTER_REVERSE) {
+    PetscCall(PetscSFReduceMultipleBegin(wsf, sf->vscat.unit, n, (const void **)sf->vscat.xdatas, (void **)sf->vscat.ydatas, mop));
+  } else {
+    PetscCall(PetscSFBcastMultipleBegin(wsf, sf->vscat.unit, n, (const void **)sf->vscat.xdatas, (void **)sf->vscat.ydatas, mop));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecScatterEndMultiple_Internal(VecScatter sf, PetscInt n, Vec x[], Vec y[], InsertMode addv, ScatterMode mode)
+{
+  PetscSF     wsf = NULL;
+  MPI_Op      mop = MPI_OP_NULL;
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCheck(n == sf->vscat.nv, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "VecScatterEndMultiple() with %" PetscInt_FMT " vectors, but VecScatterBeginMultiple() was called with %" PetscInt_FMT, n, sf->vscat.nv);
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)sf), &size));
+  wsf = ((mode & SCATTER_FORWARD_LOCAL) && size > 1) ? sf->vscat.lsf : sf;
+  PetscCall(VecScatterGetMPIOp_Private(sf, addv, &mop));
+
+  if (mode & SCATTER_REVERSE) {
+    PetscCall(PetscSFReduceMultipleEnd(wsf, sf->vscat.unit, n, (const void **)sf->vscat.xdatas, (void **)sf->vscat.ydatas, mop));
+  } else {
+    PetscCall(PetscSFBcastMultipleEnd(wsf, sf->vscat.unit, n, (const void **)sf->vscat.xdatas, (void **)sf->vscat.ydatas, mop));
+  }
+
+  for (PetscInt j = 0; j < n; j++) {
+    PetscCall(VecRestoreArrayReadAndMemType(x[j], &sf->vscat.xdatas[j]));
+    if (x[j] != y[j]) PetscCall(VecLockReadPop(x[j]));
+    PetscCall(VecRestoreArrayAndMemType(y[j], &sf->vscat.ydatas[j]));
+    PetscCall(VecLockWriteSet(y[j], PETSC_FALSE));
+  }
+  PetscCall(PetscFree2(sf->vscat.xdatas, sf->vscat.ydatas));
+  sf->vscat.nv = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  VecScatterBeginMultiple - Begins the same generalized scatter for several pairs of vectors. Complete the scatters with `VecScatterEndMultiple()`.
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ sf   - scatter context generated by `VecScatterCreate()`
+. n    - the number of pairs of vectors
+. x    - the `n` vectors from which we scatter
+. y    - the `n` vectors to which we scatter
+. addv - either `ADD_VALUES`, `MAX_VALUES`, `MIN_VALUES` or `INSERT_VALUES`
+- mode - the scattering mode, see `VecScatterBegin()`
+
+  Level: intermediate
+
+  Notes:
+  This is equivalent to calling `VecScatterBegin()` on each pair `x[i]`, `y[i]`, but the values of all vectors going to a process are
+  packed in one message, so that the number of messages does not grow with `n`. This requires the `PetscSFType` of the scatter to be
+  `PETSCSFBASIC` (the default) or `PETSCSFNEIGHBOR` and the vectors to be in host memory; otherwise one scatter per pair is done.
+
+  No other scatter with `sf` can be in progress until `VecScatterEndMultiple()` is called.
+
+.seealso: [](sec_scatter), `VecScatter`, `VecScatterEndMultiple()`, `VecScatterBegin()`, `PetscSFBcastMultipleBegin()`
+@*/
+PetscErrorCode VecScatterBeginMultiple(VecScatter sf, PetscInt n, Vec x[], Vec y[], InsertMode addv, ScatterMode mode)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors %" PetscInt_FMT " cannot be negative", n);
+  if (n) {
+    PetscAssertPointer(x, 3);
+    PetscAssertPointer(y, 4);
+  }
+  PetscCheck(!sf->vscat.nv, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "VecScatterEndMultiple() must be called before another VecScatterBeginMultiple()");
+  for (PetscInt j = 0; j < n; j++) {
+    PetscValidHeaderSpecific(x[j], VEC_CLASSID, 3);
+    PetscValidHeaderSpecific(y[j], VEC_CLASSID, 4);
+    if (PetscDefined(USE_DEBUG)) PetscCall(VecScatterCheckSizes_Private(sf, x[j], y[j], mode));
+  }
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+
+  sf->vscat.logging = PETSC_TRUE;
+  PetscCall(PetscLogEventBegin(VEC_ScatterBegin, sf, x[0], y[0], 0));
+  PetscCall(VecScatterBeginMultiple_Internal(sf, n, x, y, addv, mode));
+  if (sf->vscat.beginandendtogether) PetscCall(VecScatterEndMultiple_Internal(sf, n, x, y, addv, mode));
+  PetscCall(PetscLogEventEnd(VEC_ScatterBegin, sf, x[0], y[0], 0));
+  sf->vscat.logging = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  VecScatterEndMultiple - Ends the scatters started with `VecScatterBeginMultiple()`.
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ sf   - scatter context generated by `VecScatterCreate()`
+. n    - the number of pairs of vectors
+. x    - the `n` vectors from which we scatter
+. y    - the `n` vectors to which we scatter
+. addv - either `ADD_VALUES`, `MAX_VALUES`, `MIN_VALUES` or `INSERT_VALUES`
+- mode - the scattering mode, see `VecScatterBegin()`
+
+  Level: intermediate
+
+  Note:
+  The arguments must be the same as in the matching call to `VecScatterBeginMultiple()`.
+
+.seealso: [](sec_scatter), `VecScatter`, `VecScatterBeginMultiple()`, `VecScatterEnd()`
+@*/
+PetscErrorCode VecScatterEndMultiple(VecScatter sf, PetscInt n, Vec x[], Vec y[], InsertMode addv, ScatterMode mode)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  if (!n || sf->vscat.beginandendtogether) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(x, 3);
+  PetscAssertPointer(y, 4);
+  sf->vscat.logging = PETSC_TRUE;
+  PetscCall(PetscLogEventBegin(VEC_ScatterEnd, sf, x[0], y[0], 0));
+  PetscCall(VecScatterEndMultiple_Internal(sf, n, x, y, addv, mode));
+  PetscCall(PetscLogEventEnd(VEC_ScatterEnd, sf, x[0], y[0], 0));
+  sf->vscat.logging = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
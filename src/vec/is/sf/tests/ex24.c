@@ -0,0 +1,145 @@
+static const char help[] = "Benchmarks repeated PetscSF halo exchanges of a 2D grid, to compare SF types such as basic, neighbor and persistent neighbor.\n\n\
+  -m <m>       : each process owns m x m grid points\n\
+  -its <its>   : number of halo exchanges to time\n\
+  -report_time : print the average time of an exchange\n\n";
+
+#include <petscsf.h>
+#include <petsctime.h>
+
+int main(int argc, char **argv)
+{
+  PetscSF        sf;
+  PetscMPIInt    size, rank, dims[2] = {0, 0}, pi, pj;
+  PetscInt       m = 16, its = 100, nleaves = 0, nerr = 0, ntotal, i, k, it;
+  PetscInt      *rootdata, *leafdata[2], *expect;
+  PetscSFNode   *iremote;
+  PetscBool      report_time = PETSC_FALSE;
+  PetscLogStage  stage[2];
+  PetscLogDouble t[2];
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-its", &its, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-report_time", &report_time, NULL));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Dims_create(size, 2, dims));
+  pi = rank % dims[0];
+  pj = rank / dims[0];
+
+  /* Ghost points are the faces of the neighbor blocks, ordered by the rank of their owner so that SF can use the leaf buffer directly.
+     Point (i,j) of the block of rank r is root i + j*m of r, its value is its global number */
+  PetscCall(PetscMalloc2(4 * m, &iremote, 4 * m, &expect));
+  if (pj > 0) {
+    for (i = 0; i < m; i++, nleaves++) {
+      iremote[nleaves].rank  = rank - dims[0];
+      iremote[nleaves].index = i + (m - 1) * m;
+    }
+  }
+  if (pi > 0) {
+    for (i = 0; i < m; i++, nleaves++) {
+      iremote[nleaves].rank  = rank - 1;
+      iremote[nleaves].index = m - 1 + i * m;
+    }
+  }
+  if (pi < dims[0] - 1) {
+    for (i = 0; i < m; i++, nleaves++) {
+      iremote[nleaves].rank  = rank + 1;
+      iremote[nleaves].index = i * m;
+    }
+  }
+  if (pj < dims[1] - 1) {
+    for (i = 0; i < m; i++, nleaves++) {
+      iremote[nleaves].rank  = rank + dims[0];
+      iremote[nleaves].index = i;
+    }
+  }
+  for (k = 0; k < nleaves; k++) expect[k] = iremote[k].rank * m * m + iremote[k].index;
+
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetGraph(sf, m * m, nleaves, NULL, PETSC_COPY_VALUES, iremote, PETSC_COPY_VALUES));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscMalloc3(m * m, &rootdata, nleaves, &leafdata[0], nleaves, &leafdata[1]));
+
+  /* Alternate between two leaf arrays, as with halo exchanges into different vectors, so that SF types which bind buffers to their
+     requests have to handle changed buffers */
+  PetscCall(PetscLogStageRegister("Halo update", &stage[0]));
+  PetscCall(PetscLogStageRegister("Halo reduce", &stage[1]));
+  PetscCall(PetscBarrier((PetscObject)sf));
+  PetscCall(PetscLogStagePush(stage[0]));
+  t[0] = 0.0;
+  PetscCall(PetscTimeSubtract(&t[0]));
+  for (it = 0; it < its; it++) {
+    PetscInt *leaves = leafdata[it % 2];
+
+    for (i = 0; i < m * m; i++) rootdata[i] = rank * m * m + i + it;
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, rootdata, leaves, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, rootdata, leaves, MPI_REPLACE));
+    for (k = 0; k < nleaves; k++) nerr += (leaves[k] != expect[k] + it);
+  }
+  PetscCall(PetscTimeAdd(&t[0]));
+  PetscCall(PetscLogStagePop());
+
+  /* Each root receives one contribution per ghost copy of it, i.e., per neighbor block whose face it is on */
+  PetscCall(PetscBarrier((PetscObject)sf));
+  PetscCall(PetscLogStagePush(stage[1]));
+  t[1] = 0.0;
+  PetscCall(PetscTimeSubtract(&t[1]));
+  for (it = 0; it < its; it++) {
+    PetscInt *leaves = leafdata[it % 2];
+
+    for (k = 0; k < nleaves; k++) leaves[k] = 1;
+    for (i = 0; i < m * m; i++) rootdata[i] = 0;
+    PetscCall(PetscSFReduceBegin(sf, MPIU_INT, leaves, rootdata, MPIU_SUM));
+    PetscCall(PetscSFReduceEnd(sf, MPIU_INT, leaves, rootdata, MPIU_SUM));
+    for (i = 0; i < m * m; i++) {
+      PetscInt x = i % m, y = i / m;
+
+      nerr += (rootdata[i] != (x == 0 && pi > 0) + (x == m - 1 && pi < dims[0] - 1) + (y == 0 && pj > 0) + (y == m - 1 && pj < dims[1] - 1));
+    }
+  }
+  PetscCall(PetscTimeAdd(&t[1]));
+  PetscCall(PetscLogStagePop());
+
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nerr, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(MPIU_Allreduce(&nleaves, &ntotal, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, t, 2, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " halo exchanges of %" PetscInt_FMT " ghost points on a %d x %d process grid: %s\n", its, ntotal, dims[0], dims[1], nerr ? "FAILED" : "ok"));
+  if (report_time && its > 0) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Average time of an update %g s, of a reduce %g s\n", t[0] / its, t[1] / its));
+
+  PetscCall(PetscFree3(rootdata, leafdata[0], leafdata[1]));
+  PetscCall(PetscFree2(iremote, expect));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: 4
+      args: -m 8 -its 10
+      output_file: output/ex24_1.out
+
+      test:
+         suffix: basic
+         args: -sf_type basic
+
+      test:
+         suffix: basic_shared_memory
+         requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+         args: -sf_type basic -sf_basic_shared_memory
+
+      test:
+         suffix: neighbor
+         requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+         args: -sf_type neighbor
+
+      test:
+         suffix: neighbor_persistent
+         requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+         args: -sf_type neighbor -sf_neighbor_persistent
+
+TEST*/
@@ -0,0 +1,145 @@
+static const char help[] = "Tests PetscSF broadcasts and reductions on units of bs PetscReals or PetscInts, with root and leaf indices made of runs of contiguous indices.\n\n\
+  -bs <bs>           : number of PetscReals or PetscInts in a unit\n\
+  -contiguous_leaves : use contiguous leaves instead of runs\n\n";
+
+#include <petscsf.h>
+
+/* Leaf i of block b goes to rank (rank + b) % size. Each block has three runs of 8 leaves, which go to three runs of 8 roots with
+   irregular gaps, so that the indices have no 3D pattern */
+#define NBLOCKS  3
+#define NBLOCK   24
+#define NROOTS   40
+#define ROOT(j)  ((j) + ((j) / 8) * ((j) / 8 + 3))
+#define LEAF(i)  ((i) + ((i) / 8) * ((i) / 8))
+#define NLEAVESX (LEAF(NBLOCKS * NBLOCK - 1) + 1)
+
+static PetscErrorCode TestUnit(PetscSF sf, MPI_Datatype basic, PetscInt bs, PetscBool contig, PetscInt *nerr)
+{
+  MPI_Datatype unit;
+  PetscMPIInt  size, rank, owner;
+  PetscInt     nleaves = NBLOCKS * NBLOCK, nleavesx = contig ? nleaves : NLEAVESX, i, j, c, l, r;
+  PetscReal   *rootr = NULL, *leafr = NULL;
+  PetscInt    *rooti = NULL, *leafi = NULL;
+  void        *rootdata, *leafdata;
+  PetscBool    isreal = basic == MPIU_REAL ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)sf), &size));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)sf), &rank));
+  unit = basic;
+  if (bs > 1) {
+    PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, basic, &unit));
+    PetscCallMPI(MPI_Type_commit(&unit));
+  }
+  if (isreal) {
+    PetscCall(PetscMalloc2(NROOTS * bs, &rootr, nleavesx * bs, &leafr));
+    rootdata = rootr;
+    leafdata = leafr;
+  } else {
+    PetscCall(PetscMalloc2(NROOTS * bs, &rooti, nleavesx * bs, &leafi));
+    rootdata = rooti;
+    leafdata = leafi;
+  }
+
+  /* Broadcast the global numbers of the roots */
+  for (r = 0; r < NROOTS * bs; r++) {
+    if (isreal) rootr[r] = rank * NROOTS * bs + r;
+    else rooti[r] = rank * NROOTS * bs + r;
+  }
+  for (l = 0; l < nleavesx * bs; l++) {
+    if (isreal) leafr[l] = -1;
+    else leafi[l] = -1;
+  }
+  PetscCall(PetscSFBcastBegin(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, unit, rootdata, leafdata, MPI_REPLACE));
+  for (i = 0; i < nleaves; i++) {
+    owner = (PetscMPIInt)((rank + i / NBLOCK) % size);
+    l     = contig ? i : LEAF(i);
+    j     = ROOT(i % NBLOCK);
+    for (c = 0; c < bs; c++) {
+      PetscInt expect = owner * NROOTS * bs + j * bs + c;
+
+      *nerr += isreal ? (leafr[l * bs + c] != (PetscReal)expect) : (leafi[l * bs + c] != expect);
+    }
+  }
+
+  /* Each root in a run is the target of one leaf of each block */
+  for (l = 0; l < nleavesx * bs; l++) {
+    if (isreal) leafr[l] = 1 + l % bs;
+    else leafi[l] = 1 + l % bs;
+  }
+  for (r = 0; r < NROOTS * bs; r++) {
+    if (isreal) rootr[r] = 0;
+    else rooti[r] = 0;
+  }
+  PetscCall(PetscSFReduceBegin(sf, unit, leafdata, rootdata, MPI_SUM));
+  PetscCall(PetscSFReduceEnd(sf, unit, leafdata, rootdata, MPI_SUM));
+  for (r = 0; r < NROOTS; r++) {
+    PetscBool used = PETSC_FALSE;
+
+    for (j = 0; j < NBLOCK; j++) used = (used || ROOT(j) == r) ? PETSC_TRUE : PETSC_FALSE;
+    for (c = 0; c < bs; c++) {
+      PetscInt expect = used ? NBLOCKS * (1 + c) : 0;
+
+      *nerr += isreal ? (rootr[r * bs + c] != (PetscReal)expect) : (rooti[r * bs + c] != expect);
+    }
+  }
+  if (isreal) PetscCall(PetscFree2(rootr, leafr));
+  else PetscCall(PetscFree2(rooti, leafi));
+  if (bs > 1) PetscCallMPI(MPI_Type_free(&unit));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscMPIInt  size, rank;
+  PetscInt     bs = 1, nleaves = NBLOCKS * NBLOCK, i, *ilocal = NULL, nerr = 0;
+  PetscSFNode *iremote;
+  PetscBool    contig = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-contiguous_leaves", &contig, NULL));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  if (!contig) PetscCall(PetscMalloc1(nleaves, &ilocal));
+  for (i = 0; i < nleaves; i++) {
+    iremote[i].rank  = (rank + i / NBLOCK) % size;
+    iremote[i].index = ROOT(i % NBLOCK);
+    if (ilocal) ilocal[i] = LEAF(i);
+  }
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetGraph(sf, NROOTS, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetUp(sf));
+
+  PetscCall(TestUnit(sf, MPIU_REAL, bs, contig, &nerr));
+  PetscCall(TestUnit(sf, MPIU_INT, bs, contig, &nerr));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &nerr, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Broadcasts and reductions: %s\n", nerr ? "FAILED" : "ok"));
+
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 3}}
+      args: -bs {{1 3 5}} -contiguous_leaves {{0 1}}
+      output_file: output/ex25_1.out
+
+      test:
+         suffix: 1
+
+      test:
+         suffix: 1_neighbor
+         requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+         args: -sf_type neighbor
+
+TEST*/
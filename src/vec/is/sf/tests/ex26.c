@@ -0,0 +1,107 @@
+static const char help[] = "Tests VecScatterBeginMultiple() and VecScatterEndMultiple() against one VecScatterBegin/End() per vector.\n\n\
+  -nv <nv> : number of vectors scattered together\n\n";
+
+#include <petscvec.h>
+
+int main(int argc, char **argv)
+{
+  VecScatter  sc;
+  IS          ix;
+  Vec         x[4], y[4], xs[4], ys[4];
+  PetscMPIInt size, rank;
+  PetscInt    n = 7, nv = 3, i, j, rstart, *idx;
+  PetscReal   norm, err = 0.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nv", &nv, NULL));
+  PetscCheck(nv >= 1 && nv <= 4, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "-nv must be in [1, 4]");
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+
+  /* Each process gathers n + 2 entries of the parallel vector, some of them from the next process and some twice, into a sequential vector */
+  PetscCall(PetscMalloc1(n + 2, &idx));
+  rstart = ((rank + 1) % size) * n;
+  for (i = 0; i < n; i++) idx[i] = rstart + (3 * i) % n;
+  idx[n]     = rank * n;
+  idx[n + 1] = rstart + 1;
+  PetscCall(ISCreateGeneral(PETSC_COMM_SELF, n + 2, idx, PETSC_OWN_POINTER, &ix));
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecCreateFromOptions(PETSC_COMM_WORLD, NULL, 1, n, PETSC_DECIDE, &x[j]));
+    PetscCall(VecCreateSeq(PETSC_COMM_SELF, n + 2, &y[j]));
+    PetscCall(VecDuplicate(x[j], &xs[j]));
+    PetscCall(VecDuplicate(y[j], &ys[j]));
+  }
+  PetscCall(VecScatterCreate(x[0], ix, y[0], NULL, &sc));
+
+  /* Forward insertion of distinct vectors */
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecSetRandom(x[j], NULL));
+    PetscCall(VecSet(y[j], -1.0));
+    PetscCall(VecSet(ys[j], -1.0));
+  }
+  PetscCall(VecScatterBeginMultiple(sc, nv, x, y, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(VecScatterEndMultiple(sc, nv, x, y, INSERT_VALUES, SCATTER_FORWARD));
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecScatterBegin(sc, x[j], ys[j], INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(sc, x[j], ys[j], INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecAXPY(ys[j], -1.0, y[j]));
+    PetscCall(VecNorm(ys[j], NORM_INFINITY, &norm));
+    err = PetscMax(err, norm);
+  }
+
+  /* Reverse addition, with repeated indices */
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecSetRandom(y[j], NULL));
+    PetscCall(VecSet(x[j], 1.0));
+    PetscCall(VecSet(xs[j], 1.0));
+  }
+  PetscCall(VecScatterBeginMultiple(sc, nv, y, x, ADD_VALUES, SCATTER_REVERSE));
+  PetscCall(VecScatterEndMultiple(sc, nv, y, x, ADD_VALUES, SCATTER_REVERSE));
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecScatterBegin(sc, y[j], xs[j], ADD_VALUES, SCATTER_REVERSE));
+    PetscCall(VecScatterEnd(sc, y[j], xs[j], ADD_VALUES, SCATTER_REVERSE));
+    PetscCall(VecAXPY(xs[j], -1.0, x[j]));
+    PetscCall(VecNorm(xs[j], NORM_INFINITY, &norm));
+    err = PetscMax(err, norm);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &err, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Scatters of %" PetscInt_FMT " vectors together: %s\n", nv, err > 100 * PETSC_MACHINE_EPSILON ? "FAILED" : "ok"));
+
+  for (j = 0; j < nv; j++) {
+    PetscCall(VecDestroy(&x[j]));
+    PetscCall(VecDestroy(&y[j]));
+    PetscCall(VecDestroy(&xs[j]));
+    PetscCall(VecDestroy(&ys[j]));
+  }
+  PetscCall(ISDestroy(&ix));
+  PetscCall(VecScatterDestroy(&sc));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 3}}
+      args: -nv 3
+      output_file: output/ex26_1.out
+
+      test:
+         suffix: 1
+
+      test:
+         suffix: 1_neighbor
+         requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+         args: -sf_type neighbor
+
+      test:
+         suffix: 1_shared_memory
+         requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+         args: -sf_basic_shared_memory
+
+      test:
+         suffix: 1_merge
+         args: -vecscatter_merge
+
+TEST*/
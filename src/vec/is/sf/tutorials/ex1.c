@@ -613,4 +613,11 @@ int main(int argc, char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_basic_shared_memory
+      output_file: output/ex1_10_basic.out
+      nsize: 4
+      args: -sf_type basic -sf_basic_shared_memory -test_all -test_bcastop 0 -test_fetchandop 0
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
 TEST*/
@@ -15,6 +15,13 @@ typedef struct {
   PetscHMapI globalht;
 } ISLocalToGlobalMapping_Hash;
 
+typedef struct {
+  PetscInt  nruns;  /* number of runs of consecutive global indices with consecutive local indices */
+  PetscInt *gstart; /* first global index of each run, in increasing order */
+  PetscInt *lstart; /* local index of the first entry of each run */
+  PetscInt *len;    /* number of entries in each run */
+} ISLocalToGlobalMapping_Runs;
+
 /*@C
   ISGetPointRange - Returns a description of the points in an `IS` suitable for traversal
 
@@ -196,6 +203,50 @@ static PetscErrorCode ISGlobalToLocalMappingSetUp_Hash(ISLocalToGlobalMapping ma
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    The (global, local) pairs are sorted by global index and merged into runs. With repeated global indices the largest local
+    index is kept, which is what the other types do.
+*/
+static PetscErrorCode ISGlobalToLocalMappingSetUp_Runs(ISLocalToGlobalMapping mapping)
+{
+  PetscInt                     i, k, m, r, *idx = mapping->indices, n = mapping->n, *g, *l;
+  ISLocalToGlobalMapping_Runs *map;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&map));
+  PetscCall(PetscMalloc2(n, &g, n, &l));
+  for (i = 0, m = 0; i < n; i++) {
+    if (idx[i] < 0) continue;
+    g[m]   = idx[i];
+    l[m++] = i;
+  }
+  PetscCall(PetscSortIntWithArray(m, g, l));
+  for (i = 0, k = 0; i < m; i++) {
+    if (k && g[k - 1] == g[i]) l[k - 1] = PetscMax(l[k - 1], l[i]);
+    else {
+      g[k]   = g[i];
+      l[k++] = l[i];
+    }
+  }
+  for (i = 0, map->nruns = 0; i < k; i++) {
+    if (!i || g[i] != g[i - 1] + 1 || l[i] != l[i - 1] + 1) map->nruns++;
+  }
+  PetscCall(PetscMalloc3(map->nruns, &map->gstart, map->nruns, &map->lstart, map->nruns, &map->len));
+  for (i = 0, r = -1; i < k; i++) {
+    if (!i || g[i] != g[i - 1] + 1 || l[i] != l[i - 1] + 1) {
+      r++;
+      map->gstart[r] = g[i];
+      map->lstart[r] = l[i];
+      map->len[r]    = 0;
+    }
+    map->len[r]++;
+  }
+  PetscCall(PetscFree2(g, l));
+  PetscCall(PetscInfo(mapping, "Global to local mapping of %" PetscInt_FMT " indices stored as %" PetscInt_FMT " runs\n", n, map->nruns));
+  mapping->data = (void *)map;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode ISLocalToGlobalMappingDestroy_Basic(ISLocalToGlobalMapping mapping)
 {
   ISLocalToGlobalMapping_Basic *map = (ISLocalToGlobalMapping_Basic *)mapping->data;
@@ -218,6 +269,17 @@ static PetscErrorCode ISLocalToGlobalMappingDestroy_Hash(ISLocalToGlobalMapping
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode ISLocalToGlobalMappingDestroy_Runs(ISLocalToGlobalMapping mapping)
+{
+  ISLocalToGlobalMapping_Runs *map = (ISLocalToGlobalMapping_Runs *)mapping->data;
+
+  PetscFunctionBegin;
+  if (!map) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree3(map->gstart, map->lstart, map->len));
+  PetscCall(PetscFree(mapping->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #define GTOLTYPE _Basic
 #define GTOLNAME _Basic
 #define GTOLBS   mapping->bs
@@ -257,6 +319,99 @@ static PetscErrorCode ISLocalToGlobalMappingDestroy_Hash(ISLocalToGlobalMapping
   } while (0)
 #include <../src/vec/is/utils/isltog.h>
 
+/*
+    The run holding g, knowing that gstart[lo] <= g < gstart[hi]. Interpolation steps, which take O(log log nruns) steps
+    on evenly spread runs, are alternated with bisection steps, which bound the cost on skewed runs.
+*/
+static inline PetscInt ISLocalToGlobalMappingRunsSearch_Private(const PetscInt gstart[], PetscInt lo, PetscInt hi, PetscInt g)
+{
+  PetscBool interpolate = PETSC_TRUE;
+
+  while (hi - lo > 1) {
+    PetscInt mid;
+
+    if (interpolate) mid = lo + (PetscInt)((PetscReal)(hi - lo) * ((PetscReal)(g - gstart[lo]) / (PetscReal)(gstart[hi] - gstart[lo])));
+    else mid = lo + (hi - lo) / 2;
+    mid = PetscMin(PetscMax(mid, lo + 1), hi - 1);
+    if (gstart[mid] <= g) lo = mid;
+    else hi = mid;
+    interpolate = (PetscBool)!interpolate;
+  }
+  return lo;
+}
+
+/*
+    The local index of the global index g >= 0, or -1. If *r >= 0, it is a run starting at or before g, from which the search
+    gallops forward, so that resolving sorted indices is one merge pass over the runs; it is updated to the run found.
+*/
+static inline PetscInt ISLocalToGlobalMappingRunsApply_Private(const ISLocalToGlobalMapping_Runs *map, PetscInt bs, PetscInt g, PetscInt *r)
+{
+  const PetscInt *gstart = map->gstart, nruns = map->nruns;
+  PetscInt        gb = g / bs, lo, hi, step = 1;
+
+  if (!nruns || gb < gstart[0]) return -1;
+  if (gb >= gstart[nruns - 1]) lo = nruns - 1;
+  else if (*r < 0) lo = ISLocalToGlobalMappingRunsSearch_Private(gstart, 0, nruns - 1, gb);
+  else {
+    for (lo = *r, hi = lo + 1; gstart[hi] <= gb; step *= 2) {
+      lo = hi;
+      hi = PetscMin(lo + step, nruns - 1);
+    }
+    lo = ISLocalToGlobalMappingRunsSearch_Private(gstart, lo, hi, gb);
+  }
+  *r = lo;
+  if (gb - gstart[lo] >= map->len[lo]) return -1;
+  return bs * (map->lstart[lo] + gb - gstart[lo]) + g % bs;
+}
+
+static PetscErrorCode ISGlobalToLocalMappingApplyRuns_Private(ISLocalToGlobalMapping mapping, PetscInt bs, ISGlobalToLocalMappingMode type, PetscInt n, const PetscInt idx[], PetscInt *nout, PetscInt idxout[])
+{
+  ISLocalToGlobalMapping_Runs *map = (ISLocalToGlobalMapping_Runs *)mapping->data;
+  PetscInt                     i, nf = 0, r = -1, tmp;
+  PetscBool                    sorted;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mapping, IS_LTOGM_CLASSID, 1);
+  if (!map) {
+    PetscCall(ISGlobalToLocalMappingSetUp(mapping));
+    map = (ISLocalToGlobalMapping_Runs *)mapping->data;
+  }
+  if (type == IS_GTOLM_MASK && !idxout) {
+    if (nout) *nout = n;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  /* sorted indices are resolved in one merge pass over the runs, the others are searched one by one */
+  PetscCall(PetscSortedInt(n, idx, &sorted));
+  for (i = 0; i < n; i++) {
+    if (idx[i] < 0) tmp = -1;
+    else {
+      if (!sorted) r = -1;
+      tmp = ISLocalToGlobalMappingRunsApply_Private(map, bs, idx[i], &r);
+    }
+    if (type == IS_GTOLM_MASK) idxout[i] = idx[i] < 0 ? idx[i] : tmp;
+    else if (tmp >= 0) {
+      if (idxout) idxout[nf] = tmp;
+      nf++;
+    }
+  }
+  if (nout) *nout = type == IS_GTOLM_MASK ? n : nf;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ISGlobalToLocalMappingApply_Runs(ISLocalToGlobalMapping mapping, ISGlobalToLocalMappingMode type, PetscInt n, const PetscInt idx[], PetscInt *nout, PetscInt idxout[])
+{
+  PetscFunctionBegin;
+  PetscCall(ISGlobalToLocalMappingApplyRuns_Private(mapping, mapping->bs, type, n, idx, nout, idxout));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode ISGlobalToLocalMappingApplyBlock_Runs(ISLocalToGlobalMapping mapping, ISGlobalToLocalMappingMode type, PetscInt n, const PetscInt idx[], PetscInt *nout, PetscInt idxout[])
+{
+  PetscFunctionBegin;
+  PetscCall(ISGlobalToLocalMappingApplyRuns_Private(mapping, 1, type, n, idx, nout, idxout));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   ISLocalToGlobalMappingDuplicate - Duplicates the local to global mapping object
 
@@ -589,7 +744,8 @@ PetscErrorCode ISLocalToGlobalMappingGetBlockSize(ISLocalToGlobalMapping mapping
 
   For large problems `ISLOCALTOGLOBALMAPPINGHASH` is used, this is scalable.
   Use `ISLocalToGlobalMappingSetType()` or call `ISLocalToGlobalMappingSetFromOptions()` with the option
-  `-islocaltoglobalmapping_type` <`basic`,`hash`> to control which is used.
+  `-islocaltoglobalmapping_type` <`basic`,`hash`,`runs`> to control which is used. `ISLOCALTOGLOBALMAPPINGRUNS` is also scalable, and is
+  faster than `ISLOCALTOGLOBALMAPPINGHASH` when the local indices are numbered mostly in the order of the global indices.
 
 .seealso: [](sec_scatter), `ISLocalToGlobalMapping`, `ISLocalToGlobalMappingDestroy()`, `ISLocalToGlobalMappingCreateIS()`, `ISLocalToGlobalMappingSetFromOptions()`,
           `ISLOCALTOGLOBALMAPPINGBASIC`, `ISLOCALTOGLOBALMAPPINGHASH`
@@ -634,7 +790,7 @@ PetscFunctionList ISLocalToGlobalMappingList = NULL;
 . mapping - mapping data structure
 
   Options Database Key:
-. -islocaltoglobalmapping_type - <basic,hash> nonscalable and scalable versions
+. -islocaltoglobalmapping_type - <basic,hash,runs> nonscalable and scalable versions
 
   Level: advanced
 
@@ -869,7 +1025,8 @@ PetscErrorCode ISLocalToGlobalMappingApplyBlock(ISLocalToGlobalMapping mapping,
   For "small" problems when using `ISGlobalToLocalMappingApply()` and `ISGlobalToLocalMappingApplyBlock()`, the `ISLocalToGlobalMappingType` of
   `ISLOCALTOGLOBALMAPPINGBASIC` will be used;
   this uses more memory but is faster; this approach is not scalable for extremely large mappings. For large problems `ISLOCALTOGLOBALMAPPINGHASH` is used, this is scalable.
-  Use `ISLocalToGlobalMappingSetType()` or call `ISLocalToGlobalMappingSetFromOptions()` with the option -islocaltoglobalmapping_type <basic,hash> to control which is used.
+  Use `ISLocalToGlobalMappingSetType()` or call `ISLocalToGlobalMappingSetFromOptions()` with the option -islocaltoglobalmapping_type <basic,hash,runs> to control which is used.
+  With `ISLOCALTOGLOBALMAPPINGRUNS`, indices given in increasing order are resolved fastest.
 
   Developer Notes:
   The manual page states that `idx` and `idxout` may be identical but the calling
@@ -964,7 +1121,8 @@ PetscErrorCode ISGlobalToLocalMappingApplyIS(ISLocalToGlobalMapping mapping, ISG
   For "small" problems when using `ISGlobalToLocalMappingApply()` and `ISGlobalToLocalMappingApplyBlock()`, the `ISLocalToGlobalMappingType` of
   `ISLOCALTOGLOBALMAPPINGBASIC` will be used;
   this uses more memory but is faster; this approach is not scalable for extremely large mappings. For large problems `ISLOCALTOGLOBALMAPPINGHASH` is used, this is scalable.
-  Use `ISLocalToGlobalMappingSetType()` or call `ISLocalToGlobalMappingSetFromOptions()` with the option -islocaltoglobalmapping_type <basic,hash> to control which is used.
+  Use `ISLocalToGlobalMappingSetType()` or call `ISLocalToGlobalMappingSetFromOptions()` with the option -islocaltoglobalmapping_type <basic,hash,runs> to control which is used.
+  With `ISLOCALTOGLOBALMAPPINGRUNS`, indices given in increasing order are resolved fastest.
 
   Developer Notes:
   The manual page states that `idx` and `idxout` may be identical but the calling
@@ -1892,6 +2050,34 @@ PETSC_EXTERN PetscErrorCode ISLocalToGlobalMappingCreate_Hash(ISLocalToGlobalMap
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*MC
+      ISLOCALTOGLOBALMAPPINGRUNS - implementation of the `ISLocalToGlobalMapping` object that stores the runs of consecutive global
+                                   indices with consecutive local indices. When `ISGlobalToLocalMappingApply()` is used this is good for
+                                   large problems whose local indices are numbered mostly in the order of the global indices.
+
+   Options Database Key:
+.   -islocaltoglobalmapping_type runs - select this method
+
+   Level: beginner
+
+   Notes:
+   The memory used is three integers per run, at most three per local index. A global index is found with an interpolation
+   search of the runs followed by offset arithmetic in its run.
+
+   Global indices given in increasing order, for example after `PetscSortInt()`, are resolved in one merge pass over the runs.
+
+.seealso: [](sec_scatter), `ISLocalToGlobalMappingCreate()`, `ISLocalToGlobalMappingSetType()`, `ISLOCALTOGLOBALMAPPINGBASIC`, `ISLOCALTOGLOBALMAPPINGHASH`
+M*/
+PETSC_EXTERN PetscErrorCode ISLocalToGlobalMappingCreate_Runs(ISLocalToGlobalMapping ltog)
+{
+  PetscFunctionBegin;
+  ltog->ops->globaltolocalmappingapply      = ISGlobalToLocalMappingApply_Runs;
+  ltog->ops->globaltolocalmappingsetup      = ISGlobalToLocalMappingSetUp_Runs;
+  ltog->ops->globaltolocalmappingapplyblock = ISGlobalToLocalMappingApplyBlock_Runs;
+  ltog->ops->destroy                        = ISLocalToGlobalMappingDestroy_Runs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   ISLocalToGlobalMappingRegister -  Registers a method for applying a global to local mapping with an `ISLocalToGlobalMapping`
 
@@ -2022,5 +2208,6 @@ PetscErrorCode ISLocalToGlobalMappingRegisterAll(void)
   ISLocalToGlobalMappingRegisterAllCalled = PETSC_TRUE;
   PetscCall(ISLocalToGlobalMappingRegister(ISLOCALTOGLOBALMAPPINGBASIC, ISLocalToGlobalMappingCreate_Basic));
   PetscCall(ISLocalToGlobalMappingRegister(ISLOCALTOGLOBALMAPPINGHASH, ISLocalToGlobalMappingCreate_Hash));
+  PetscCall(ISLocalToGlobalMappingRegister(ISLOCALTOGLOBALMAPPINGRUNS, ISLocalToGlobalMappingCreate_Runs));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
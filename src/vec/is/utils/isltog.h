@@ -25,7 +25,11 @@ static PetscErrorCode PETSCMAPNAME(ISGlobalToLocalMappingApply)(ISLocalToGlobalM
         if (idx[i] < 0) idxout[i] = idx[i];
         else if (idx[i] < bs * start) idxout[i] = -1;
         else if (idx[i] > bs * (end + 1) - 1) idxout[i] = -1;
-        else GTOL(idx[i], idxout[i]);
+        else {
+          /* idx and idxout may be the same array */
+          GTOL(idx[i], tmp);
+          idxout[i] = tmp;
+        }
       }
     }
     if (nout) *nout = n;
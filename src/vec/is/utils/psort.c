@@ -2,168 +2,68 @@
 #include <petsc/private/petscimpl.h>
 #include <petscis.h> /*I "petscis.h" I*/
 
-/* This is the bitonic merge that works on non-power-of-2 sizes found at http://www.iti.fh-flensburg.de/lang/algorithmen/sortieren/bitonic/oddn.htm */
-static PetscErrorCode PetscParallelSortInt_Bitonic_Merge(MPI_Comm comm, PetscMPIInt tag, PetscMPIInt rankStart, PetscMPIInt rankEnd, PetscMPIInt rank, PetscMPIInt n, PetscInt keys[], PetscInt buffer[], PetscBool forward)
-{
-  PetscInt diff;
-  PetscInt split, mid, partner;
-
-  PetscFunctionBegin;
-  diff = rankEnd - rankStart;
-  if (diff <= 0) PetscFunctionReturn(PETSC_SUCCESS);
-  if (diff == 1) {
-    if (forward) {
-      PetscCall(PetscSortInt((PetscInt)n, keys));
-    } else {
-      PetscCall(PetscSortReverseInt((PetscInt)n, keys));
-    }
-    PetscFunctionReturn(PETSC_SUCCESS);
-  }
-  split = 1;
-  while (2 * split < diff) split *= 2;
-  mid = rankStart + split;
-  if (rank < mid) {
-    partner = rank + split;
-  } else {
-    partner = rank - split;
-  }
-  if (partner < rankEnd) {
-    PetscMPIInt i;
-
-    PetscCallMPI(MPI_Sendrecv(keys, n, MPIU_INT, partner, tag, buffer, n, MPIU_INT, partner, tag, comm, MPI_STATUS_IGNORE));
-    if ((rank < partner) == (forward == PETSC_TRUE)) {
-      for (i = 0; i < n; i++) keys[i] = (keys[i] <= buffer[i]) ? keys[i] : buffer[i];
-    } else {
-      for (i = 0; i < n; i++) keys[i] = (keys[i] > buffer[i]) ? keys[i] : buffer[i];
-    }
-  }
-  /* divide and conquer */
-  if (rank < mid) {
-    PetscCall(PetscParallelSortInt_Bitonic_Merge(comm, tag, rankStart, mid, rank, n, keys, buffer, forward));
-  } else {
-    PetscCall(PetscParallelSortInt_Bitonic_Merge(comm, tag, mid, rankEnd, rank, n, keys, buffer, forward));
-  }
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
+#if defined(PETSC_USE_64BIT_INDICES)
+typedef uint64_t PetscUInt_Private;
+#else
+typedef uint32_t PetscUInt_Private;
+#endif
 
-/* This is the bitonic sort that works on non-power-of-2 sizes found at http://www.iti.fh-flensburg.de/lang/algorithmen/sortieren/bitonic/oddn.htm */
-static PetscErrorCode PetscParallelSortInt_Bitonic_Recursive(MPI_Comm comm, PetscMPIInt tag, PetscMPIInt rankStart, PetscMPIInt rankEnd, PetscMPIInt rank, PetscMPIInt n, PetscInt keys[], PetscInt buffer[], PetscBool forward)
+/* Number of the nsorted keys smaller than key */
+static inline PetscInt PetscParallelSortCountSmaller_Private(PetscInt key, PetscInt n, const PetscInt sorted[])
 {
-  PetscInt diff;
-  PetscInt mid;
-
-  PetscFunctionBegin;
-  diff = rankEnd - rankStart;
-  if (diff <= 0) PetscFunctionReturn(PETSC_SUCCESS);
-  if (diff == 1) {
-    if (forward) {
-      PetscCall(PetscSortInt(n, keys));
-    } else {
-      PetscCall(PetscSortReverseInt(n, keys));
-    }
-    PetscFunctionReturn(PETSC_SUCCESS);
-  }
-  mid = rankStart + diff / 2;
-  /* divide and conquer */
-  if (rank < mid) {
-    PetscCall(PetscParallelSortInt_Bitonic_Recursive(comm, tag, rankStart, mid, rank, n, keys, buffer, (PetscBool)!forward));
-  } else {
-    PetscCall(PetscParallelSortInt_Bitonic_Recursive(comm, tag, mid, rankEnd, rank, n, keys, buffer, forward));
-  }
-  /* bitonic merge */
-  PetscCall(PetscParallelSortInt_Bitonic_Merge(comm, tag, rankStart, rankEnd, rank, n, keys, buffer, forward));
-  PetscFunctionReturn(PETSC_SUCCESS);
-}
+  PetscInt lo = 0, hi = n;
 
-static PetscErrorCode PetscParallelSortInt_Bitonic(MPI_Comm comm, PetscInt n, PetscInt keys[])
-{
-  PetscMPIInt size, rank, tag, mpin;
-  PetscInt   *buffer;
+  while (lo < hi) {
+    PetscInt mid = lo + (hi - lo) / 2;
 
-  PetscFunctionBegin;
-  PetscAssertPointer(keys, 3);
-  PetscCall(PetscCommGetNewTag(comm, &tag));
-  PetscCallMPI(MPI_Comm_size(comm, &size));
-  PetscCallMPI(MPI_Comm_rank(comm, &rank));
-  PetscCall(PetscMPIIntCast(n, &mpin));
-  PetscCall(PetscMalloc1(n, &buffer));
-  PetscCall(PetscParallelSortInt_Bitonic_Recursive(comm, tag, 0, size, rank, mpin, keys, buffer, PETSC_TRUE));
-  PetscCall(PetscFree(buffer));
-  PetscFunctionReturn(PETSC_SUCCESS);
+    if (sorted[mid] < key) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
 }
 
+/*
+  Choose the P - 1 splitters that divide the keys as mapout does: splitter i is the smallest key value v such that at least
+  mapout->range[i + 1] keys are smaller than v. All splitters are found together by bisection on the key values, each round
+  sampling the global histogram of the candidate splitters with one reduction of length P - 1
+*/
 static PetscErrorCode PetscParallelSampleSelect(PetscLayout mapin, PetscLayout mapout, PetscInt keysin[], PetscInt *outpivots[])
 {
-  PetscMPIInt  size, rank;
-  PetscInt    *pivots, *finalpivots, i;
-  PetscInt     non_empty, my_first, count;
-  PetscMPIInt *keys_per, max_keys_per;
+  PetscMPIInt size;
+  PetscInt   *lo, *hi, *mid, *counts, minmax[2], i, nactive, nrounds = 0;
 
   PetscFunctionBegin;
   PetscCallMPI(MPI_Comm_size(mapin->comm, &size));
-  PetscCallMPI(MPI_Comm_rank(mapin->comm, &rank));
+  PetscCall(PetscMalloc4(size - 1, &lo, size - 1, &hi, size - 1, &mid, size - 1, &counts));
 
-  /* Choose P - 1 pivots that would be ideal for the distribution on this process */
-  PetscCall(PetscMalloc1(size - 1, &pivots));
+  /* the keys are sorted locally, so the bisection starts from the range of all keys */
+  minmax[0] = mapin->n ? keysin[0] : PETSC_MAX_INT;
+  minmax[1] = mapin->n ? keysin[mapin->n - 1] : PETSC_MIN_INT;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &minmax[0], 1, MPIU_INT, MPI_MIN, mapin->comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &minmax[1], 1, MPIU_INT, MPI_MAX, mapin->comm));
   for (i = 0; i < size - 1; i++) {
-    PetscInt index;
-
-    if (!mapin->n) {
-      /* if this rank is empty, put "infinity" in the list.  each process knows how many empty
-       * processes are in the layout, so those values will be ignored from the end of the sorted
-       * pivots */
-      pivots[i] = PETSC_MAX_INT;
-    } else {
-      /* match the distribution to the desired output described by mapout by getting the index
-       * that is approximately the appropriate fraction through the list */
-      index     = ((PetscReal)mapout->range[i + 1]) * ((PetscReal)mapin->n) / ((PetscReal)mapout->N);
-      index     = PetscMin(index, (mapin->n - 1));
-      index     = PetscMax(index, 0);
-      pivots[i] = keysin[index];
-    }
+    lo[i] = minmax[0];
+    hi[i] = mapout->N ? minmax[1] : minmax[0];
   }
-  /* sort the pivots in parallel */
-  PetscCall(PetscParallelSortInt_Bitonic(mapin->comm, size - 1, pivots));
-  if (PetscDefined(USE_DEBUG)) {
-    PetscBool sorted;
-
-    PetscCall(PetscParallelSortedInt(mapin->comm, size - 1, pivots, &sorted));
-    PetscCheck(sorted, mapin->comm, PETSC_ERR_PLIB, "bitonic sort failed");
-  }
-
-  /* if there are Z nonempty processes, we have (P - 1) * Z real pivots, and we want to select
-   * at indices Z - 1, 2*Z - 1, ... (P - 1) * Z - 1 */
-  non_empty = size;
-  for (i = 0; i < size; i++)
-    if (mapout->range[i] == mapout->range[i + 1]) non_empty--;
-  PetscCall(PetscCalloc1(size + 1, &keys_per));
-  my_first = -1;
-  if (non_empty) {
+  for (nactive = size - 1; nactive;) {
+    /* the midpoint is computed in unsigned arithmetic, since hi - lo may overflow */
     for (i = 0; i < size - 1; i++) {
-      size_t sample      = (i + 1) * non_empty - 1;
-      size_t sample_rank = sample / (size - 1);
-
-      keys_per[sample_rank]++;
-      if (my_first < 0 && (PetscMPIInt)sample_rank == rank) my_first = (PetscInt)(sample - sample_rank * (size - 1));
+      mid[i]    = (PetscInt)((PetscUInt_Private)lo[i] + (((PetscUInt_Private)hi[i] - (PetscUInt_Private)lo[i]) >> 1));
+      counts[i] = lo[i] < hi[i] ? PetscParallelSortCountSmaller_Private(mid[i], mapin->n, keysin) : 0;
     }
-  }
-  for (i = 0, max_keys_per = 0; i < size; i++) max_keys_per = PetscMax(keys_per[i], max_keys_per);
-  PetscCall(PetscMalloc1(size * max_keys_per, &finalpivots));
-  /* now that we know how many pivots each process will provide, gather the selected pivots at the start of the array
-   * and allgather them */
-  for (i = 0; i < keys_per[rank]; i++) pivots[i] = pivots[my_first + i * non_empty];
-  for (i = keys_per[rank]; i < max_keys_per; i++) pivots[i] = PETSC_MAX_INT;
-  PetscCallMPI(MPI_Allgather(pivots, max_keys_per, MPIU_INT, finalpivots, max_keys_per, MPIU_INT, mapin->comm));
-  for (i = 0, count = 0; i < size; i++) {
-    PetscInt j;
-
-    for (j = 0; j < max_keys_per; j++) {
-      if (j < keys_per[i]) finalpivots[count++] = finalpivots[i * max_keys_per + j];
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, counts, size - 1, MPIU_INT, MPI_SUM, mapin->comm));
+    for (i = 0, nactive = 0; i < size - 1; i++) {
+      if (lo[i] == hi[i]) continue;
+      if (counts[i] >= mapout->range[i + 1]) hi[i] = mid[i];
+      else lo[i] = mid[i] + 1;
+      if (lo[i] < hi[i]) nactive++;
     }
+    nrounds++;
   }
-  *outpivots = finalpivots;
-  PetscCall(PetscFree(keys_per));
-  PetscCall(PetscFree(pivots));
+  PetscCall(PetscInfo(NULL, "Found %d splitters in %" PetscInt_FMT " rounds\n", size - 1, nrounds));
+  PetscCall(PetscMalloc1(size - 1, outpivots));
+  PetscCall(PetscArraycpy(*outpivots, lo, size - 1));
+  PetscCall(PetscFree4(lo, hi, mid, counts));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -179,18 +79,20 @@ static PetscErrorCode PetscParallelRedistribute(PetscLayout map, PetscInt n, Pet
   MPI_Request *firstreqs;
   MPI_Request *secondreqs;
   MPI_Status   firststatus;
+  MPI_Comm     comm;
 
   PetscFunctionBegin;
-  PetscCallMPI(MPI_Comm_size(map->comm, &size));
-  PetscCallMPI(MPI_Comm_rank(map->comm, &rank));
-  PetscCall(PetscCommGetNewTag(map->comm, &firsttag));
-  PetscCall(PetscCommGetNewTag(map->comm, &secondtag));
+  /* the layout may live on any communicator, so take the tags from the PETSc communicator attached to it */
+  PetscCall(PetscCommDuplicate(map->comm, &comm, &firsttag));
+  PetscCall(PetscCommGetNewTag(comm, &secondtag));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
   myOffset = 0;
   PetscCall(PetscMalloc2(size, &firstreqs, size, &secondreqs));
-  PetscCallMPI(MPI_Scan(&n, &nextOffset, 1, MPIU_INT, MPI_SUM, map->comm));
+  PetscCallMPI(MPI_Scan(&n, &nextOffset, 1, MPIU_INT, MPI_SUM, comm));
   myOffset = nextOffset - n;
   total    = map->range[rank + 1] - map->range[rank];
-  if (total > 0) PetscCallMPI(MPI_Irecv(arrayout, total, MPIU_INT, MPI_ANY_SOURCE, firsttag, map->comm, &firstreqrcv));
+  if (total > 0) PetscCallMPI(MPI_Irecv(arrayout, total, MPIU_INT, MPI_ANY_SOURCE, firsttag, comm, &firstreqrcv));
   for (i = 0, nsecond = 0, nfirst = 0; i < size; i++) {
     PetscInt itotal;
     PetscInt overlap, oStart, oEnd;
@@ -202,13 +104,13 @@ static PetscErrorCode PetscParallelRedistribute(PetscLayout map, PetscInt n, Pet
     overlap = oEnd - oStart;
     if (map->range[i] >= myOffset && map->range[i] < nextOffset) {
       /* send first message */
-      PetscCallMPI(MPI_Isend(&arrayin[map->range[i] - myOffset], overlap, MPIU_INT, i, firsttag, map->comm, &(firstreqs[nfirst++])));
+      PetscCallMPI(MPI_Isend(&arrayin[map->range[i] - myOffset], overlap, MPIU_INT, i, firsttag, comm, &(firstreqs[nfirst++])));
     } else if (overlap > 0) {
       /* send second message */
-      PetscCallMPI(MPI_Isend(&arrayin[oStart - myOffset], overlap, MPIU_INT, i, secondtag, map->comm, &(secondreqs[nsecond++])));
+      PetscCallMPI(MPI_Isend(&arrayin[oStart - myOffset], overlap, MPIU_INT, i, secondtag, comm, &(secondreqs[nsecond++])));
     } else if (overlap == 0 && myOffset > map->range[i] && myOffset < map->range[i + 1]) {
       /* send empty second message */
-      PetscCallMPI(MPI_Isend(&arrayin[oStart - myOffset], 0, MPIU_INT, i, secondtag, map->comm, &(secondreqs[nsecond++])));
+      PetscCallMPI(MPI_Isend(&arrayin[oStart - myOffset], 0, MPIU_INT, i, secondtag, comm, &(secondreqs[nsecond++])));
     }
   }
   filled = 0;
@@ -223,13 +125,14 @@ static PetscErrorCode PetscParallelRedistribute(PetscLayout map, PetscInt n, Pet
     MPI_Status  stat;
 
     sender++;
-    PetscCallMPI(MPI_Recv(&arrayout[filled], total - filled, MPIU_INT, sender, secondtag, map->comm, &stat));
+    PetscCallMPI(MPI_Recv(&arrayout[filled], total - filled, MPIU_INT, sender, secondtag, comm, &stat));
     PetscCallMPI(MPI_Get_count(&stat, MPIU_INT, &mfilled));
     filled += mfilled;
   }
   PetscCallMPI(MPI_Waitall(nfirst, firstreqs, MPI_STATUSES_IGNORE));
   PetscCallMPI(MPI_Waitall(nsecond, secondreqs, MPI_STATUSES_IGNORE));
   PetscCall(PetscFree2(firstreqs, secondreqs));
+  PetscCall(PetscCommDestroy(&comm));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -308,7 +211,8 @@ static PetscErrorCode PetscParallelSortInt_Samplesort(PetscLayout mapin, PetscLa
   global size N, and global number of MPI processes P, does\:
 .vb
   - sorts locally
-  - chooses pivots by sorting (in parallel) (P-1) pivot suggestions from each process using bitonic sort and allgathering a subset of (P-1) of those
+  - chooses the (P-1) pivots by bisection on the key values, counting at each step the keys smaller than each candidate pivot
+    with one reduction of length (P-1), so that the pivots split the keys as mapout does
   - using to the pivots to repartition the keys by all-to-all exchange
   - sorting the repartitioned keys locally (the array is now globally sorted, but does not match the mapout layout)
   - redistributing to match the mapout layout
@@ -19,6 +19,9 @@ typedef struct {
   PetscCount *perm1; /* [tot1]: The permutation array in sorting coo_i[] */
 } Vec_Seq;
 
+/* number of PetscScalar in the 64 bytes each array of VecDuplicateVecsContiguous_Private() is padded to */
+#define VEC_DUPLICATEVECS_ALIGN PetscMax(64 / (PetscInt)sizeof(PetscScalar), 1)
+
 PETSC_INTERN PetscErrorCode VecMaxPointwiseDivide_Seq(Vec, Vec, PetscReal *);
 PETSC_INTERN PetscErrorCode VecReplaceArray_Seq(Vec, const PetscScalar *);
 PETSC_INTERN PetscErrorCode VecDuplicate_Seq(Vec, Vec *);
@@ -40,6 +43,14 @@ PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_Seq(Vec, PetscInt, const Vec[
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_Seq(Vec, PetscInt, const Vec[], PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecSet_Seq(Vec, PetscScalar);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPY_Seq(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_Seq_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_Seq_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPY_Seq_GEMV(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecDuplicateVecs_Seq_GEMV(Vec, PetscInt, Vec *[]);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecSetUseGEMV_Seq(Vec, PetscBool, PetscBool);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecDuplicateVecsContiguous_Private(PetscInt, PetscInt, PetscContainer *, PetscScalar **, PetscInt *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMSubtractNorm_Seq(Vec, PetscInt, const PetscScalar *, const Vec *, PetscReal *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDotMAXPYNorm_Seq(Vec, PetscInt, const Vec[], PetscScalar *, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAYPX_Seq(Vec, PetscScalar, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecWAXPY_Seq(Vec, PetscScalar, Vec, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAXPBYPCZ_Seq(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
@@ -53,6 +53,41 @@ PetscErrorCode VecDuplicate_MPI(Vec win, Vec *v)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecDuplicateVecs_MPI_GEMV(Vec w, PetscInt m, Vec *V[])
+{
+  Vec_MPI       *wmpi = (Vec_MPI *)w->data;
+  PetscContainer container;
+  PetscScalar   *array;
+  PetscInt       lda;
+  PetscBool      ismpi;
+
+  PetscFunctionBegin;
+  /* ghosted vectors and subtypes that only inherit the operations, e.g. device vectors, have their own storage */
+  PetscCall(PetscObjectTypeCompare((PetscObject)w, VECMPI, &ismpi));
+  if (!ismpi || wmpi->nghost || wmpi->localrep || w->ops->duplicate != VecDuplicate_MPI) {
+    PetscCall(VecDuplicateVecs_Default(w, m, V));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc1(m, V));
+  PetscCall(VecDuplicateVecsContiguous_Private(w->map->n, m, &container, &array, &lda));
+  for (PetscInt i = 0; i < m; i++) {
+    Vec v;
+
+    PetscCall(VecCreateWithLayout_Private(w->map, &v));
+    PetscCall(VecCreate_MPI_Private(v, PETSC_FALSE, 0, array + i * lda));
+    v->ops[0] = w->ops[0];
+    PetscCall(PetscObjectListDuplicate(((PetscObject)w)->olist, &((PetscObject)v)->olist));
+    PetscCall(PetscFunctionListDuplicate(((PetscObject)w)->qlist, &((PetscObject)v)->qlist));
+    PetscCall(PetscObjectCompose((PetscObject)v, "VecDuplicateVecs_array", (PetscObject)container));
+    v->stash.donotstash   = w->stash.donotstash;
+    v->stash.ignorenegidx = w->stash.ignorenegidx;
+    v->bstash.bs          = w->bstash.bs;
+    (*V)[i]               = v;
+  }
+  PetscCall(PetscContainerDestroy(&container));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode VecSetOption_MPI(Vec V, VecOption op, PetscBool flag)
 {
   Vec_MPI *v = (Vec_MPI *)V->data;
@@ -344,24 +379,67 @@ PetscErrorCode VecAssemblyReset_MPI(Vec X)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Switches the operations of a VECMPI vector between the BLAS gemv versions and the default ones; the operations replaced
+   with VecSetOperation() are kept
+*/
+static PetscErrorCode VecSetUseGEMV_MPI(Vec X, PetscBool mdot, PetscBool maxpy)
+{
+  PetscFunctionBegin;
+  if (X->ops->duplicatevecs == VecDuplicateVecs_Default || X->ops->duplicatevecs == VecDuplicateVecs_MPI_GEMV) X->ops->duplicatevecs = mdot || maxpy ? VecDuplicateVecs_MPI_GEMV : VecDuplicateVecs_Default;
+  if (X->ops->mdot == VecMDot_MPI || X->ops->mdot == VecMDot_MPI_GEMV) X->ops->mdot = mdot ? VecMDot_MPI_GEMV : VecMDot_MPI;
+  if (X->ops->mdot_local == VecMDot_Seq || X->ops->mdot_local == VecMDot_Seq_GEMV) X->ops->mdot_local = mdot ? VecMDot_Seq_GEMV : VecMDot_Seq;
+  if (X->ops->mtdot == VecMTDot_MPI || X->ops->mtdot == VecMTDot_MPI_GEMV) X->ops->mtdot = mdot ? VecMTDot_MPI_GEMV : VecMTDot_MPI;
+  if (X->ops->mtdot_local == VecMTDot_Seq || X->ops->mtdot_local == VecMTDot_Seq_GEMV) X->ops->mtdot_local = mdot ? VecMTDot_Seq_GEMV : VecMTDot_Seq;
+  if (X->ops->maxpy == VecMAXPY_Seq || X->ops->maxpy == VecMAXPY_Seq_GEMV) X->ops->maxpy = maxpy ? VecMAXPY_Seq_GEMV : VecMAXPY_Seq;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   VecSetUseGEMV_Private - Switches a `VECSEQ` or `VECMPI` vector, and the vectors later obtained from it with `VecDuplicate()`
+   and `VecDuplicateVecs()`, to the BLAS gemv versions of `VecMDot()` and `VecMTDot()` (mdot) and of `VecMAXPY()` (maxpy),
+   like `-vec_mdot_use_gemv` and `-vec_maxpy_use_gemv`. Other types and the operations replaced with `VecSetOperation()` are left alone.
+*/
+PetscErrorCode VecSetUseGEMV_Private(Vec v, PetscBool mdot, PetscBool maxpy)
+{
+  PetscBool isseq, ismpi;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 1);
+  PetscCall(PetscObjectTypeCompare((PetscObject)v, VECSEQ, &isseq));
+  PetscCall(PetscObjectTypeCompare((PetscObject)v, VECMPI, &ismpi));
+  if (isseq) PetscCall(VecSetUseGEMV_Seq(v, mdot, maxpy));
+  else if (ismpi) PetscCall(VecSetUseGEMV_MPI(v, mdot, maxpy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode VecSetFromOptions_MPI(Vec X, PetscOptionItems *PetscOptionsObject)
 {
+  PetscBool ismpi, mdot = (PetscBool)(X->ops->mdot == VecMDot_MPI_GEMV), maxpy = (PetscBool)(X->ops->maxpy == VecMAXPY_Seq_GEMV), set_mdot, set_maxpy;
 #if !defined(PETSC_HAVE_MPIUNI)
   PetscBool flg = PETSC_FALSE, set;
+#endif
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "VecMPI Options");
+#if !defined(PETSC_HAVE_MPIUNI)
   PetscCall(PetscOptionsBool("-vec_assembly_legacy", "Use MPI 1 version of assembly", "", flg, &flg, &set));
   if (set) {
     X->ops->assemblybegin = flg ? VecAssemblyBegin_MPI : VecAssemblyBegin_MPI_BTS;
     X->ops->assemblyend   = flg ? VecAssemblyEnd_MPI : VecAssemblyEnd_MPI_BTS;
   }
-  PetscOptionsHeadEnd();
 #else
-  PetscFunctionBegin;
   X->ops->assemblybegin = VecAssemblyBegin_MPI;
   X->ops->assemblyend   = VecAssemblyEnd_MPI;
 #endif
+  /* subtypes that only inherit the operations, e.g. device vectors, keep their own */
+  PetscCall(PetscObjectTypeCompare((PetscObject)X, VECMPI, &ismpi));
+  if (ismpi) {
+    PetscCall(PetscOptionsBool("-vec_mdot_use_gemv", "Store VecDuplicateVecs() contiguously and use BLAS gemv in VecMDot()", "VecMDot", mdot, &mdot, &set_mdot));
+    PetscCall(PetscOptionsBool("-vec_maxpy_use_gemv", "Store VecDuplicateVecs() contiguously and use BLAS gemv in VecMAXPY()", "VecMAXPY", maxpy, &maxpy, &set_maxpy));
+    if (set_mdot || set_maxpy) PetscCall(VecSetUseGEMV_MPI(X, mdot, maxpy));
+  }
+  PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -453,7 +531,9 @@ static struct _VecOps DvOps = {PetscDesignatedInitializer(duplicate, VecDuplicat
                                PetscDesignatedInitializer(sum, NULL),
                                PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_MPI),
                                PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_MPI),
-                               PetscDesignatedInitializer(errorwnorm, NULL)};
+                               PetscDesignatedInitializer(errorwnorm, NULL),
+                               PetscDesignatedInitializer(maxpby, NULL),
+                               PetscDesignatedInitializer(mdotmaxpynorm, VecMDotMAXPYNorm_MPI)};
 
 /*
     VecCreate_MPI_Private - Basic create routine called by VecCreate_MPI() (i.e. VecCreateMPI()),
@@ -481,7 +561,7 @@ PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, co
   s->array_allocated = NULL;
   if (alloc && !array) {
     PetscInt n = v->map->n + nghost;
-    PetscCall(PetscCalloc1(n, &s->array));
+    PetscCall(VecCallocArray_Private(n, &s->array));
     s->array_allocated = s->array;
     PetscCall(PetscObjectComposedDataSetReal((PetscObject)v, NormIds[NORM_2], 0));
     PetscCall(PetscObjectComposedDataSetReal((PetscObject)v, NormIds[NORM_1], 0));
@@ -511,8 +591,11 @@ PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, co
 /*MC
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
-   Options Database Key:
-. -vec_type mpi - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+   Options Database Keys:
++ -vec_type mpi        - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+. -vec_omp_first_touch - zero the local arrays from the OpenMP threads, see `VECSEQ`
+. -vec_mdot_use_gemv   - store the local parts of `VecDuplicateVecs()` contiguously and use BLAS gemv in `VecMDot()`, see `VECSEQ`
+- -vec_maxpy_use_gemv  - same for `VecMAXPY()`
 
   Level: beginner
 
@@ -33,6 +33,20 @@ PetscErrorCode VecMTDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecMDot_MPI_GEMV(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_MPI_Default(xin, nv, y, z, VecMDot_Seq_GEMV));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMTDot_MPI_GEMV(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_MPI_Default(xin, nv, y, z, VecMTDot_Seq_GEMV));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecNorm_MPI(Vec xin, NormType type, PetscReal *z)
 {
   PetscFunctionBegin;
@@ -40,6 +54,35 @@ PetscErrorCode VecNorm_MPI(Vec xin, NormType type, PetscReal *z)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The dot products are summed in one reduction, then the local square of the norm of the updated x is computed while the last
+   entries are subtracted and summed in a second reduction
+*/
+PetscErrorCode VecMDotMAXPYNorm_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z, PetscReal *nrm)
+{
+  PetscBool finite = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  if ((xin->ops->mdot != VecMDot_MPI && xin->ops->mdot != VecMDot_MPI_GEMV) || (xin->ops->maxpy != VecMAXPY_Seq && xin->ops->maxpy != VecMAXPY_Seq_GEMV)) {
+    PetscCall(VecMDotMAXPYNorm_Default(xin, nv, y, z, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(xin->ops->mdot(xin, nv, y, z));
+  for (PetscInt j = 0; j < nv; ++j) finite = (PetscBool)(finite && !PetscIsInfOrNanScalar(z[j]));
+  if (!finite) {
+    /* x is left unchanged if a dot product is Inf or NaN, so that the caller can check them before x is lost */
+    if (nrm) PetscCall(VecNorm_MPI(xin, NORM_2, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecMSubtractNorm_Seq(xin, nv, z, y, nrm));
+  if (nrm) {
+    *nrm *= *nrm;
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, nrm, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)xin)));
+    *nrm = PetscSqrtReal(*nrm);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecMax_MPI(Vec xin, PetscInt *idx, PetscReal *z)
 {
   const MPI_Op ops[] = {MPIU_MAXLOC, MPIU_MAX};
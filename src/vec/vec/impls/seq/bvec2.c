@@ -748,6 +748,97 @@ PetscErrorCode VecDuplicate_Seq(Vec win, Vec *V)
 
   (*V)->ops->view          = win->ops->view;
   (*V)->stash.ignorenegidx = win->stash.ignorenegidx;
+  /* keep the choice of -vec_mdot_use_gemv and -vec_maxpy_use_gemv */
+  if (win->ops->duplicatevecs == VecDuplicateVecs_Seq_GEMV) {
+    (*V)->ops->duplicatevecs = win->ops->duplicatevecs;
+    (*V)->ops->mdot          = win->ops->mdot;
+    (*V)->ops->mdot_local    = win->ops->mdot_local;
+    (*V)->ops->mtdot         = win->ops->mtdot;
+    (*V)->ops->mtdot_local   = win->ops->mtdot_local;
+    (*V)->ops->maxpy         = win->ops->maxpy;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Allocates the arrays of m vectors of local length n one after the other, each padded to a multiple of 64 bytes, so that
+   VecMDot() and VecMAXPY() can treat them as a column-major matrix with leading dimension lda. The storage is owned by a
+   container that every vector references, hence it is freed with the last vector whatever the order of destruction.
+*/
+PetscErrorCode VecDuplicateVecsContiguous_Private(PetscInt n, PetscInt m, PetscContainer *container, PetscScalar **array, PetscInt *lda)
+{
+  const PetscInt align = VEC_DUPLICATEVECS_ALIGN;
+
+  PetscFunctionBegin;
+  *lda = ((n + align - 1) / align) * align;
+  PetscCall(PetscCalloc1(m * (size_t)*lda, array));
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, container));
+  PetscCall(PetscContainerSetPointer(*container, *array));
+  PetscCall(PetscContainerSetUserDestroy(*container, PetscContainerUserDestroyDefault));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecDuplicateVecs_Seq_GEMV(Vec w, PetscInt m, Vec *V[])
+{
+  PetscContainer container;
+  PetscScalar   *array;
+  PetscInt       lda;
+  PetscBool      isseq;
+
+  PetscFunctionBegin;
+  /* subtypes that only inherit the operations, e.g. device vectors, have their own storage */
+  PetscCall(PetscObjectTypeCompare((PetscObject)w, VECSEQ, &isseq));
+  if (!isseq || w->ops->duplicate != VecDuplicate_Seq) {
+    PetscCall(VecDuplicateVecs_Default(w, m, V));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc1(m, V));
+  PetscCall(VecDuplicateVecsContiguous_Private(w->map->n, m, &container, &array, &lda));
+  for (PetscInt i = 0; i < m; i++) {
+    Vec v;
+
+    PetscCall(VecCreateWithLayout_Private(w->map, &v));
+    PetscCall(VecCreate_Seq_Private(v, array + i * lda));
+    v->ops[0] = w->ops[0];
+    PetscCall(PetscObjectListDuplicate(((PetscObject)w)->olist, &((PetscObject)v)->olist));
+    PetscCall(PetscFunctionListDuplicate(((PetscObject)w)->qlist, &((PetscObject)v)->qlist));
+    PetscCall(PetscObjectCompose((PetscObject)v, "VecDuplicateVecs_array", (PetscObject)container));
+    v->stash.ignorenegidx = w->stash.ignorenegidx;
+    (*V)[i]               = v;
+  }
+  PetscCall(PetscContainerDestroy(&container));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Switches the operations of a VECSEQ vector between the BLAS gemv versions and the default ones; the operations replaced
+   with VecSetOperation() are kept
+*/
+PetscErrorCode VecSetUseGEMV_Seq(Vec v, PetscBool mdot, PetscBool maxpy)
+{
+  PetscFunctionBegin;
+  if (v->ops->duplicatevecs == VecDuplicateVecs_Default || v->ops->duplicatevecs == VecDuplicateVecs_Seq_GEMV) v->ops->duplicatevecs = mdot || maxpy ? VecDuplicateVecs_Seq_GEMV : VecDuplicateVecs_Default;
+  if (v->ops->mdot == VecMDot_Seq || v->ops->mdot == VecMDot_Seq_GEMV) v->ops->mdot = mdot ? VecMDot_Seq_GEMV : VecMDot_Seq;
+  if (v->ops->mdot_local == VecMDot_Seq || v->ops->mdot_local == VecMDot_Seq_GEMV) v->ops->mdot_local = mdot ? VecMDot_Seq_GEMV : VecMDot_Seq;
+  if (v->ops->mtdot == VecMTDot_Seq || v->ops->mtdot == VecMTDot_Seq_GEMV) v->ops->mtdot = mdot ? VecMTDot_Seq_GEMV : VecMTDot_Seq;
+  if (v->ops->mtdot_local == VecMTDot_Seq || v->ops->mtdot_local == VecMTDot_Seq_GEMV) v->ops->mtdot_local = mdot ? VecMTDot_Seq_GEMV : VecMTDot_Seq;
+  if (v->ops->maxpy == VecMAXPY_Seq || v->ops->maxpy == VecMAXPY_Seq_GEMV) v->ops->maxpy = maxpy ? VecMAXPY_Seq_GEMV : VecMAXPY_Seq;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecSetFromOptions_Seq(Vec v, PetscOptionItems *PetscOptionsObject)
+{
+  PetscBool isseq, mdot = (PetscBool)(v->ops->mdot == VecMDot_Seq_GEMV), maxpy = (PetscBool)(v->ops->maxpy == VecMAXPY_Seq_GEMV), set_mdot, set_maxpy;
+
+  PetscFunctionBegin;
+  /* subtypes that only inherit the operations, e.g. device vectors, keep their own */
+  PetscCall(PetscObjectTypeCompare((PetscObject)v, VECSEQ, &isseq));
+  if (!isseq) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscOptionsHeadBegin(PetscOptionsObject, "VecSeq Options");
+  PetscCall(PetscOptionsBool("-vec_mdot_use_gemv", "Store VecDuplicateVecs() contiguously and use BLAS gemv in VecMDot()", "VecMDot", mdot, &mdot, &set_mdot));
+  PetscCall(PetscOptionsBool("-vec_maxpy_use_gemv", "Store VecDuplicateVecs() contiguously and use BLAS gemv in VecMAXPY()", "VecMAXPY", maxpy, &maxpy, &set_maxpy));
+  PetscOptionsHeadEnd();
+  if (set_mdot || set_maxpy) PetscCall(VecSetUseGEMV_Seq(v, mdot, maxpy));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -799,7 +890,7 @@ static const struct _VecOps DvOps = {
   PetscDesignatedInitializer(setlocaltoglobalmapping, NULL),
   PetscDesignatedInitializer(setvalueslocal, NULL),
   PetscDesignatedInitializer(resetarray, VecResetArray_Seq),
-  PetscDesignatedInitializer(setfromoptions, NULL),
+  PetscDesignatedInitializer(setfromoptions, VecSetFromOptions_Seq),
   PetscDesignatedInitializer(maxpointwisedivide, VecMaxPointwiseDivide_Seq),
   PetscDesignatedInitializer(pointwisemax, VecPointwiseMax_Seq),
   PetscDesignatedInitializer(pointwisemaxabs, VecPointwiseMaxAbs_Seq),
@@ -841,6 +932,8 @@ static const struct _VecOps DvOps = {
   PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_Seq),
   PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_Seq),
   PetscDesignatedInitializer(errorwnorm, NULL),
+  PetscDesignatedInitializer(maxpby, NULL),
+  PetscDesignatedInitializer(mdotmaxpynorm, VecMDotMAXPYNorm_Seq),
 };
 
 /*
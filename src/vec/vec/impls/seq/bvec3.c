@@ -8,7 +8,12 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq        - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+. -vec_omp_first_touch - zero the vector arrays from the OpenMP threads, each thread touching one contiguous chunk,
+                         so that on NUMA machines the pages are placed close to the threads that use them
+. -vec_mdot_use_gemv   - `VecDuplicateVecs()` stores the vectors contiguously and `VecMDot()` and `VecMTDot()` use BLAS gemv
+                         on runs of such vectors (default false, true for the Krylov vectors of `KSPGMRES` and `KSPFGMRES`)
+- -vec_maxpy_use_gemv  - same for `VecMAXPY()` (default false, true for the Krylov vectors of `KSPGMRES` and `KSPFGMRES`)
 
   Level: beginner
 
@@ -20,6 +25,30 @@ extern PetscErrorCode VecCreate_Seq_Private(Vec, const float *);
 extern PetscErrorCode VecCreate_Seq_Private(Vec, const double *);
 #endif
 
+/*
+   VecCallocArray_Private - allocates a zeroed array for a vector. With -vec_omp_first_touch the array is zeroed by
+   the OpenMP threads, thread t touching the t-th of PetscNumOMPThreads contiguous chunks, which is the split of the
+   rows the threaded kernels use for matrices with (nearly) constant row lengths
+*/
+PetscErrorCode VecCallocArray_Private(PetscInt n, PetscScalar **array)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPFirstTouch && PetscNumOMPThreads > 1) {
+    PetscScalar *a;
+    PetscInt     i;
+
+    PetscCall(PetscMalloc1(n, &a));
+    PetscPragmaOMP(parallel for num_threads((int)PetscNumOMPThreads) schedule(static))
+    for (i = 0; i < n; i++) a[i] = 0.0;
+    *array = a;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCall(PetscCalloc1(n, array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecCreate_Seq(Vec V)
 {
   Vec_Seq     *s;
@@ -31,7 +60,7 @@ PetscErrorCode VecCreate_Seq(Vec V)
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)V), &size));
   PetscCheck(size <= 1, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Cannot create VECSEQ on more than one process");
 #if !defined(PETSC_USE_MIXED_PRECISION)
-  PetscCall(PetscCalloc1(n, &array));
+  PetscCall(VecCallocArray_Private(n, &array));
   PetscCall(VecCreate_Seq_Private(V, array));
 
   s                  = (Vec_Seq *)V->data;
@@ -5,6 +5,7 @@
 */
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
+#include <petscblaslapack.h>
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
   #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
@@ -613,6 +614,209 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Finds the longest run y[i], y[i+1], ..., y[j-1] of vectors whose arrays are equally spaced in memory, as those created by
+   VecDuplicateVecs_Seq_GEMV() or VecDuplicateVecs_MPI_GEMV(), so that the run is a column-major matrix with leading dimension lda
+*/
+static PetscErrorCode VecFindContiguousRun_Private(PetscInt n, PetscInt i, PetscInt nv, const Vec y[], PetscInt *j, PetscBLASInt *lda)
+{
+  const PetscScalar *yfirst, *ynext;
+  PetscInt64         stride = 0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(y[i], &yfirst));
+  for (*j = i + 1; *j < nv; (*j)++) {
+    PetscBool stop;
+
+    PetscCall(VecGetArrayRead(y[*j], &ynext));
+    if (*j == i + 1) {
+      stride = ynext - yfirst;
+      stop   = (PetscBool)(stride < n || stride - n >= VEC_DUPLICATEVECS_ALIGN || stride > PETSC_BLAS_INT_MAX); /* only the padding of the aligned arrays is accepted */
+    } else stop = (PetscBool)(stride * (*j - i) != ynext - yfirst);
+    PetscCall(VecRestoreArrayRead(y[*j], &ynext));
+    if (stop) break;
+  }
+  PetscCall(VecRestoreArrayRead(y[i], &yfirst));
+  *lda = (PetscBLASInt)stride;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecMXDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z, PetscBool conjugate)
+{
+  const PetscInt     n = xin->map->n;
+  const PetscScalar *xx, *yy;
+  PetscBLASInt       bn, bm, lda, one = 1;
+  const PetscScalar  sone = 1.0, zero = 0.0;
+
+  PetscFunctionBegin;
+  if (!n) {
+    PetscCall(PetscArrayzero(z, nv));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(VecGetArrayRead(xin, &xx));
+  for (PetscInt i = 0, j; i < nv; i = j) {
+    PetscCall(VecFindContiguousRun_Private(n, i, nv, yin, &j, &lda));
+    if (j - i > 1) {
+      PetscCall(PetscBLASIntCast(j - i, &bm));
+      PetscCall(VecGetArrayRead(yin[i], &yy));
+      PetscCallBLAS("BLASgemv", BLASgemv_(conjugate ? "C" : "T", &bn, &bm, &sone, yy, &lda, xx, &one, &zero, z + i, &one));
+      PetscCall(VecRestoreArrayRead(yin[i], &yy));
+      PetscCall(PetscLogFlops(bm * (2.0 * n - 1)));
+    } else if (conjugate) PetscCall(VecDot_Seq(xin, yin[i], z + i));
+    else PetscCall(VecTDot_Seq(xin, yin[i], z + i));
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_Seq_GEMV(xin, nv, yin, z, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMTDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_Seq_GEMV(xin, nv, yin, z, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMAXPY_Seq_GEMV(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y)
+{
+  const PetscInt     n = xin->map->n;
+  const PetscScalar *yy;
+  PetscScalar       *xx;
+  PetscBLASInt       bn, bm, lda, one = 1;
+  const PetscScalar  sone = 1.0;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(n, &bn));
+  for (PetscInt i = 0, j; i < nv; i = j) {
+    PetscCall(VecFindContiguousRun_Private(n, i, nv, y, &j, &lda));
+    if (j - i > 1) {
+      PetscCall(PetscBLASIntCast(j - i, &bm));
+      PetscCall(VecGetArray(xin, &xx));
+      PetscCall(VecGetArrayRead(y[i], &yy));
+      PetscCallBLAS("BLASgemv", BLASgemv_("N", &bn, &bm, &sone, yy, &lda, alpha + i, &one, &sone, xx, &one));
+      PetscCall(VecRestoreArrayRead(y[i], &yy));
+      PetscCall(VecRestoreArray(xin, &xx));
+      PetscCall(PetscLogFlops(bm * 2.0 * n));
+    } else PetscCall(VecAXPY_Seq(xin, alpha[i], y[i]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   x = x - sum z[j] y[j], used to orthogonalize x against the y[j] once z[j] = (x, y[j]) is known. If nrm is not NULL
+   it returns the 2-norm of the local entries of the result; the squares are summed while the last group of y[j] is
+   subtracted, so that x is read only once for both, unless the sum is out of the range where it is accurate, then the
+   norm is computed again with the scaled BLAS nrm2.
+
+   The groups of vectors and the association of the sums are those of VecMAXPY_Seq(), hence x gets the same rounding
+*/
+PetscErrorCode VecMSubtractNorm_Seq(Vec xin, PetscInt nv, const PetscScalar *z, const Vec *y, PetscReal *nrm)
+{
+  const PetscInt     n = xin->map->n;
+  const PetscScalar *yptr[4];
+  PetscScalar       *xx;
+  PetscReal          sum = 0.0;
+
+  PetscFunctionBegin;
+  if (xin->ops->maxpy == VecMAXPY_Seq_GEMV) {
+    PetscScalar *a;
+
+    PetscCall(PetscMalloc1(nv, &a));
+    for (PetscInt j = 0; j < nv; ++j) a[j] = -z[j];
+    PetscCall(VecMAXPY_Seq_GEMV(xin, nv, a, (Vec *)y));
+    PetscCall(PetscFree(a));
+    if (nrm) PetscCall(VecNorm_Seq(xin, NORM_2, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscLogFlops(nv * 2.0 * n + (nrm ? 2.0 * n : 0.0)));
+  PetscCall(VecGetArray(xin, &xx));
+  /* as in VecMAXPY_Seq() the remainder of nv by 4 is handled first, then groups of 4 vectors */
+  for (PetscInt j = 0, inc; j < nv; j += inc, z += inc, y += inc) {
+    PetscScalar a[4] = {0.0, 0.0, 0.0, 0.0};
+
+    inc = (j || !(nv & 0x3)) ? 4 : (nv & 0x3);
+    for (PetscInt i = 0; i < inc; ++i) {
+      PetscCall(VecGetArrayRead(y[i], yptr + i));
+      a[i] = -z[i];
+    }
+    if (nrm && j + inc == nv) {
+      switch (inc) {
+      case 4:
+        for (PetscInt i = 0; i < n; ++i) {
+          xx[i] += a[0] * yptr[0][i] + a[1] * yptr[1][i] + a[2] * yptr[2][i] + a[3] * yptr[3][i];
+          sum += PetscRealPart(xx[i] * PetscConj(xx[i]));
+        }
+        break;
+      case 3:
+        for (PetscInt i = 0; i < n; ++i) {
+          xx[i] += a[0] * yptr[0][i] + a[1] * yptr[1][i] + a[2] * yptr[2][i];
+          sum += PetscRealPart(xx[i] * PetscConj(xx[i]));
+        }
+        break;
+      case 2:
+        for (PetscInt i = 0; i < n; ++i) {
+          xx[i] += a[0] * yptr[0][i] + a[1] * yptr[1][i];
+          sum += PetscRealPart(xx[i] * PetscConj(xx[i]));
+        }
+        break;
+      default:
+        for (PetscInt i = 0; i < n; ++i) {
+          xx[i] += a[0] * yptr[0][i];
+          sum += PetscRealPart(xx[i] * PetscConj(xx[i]));
+        }
+      }
+    } else {
+      switch (inc) {
+      case 4:
+        PetscKernelAXPY4(xx, a[0], a[1], a[2], a[3], yptr[0], yptr[1], yptr[2], yptr[3], n);
+        break;
+      case 3:
+        PetscKernelAXPY3(xx, a[0], a[1], a[2], yptr[0], yptr[1], yptr[2], n);
+        break;
+      case 2:
+        PetscKernelAXPY2(xx, a[0], a[1], yptr[0], yptr[1], n);
+        break;
+      default:
+        PetscKernelAXPY(xx, a[0], yptr[0], n);
+      }
+    }
+    for (PetscInt i = 0; i < inc; ++i) PetscCall(VecRestoreArrayRead(y[i], yptr + i));
+  }
+  PetscCall(VecRestoreArray(xin, &xx));
+  if (nrm) {
+    /* squares that underflow or overflow, including a zero or non-finite x, are left to the scaled nrm2 */
+    if (nv && sum > n * (PETSC_REAL_MIN / PETSC_MACHINE_EPSILON) && sum < PETSC_MAX_REAL) *nrm = PetscSqrtReal(sum);
+    else PetscCall(VecNorm_Seq(xin, NORM_2, nrm));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMDotMAXPYNorm_Seq(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z, PetscReal *nrm)
+{
+  PetscBool finite = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  /* types that inherit the sequential operations but replace the kernels, e.g. device vectors, use their own */
+  if ((xin->ops->mdot != VecMDot_Seq && xin->ops->mdot != VecMDot_Seq_GEMV) || (xin->ops->maxpy != VecMAXPY_Seq && xin->ops->maxpy != VecMAXPY_Seq_GEMV)) {
+    PetscCall(VecMDotMAXPYNorm_Default(xin, nv, y, z, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(xin->ops->mdot(xin, nv, y, z));
+  for (PetscInt j = 0; j < nv; ++j) finite = (PetscBool)(finite && !PetscIsInfOrNanScalar(z[j]));
+  /* x is left unchanged if a dot product is Inf or NaN, so that the caller can check them before x is lost */
+  if (finite) PetscCall(VecMSubtractNorm_Seq(xin, nv, z, y, nrm));
+  else if (nrm) PetscCall(VecNorm_Seq(xin, NORM_2, nrm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/faypx.h>
 
 PetscErrorCode VecAYPX_Seq(Vec yin, PetscScalar alpha, Vec xin)
@@ -150,6 +150,7 @@ PETSC_EXTERN void MPIAPI PetscSplitReduction_Local(void *, void *, PetscMPIInt *
 
 const char *const NormTypes[] = {"1", "2", "FROBENIUS", "INFINITY", "1_AND_2", "NormType", "NORM_", NULL};
 PetscInt          NormIds[7]; /* map from NormType to IDs used to cache Normvalues */
+PetscBool         VecOMPFirstTouch = PETSC_FALSE;
 
 static PetscBool VecPackageInitialized = PETSC_FALSE;
 
@@ -193,6 +194,7 @@ PetscErrorCode VecInitializePackage(void)
   PetscCall(PetscLogEventRegister("VecAXPBYCZ", VEC_CLASSID, &VEC_AXPBYPCZ));
   PetscCall(PetscLogEventRegister("VecWAXPY", VEC_CLASSID, &VEC_WAXPY));
   PetscCall(PetscLogEventRegister("VecMAXPY", VEC_CLASSID, &VEC_MAXPY));
+  PetscCall(PetscLogEventRegister("VecMDotMAXPYNrm", VEC_CLASSID, &VEC_MDotMAXPYNorm));
   PetscCall(PetscLogEventRegister("VecSwap", VEC_CLASSID, &VEC_Swap));
   PetscCall(PetscLogEventRegister("VecOps", VEC_CLASSID, &VEC_Ops));
   PetscCall(PetscLogEventRegister("VecAssemblyBegin", VEC_CLASSID, &VEC_AssemblyBegin));
@@ -264,6 +266,10 @@ PetscErrorCode VecInitializePackage(void)
   /* Register the different norm types for cached norms */
   for (i = 0; i < 4; i++) PetscCall(PetscObjectComposedDataRegister(NormIds + i));
 
+#if defined(PETSC_HAVE_OPENMP)
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vec_omp_first_touch", &VecOMPFirstTouch, NULL));
+#endif
+
   /* Register package finalizer */
   PetscCall(PetscRegisterFinalize(VecFinalizePackage));
   PetscFunctionReturn(PETSC_SUCCESS);
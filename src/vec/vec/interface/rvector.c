@@ -1342,6 +1342,87 @@ PetscErrorCode VecMAXPBY(Vec y, PetscInt nv, const PetscScalar alpha[], PetscSca
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecMDotMAXPYNorm_Default(Vec x, PetscInt nv, const Vec y[], PetscScalar val[], PetscReal *norm)
+{
+  PetscBool finite = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(VecMDot(x, nv, y, val));
+  for (PetscInt i = 0; i < nv; ++i) finite = (PetscBool)(finite && !PetscIsInfOrNanScalar(val[i]));
+  if (finite) {
+    for (PetscInt i = 0; i < nv; ++i) val[i] = -val[i];
+    PetscCall(VecMAXPY(x, nv, val, (Vec *)y));
+    for (PetscInt i = 0; i < nv; ++i) val[i] = -val[i];
+  }
+  if (norm) PetscCall(VecNorm(x, NORM_2, norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  VecMDotMAXPYNorm - Computes the multiple dot products `val[i] = (x, y[i])`, then `x = x - sum val[i] y[i]` and
+  the 2-norm of the updated `x`, that is one classical Gram-Schmidt step of `x` against the `y` vectors
+
+  Collective
+
+  Input Parameters:
++ x  - the vector to orthogonalize
+. nv - number of vectors
+- y  - array of vectors
+
+  Output Parameters:
++ val  - array of the dot products (does not allocate the array)
+- norm - the 2-norm of `x` after the update, pass `NULL` if it is not needed
+
+  Level: advanced
+
+  Notes:
+  The result is the same as `VecMDot()`, `VecMAXPY()` with the negated dot products, and `VecNorm()`, but implementations
+  can fuse the operations, for example the standard CPU vectors compute the norm while the last entries are subtracted so
+  that `x` is streamed through memory one time less. The norm is stashed in `x`, hence a following `VecNorm()` or
+  `VecNormalize()` does not compute it again.
+
+  If any of the dot products is Inf or NaN, `x` is not updated and `norm` is its unchanged norm, so that the caller can
+  check the dot products before `x` is modified.
+
+  `x` cannot be any of the `y` vectors.
+
+.seealso: [](ch_vectors), `Vec`, `VecMDot()`, `VecMAXPY()`, `VecNorm()`, `KSPGMRESClassicalGramSchmidtOrthogonalization()`
+@*/
+PetscErrorCode VecMDotMAXPYNorm(Vec x, PetscInt nv, const Vec y[], PetscScalar val[], PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 1);
+  PetscValidType(x, 1);
+  VecCheckAssembled(x);
+  PetscValidLogicalCollectiveInt(x, nv, 2);
+  PetscCall(VecSetErrorIfLocked(x, 1));
+  PetscCheck(nv >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nv);
+  if (!nv) {
+    if (norm) PetscCall(VecNorm(x, NORM_2, norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscAssertPointer(y, 3);
+  PetscAssertPointer(val, 4);
+  for (PetscInt i = 0; i < nv; ++i) {
+    PetscValidHeaderSpecific(y[i], VEC_CLASSID, 3);
+    PetscValidType(y[i], 3);
+    PetscCheckSameTypeAndComm(x, 1, y[i], 3);
+    VecCheckSameSize(x, 1, y[i], 3);
+    PetscCheck(x != y[i], PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Array of vectors 'y' cannot contain x, found y[%" PetscInt_FMT "] == x", i);
+    VecCheckAssembled(y[i]);
+    PetscCall(VecLockReadPush(y[i]));
+  }
+
+  PetscCall(PetscLogEventBegin(VEC_MDotMAXPYNorm, x, *y, 0, 0));
+  if (x->ops->mdotmaxpynorm) PetscUseTypeMethod(x, mdotmaxpynorm, nv, y, val, norm);
+  else PetscCall(VecMDotMAXPYNorm_Default(x, nv, y, val, norm));
+  PetscCall(PetscLogEventEnd(VEC_MDotMAXPYNorm, x, *y, 0, 0));
+  for (PetscInt i = 0; i < nv; ++i) PetscCall(VecLockReadPop(y[i]));
+  PetscCall(PetscObjectStateIncrease((PetscObject)x));
+  if (norm) PetscCall(PetscObjectComposedDataSetReal((PetscObject)x, NormIds[NORM_2], *norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   VecConcatenate - Creates a new vector that is a vertical concatenation of all the given array of vectors
   in the order they appear in the array. The concatenated vector resides on the same
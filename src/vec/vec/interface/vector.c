@@ -9,7 +9,7 @@
 PetscClassId  VEC_CLASSID;
 PetscLogEvent VEC_View, VEC_Max, VEC_Min, VEC_Dot, VEC_MDot, VEC_TDot;
 PetscLogEvent VEC_Norm, VEC_Normalize, VEC_Scale, VEC_Copy, VEC_Set, VEC_AXPY, VEC_AYPX, VEC_WAXPY;
-PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
+PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_MDotMAXPYNorm, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
 PetscLogEvent VEC_AssemblyEnd, VEC_PointwiseMult, VEC_SetValues, VEC_Load, VEC_SetPreallocateCOO, VEC_SetValuesCOO;
 PetscLogEvent VEC_SetRandom, VEC_ReduceArithmetic, VEC_ReduceCommunication, VEC_ReduceBegin, VEC_ReduceEnd, VEC_Ops;
 PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ;
@@ -598,10 +598,14 @@ PetscErrorCode VecDestroy(Vec *v)
 
   Level: intermediate
 
-  Note:
+  Notes:
   Use `VecDestroyVecs()` to free the space. Use `VecDuplicate()` to form a single
   vector.
 
+  With `-vec_mdot_use_gemv` or `-vec_maxpy_use_gemv`, given to `VecSetFromOptions()` of `v`, `VECSEQ` and `VECMPI` store the local
+  parts of the `m` vectors one after the other in a single allocation, so that `VecMDot()` and `VecMAXPY()` on consecutive vectors
+  of the array use BLAS gemv, see `VECSEQ`.
+
   Fortran Notes:
   The Fortran interface is slightly different from that given below, it
   requires one to pass in `V` a `Vec` array of size at least `m`.
@@ -0,0 +1,118 @@
+static char help[] = "Tests VecMDotMAXPYNorm() against VecMDot(), VecMAXPY() and VecNorm()\n";
+
+#include <petscvec.h>
+
+int main(int argc, char **argv)
+{
+  Vec         *V, t, x, y;
+  PetscInt     i, j, n = 15, k = 9;
+  PetscRandom  rctx;
+  PetscScalar *val, *val_fused;
+  PetscReal    nrm, nrm_fused, err, in_span = 0.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-k", &k, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-in_span", &in_span, NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Test with %" PetscInt_FMT " random vectors of length %" PetscInt_FMT "\n", k, n));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rctx));
+  PetscCall(PetscRandomSetFromOptions(rctx));
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &t));
+  PetscCall(VecSetSizes(t, n, PETSC_DECIDE));
+  PetscCall(VecSetFromOptions(t));
+  PetscCall(VecDuplicate(t, &x));
+  PetscCall(VecDuplicate(t, &y));
+  PetscCall(VecDuplicateVecs(t, k, &V));
+  PetscCall(VecSetRandom(t, rctx));
+  PetscCall(PetscMalloc2(k, &val, k, &val_fused));
+  /* orthonormal vectors, as in classical Gram-Schmidt, obtained with two passes of it */
+  for (i = 0; i < k; i++) {
+    PetscCall(VecSetRandom(V[i], rctx));
+    for (PetscInt pass = 0; pass < 2; pass++) {
+      PetscCall(VecMDot(V[i], i, V, val));
+      for (j = 0; j < i; j++) val[j] = -val[j];
+      PetscCall(VecMAXPY(V[i], i, val, V));
+    }
+    PetscCall(VecNormalize(V[i], NULL));
+  }
+  /* t = sum V[i] + in_span t so that orthogonalizing it against all the V[i] cancels most of it */
+  if (in_span > 0.0) {
+    PetscCall(VecScale(t, in_span));
+    for (i = 0; i < k; i++) PetscCall(VecAXPY(t, 1.0, V[i]));
+  }
+
+  /* every number of vectors, so that all the remainders of the groups of 4 vectors are covered, with and without the norm */
+  for (i = 0; i <= k; i++) {
+    PetscCall(VecCopy(t, x));
+    PetscCall(VecMDot(x, i, V, val));
+    for (j = 0; j < i; j++) val[j] = -val[j];
+    PetscCall(VecMAXPY(x, i, val, V));
+    PetscCall(VecNorm(x, NORM_2, &nrm));
+
+    PetscCall(VecCopy(t, y));
+    PetscCall(VecMDotMAXPYNorm(y, i, V, val_fused, i % 2 ? NULL : &nrm_fused));
+    for (j = 0; j < i; j++) {
+      if (PetscAbsScalar(val_fused[j] + val[j]) > 1e-10 * PetscAbsScalar(val[j])) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "[TEST FAILED] i=%" PetscInt_FMT ", j=%" PetscInt_FMT ", dot products differ\n", i, j));
+    }
+    if (!(i % 2) && PetscAbsReal(nrm_fused - nrm) > 1e-10 * nrm) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "[TEST FAILED] i=%" PetscInt_FMT ", norm %g instead of %g\n", i, (double)nrm_fused, (double)nrm));
+    PetscCall(VecAXPY(y, -1.0, x));
+    PetscCall(VecNorm(y, NORM_2, &err));
+    if (err > 1e-10 * nrm) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "[TEST FAILED] i=%" PetscInt_FMT ", vectors differ by %g\n", i, (double)err));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Test completed successfully!\n"));
+  PetscCall(PetscFree2(val, val_fused));
+  PetscCall(VecDestroyVecs(k, &V));
+  PetscCall(VecDestroy(&t));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(PetscRandomDestroy(&rctx));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/ex65_1.out
+
+      test:
+         suffix: 1
+
+      test:
+         suffix: 2
+         nsize: 2
+
+      test:
+         suffix: in_span
+         args: -in_span 1e-3
+
+      test:
+         suffix: 2_in_span
+         nsize: 2
+         args: -in_span 1e-3
+
+      test:
+         suffix: mdot_gemv
+         args: -vec_mdot_use_gemv
+
+      test:
+         suffix: maxpy_gemv
+         args: -vec_mdot_use_gemv -vec_maxpy_use_gemv
+
+      test:
+         suffix: 2_maxpy_gemv
+         nsize: 2
+         args: -vec_mdot_use_gemv -vec_maxpy_use_gemv
+
+      test:
+         suffix: cuda
+         args: -vec_type cuda
+         requires: cuda
+
+      test:
+         suffix: kokkos
+         args: -vec_type kokkos
+         requires: kokkos_kernels
+
+TEST*/